@@ -144,6 +144,17 @@ public:
     void updateHashWithValues(IColumn::HashValues & hash_values, const TiDB::TiDBCollatorPtr &, String &) const override;
     void updateWeakHash32(WeakHash32 & hash, const TiDB::TiDBCollatorPtr &, String &) const override;
     int compareAt(size_t n, size_t m, const IColumn & rhs_, int nan_direction_hint) const override;
+    void compareColumn(
+        const IColumn & rhs,
+        size_t rhs_row_num,
+        IColumn::RowIndexes & row_indexes,
+        IColumn::CompareResults & compare_results,
+        int direction,
+        int nan_direction_hint,
+        const ICollator * /*collator*/) const override
+    {
+        this->template compareColumnImpl<Self>(rhs, rhs_row_num, row_indexes, compare_results, direction, nan_direction_hint);
+    }
     void getPermutation(bool reverse, size_t limit, int nan_direction_hint, IColumn::Permutation & res) const override;
 
     MutableColumnPtr cloneResized(size_t size) const override;
@@ -134,6 +134,18 @@ public:
         return memcmp(&chars[p1 * n], &rhs.chars[p2 * n], n);
     }
 
+    void compareColumn(
+        const IColumn & rhs,
+        size_t rhs_row_num,
+        RowIndexes & row_indexes,
+        CompareResults & compare_results,
+        int direction,
+        int nan_direction_hint,
+        const ICollator * /*collator*/) const override
+    {
+        compareColumnImpl<ColumnFixedString>(rhs, rhs_row_num, row_indexes, compare_results, direction, nan_direction_hint);
+    }
+
     void getPermutation(bool reverse, size_t limit, int nan_direction_hint, Permutation & res) const override;
 
     void insertRangeFrom(const IColumn & src, size_t start, size_t length) override;
@@ -332,6 +332,53 @@ int ColumnNullable::compareAt(size_t n, size_t m, const IColumn & rhs_, int null
     return getNestedColumn().compareAt(n, m, nested_rhs, null_direction_hint);
 }
 
+void ColumnNullable::compareColumn(
+    const IColumn & rhs_,
+    size_t rhs_row_num,
+    RowIndexes & row_indexes,
+    CompareResults & compare_results,
+    int direction,
+    int null_direction_hint,
+    const ICollator * collator) const
+{
+    const auto & nullable_rhs = static_cast<const ColumnNullable &>(rhs_);
+    const auto & null_map = getNullMapData();
+    const bool rval_is_null = nullable_rhs.isNullAt(rhs_row_num);
+
+    /// The rows with NULL are compared here, and the others are compared by the nested column in batch.
+    RowIndexes nested_row_indexes;
+    size_t num_ties = 0;
+    for (const auto row : row_indexes)
+    {
+        const bool lval_is_null = null_map[row];
+        if (!lval_is_null && !rval_is_null)
+        {
+            nested_row_indexes.push_back(row);
+            continue;
+        }
+        int res = 0;
+        if (!lval_is_null || !rval_is_null)
+            res = lval_is_null ? null_direction_hint : -null_direction_hint;
+        compare_results[row] = static_cast<Int8>(res * direction);
+        if (res == 0)
+            row_indexes[num_ties++] = row;
+    }
+    row_indexes.resize(num_ties);
+    if (nested_row_indexes.empty())
+        return;
+
+    /// rhs[rhs_row_num] is not NULL here, so none of the rows with NULL is a tie.
+    getNestedColumn().compareColumn(
+        nullable_rhs.getNestedColumn(),
+        rhs_row_num,
+        nested_row_indexes,
+        compare_results,
+        direction,
+        null_direction_hint,
+        collator);
+    row_indexes.swap(nested_row_indexes);
+}
+
 void ColumnNullable::getPermutation(
     const ICollator & collator,
     bool reverse,
@@ -314,6 +314,21 @@ public:
     /// Variant of compareAt for string comparison with respect of collation.
     int compareAtWithCollationImpl(size_t n, size_t m, const IColumn & rhs_, const ICollator & collator) const;
 
+    void compareColumn(
+        const IColumn & rhs,
+        size_t rhs_row_num,
+        RowIndexes & row_indexes,
+        CompareResults & compare_results,
+        int direction,
+        int nan_direction_hint,
+        const ICollator * collator) const override
+    {
+        if (collator)
+            IColumn::compareColumn(rhs, rhs_row_num, row_indexes, compare_results, direction, nan_direction_hint, collator);
+        else
+            compareColumnImpl<ColumnString>(rhs, rhs_row_num, row_indexes, compare_results, direction, nan_direction_hint);
+    }
+
     void getPermutation(bool reverse, size_t limit, int nan_direction_hint, Permutation & res) const override;
 
     void getPermutation(const ICollator & collator, bool reverse, size_t limit, int, Permutation & res) const override
@@ -349,6 +349,18 @@ public:
         return CompareHelper<T>::compare(data[n], static_cast<const Self &>(rhs_).data[m], nan_direction_hint);
     }
 
+    void compareColumn(
+        const IColumn & rhs,
+        size_t rhs_row_num,
+        IColumn::RowIndexes & row_indexes,
+        IColumn::CompareResults & compare_results,
+        int direction,
+        int nan_direction_hint,
+        const ICollator * /*collator*/) const override
+    {
+        this->template compareColumnImpl<Self>(rhs, rhs_row_num, row_indexes, compare_results, direction, nan_direction_hint);
+    }
+
     void getPermutation(bool reverse, size_t limit, int nan_direction_hint, IColumn::Permutation & res) const override;
 
     void reserve(size_t n) override
@@ -34,4 +34,26 @@ String IColumn::dumpStructure() const
     return res.str();
 }
 
+void IColumn::compareColumn(
+    const IColumn & rhs,
+    size_t rhs_row_num,
+    RowIndexes & row_indexes,
+    CompareResults & compare_results,
+    int direction,
+    int nan_direction_hint,
+    const ICollator * collator) const
+{
+    size_t num_ties = 0;
+    for (const auto row : row_indexes)
+    {
+        const int res = collator
+            ? compareAt(row, rhs_row_num, rhs, nan_direction_hint, *collator)
+            : compareAt(row, rhs_row_num, rhs, nan_direction_hint);
+        compare_results[row] = static_cast<Int8>(((res > 0) - (res < 0)) * direction);
+        if (res == 0)
+            row_indexes[num_ties++] = row;
+    }
+    row_indexes.resize(num_ties);
+}
+
 } // namespace DB
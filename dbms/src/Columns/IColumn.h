@@ -255,6 +255,22 @@ public:
         throw Exception(fmt::format("Method compareAt with collation is not supported for {}", getName()), ErrorCodes::NOT_IMPLEMENTED);
     }
 
+    /** Compares the rows in row_indexes of this column with rhs[rhs_row_num] in batch.
+      * The sign of each result multiplied by direction is written to compare_results[row], which should have the size of this column.
+      * Only the rows equal to rhs[rhs_row_num] are kept in row_indexes, so that they can be compared by the next sort column.
+      * collator is only used by the string columns and can be nullptr.
+      */
+    using CompareResults = PaddedPODArray<Int8>;
+    using RowIndexes = PaddedPODArray<UInt64>;
+    virtual void compareColumn(
+        const IColumn & rhs,
+        size_t rhs_row_num,
+        RowIndexes & row_indexes,
+        CompareResults & compare_results,
+        int direction,
+        int nan_direction_hint,
+        const ICollator * collator) const;
+
     /** Returns a permutation that sorts elements of this column,
       *  i.e. perm[i]-th element of source column should be i-th element of sorted column.
       * reverse - reverse ordering (ascending).
@@ -458,6 +474,29 @@ protected:
         for (size_t i = 0; i < num_rows; ++i)
             static_cast<Derived &>(*columns[selector[i]]).insertFrom(*this, i);
     }
+
+    /// Template is to de-virtualize calls to compareAt method.
+    /// In derived classes, implement compareColumn method as call to compareColumnImpl.
+    template <typename Derived>
+    void compareColumnImpl(
+        const IColumn & rhs,
+        size_t rhs_row_num,
+        RowIndexes & row_indexes,
+        CompareResults & compare_results,
+        int direction,
+        int nan_direction_hint) const
+    {
+        const auto & derived = static_cast<const Derived &>(*this);
+        size_t num_ties = 0;
+        for (const auto row : row_indexes)
+        {
+            const int res = derived.Derived::compareAt(row, rhs_row_num, rhs, nan_direction_hint);
+            compare_results[row] = static_cast<Int8>(((res > 0) - (res < 0)) * direction);
+            if (res == 0)
+                row_indexes[num_ties++] = row;
+        }
+        row_indexes.resize(num_ties);
+    }
 };
 
 using ColumnPtr = IColumn::Ptr;
@@ -0,0 +1,106 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <numeric>
+
+namespace DB
+{
+namespace tests
+{
+class TestColumnCompareColumn : public ::testing::Test
+{
+public:
+    /// compareColumn should produce the same results as compareAt on each row, and keep the ties only.
+    static void doTestWork(const ColumnPtr & column, size_t rhs_row_num, const ICollator * collator = nullptr)
+    {
+        const size_t rows = column->size();
+        for (int direction : {1, -1})
+        {
+            for (int nan_direction_hint : {1, -1})
+            {
+                IColumn::RowIndexes row_indexes(rows);
+                std::iota(row_indexes.begin(), row_indexes.end(), 0);
+                IColumn::CompareResults compare_results(rows, 0);
+                column->compareColumn(*column, rhs_row_num, row_indexes, compare_results, direction, nan_direction_hint, collator);
+
+                IColumn::RowIndexes expected_row_indexes;
+                for (size_t row = 0; row < rows; ++row)
+                {
+                    int res = collator
+                        ? column->compareAt(row, rhs_row_num, *column, nan_direction_hint, *collator)
+                        : column->compareAt(row, rhs_row_num, *column, nan_direction_hint);
+                    res = ((res > 0) - (res < 0)) * direction;
+                    ASSERT_EQ(static_cast<int>(compare_results[row]), res) << column->getName() << " row " << row;
+                    if (res == 0)
+                        expected_row_indexes.push_back(row);
+                }
+                ASSERT_EQ(row_indexes, expected_row_indexes) << column->getName();
+            }
+        }
+    }
+};
+
+TEST_F(TestColumnCompareColumn, Vector)
+try
+{
+    auto column = createColumn<Int64>({3, 1, 2, 1, -5, 1}).column;
+    for (size_t rhs_row_num = 0; rhs_row_num < column->size(); ++rhs_row_num)
+        doTestWork(column, rhs_row_num);
+}
+CATCH
+
+TEST_F(TestColumnCompareColumn, Decimal)
+try
+{
+    auto column = createColumn<Decimal64>(std::make_tuple(10, 2), {"1.00", "-2.50", "1.00", "3.25"}).column;
+    for (size_t rhs_row_num = 0; rhs_row_num < column->size(); ++rhs_row_num)
+        doTestWork(column, rhs_row_num);
+}
+CATCH
+
+TEST_F(TestColumnCompareColumn, String)
+try
+{
+    auto column = createColumn<String>({"b", "a", "B", "", "b", "abc"}).column;
+    auto collator = TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI);
+    for (size_t rhs_row_num = 0; rhs_row_num < column->size(); ++rhs_row_num)
+    {
+        doTestWork(column, rhs_row_num);
+        doTestWork(column, rhs_row_num, collator);
+    }
+}
+CATCH
+
+TEST_F(TestColumnCompareColumn, Nullable)
+try
+{
+    auto column = createColumn<Nullable<Int64>>({2, {}, 1, 2, {}, 3}).column;
+    for (size_t rhs_row_num = 0; rhs_row_num < column->size(); ++rhs_row_num)
+        doTestWork(column, rhs_row_num);
+
+    auto string_column = createColumn<Nullable<String>>({"b", {}, "B", "a", {}}).column;
+    auto collator = TiDB::ITiDBCollator::getCollator(TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI);
+    for (size_t rhs_row_num = 0; rhs_row_num < string_column->size(); ++rhs_row_num)
+    {
+        doTestWork(string_column, rhs_row_num);
+        doTestWork(string_column, rhs_row_num, collator);
+    }
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
@@ -91,6 +91,11 @@ namespace DB
         F(type_mpp_establish_conn, {{"type", "mpp_tunnel"}}),                                                                                       \
         F(type_mpp_establish_conn_local, {{"type", "mpp_tunnel_local"}}),                                                                           \
         F(type_cancel_mpp_task, {{"type", "cancel_mpp_task"}}))                                                                                     \
+    M(tiflash_coprocessor_response_cache, "Operations of coprocessor response cache", Counter,                                                      \
+        F(type_hit, {"type", "hit"}), F(type_miss, {"type", "miss"}), F(type_stale, {"type", "stale"}),                                             \
+        F(type_insert, {"type", "insert"}), F(type_too_large, {"type", "too_large"}), F(type_evict, {"type", "evict"}),                             \
+        F(type_invalidate, {"type", "invalidate"}))                                                                                                 \
+    M(tiflash_coprocessor_response_cache_bytes, "Memory usage of coprocessor response cache", Gauge)                                                \
     M(tiflash_exchange_data_bytes, "Total bytes sent by exchange operators", Counter,                                                               \
         F(type_hash_original, {"type", "hash_original"}),                                                                                           \
         F(type_hash_none_compression_remote, {"type", "hash_none_compression_remote"}),                                                             \
@@ -176,6 +181,26 @@ namespace DB
         F(type_delta_merge_by_delete_range, {{"type", "delta_merge_by_delete_range"}}, ExpBuckets{0.001, 2, 20}),                                   \
         F(type_flush, {{"type", "flush"}}, ExpBuckets{0.001, 2, 20}),                                                                               \
         F(type_split, {{"type", "split"}}, ExpBuckets{0.001, 2, 20}))                                                                               \
+    M(tiflash_storage_bg_task_wait_seconds, "Bucketed histogram of the time that storage's background tasks wait in the queue", Histogram,          \
+        F(type_flush, {{"type", "flush"}}, ExpBuckets{0.001, 2, 20}),                                                                               \
+        F(type_compact, {{"type", "compact"}}, ExpBuckets{0.001, 2, 20}),                                                                           \
+        F(type_merge_delta, {{"type", "merge_delta"}}, ExpBuckets{0.001, 2, 20}),                                                                   \
+        F(type_split, {{"type", "split"}}, ExpBuckets{0.001, 2, 20}),                                                                               \
+        F(type_place_index, {{"type", "place_index"}}, ExpBuckets{0.001, 2, 20}))                                                                   \
+    M(tiflash_storage_bg_task_deadline_exceeded_count, "Total number of storage's background tasks that start after their deadlines", Counter,      \
+        F(type_flush, {"type", "flush"}),                                                                                                           \
+        F(type_compact, {"type", "compact"}),                                                                                                       \
+        F(type_merge_delta, {"type", "merge_delta"}),                                                                                               \
+        F(type_split, {"type", "split"}),                                                                                                           \
+        F(type_place_index, {"type", "place_index"}))                                                                                               \
+    M(tiflash_storage_bg_task_deferred_count, "Total number of times that storage's background tasks are deferred by the scheduler", Counter,       \
+        F(type_disk_budget, {"type", "disk_budget"}),                                                                                               \
+        F(type_urgent_tasks, {"type", "urgent_tasks"}),                                                                                             \
+        F(type_foreground_latency, {"type", "foreground_latency"}))                                                                                 \
+    M(tiflash_storage_tier_migration_count, "Total number of the stables moved between the main and the cold data paths", Counter,                  \
+        F(type_to_cold, {"type", "to_cold"}),                                                                                                       \
+        F(type_to_hot, {"type", "to_hot"}),                                                                                                         \
+        F(type_throttled, {"type", "throttled"}))                                                                                                   \
     M(tiflash_storage_page_gc_count, "Total number of page's gc execution.", Counter,                                                               \
         F(type_v2, {"type", "v2"}),                                                                                                                 \
         F(type_v2_low, {"type", "v2_low"}),                                                                                                         \
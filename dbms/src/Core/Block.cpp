@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Columns/ColumnConst.h>
+#include <Columns/ColumnsNumber.h>
 #include <Common/Exception.h>
 #include <Common/FieldVisitors.h>
 #include <Common/typeid_cast.h>
@@ -681,6 +682,8 @@ void Block::clear()
     info = BlockInfo();
     data.clear();
     index_by_name.clear();
+    selection_col = nullptr;
+    selected_rows = 0;
 }
 
 void Block::swap(Block & other) noexcept
@@ -688,6 +691,25 @@ void Block::swap(Block & other) noexcept
     std::swap(info, other.info);
     data.swap(other.data);
     index_by_name.swap(other.index_by_name);
+    selection_col.swap(other.selection_col);
+    std::swap(selected_rows, other.selected_rows);
+}
+
+void Block::materializeSelection()
+{
+    if (!selection_col)
+        return;
+
+    const auto & filter = typeid_cast<const ColumnUInt8 &>(*selection_col).getData();
+    for (auto & elem : data)
+    {
+        if (elem.column->isColumnConst())
+            elem.column = elem.column->cut(0, selected_rows);
+        else
+            elem.column = elem.column->filter(filter, selected_rows);
+    }
+    selection_col = nullptr;
+    selected_rows = 0;
 }
 
 
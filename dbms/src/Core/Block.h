@@ -51,6 +51,10 @@ private:
     // `segment_row_id_col` is a virtual column that represents the records' row id in the corresponding segment.
     // Only used for calculating MVCC-bitmap-filter.
     ColumnPtr segment_row_id_col;
+    // `selection_col` is an optional ColumnUInt8 of the same size as the columns, only the rows whose value is not 0 are
+    // valid. It is set by the filter to defer filtering the columns, see `materializeSelection`.
+    ColumnPtr selection_col;
+    size_t selected_rows = 0;
 
 public:
     BlockInfo info;
@@ -163,6 +167,17 @@ public:
     void setSegmentRowIdCol(ColumnPtr && col) { segment_row_id_col = col; }
     ColumnPtr segmentRowIdCol() const { return segment_row_id_col; }
 
+    void setSelection(ColumnPtr && col, size_t selected_rows_)
+    {
+        selection_col = std::move(col);
+        selected_rows = selected_rows_;
+    }
+    const ColumnPtr & selectionCol() const { return selection_col; }
+    /// Returns the number of valid rows, which is less than `rows()` if the block has a selection.
+    size_t selectedRows() const { return selection_col ? selected_rows : rows(); }
+    /// Filter the columns by the selection and drop it. Nothing is done if the block has no selection.
+    void materializeSelection();
+
 private:
     void eraseImpl(size_t position);
     void initializeIndexByName();
@@ -0,0 +1,113 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/FmtUtils.h>
+#include <DataStreams/AdaptivePreAggregatingBlockInputStream.h>
+#include <DataStreams/MergingAndConvertingBlockInputStream.h>
+
+namespace DB
+{
+AdaptivePreAggregatingBlockInputStream::AdaptivePreAggregatingBlockInputStream(
+    const BlockInputStreamPtr & input,
+    const Aggregator::Params & params_,
+    size_t sample_rows_,
+    double pass_through_ratio_,
+    const String & req_id)
+    : log(Logger::get(req_id))
+    , params(params_)
+    , aggregator(params, req_id)
+    , sample_rows(sample_rows_)
+    , pass_through_ratio(pass_through_ratio_)
+    , data_variants(std::make_shared<AggregatedDataVariants>())
+{
+    RUNTIME_CHECK(params.keys_size > 0);
+    children.push_back(input);
+    key_columns.resize(params.keys_size);
+    aggregate_columns.resize(params.aggregates_size);
+
+    aggregator.setCancellationHook([&]() { return this->isCancelled(); });
+    aggregator.initThresholdByAggregatedDataVariantsSize(1);
+}
+
+Block AdaptivePreAggregatingBlockInputStream::getHeader() const
+{
+    return aggregator.getHeader(/*final=*/true);
+}
+
+void AdaptivePreAggregatingBlockInputStream::flush()
+{
+    ManyAggregatedDataVariants many_data{data_variants};
+    auto merging_buckets = aggregator.mergeAndConvertToBlocks(many_data, /*final=*/true, 1);
+    if (merging_buckets)
+    {
+        RUNTIME_CHECK(1 == merging_buckets->getConcurrency());
+        flushed = std::make_unique<MergingAndConvertingBlockInputStream>(merging_buckets, 0, log->identifier());
+        ++flush_count;
+    }
+    /// `merging_buckets` holds the flushed data until it is converted.
+    data_variants = std::make_shared<AggregatedDataVariants>();
+    aggregated_rows = 0;
+}
+
+Block AdaptivePreAggregatingBlockInputStream::readImpl()
+{
+    while (true)
+    {
+        if (flushed)
+        {
+            if (Block block = flushed->read())
+                return block;
+            flushed.reset();
+        }
+
+        if (input_done || isCancelledOrThrowIfKilled())
+            return {};
+
+        Block block = children.back()->read();
+        if (!block)
+        {
+            input_done = true;
+            flush();
+            LOG_DEBUG(log, "Pre-aggregation finished, flush count: {}, pass through rows: {}", flush_count, pass_through_rows);
+            continue;
+        }
+
+        if (pass_through)
+        {
+            pass_through_rows += block.rows();
+            return aggregator.passThroughBlock(block, aggregate_columns);
+        }
+
+        aggregator.executeOnBlock(block, *data_variants, key_columns, aggregate_columns);
+        aggregated_rows += block.rows();
+        if (data_variants->need_spill)
+        {
+            /// The final aggregation merges the flushed data with the rest, so there is no need to spill it.
+            flush();
+        }
+        else if (sample_rows > 0 && aggregated_rows >= sample_rows && data_variants->size() >= aggregated_rows * pass_through_ratio)
+        {
+            LOG_DEBUG(log, "Pass through the rows since {} rows are aggregated into {} keys", aggregated_rows, data_variants->size());
+            pass_through = true;
+            flush();
+        }
+    }
+}
+
+void AdaptivePreAggregatingBlockInputStream::appendInfo(FmtBuffer & buffer) const
+{
+    buffer.fmtAppend(": sample_rows = {}, pass_through_ratio = {}", sample_rows, pass_through_ratio);
+}
+
+} // namespace DB
@@ -0,0 +1,79 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <DataStreams/IProfilingBlockInputStream.h>
+#include <Interpreters/Aggregator.h>
+
+namespace DB
+{
+/** The partial aggregation of one stream, whose results are merged by the final aggregation.
+  * Since the final aggregation merges the rows of the same key anyway, the partial aggregation is free to output
+  *  a key more than once, so instead of building a hash table of all the input:
+  * - If the aggregated rows are hardly reduced, that is the number of keys is more than `pass_through_ratio` of the
+  *   rows after at least `sample_rows` rows are aggregated, the aggregated data is output and the following rows
+  *   are passed through as groups of their own, see `Aggregator::passThroughBlock`.
+  * - If the aggregated data needs to be spilled, it is output and the aggregation restarts with empty data.
+  * The output is always finalized.
+  */
+class AdaptivePreAggregatingBlockInputStream : public IProfilingBlockInputStream
+{
+    static constexpr auto NAME = "AdaptivePreAggregating";
+
+public:
+    AdaptivePreAggregatingBlockInputStream(
+        const BlockInputStreamPtr & input,
+        const Aggregator::Params & params_,
+        size_t sample_rows_,
+        double pass_through_ratio_,
+        const String & req_id);
+
+    String getName() const override { return NAME; }
+
+    Block getHeader() const override;
+
+protected:
+    Block readImpl() override;
+    void appendInfo(FmtBuffer & buffer) const override;
+
+private:
+    /// Output the aggregated data and restart with empty data.
+    void flush();
+
+    const LoggerPtr log;
+
+    Aggregator::Params params;
+    Aggregator aggregator;
+    const size_t sample_rows;
+    const double pass_through_ratio;
+
+    AggregatedDataVariantsPtr data_variants;
+    ColumnRawPtrs key_columns;
+    Aggregator::AggregateColumns aggregate_columns;
+    /// The rows aggregated into `data_variants` since the last restart.
+    size_t aggregated_rows = 0;
+
+    bool pass_through = false;
+    bool input_done = false;
+
+    /// The blocks converted from the flushed data.
+    std::unique_ptr<IBlockInputStream> flushed;
+
+    size_t flush_count = 0;
+    size_t pass_through_rows = 0;
+};
+
+} // namespace DB
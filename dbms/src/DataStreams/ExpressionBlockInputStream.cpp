@@ -25,6 +25,8 @@ ExpressionBlockInputStream::ExpressionBlockInputStream(
     , log(Logger::get(req_id))
 {
     children.push_back(input);
+    if (input->isSortedOutput())
+        sort_description = expression->getOutputSortDescription(input->getSortDescription());
 }
 
 Block ExpressionBlockInputStream::getHeader() const
@@ -41,11 +41,16 @@ public:
     String getName() const override { return NAME; }
     Block getHeader() const override;
 
+    bool isSortedOutput() const override { return !sort_description.empty(); }
+    const SortDescription & getSortDescription() const override { return sort_description; }
+
 protected:
     Block readImpl() override;
 
 private:
     ExpressionActionsPtr expression;
+    /// The order of the input which is kept by the expression.
+    SortDescription sort_description;
     const LoggerPtr log;
 };
 
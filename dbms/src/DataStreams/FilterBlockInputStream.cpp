@@ -38,6 +38,8 @@ FilterBlockInputStream::FilterBlockInputStream(
     , log(Logger::get(req_id))
 {
     children.push_back(input);
+    if (input->isSortedOutput())
+        sort_description = expression_->getOutputSortDescription(input->getSortDescription());
 }
 
 Block FilterBlockInputStream::getHeader() const
@@ -42,6 +42,9 @@ public:
     String getName() const override { return NAME; }
     Block getHeader() const override;
 
+    bool isSortedOutput() const override { return !sort_description.empty(); }
+    const SortDescription & getSortDescription() const override { return sort_description; }
+
 protected:
     Block readImpl() override
     {
@@ -55,6 +58,8 @@ protected:
 
 private:
     FilterTransformAction filter_transform_action;
+    /// The order of the input which is kept by the expression.
+    SortDescription sort_description;
 
     const LoggerPtr log;
 };
@@ -33,9 +33,11 @@ extern const int LOGICAL_ERROR;
 FilterTransformAction::FilterTransformAction(
     const Block & header_,
     const ExpressionActionsPtr & expression_,
-    const String & filter_column_name)
+    const String & filter_column_name,
+    double selection_min_ratio_)
     : header(header_)
     , expression(expression_)
+    , selection_min_ratio(selection_min_ratio_)
 {
     /// Determine position of filter column.
     expression->execute(header);
@@ -136,6 +138,17 @@ bool FilterTransformAction::transform(Block & block, FilterPtr & res_filter, boo
         return true;
     }
 
+    /// Most of the rows pass, defer filtering the columns to the following operators, which may drop some of them or
+    /// handle the selection without copying the rows.
+    if (selection_min_ratio > 0 && filtered_rows >= rows * selection_min_ratio)
+    {
+        block.safeGetByPosition(filter_column).column
+            = block.safeGetByPosition(filter_column).type->createColumnConst(rows, UInt64(1));
+        ColumnPtr selection = filter_holder ? filter_holder : column_of_filter;
+        block.setSelection(std::move(selection), filtered_rows);
+        return true;
+    }
+
     /// Filter the rest of the columns.
     for (size_t i = 0; i < columns; ++i)
     {
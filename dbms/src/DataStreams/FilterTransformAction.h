@@ -28,12 +28,15 @@ public:
     FilterTransformAction(
         const Block & header_,
         const ExpressionActionsPtr & expression_,
-        const String & filter_column_name_);
+        const String & filter_column_name_,
+        double selection_min_ratio_ = 0);
 
     bool alwaysFalse() const;
     // return false if all filter out.
     // When return_filter is true, res_filter will be set to the filter column.
     // Always return true, and when filter conditions are always true, set res_filter = nullptr.
+    // When return_filter is false and at least `selection_min_ratio` of the rows pass, the filter is set as the selection
+    // of the block instead of filtering the columns, see `Block::materializeSelection`.
     bool transform(Block & block, FilterPtr & res_filter, bool return_filter);
     Block getHeader() const;
     ExpressionActionsPtr getExperssion() const;
@@ -42,6 +45,8 @@ private:
     Block header;
     ExpressionActionsPtr expression;
     size_t filter_column;
+    /// 0 means always filtering the columns.
+    double selection_min_ratio;
 
     ConstantFilterDescription constant_filter_description;
     IColumn::Filter * filter = nullptr;
@@ -0,0 +1,266 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnUtils.h>
+#include <Columns/ColumnsNumber.h>
+#include <Common/Exception.h>
+#include <Common/FmtUtils.h>
+#include <DataStreams/MergeJoinBlockInputStream.h>
+#include <DataStreams/materializeBlock.h>
+
+#include <algorithm>
+
+namespace DB
+{
+namespace
+{
+int compareKeys(const ColumnRawPtrs & lhs, size_t lhs_row, const ColumnRawPtrs & rhs, size_t rhs_row)
+{
+    for (size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (int res = lhs[i]->compareAt(lhs_row, rhs_row, *rhs[i], 1); res != 0)
+            return res;
+    }
+    return 0;
+}
+} // namespace
+
+MergeJoinBlockInputStream::MergeJoinBlockInputStream(
+    const BlockInputStreamPtr & left,
+    const BlockInputStreamPtr & right,
+    ASTTableJoin::Kind kind_,
+    const Names & left_key_names_,
+    const Names & right_key_names_,
+    size_t max_block_size_,
+    const String & req_id)
+    : kind(kind_)
+    , left_key_names(left_key_names_)
+    , right_key_names(right_key_names_)
+    , max_block_size(max_block_size_)
+    , log(Logger::get(req_id))
+{
+    RUNTIME_CHECK(isSupported(kind, ASTTableJoin::Strictness::All));
+    RUNTIME_CHECK(!left_key_names.empty() && left_key_names.size() == right_key_names.size());
+    children.push_back(left);
+    children.push_back(right);
+
+    header = materializeBlock(left->getHeader());
+    left_columns = header.columns();
+    right_header = materializeBlock(right->getHeader());
+    for (size_t i = 0; i < left_key_names.size(); ++i)
+    {
+        const auto & left_key = header.getByName(left_key_names[i]);
+        const auto & right_key = right_header.getByName(right_key_names[i]);
+        RUNTIME_CHECK_MSG(
+            !left_key.type->isNullable() && left_key.type->equals(*right_key.type),
+            "Merge join does not support the keys {} and {} of types {} and {}",
+            left_key.name,
+            right_key.name,
+            left_key.type->getName(),
+            right_key.type->getName());
+        right_key_positions.push_back(right_header.getPositionByName(right_key_names[i]));
+    }
+    for (size_t i = 0; i < right_header.columns(); ++i)
+    {
+        if (std::find(right_key_positions.begin(), right_key_positions.end(), i) != right_key_positions.end())
+            continue;
+        auto column = right_header.getByPosition(i).cloneEmpty();
+        if (kind == ASTTableJoin::Kind::LeftOuter)
+            convertColumnToNullable(column);
+        header.insert(std::move(column));
+        right_column_positions.push_back(i);
+    }
+}
+
+bool MergeJoinBlockInputStream::prepareCursor(size_t child_index, Cursor & cursor, const Names & key_names)
+{
+    while (!cursor.finished && cursor.pos >= cursor.block.rows())
+    {
+        Block block = children[child_index]->read();
+        cursor.key_columns.clear();
+        cursor.pos = 0;
+        if (!block)
+        {
+            cursor.block = {};
+            cursor.finished = true;
+            break;
+        }
+        cursor.block = materializeBlock(block);
+        for (const auto & name : key_names)
+            cursor.key_columns.push_back(cursor.block.getByName(name).column.get());
+    }
+    return !cursor.finished;
+}
+
+bool MergeJoinBlockInputStream::advanceRight(size_t left_row)
+{
+    auto & cursor = right_cursor;
+    while (prepareCursor(1, cursor, right_key_names))
+    {
+        const size_t rows = cursor.block.rows();
+        if (compareKeys(cursor.key_columns, rows - 1, left_cursor.key_columns, left_row) < 0)
+        {
+            cursor.pos = rows;
+            continue;
+        }
+        /// The rows are sorted, so binary search the first row whose key is not less than the left key.
+        size_t low = cursor.pos;
+        size_t high = rows - 1;
+        while (low < high)
+        {
+            const size_t mid = low + (high - low) / 2;
+            if (compareKeys(cursor.key_columns, mid, left_cursor.key_columns, left_row) < 0)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        cursor.pos = low;
+        return compareKeys(cursor.key_columns, low, left_cursor.key_columns, left_row) == 0;
+    }
+    return false;
+}
+
+void MergeJoinBlockInputStream::loadRightGroup()
+{
+    auto & cursor = right_cursor;
+    group_columns = right_header.cloneEmptyColumns();
+    group_key_columns.clear();
+    for (auto pos : right_key_positions)
+        group_key_columns.push_back(group_columns[pos].get());
+
+    for (size_t i = 0; i < group_columns.size(); ++i)
+        group_columns[i]->insertFrom(*cursor.block.getByPosition(i).column, cursor.pos);
+    ++cursor.pos;
+    group_rows = 1;
+
+    /// The rows with the same key may span several blocks.
+    while (prepareCursor(1, cursor, right_key_names))
+    {
+        const size_t rows = cursor.block.rows();
+        size_t end = cursor.pos;
+        while (end < rows && compareKeys(cursor.key_columns, end, group_key_columns, 0) == 0)
+            ++end;
+        if (end > cursor.pos)
+        {
+            for (size_t i = 0; i < group_columns.size(); ++i)
+                group_columns[i]->insertRangeFrom(*cursor.block.getByPosition(i).column, cursor.pos, end - cursor.pos);
+            group_rows += end - cursor.pos;
+            cursor.pos = end;
+        }
+        if (end < rows)
+            break;
+    }
+    max_group_rows = std::max(max_group_rows, group_rows);
+}
+
+Block MergeJoinBlockInputStream::readImpl()
+{
+    const bool is_left_outer = kind == ASTTableJoin::Kind::LeftOuter;
+    MutableColumns left_output(left_columns);
+    for (size_t i = 0; i < left_columns; ++i)
+        left_output[i] = header.getByPosition(i).column->cloneEmpty();
+    MutableColumns right_output(right_column_positions.size());
+    for (size_t i = 0; i < right_column_positions.size(); ++i)
+        right_output[i] = right_header.getByPosition(right_column_positions[i]).column->cloneEmpty();
+    /// For the left outer join, marks the right columns of the left rows without matched right rows as null.
+    auto null_map = ColumnUInt8::create();
+
+    size_t output_rows = 0;
+    while (output_rows < max_block_size && prepareCursor(0, left_cursor, left_key_names))
+    {
+        /// No more rows can be joined for the inner join.
+        if (!is_left_outer && group_rows == 0 && right_cursor.finished)
+            break;
+
+        auto & cursor = left_cursor;
+        const size_t rows = cursor.block.rows();
+        const size_t start = cursor.pos;
+        offsets.resize(rows);
+        size_t current_offset = 0;
+        for (; cursor.pos < rows && output_rows + current_offset < max_block_size; ++cursor.pos)
+        {
+            int cmp = group_rows > 0 ? compareKeys(cursor.key_columns, cursor.pos, group_key_columns, 0) : 1;
+            if (cmp > 0)
+            {
+                group_rows = 0;
+                cmp = advanceRight(cursor.pos) ? 0 : -1;
+                if (cmp == 0)
+                    loadRightGroup();
+            }
+
+            if (cmp == 0)
+            {
+                for (size_t i = 0; i < right_column_positions.size(); ++i)
+                    right_output[i]->insertRangeFrom(*group_columns[right_column_positions[i]], 0, group_rows);
+                if (is_left_outer)
+                    null_map->getData().resize_fill(null_map->size() + group_rows, 0);
+                current_offset += group_rows;
+            }
+            else if (is_left_outer)
+            {
+                for (auto & column : right_output)
+                    column->insertDefault();
+                null_map->getData().push_back(1);
+                ++current_offset;
+            }
+            offsets[cursor.pos] = current_offset;
+        }
+        output_rows += current_offset;
+
+        if (current_offset > 0)
+        {
+            for (size_t i = 0; i < left_columns; ++i)
+            {
+                auto replicated = cursor.block.getByPosition(i).column->replicateRange(start, cursor.pos, offsets);
+                left_output[i]->insertRangeFrom(*replicated, 0, replicated->size());
+            }
+        }
+    }
+
+    if (output_rows == 0)
+        return {};
+
+    joined_rows += output_rows;
+    Columns columns;
+    columns.reserve(header.columns());
+    for (auto & column : left_output)
+        columns.push_back(std::move(column));
+    ColumnPtr null_map_holder = std::move(null_map);
+    for (auto & column : right_output)
+    {
+        ColumnPtr nested = std::move(column);
+        if (is_left_outer && !nested->isColumnNullable())
+            columns.push_back(ColumnNullable::create(nested, null_map_holder));
+        else
+            columns.push_back(std::move(nested));
+    }
+    return header.cloneWithColumns(std::move(columns));
+}
+
+void MergeJoinBlockInputStream::appendInfo(FmtBuffer & buffer) const
+{
+    buffer.append(": left keys = [");
+    buffer.joinStr(left_key_names.begin(), left_key_names.end());
+    buffer.append("], right keys = [");
+    buffer.joinStr(right_key_names.begin(), right_key_names.end());
+    buffer.append("]");
+}
+
+void MergeJoinBlockInputStream::readSuffixImpl()
+{
+    LOG_DEBUG(log, "Finish merge join, joined rows {}, max rows of a right key {}", joined_rows, max_group_rows);
+}
+
+} // namespace DB
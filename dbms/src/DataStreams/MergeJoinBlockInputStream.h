@@ -0,0 +1,108 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <DataStreams/IProfilingBlockInputStream.h>
+#include <Parsers/ASTTablesInSelectQuery.h>
+
+namespace DB
+{
+/** Joins two inputs which are both sorted ascending by the join keys without building a hash table.
+  * The inputs are read block by block in the order of the keys, and only the right rows with the key of the current left
+  * row are buffered, so the memory usage is bounded by the largest group of right rows with the same key and nothing
+  * needs to be spilled. It is used instead of the hash join when both inputs are known to be sorted by the join keys,
+  * for example the scans of two tables joined on their int handles.
+  * Only inner and left outer join with ALL strictness, non-nullable keys of the same types and no other conditions are
+  * supported. The output has the same structure as the hash join: the left columns followed by the right columns except
+  * the right keys, which are converted to nullable for the left outer join.
+  */
+class MergeJoinBlockInputStream : public IProfilingBlockInputStream
+{
+    static constexpr auto NAME = "MergeJoin";
+
+public:
+    MergeJoinBlockInputStream(
+        const BlockInputStreamPtr & left,
+        const BlockInputStreamPtr & right,
+        ASTTableJoin::Kind kind_,
+        const Names & left_key_names_,
+        const Names & right_key_names_,
+        size_t max_block_size_,
+        const String & req_id);
+
+    static bool isSupported(ASTTableJoin::Kind kind, ASTTableJoin::Strictness strictness)
+    {
+        return (kind == ASTTableJoin::Kind::Inner || kind == ASTTableJoin::Kind::LeftOuter)
+            && strictness == ASTTableJoin::Strictness::All;
+    }
+
+    String getName() const override { return NAME; }
+
+    Block getHeader() const override { return header; }
+
+protected:
+    Block readImpl() override;
+    void appendInfo(FmtBuffer & buffer) const override;
+    void readSuffixImpl() override;
+
+private:
+    struct Cursor
+    {
+        Block block;
+        ColumnRawPtrs key_columns;
+        size_t pos = 0;
+        bool finished = false;
+    };
+
+    /// Make sure the cursor points to a row, reading the next non-empty block if needed. Returns false if the input is exhausted.
+    bool prepareCursor(size_t child_index, Cursor & cursor, const Names & key_names);
+
+    /// Skip the right rows whose keys are less than the key of the left row.
+    /// Returns whether the key of the current right row equals the key of the left row.
+    bool advanceRight(size_t left_row);
+
+    /// Move the right rows with the same key as the current right row to `group_columns`.
+    void loadRightGroup();
+
+    Block header;
+    ASTTableJoin::Kind kind;
+    Names left_key_names;
+    Names right_key_names;
+    size_t max_block_size;
+
+    /// The positions of the right columns appended to the output, and of the right keys, in the right header.
+    std::vector<size_t> right_column_positions;
+    std::vector<size_t> right_key_positions;
+    size_t left_columns;
+
+    Cursor left_cursor;
+    Cursor right_cursor;
+
+    /// The right rows with the key of the current left row.
+    Block right_header;
+    MutableColumns group_columns;
+    ColumnRawPtrs group_key_columns;
+    size_t group_rows = 0;
+
+    IColumn::Offsets offsets;
+
+    size_t joined_rows = 0;
+    size_t max_group_rows = 0;
+
+    const LoggerPtr log;
+};
+
+} // namespace DB
@@ -0,0 +1,142 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsCommon.h>
+#include <Common/Exception.h>
+#include <Common/FmtUtils.h>
+#include <Common/typeid_cast.h>
+#include <DataStreams/SortHelper.h>
+#include <DataStreams/TopNBlockInputStream.h>
+#include <Interpreters/sortBlock.h>
+
+#include <numeric>
+
+namespace DB
+{
+TopNBlockInputStream::TopNBlockInputStream(
+    const BlockInputStreamPtr & input,
+    const SortDescription & description_,
+    size_t limit_,
+    const TopNThresholdPtr & topn_threshold_,
+    const String & req_id)
+    : description(description_)
+    , limit(limit_)
+    , topn_threshold(topn_threshold_)
+    , log(Logger::get(req_id))
+{
+    RUNTIME_CHECK(limit > 0);
+    children.push_back(input);
+    header = children.at(0)->getHeader();
+    if (!description.empty())
+        first_column_name = description.front().column_name;
+    SortHelper::removeConstantsFromSortDescription(header, description);
+}
+
+Block TopNBlockInputStream::readImpl()
+{
+    /// If there were only const columns in sort description, then there is no need to sort.
+    if (description.empty())
+        return children.back()->read();
+
+    if (done)
+        return {};
+
+    while (Block block = children.back()->read())
+    {
+        SortHelper::removeConstantsFromBlock(block);
+        filterByThreshold(block);
+        if (block.rows() == 0)
+            continue;
+
+        buffered_rows += block.rows();
+        buffered_blocks.push_back(std::move(block));
+        if (buffered_rows >= limit * 2)
+            shrinkBuffer();
+    }
+    done = true;
+
+    shrinkBuffer();
+    if (buffered_blocks.empty())
+        return {};
+    Block res = std::move(buffered_blocks.front());
+    buffered_blocks.clear();
+    SortHelper::enrichBlockWithConstants(res, header);
+    return res;
+}
+
+void TopNBlockInputStream::filterByThreshold(Block & block) const
+{
+    if (threshold_columns.empty() || block.rows() == 0)
+        return;
+
+    const size_t rows = block.rows();
+    /// The rows equal to the threshold on all the columns compared so far, only these rows need to compare the next column.
+    IColumn::RowIndexes row_indexes(rows);
+    std::iota(row_indexes.begin(), row_indexes.end(), 0);
+    IColumn::CompareResults compare_results(rows, 0);
+    for (size_t i = 0; i < description.size() && !row_indexes.empty(); ++i)
+    {
+        const auto & desc = description[i];
+        const auto & column = *block.getByName(desc.column_name).column;
+        const bool need_collation = desc.collator != nullptr && typeid_cast<const ColumnString *>(std::get<0>(removeNullable(&column)));
+        column.compareColumn(
+            *threshold_columns[i],
+            0,
+            row_indexes,
+            compare_results,
+            desc.direction,
+            desc.nulls_direction,
+            need_collation ? desc.collator : nullptr);
+    }
+
+    /// The rows equal to the threshold on all the columns are dropped too, because the top rows are enough to fill the limit.
+    IColumn::Filter filter(rows);
+    for (size_t row = 0; row < rows; ++row)
+        filter[row] = compare_results[row] < 0;
+
+    const size_t passed_rows = countBytesInFilter(filter);
+    if (passed_rows == rows)
+        return;
+    for (auto & column : block)
+        column.column = column.column->filter(filter, passed_rows);
+}
+
+void TopNBlockInputStream::shrinkBuffer()
+{
+    if (buffered_blocks.empty())
+        return;
+
+    Block merged = vstackBlocks(std::move(buffered_blocks));
+    buffered_blocks.clear();
+    sortBlock(merged, description, limit);
+    buffered_rows = merged.rows();
+
+    if (buffered_rows >= limit)
+    {
+        threshold_columns.clear();
+        for (const auto & desc : description)
+            threshold_columns.push_back(merged.getByName(desc.column_name).column->cut(limit - 1, 1));
+        if (topn_threshold && description.front().column_name == first_column_name)
+            topn_threshold->update((*threshold_columns.front())[0]);
+    }
+    buffered_blocks.push_back(std::move(merged));
+}
+
+void TopNBlockInputStream::appendInfo(FmtBuffer & buffer) const
+{
+    buffer.fmtAppend(": limit = {}", limit);
+}
+} // namespace DB
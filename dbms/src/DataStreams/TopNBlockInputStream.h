@@ -0,0 +1,77 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <Core/SortDescription.h>
+#include <DataStreams/IProfilingBlockInputStream.h>
+#include <DataStreams/TopNThreshold.h>
+
+namespace DB
+{
+/** Keeps the top `limit` rows of the input in the order of `description`, and returns them sorted after the input is exhausted.
+  * The buffered rows are cut back to the top `limit` rows by a partial sort whenever they are twice as many, so the memory
+  * is bounded by the limit. The last of the top rows is the threshold: each input block is compared with it column by column
+  * before being buffered, and only the rows ordered before it are kept, so most rows are dropped without being sorted once
+  * the threshold gets tight.
+  * The threshold of the first ORDER BY column is also published to `topn_threshold` if any, see `TopNThreshold`.
+  */
+class TopNBlockInputStream : public IProfilingBlockInputStream
+{
+    static constexpr auto NAME = "TopN";
+
+public:
+    TopNBlockInputStream(
+        const BlockInputStreamPtr & input,
+        const SortDescription & description_,
+        size_t limit_,
+        const TopNThresholdPtr & topn_threshold_,
+        const String & req_id);
+
+    String getName() const override { return NAME; }
+
+    bool isGroupedOutput() const override { return true; }
+    bool isSortedOutput() const override { return true; }
+    const SortDescription & getSortDescription() const override { return description; }
+
+    Block getHeader() const override { return header; }
+
+protected:
+    Block readImpl() override;
+    void appendInfo(FmtBuffer & buffer) const override;
+
+private:
+    void filterByThreshold(Block & block) const;
+
+    void shrinkBuffer();
+
+    Block header;
+    SortDescription description;
+    size_t limit;
+    TopNThresholdPtr topn_threshold;
+    /// The name of the first ORDER BY column, whose threshold is published to `topn_threshold`.
+    String first_column_name;
+
+    LoggerPtr log;
+
+    /// Constant columns are removed from the buffered blocks.
+    Blocks buffered_blocks;
+    size_t buffered_rows = 0;
+    /// The ORDER BY columns of the last row of the top rows, empty if less than `limit` rows are collected.
+    Columns threshold_columns;
+    bool done = false;
+};
+
+} // namespace DB
@@ -0,0 +1,76 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/FieldVisitors.h>
+#include <Core/Field.h>
+#include <Storages/Transaction/Types.h>
+
+#include <memory>
+#include <mutex>
+
+namespace DB
+{
+/** The threshold of a TopN on a table scan, which is shared by the TopN streams and the table scan.
+  * It is the value of the first ORDER BY column of the last row in the current top rows of a TopN stream.
+  * Rows ordered after it by the first ORDER BY column can never be in the result, so the table scan can
+  * skip the packs whose min/max values are all ordered after it.
+  */
+class TopNThreshold
+{
+public:
+    TopNThreshold(ColumnID column_id_, bool desc_)
+        : column_id(column_id_)
+        , desc(desc_)
+    {}
+
+    /// The id of the first ORDER BY column in the table.
+    ColumnID getColumnID() const { return column_id; }
+
+    bool isDesc() const { return desc; }
+
+    /// Returns a null Field if no TopN stream has collected enough rows yet.
+    Field get() const
+    {
+        std::lock_guard lock(mutex);
+        return value;
+    }
+
+    /// Each TopN stream publishes the threshold of its own top rows, and the tightest one is kept.
+    void update(const Field & new_value)
+    {
+        if (new_value.isNull())
+            return;
+
+        std::lock_guard lock(mutex);
+        if (value.isNull()
+            || (desc ? applyVisitor(FieldVisitorAccurateLess(), value, new_value)
+                     : applyVisitor(FieldVisitorAccurateLess(), new_value, value)))
+            value = new_value;
+    }
+
+    String toDebugString() const { return applyVisitor(FieldVisitorToDebugString(), get()); }
+
+private:
+    const ColumnID column_id;
+    const bool desc;
+
+    mutable std::mutex mutex;
+    Field value;
+};
+
+using TopNThresholdPtr = std::shared_ptr<TopNThreshold>;
+
+} // namespace DB
@@ -0,0 +1,89 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Core/Block.h>
+#include <DataStreams/BlocksListBlockInputStream.h>
+#include <DataStreams/MergeJoinBlockInputStream.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/InputStreamTestUtils.h>
+
+namespace DB
+{
+namespace tests
+{
+class MergeJoinBlockInputStreamTest : public ::testing::Test
+{
+protected:
+    /// The rows with the same key span several blocks on both sides.
+    static BlockInputStreamPtr leftInput()
+    {
+        BlocksList blocks{
+            Block({createColumn<Int64>({1, 2, 2}, "a"), createColumn<Int64>({10, 11, 12}, "la")}),
+            Block({createColumn<Int64>({2, 4, 5}, "a"), createColumn<Int64>({13, 14, 15}, "la")}),
+        };
+        return std::make_shared<BlocksListBlockInputStream>(std::move(blocks));
+    }
+
+    static BlockInputStreamPtr rightInput()
+    {
+        BlocksList blocks{
+            Block({createColumn<Int64>({0, 2}, "b"), createColumn<Int64>({19, 20}, "rb")}),
+            Block({createColumn<Int64>({2, 3}, "b"), createColumn<Int64>({21, 22}, "rb")}),
+            Block({createColumn<Int64>({5, 5}, "b"), createColumn<Int64>({23, 24}, "rb")}),
+        };
+        return std::make_shared<BlocksListBlockInputStream>(std::move(blocks));
+    }
+
+    static BlockInputStreamPtr mergeJoin(ASTTableJoin::Kind kind, size_t max_block_size)
+    {
+        return std::make_shared<MergeJoinBlockInputStream>(leftInput(), rightInput(), kind, Names{"a"}, Names{"b"}, max_block_size, "");
+    }
+};
+
+TEST_F(MergeJoinBlockInputStreamTest, InnerJoin)
+try
+{
+    for (size_t max_block_size : {1, 3, 8192})
+    {
+        auto stream = mergeJoin(ASTTableJoin::Kind::Inner, max_block_size);
+        ASSERT_INPUTSTREAM_BLOCK_UR(
+            stream,
+            Block({
+                createColumn<Int64>({2, 2, 2, 2, 2, 2, 5, 5}, "a"),
+                createColumn<Int64>({11, 11, 12, 12, 13, 13, 15, 15}, "la"),
+                createColumn<Int64>({20, 21, 20, 21, 20, 21, 23, 24}, "rb"),
+            }));
+    }
+}
+CATCH
+
+TEST_F(MergeJoinBlockInputStreamTest, LeftOuterJoin)
+try
+{
+    for (size_t max_block_size : {1, 3, 8192})
+    {
+        auto stream = mergeJoin(ASTTableJoin::Kind::LeftOuter, max_block_size);
+        ASSERT_INPUTSTREAM_BLOCK_UR(
+            stream,
+            Block({
+                createColumn<Int64>({1, 2, 2, 2, 2, 2, 2, 4, 5, 5}, "a"),
+                createColumn<Int64>({10, 11, 11, 12, 12, 13, 13, 14, 15, 15}, "la"),
+                createColumn<Nullable<Int64>>({{}, 20, 21, 20, 21, 20, 21, {}, 23, 24}, "rb"),
+            }));
+    }
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
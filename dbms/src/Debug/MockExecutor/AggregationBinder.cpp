@@ -173,6 +173,8 @@ void AggregationBinder::buildAggFunc(tipb::Expr * agg_func, const ASTFunction *
 
     auto agg_sig = agg_sig_it->second;
     agg_func->set_tp(agg_sig);
+    if (func->name == "countDistinct")
+        agg_func->set_has_distinct(true);
 
     if (agg_sig == tipb::ExprType::Count || agg_sig == tipb::ExprType::Sum)
     {
@@ -235,7 +237,7 @@ ExecutorBinderPtr compileAggregation(ExecutorBinderPtr input, size_t & executor_
             }
 
             TiDB::ColumnInfo ci;
-            if (func->name == "count")
+            if (func->name == "count" || func->name == "countDistinct")
             {
                 ci.tp = TiDB::TypeLongLong;
                 ci.flag = TiDB::ColumnFlagUnsigned | TiDB::ColumnFlagNotNull;
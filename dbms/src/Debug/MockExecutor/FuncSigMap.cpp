@@ -84,6 +84,7 @@ std::unordered_map<String, tipb::ExprType> agg_func_name_to_sig({
     {"min", tipb::ExprType::Min},
     {"max", tipb::ExprType::Max},
     {"count", tipb::ExprType::Count},
+    {"countDistinct", tipb::ExprType::Count},
     {"sum", tipb::ExprType::Sum},
     {"first_row", tipb::ExprType::First},
     {"uniqRawRes", tipb::ExprType::ApproxCountDistinct},
@@ -14,6 +14,7 @@
 
 #include <Common/TiFlashMetrics.h>
 #include <Flash/BatchCoprocessorHandler.h>
+#include <Flash/Coprocessor/CopResponseCache.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGDriver.h>
 #include <Flash/Coprocessor/InterpreterDAG.h>
@@ -22,6 +23,8 @@
 #include <Interpreters/Context.h>
 #include <Interpreters/SharedContexts/Disagg.h>
 #include <Storages/IStorage.h>
+#include <Storages/Transaction/KVStore.h>
+#include <Storages/Transaction/LearnerRead.h>
 #include <Storages/Transaction/TMTContext.h>
 #include <TiDB/Schema/SchemaSyncer.h>
 
@@ -64,6 +67,40 @@ grpc::Status BatchCoprocessorHandler::execute()
                 { GET_METRIC(tiflash_coprocessor_handling_request_count, type_batch_executing).Decrement(); });
 
             auto dag_request = getDAGRequestFromStringWithRetry(cop_request->data());
+            const UInt64 start_ts = cop_request->start_ts() > 0 ? cop_request->start_ts() : dag_request.start_ts_fallback();
+
+            auto & tmt = cop_context.db_context.getTMTContext();
+            auto cop_response_cache = cop_context.db_context.getCopResponseCache();
+            UInt128 cache_key;
+            // The applied index of every region before reading, empty if the responses can not be cached.
+            std::vector<std::pair<RegionID, UInt64>> applied_indexes_before_read;
+            std::unordered_map<RegionID, UInt64> read_indexes;
+            if (cop_response_cache)
+            {
+                cache_key = CopResponseCache::hash(*cop_request, dag_request);
+                // Get the read indexes before looking up the cache, see `CoprocessorHandler::execute`.
+                read_indexes = batchGetReadIndex(collectRegionIDs(), start_ts, tmt);
+                auto entry = cop_response_cache->get(cache_key, start_ts, [&](RegionID id, UInt64 applied_index) {
+                    return checkRegion(tmt, id, applied_index, start_ts, /*bypass_lock_ts=*/nullptr, read_indexes);
+                });
+                if (entry)
+                {
+                    auto write_response = [this](String data) {
+                        ::coprocessor::BatchResponse response;
+                        response.set_data(std::move(data));
+                        if (!writer->Write(response))
+                            throw Exception("Failed to write resp");
+                    };
+                    for (const auto & data : entry->responses)
+                        write_response(data);
+                    if (entry->execution_summaries.execution_summaries_size() > 0)
+                        write_response(entry->genExecutionSummaries(watch.elapsed()).SerializeAsString());
+                    LOG_DEBUG(log, "Handle DAG request done, served by response cache");
+                    break;
+                }
+                applied_indexes_before_read = collectAppliedIndexes(tmt);
+            }
+
             auto tables_regions_info = TablesRegionsInfo::create(cop_request->regions(), cop_request->table_regions(), cop_context.db_context.getTMTContext());
             LOG_DEBUG(
                 log,
@@ -80,10 +117,27 @@ grpc::Status BatchCoprocessorHandler::execute()
                 /*is_batch_cop=*/true,
                 Logger::get("BatchCoprocessorHandler"));
             cop_context.db_context.setDAGContext(&dag_context);
+            reuseReadIndexes(dag_context, read_indexes);
 
-            DAGDriver<true> driver(cop_context.db_context, cop_request->start_ts() > 0 ? cop_request->start_ts() : dag_request.start_ts_fallback(), cop_request->schema_ver(), writer);
+            DAGDriver<true> driver(cop_context.db_context, start_ts, cop_request->schema_ver(), writer);
+            if (!applied_indexes_before_read.empty())
+                driver.enableResponseRecording(cop_response_cache->maxEntrySize());
             // batch execution;
             driver.execute();
+
+            // Only cache the responses if none of the regions has applied any raft log during the read, and
+            // the responses do not change with a bigger start_ts.
+            if (auto & responses = driver.getRecordedResponses();
+                responses && !applied_indexes_before_read.empty() && !hasMetNewerVersion(dag_context)
+                && collectAppliedIndexes(tmt) == applied_indexes_before_read)
+            {
+                auto entry = std::make_shared<CopResponseCacheEntry>();
+                entry->start_ts = start_ts;
+                entry->applied_indexes = std::move(applied_indexes_before_read);
+                entry->responses = std::move(*responses);
+                entry->execution_summaries = std::move(driver.getRecordedExecutionSummaries());
+                cop_response_cache->set(cache_key, std::move(entry));
+            }
             LOG_DEBUG(log, "Handle DAG request done");
             break;
         }
@@ -123,6 +177,43 @@ grpc::Status BatchCoprocessorHandler::execute()
     }
 }
 
+std::vector<RegionID> BatchCoprocessorHandler::collectRegionIDs() const
+{
+    std::vector<RegionID> region_ids;
+    for (const auto & region : cop_request->regions())
+        region_ids.push_back(region.region_id());
+    for (const auto & table_regions : cop_request->table_regions())
+    {
+        for (const auto & region : table_regions.regions())
+            region_ids.push_back(region.region_id());
+    }
+    return region_ids;
+}
+
+std::vector<std::pair<RegionID, UInt64>> BatchCoprocessorHandler::collectAppliedIndexes(TMTContext & tmt) const
+{
+    std::vector<std::pair<RegionID, UInt64>> applied_indexes;
+    auto collect = [&](const ::google::protobuf::RepeatedPtrField<::coprocessor::RegionInfo> & regions) {
+        for (const auto & region : regions)
+        {
+            auto applied_index = getRegionAppliedIndex(tmt, region.region_id());
+            if (!applied_index)
+                return false;
+            applied_indexes.emplace_back(region.region_id(), *applied_index);
+        }
+        return true;
+    };
+    // Regions that are not on this store are read from remote, the responses can not be cached.
+    if (!collect(cop_request->regions()))
+        return {};
+    for (const auto & table_regions : cop_request->table_regions())
+    {
+        if (!collect(table_regions.regions()))
+            return {};
+    }
+    return applied_indexes;
+}
+
 grpc::Status BatchCoprocessorHandler::recordError(grpc::StatusCode err_code, const String & err_msg)
 {
     err_response.set_other_error(err_msg);
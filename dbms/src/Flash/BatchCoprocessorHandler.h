@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Flash/CoprocessorHandler.h>
+#include <Storages/Transaction/Types.h>
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wdeprecated-declarations"
@@ -38,6 +39,12 @@ public:
 protected:
     grpc::Status recordError(grpc::StatusCode err_code, const String & err_msg) override;
 
+    /// Return the id of all regions in the request.
+    std::vector<RegionID> collectRegionIDs() const;
+
+    /// Return the applied index of all regions in the request, or an empty vector if some of them are not found.
+    std::vector<std::pair<RegionID, UInt64>> collectAppliedIndexes(TMTContext & tmt) const;
+
 protected:
     const coprocessor::BatchRequest * cop_request;
     ::grpc::ServerWriter<::coprocessor::BatchResponse> * writer;
@@ -16,7 +16,10 @@
 #include <Common/TiFlashException.h>
 #include <Core/ColumnNumbers.h>
 #include <Flash/Coprocessor/AggregationInterpreterHelper.h>
+#include <Flash/Coprocessor/DAGCodec.h>
 #include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Coprocessor/DAGUtils.h>
+#include <IO/WriteBufferFromString.h>
 #include <Interpreters/Context.h>
 
 namespace DB::AggregationInterpreterHelper
@@ -40,6 +43,27 @@ bool isAllowToUseTwoLevelGroupBy(size_t before_agg_streams_size, const Settings
       */
     return before_agg_streams_size > 1 || settings.max_bytes_before_external_group_by != 0;
 }
+
+const TiDB::ColumnInfo * getSourceColumn(const tipb::Expr & expr, const std::vector<TiDB::ColumnInfo> & source_columns)
+{
+    if (!isColumnExpr(expr))
+        return nullptr;
+    auto column_index = decodeDAGInt64(expr.val());
+    if (column_index < 0 || column_index >= static_cast<Int64>(source_columns.size()))
+        return nullptr;
+    return &source_columns[column_index];
+}
+
+tipb::Expr constructColumnRefExpr(Int64 index, const tipb::FieldType & field_type)
+{
+    tipb::Expr expr;
+    expr.set_tp(tipb::ExprType::ColumnRef);
+    WriteBufferFromOwnString ss;
+    encodeDAGInt64(index, ss);
+    expr.set_val(ss.releaseStr());
+    *expr.mutable_field_type() = field_type;
+    return expr;
+}
 } // namespace
 
 bool isSumOnPartialResults(const tipb::Expr & expr)
@@ -73,6 +97,95 @@ bool isGroupByCollationSensitive(const Context & context)
     return context.getSettingsRef().group_by_collation_sensitive || context.getDAGContext()->isMPPTask();
 }
 
+bool canAggregateFromPackStats(const tipb::Aggregation & aggregation, const std::vector<TiDB::ColumnInfo> & source_columns)
+{
+    if (aggregation.group_by_size() > 0 || aggregation.agg_func_size() == 0)
+        return false;
+    for (const auto & expr : aggregation.agg_func())
+    {
+        if (expr.has_distinct())
+            return false;
+        switch (expr.tp())
+        {
+        case tipb::ExprType::Count:
+            // count(*), count(1) or count(not_null_column), only the number of rows matters.
+            for (const auto & child : expr.children())
+            {
+                if (isLiteralExpr(child))
+                    continue;
+                const auto * column_info = getSourceColumn(child, source_columns);
+                if (column_info == nullptr || !column_info->hasNotNullFlag())
+                    return false;
+            }
+            break;
+        case tipb::ExprType::Min:
+        case tipb::ExprType::Max:
+        {
+            if (expr.children_size() != 1)
+                return false;
+            const auto * column_info = getSourceColumn(expr.children(0), source_columns);
+            if (column_info == nullptr || !isPackStatsType(*column_info))
+                return false;
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+bool canRewriteCountDistinct(const Context & context, const tipb::Aggregation & aggregation)
+{
+    const auto & settings = context.getSettingsRef();
+    /// Only the exact count distinct is equal to the number of the groups.
+    if (!settings.enable_count_distinct_rewrite || settings.count_distinct_implementation.toString() != "uniqExact")
+        return false;
+    /// The distinct values are compared with collation by the states, so the group by must do the same.
+    if (!isGroupByCollationSensitive(context))
+        return false;
+    /// The partial states of count distinct can not be produced by a count.
+    if (aggregation.agg_func_size() == 0 || !isFinalAgg(aggregation))
+        return false;
+    const auto & first = aggregation.agg_func(0);
+    if (first.children_size() != 1)
+        return false;
+    const String first_argument = first.children(0).SerializeAsString();
+    for (const auto & expr : aggregation.agg_func())
+    {
+        if (expr.tp() != tipb::ExprType::Count || !expr.has_distinct() || expr.children_size() != 1)
+            return false;
+        if (expr.children(0).SerializeAsString() != first_argument)
+            return false;
+    }
+    return true;
+}
+
+std::pair<tipb::Aggregation, tipb::Aggregation> rewriteCountDistinct(const tipb::Aggregation & aggregation)
+{
+    const auto & argument = aggregation.agg_func(0).children(0);
+
+    /// The output of `group by keys, x` is the keys followed by x.
+    tipb::Aggregation distinct_agg;
+    for (const auto & expr : aggregation.group_by())
+        *distinct_agg.add_group_by() = expr;
+    *distinct_agg.add_group_by() = argument;
+
+    /// The output of `count(x) group by keys` is the same as the original aggregation.
+    tipb::Aggregation count_agg;
+    for (const auto & expr : aggregation.agg_func())
+    {
+        auto * count = count_agg.add_agg_func();
+        *count = expr;
+        count->clear_has_distinct();
+        count->clear_children();
+        *count->add_children() = constructColumnRefExpr(aggregation.group_by_size(), argument.field_type());
+    }
+    for (Int32 i = 0; i < aggregation.group_by_size(); ++i)
+        *count_agg.add_group_by() = constructColumnRefExpr(i, aggregation.group_by(i).field_type());
+    return {std::move(distinct_agg), std::move(count_agg)};
+}
+
 Aggregator::Params buildParams(
     const Context & context,
     const Block & before_agg_header,
@@ -109,7 +222,8 @@ Aggregator::Params buildParams(
         !is_final_agg,
         spill_config,
         context.getSettingsRef().max_block_size,
-        has_collator ? collators : TiDB::dummy_collators);
+        has_collator ? collators : TiDB::dummy_collators,
+        settings.group_by_partition_threshold);
 }
 
 void fillArgColumnNumbers(AggregateDescriptions & aggregate_descriptions, const Block & before_agg_header)
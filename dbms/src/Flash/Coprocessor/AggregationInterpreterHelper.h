@@ -18,6 +18,7 @@
 #include <Core/Names.h>
 #include <Interpreters/AggregateDescription.h>
 #include <Interpreters/Aggregator.h>
+#include <Storages/Transaction/TiDB.h>
 #include <tipb/executor.pb.h>
 
 namespace DB
@@ -33,6 +34,19 @@ bool isFinalAgg(const tipb::Aggregation & aggregation);
 
 bool isGroupByCollationSensitive(const Context & context);
 
+// Judge if the aggregation on the table scan only needs the number of rows and the min/max values of the scanned columns,
+// e.g. `select count(*), min(a), max(b) from t`. If so, the storage can answer the fully visible packs from their statistics.
+bool canAggregateFromPackStats(const tipb::Aggregation & aggregation, const std::vector<TiDB::ColumnInfo> & source_columns);
+
+// Judge if the aggregation only has `count(distinct x)` on the same single argument and computes the final result,
+// e.g. `select count(distinct b) from t group by a`. If so, it can be rewritten by `rewriteCountDistinct`.
+bool canRewriteCountDistinct(const Context & context, const tipb::Aggregation & aggregation);
+
+// Rewrite `count(distinct x) group by keys` into a `group by keys, x` and a `count(x) group by keys` on top of it,
+// so the distinct values are deduplicated by the hash table of the aggregation instead of the hash set in each state.
+// Returns the two aggregations in the order of execution.
+std::pair<tipb::Aggregation, tipb::Aggregation> rewriteCountDistinct(const tipb::Aggregation & aggregation);
+
 Aggregator::Params buildParams(
     const Context & context,
     const Block & before_agg_header,
@@ -0,0 +1,280 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/SipHash.h>
+#include <Common/TiFlashMetrics.h>
+#include <Flash/Coprocessor/CopResponseCache.h>
+#include <Storages/DeltaMerge/ScanContext.h>
+#include <common/likely.h>
+#include <common/logger_useful.h>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+} // namespace ErrorCodes
+
+namespace
+{
+void updateString(SipHash & hash, const String & s)
+{
+    // Hash the length as well, so that the boundaries of adjacent strings are not ambiguous.
+    hash.update(s.size());
+    hash.update(s.data(), s.size());
+}
+
+void updateRegion(
+    SipHash & hash,
+    RegionID region_id,
+    const metapb::RegionEpoch & epoch,
+    const ::google::protobuf::RepeatedPtrField<::coprocessor::KeyRange> & ranges)
+{
+    hash.update(region_id);
+    hash.update(epoch.version());
+    hash.update(epoch.conf_ver());
+    hash.update(static_cast<UInt64>(ranges.size()));
+    for (const auto & range : ranges)
+    {
+        updateString(hash, range.start());
+        updateString(hash, range.end());
+    }
+}
+
+void updateContext(SipHash & hash, const kvrpcpb::Context & context)
+{
+    hash.update(context.api_version());
+    hash.update(context.keyspace_id());
+    hash.update(static_cast<UInt64>(context.resolved_locks_size()));
+    for (const auto & lock_ts : context.resolved_locks())
+        hash.update(lock_ts);
+}
+
+void updatePlan(SipHash & hash, const tipb::DAGRequest & dag_request)
+{
+    // The start_ts is not a part of the plan, the entry is validated by the applied index of regions instead.
+    tipb::DAGRequest plan = dag_request;
+    plan.clear_start_ts_fallback();
+    updateString(hash, plan.SerializeAsString());
+}
+} // namespace
+
+size_t CopResponseCacheEntry::bytes() const
+{
+    size_t bytes = sizeof(CopResponseCacheEntry) + applied_indexes.size() * sizeof(applied_indexes[0]);
+    for (const auto & resp : responses)
+        bytes += sizeof(String) + resp.size();
+    bytes += execution_summaries.ByteSizeLong();
+    return bytes;
+}
+
+tipb::SelectResponse CopResponseCacheEntry::genExecutionSummaries(UInt64 time_processed_ns) const
+{
+    // Only the produced rows, iterations and concurrency describe the cached result. The time and
+    // scan details of the original execution are stale, so they are regenerated for this request.
+    tipb::SelectResponse response = execution_summaries;
+    const auto empty_scan_context = DM::ScanContext().serialize();
+    for (auto & summary : *response.mutable_execution_summaries())
+    {
+        summary.set_time_processed_ns(time_processed_ns);
+        if (summary.has_tiflash_scan_context())
+            summary.mutable_tiflash_scan_context()->CopyFrom(empty_scan_context);
+    }
+    return response;
+}
+
+CopResponseCache::CopResponseCache(size_t max_size_, size_t max_entry_size_)
+    : max_size(max_size_)
+    , max_entry_size(std::min(max_size_, max_entry_size_))
+    , log(Logger::get())
+{}
+
+UInt128 CopResponseCache::hash(const coprocessor::Request & request, const tipb::DAGRequest & dag_request)
+{
+    SipHash hash;
+    hash.update(request.tp());
+    updatePlan(hash, dag_request);
+    hash.update(request.schema_ver());
+    updateContext(hash, request.context());
+    updateRegion(hash, request.context().region_id(), request.context().region_epoch(), request.ranges());
+
+    UInt128 key;
+    hash.get128(key);
+    return key;
+}
+
+UInt128 CopResponseCache::hash(const coprocessor::BatchRequest & request, const tipb::DAGRequest & dag_request)
+{
+    SipHash hash;
+    hash.update(request.tp());
+    updatePlan(hash, dag_request);
+    hash.update(request.schema_ver());
+    updateContext(hash, request.context());
+    hash.update(static_cast<UInt64>(request.regions_size()));
+    for (const auto & region : request.regions())
+        updateRegion(hash, region.region_id(), region.region_epoch(), region.ranges());
+    hash.update(static_cast<UInt64>(request.table_regions_size()));
+    for (const auto & table_regions : request.table_regions())
+    {
+        hash.update(table_regions.physical_table_id());
+        hash.update(static_cast<UInt64>(table_regions.regions_size()));
+        for (const auto & region : table_regions.regions())
+            updateRegion(hash, region.region_id(), region.region_epoch(), region.ranges());
+    }
+
+    UInt128 key;
+    hash.get128(key);
+    return key;
+}
+
+CopResponseCacheEntryPtr CopResponseCache::get(const Key & key, UInt64 start_ts, const CheckRegion & check_region)
+{
+    CopResponseCacheEntryPtr entry;
+    {
+        std::lock_guard lock(mutex);
+        auto it = entry_map.find(key);
+        // The responses may contain rows committed after `start_ts`, they can not be reused by the request.
+        if (it == entry_map.end() || start_ts < it->second.entry->start_ts)
+        {
+            GET_METRIC(tiflash_coprocessor_response_cache, type_miss).Increment();
+            return nullptr;
+        }
+        entry = it->second.entry;
+        lru_queue.splice(lru_queue.end(), lru_queue, it->second.queue_it);
+    }
+
+    // Check the regions out of the lock scope, `check_region` may need to acquire the region lock.
+    for (const auto & [region_id, applied_index] : entry->applied_indexes)
+    {
+        if (!check_region(region_id, applied_index))
+        {
+            LOG_DEBUG(
+                log,
+                "Cop response is stale, region_id={} cached_applied_index={} cached_start_ts={} start_ts={}",
+                region_id,
+                applied_index,
+                entry->start_ts,
+                start_ts);
+            GET_METRIC(tiflash_coprocessor_response_cache, type_stale).Increment();
+            std::lock_guard lock(mutex);
+            if (auto it = entry_map.find(key); it != entry_map.end() && it->second.entry == entry)
+                removeImpl(it, lock);
+            return nullptr;
+        }
+    }
+
+    GET_METRIC(tiflash_coprocessor_response_cache, type_hit).Increment();
+    return entry;
+}
+
+void CopResponseCache::set(const Key & key, CopResponseCacheEntryPtr entry)
+{
+    const size_t size = entry->bytes();
+    if (size > max_entry_size)
+    {
+        GET_METRIC(tiflash_coprocessor_response_cache, type_too_large).Increment();
+        return;
+    }
+
+    std::lock_guard lock(mutex);
+    if (auto it = entry_map.find(key); it != entry_map.end())
+        removeImpl(it, lock);
+
+    auto [it, inserted] = entry_map.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+    RUNTIME_CHECK(inserted);
+    Holder & holder = it->second;
+    holder.queue_it = lru_queue.insert(lru_queue.end(), key);
+    holder.size = size;
+    holder.entry = std::move(entry);
+    for (const auto & region_and_index : holder.entry->applied_indexes)
+        region_index[region_and_index.first].insert(key);
+    current_size += size;
+    entry_count.store(entry_map.size(), std::memory_order_relaxed);
+    GET_METRIC(tiflash_coprocessor_response_cache, type_insert).Increment();
+
+    removeOverflow(lock);
+    GET_METRIC(tiflash_coprocessor_response_cache_bytes).Set(current_size);
+}
+
+void CopResponseCache::invalidateRegion(RegionID region_id)
+{
+    if (entry_count.load(std::memory_order_relaxed) == 0)
+        return;
+
+    std::lock_guard lock(mutex);
+    auto region_it = region_index.find(region_id);
+    if (region_it == region_index.end())
+        return;
+
+    // Copy the keys because `removeImpl` modifies `region_index`.
+    std::vector<Key> keys(region_it->second.begin(), region_it->second.end());
+    for (const auto & key : keys)
+    {
+        if (auto it = entry_map.find(key); it != entry_map.end())
+        {
+            removeImpl(it, lock);
+            GET_METRIC(tiflash_coprocessor_response_cache, type_invalidate).Increment();
+        }
+    }
+    region_index.erase(region_id);
+    GET_METRIC(tiflash_coprocessor_response_cache_bytes).Set(current_size);
+}
+
+size_t CopResponseCache::currentSize() const
+{
+    std::lock_guard lock(mutex);
+    return current_size;
+}
+
+size_t CopResponseCache::count() const
+{
+    std::lock_guard lock(mutex);
+    return entry_map.size();
+}
+
+void CopResponseCache::removeImpl(EntryMap::iterator it, std::lock_guard<std::mutex> &)
+{
+    const Holder & holder = it->second;
+    for (const auto & region_and_index : holder.entry->applied_indexes)
+    {
+        if (auto region_it = region_index.find(region_and_index.first); region_it != region_index.end())
+        {
+            region_it->second.erase(it->first);
+            if (region_it->second.empty())
+                region_index.erase(region_it);
+        }
+    }
+    current_size -= holder.size;
+    lru_queue.erase(holder.queue_it);
+    entry_map.erase(it);
+    entry_count.store(entry_map.size(), std::memory_order_relaxed);
+
+    if (unlikely(current_size > (1ull << 63)))
+        throw Exception(String(__FUNCTION__) + " inconsistent, current_size < 0", ErrorCodes::LOGICAL_ERROR);
+}
+
+void CopResponseCache::removeOverflow(std::lock_guard<std::mutex> & lock)
+{
+    while (current_size > max_size && !lru_queue.empty())
+    {
+        auto it = entry_map.find(lru_queue.front());
+        if (unlikely(it == entry_map.end()))
+            throw Exception(String(__FUNCTION__) + " inconsistent", ErrorCodes::LOGICAL_ERROR);
+        removeImpl(it, lock);
+        GET_METRIC(tiflash_coprocessor_response_cache, type_evict).Increment();
+    }
+}
+
+} // namespace DB
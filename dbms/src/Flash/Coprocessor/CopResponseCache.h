@@ -0,0 +1,140 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/HashTable/Hash.h>
+#include <Common/Logger.h>
+#include <Storages/Transaction/Types.h>
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include <kvproto/coprocessor.pb.h>
+#include <tipb/select.pb.h>
+#pragma GCC diagnostic pop
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace DB
+{
+/// The responses of a cop / batch cop request which have been sent to the client.
+struct CopResponseCacheEntry
+{
+    /// The start_ts the responses are computed at. The responses can be reused by the requests with
+    /// a start_ts not less than it, because no data newer than it is met when computing the responses.
+    UInt64 start_ts = 0;
+    /// The applied index of every region which the responses are computed on.
+    /// The entry is only valid when all of them are not changed.
+    std::vector<std::pair<RegionID, UInt64>> applied_indexes;
+    /// Serialized `coprocessor::Response::data` for cop request, or serialized
+    /// `coprocessor::BatchResponse` in writing order for batch cop request.
+    /// The execution summaries are not included.
+    std::vector<String> responses;
+    /// The execution summaries of the executors, only the fields describing the result are reused.
+    tipb::SelectResponse execution_summaries;
+
+    size_t bytes() const;
+
+    /// Generate the execution summaries for serving a request by this entry, which takes `time_processed_ns`
+    /// and does not scan any data. Return an empty response if the execution summaries are not collected.
+    tipb::SelectResponse genExecutionSummaries(UInt64 time_processed_ns) const;
+};
+using CopResponseCacheEntryPtr = std::shared_ptr<const CopResponseCacheEntry>;
+
+/// A bounded LRU cache for the responses of cop / batch cop requests.
+///
+/// The key is the fingerprint of the plan, which includes the DAG request without start_ts, key ranges
+/// and the epoch of every region. The entry is validated by the applied index of the regions instead of
+/// the start_ts of the request:
+/// - Only the responses which meet no data newer than their start_ts are cached, so they are the same
+///   for any bigger start_ts as long as the regions have not applied any raft log since then.
+/// - A region may contain locks with ts between the two start_ts, which would block the new request.
+///   The entry is not served in this case.
+///
+/// Entries of a region are dropped eagerly once the region applies a raft log or is removed.
+class CopResponseCache
+{
+private:
+    // Note that we don't use Common/LRUCache.h here. Because we need to drop all entries of a region
+    // when the region applies raft logs, which requires an index from region to its entries.
+
+    struct Holder;
+    using Key = UInt128;
+    using EntryMap = std::unordered_map<Key, Holder, TrivialHash>;
+    using LRUQueue = std::list<Key>;
+    using LRUQueueItr = typename LRUQueue::iterator;
+    using RegionIndex = std::unordered_map<RegionID, std::unordered_set<Key, TrivialHash>>;
+
+    struct Holder
+    {
+        CopResponseCacheEntryPtr entry;
+        size_t size;
+        LRUQueueItr queue_it;
+    };
+
+public:
+    /// Return true if the region is still at `applied_index` and has no lock blocking the read of the request.
+    using CheckRegion = std::function<bool(RegionID region_id, UInt64 applied_index)>;
+
+    CopResponseCache(size_t max_size_, size_t max_entry_size_);
+
+    /// Calculate the key of a cop request.
+    static UInt128 hash(const coprocessor::Request & request, const tipb::DAGRequest & dag_request);
+    /// Calculate the key of a batch cop request.
+    static UInt128 hash(const coprocessor::BatchRequest & request, const tipb::DAGRequest & dag_request);
+
+    /// Return the cached entry if it can serve the request with `start_ts`, and `check_region` passes for all its regions.
+    CopResponseCacheEntryPtr get(const Key & key, UInt64 start_ts, const CheckRegion & check_region);
+
+    /// Put the entry into the cache. Entries larger than `max_entry_size` are ignored.
+    void set(const Key & key, CopResponseCacheEntryPtr entry);
+
+    /// Drop all entries computed on the region.
+    void invalidateRegion(RegionID region_id);
+
+    size_t maxEntrySize() const { return max_entry_size; }
+    size_t currentSize() const;
+    size_t count() const;
+
+private:
+    void removeImpl(EntryMap::iterator it, std::lock_guard<std::mutex> &);
+    void removeOverflow(std::lock_guard<std::mutex> & lock);
+
+private:
+    EntryMap entry_map;
+    LRUQueue lru_queue;
+    RegionIndex region_index;
+
+    size_t current_size = 0;
+    const size_t max_size;
+    const size_t max_entry_size;
+
+    /// Used for skipping the lock in `invalidateRegion` when the cache is empty,
+    /// which is the common case on the raft apply path.
+    std::atomic<size_t> entry_count = 0;
+
+    LoggerPtr log;
+
+    mutable std::mutex mutex;
+};
+
+using CopResponseCachePtr = std::shared_ptr<CopResponseCache>;
+
+} // namespace DB
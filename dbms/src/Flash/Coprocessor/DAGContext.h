@@ -316,6 +316,11 @@ public:
     /// thus we need to pay attention to scan_context_map usage that time.
     std::unordered_map<String, DM::ScanContextPtr> scan_context_map;
 
+    /// region_id, read index
+    /// The read indexes got before executing the request, e.g. to validate the entries of the cop response cache.
+    /// They are reused by the learner read instead of sending the read index requests again.
+    std::unordered_map<RegionID, UInt64> read_index_res;
+
 private:
     void initExecutorIdToJoinIdMap();
     void initOutputInfo();
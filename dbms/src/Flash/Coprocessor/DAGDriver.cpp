@@ -134,7 +134,8 @@ try
             writer->Write(response);
         }
 
-        auto streaming_writer = std::make_shared<StreamWriter>(writer);
+        // The responses are not complete if some regions need retry, don't record them.
+        auto streaming_writer = std::make_shared<StreamWriter>(writer, dag_context.retry_regions.empty() ? record_limit : 0);
         TiDB::TiDBCollators collators;
         auto response_writer = std::make_unique<StreamingDAGResponseWriter<StreamWriterPtr>>(
             streaming_writer,
@@ -144,6 +145,8 @@ try
         response_writer->prepare(query_executor->getSampleBlock());
         query_executor->execute([&response_writer](const Block & block) { response_writer->write(block); }).verify();
         response_writer->flush();
+        recorded_responses = std::move(streaming_writer->recorded);
+        streaming_writer->recorded.reset();
 
         if (dag_context.collect_execution_summaries)
         {
@@ -151,6 +154,8 @@ try
             statistics_collector.initialize(&dag_context);
             auto execution_summary_response = statistics_collector.genExecutionSummaryResponse();
             streaming_writer->write(execution_summary_response);
+            if (recorded_responses)
+                recorded_execution_summaries = std::move(execution_summary_response);
         }
     }
 
@@ -228,6 +233,7 @@ catch (...)
 template <bool batch>
 void DAGDriver<batch>::recordError(Int32 err_code, const String & err_msg)
 {
+    recorded_responses.reset();
     if constexpr (batch)
     {
         tipb::SelectResponse dag_response;
@@ -31,6 +31,7 @@
 #pragma clang diagnostic pop
 #endif
 
+#include <optional>
 #include <vector>
 
 namespace DB
@@ -60,6 +61,17 @@ public:
 
     void execute();
 
+    /// Record the data of the responses written to the batch cop writer, at most `max_bytes`.
+    void enableResponseRecording(size_t max_bytes) { record_limit = max_bytes; }
+
+    /// Return the recorded responses. Return std::nullopt if nothing is recorded or the responses
+    /// can not be reused, e.g. an error happened, some regions need retry or the responses are too large.
+    std::optional<std::vector<String>> & getRecordedResponses() { return recorded_responses; }
+
+    /// Return the execution summaries written after the recorded responses, they are not recorded as a response
+    /// because the time and scan details are only valid for this execution.
+    tipb::SelectResponse & getRecordedExecutionSummaries() { return recorded_execution_summaries; }
+
 private:
     void recordError(Int32 err_code, const String & err_msg);
 
@@ -73,6 +85,10 @@ private:
 
     bool internal;
 
+    size_t record_limit = 0;
+    std::optional<std::vector<String>> recorded_responses;
+    tipb::SelectResponse recorded_execution_summaries;
+
     LoggerPtr log;
 };
 } // namespace DB
@@ -672,7 +672,8 @@ String DAGExpressionAnalyzer::applyFunction(
     if (actions->getSampleBlock().has(result_name))
         return result_name;
     const FunctionBuilderPtr & function_builder = FunctionFactory::instance().get(func_name, context);
-    const ExpressionAction & action = ExpressionAction::applyFunction(function_builder, arg_names, result_name, collator);
+    ExpressionAction action = ExpressionAction::applyFunction(function_builder, arg_names, result_name, collator);
+    action.short_circuit = context.getSettingsRef().enable_short_circuit_evaluation;
     actions->add(action);
     return result_name;
 }
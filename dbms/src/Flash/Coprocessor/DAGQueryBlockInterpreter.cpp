@@ -16,6 +16,7 @@
 #include <Common/ThresholdUtils.h>
 #include <Common/TiFlashException.h>
 #include <Core/NamesAndTypes.h>
+#include <DataStreams/AdaptivePreAggregatingBlockInputStream.h>
 #include <DataStreams/AggregatingBlockInputStream.h>
 #include <DataStreams/ExchangeSenderBlockInputStream.h>
 #include <DataStreams/ExpressionBlockInputStream.h>
@@ -409,6 +410,8 @@ void DAGQueryBlockInterpreter::executeAggregation(
 
     Block before_agg_header = pipeline.firstStream()->getHeader();
     const Settings & settings = context.getSettingsRef();
+    /// The partial aggregation of each stream can be done independently, since the final aggregation merges them.
+    bool enable_adaptive_pre_agg = !enable_fine_grained_shuffle && !is_final_agg && !key_names.empty() && settings.enable_adaptive_pre_aggregation;
 
     AggregationInterpreterHelper::fillArgColumnNumbers(aggregate_descriptions, before_agg_header);
     SpillConfig spill_config(
@@ -422,7 +425,7 @@ void DAGQueryBlockInterpreter::executeAggregation(
         context,
         before_agg_header,
         pipeline.streams.size(),
-        enable_fine_grained_shuffle ? pipeline.streams.size() : 1,
+        enable_fine_grained_shuffle || enable_adaptive_pre_agg ? pipeline.streams.size() : 1,
         key_names,
         collators,
         aggregate_descriptions,
@@ -442,6 +445,18 @@ void DAGQueryBlockInterpreter::executeAggregation(
         });
         recordProfileStreams(pipeline, query_block.aggregation_name);
     }
+    else if (enable_adaptive_pre_agg)
+    {
+        pipeline.transform([&](auto & stream) {
+            stream = std::make_shared<AdaptivePreAggregatingBlockInputStream>(
+                stream,
+                params,
+                settings.pre_aggregation_sample_rows,
+                settings.pre_aggregation_pass_through_ratio,
+                log->identifier());
+        });
+        recordProfileStreams(pipeline, query_block.aggregation_name);
+    }
     else if (pipeline.streams.size() > 1)
     {
         /// If there are several sources, then we perform parallel aggregation
@@ -481,7 +496,7 @@ void DAGQueryBlockInterpreter::executeWindowOrder(DAGPipeline & pipeline, SortDe
 void DAGQueryBlockInterpreter::executeOrder(DAGPipeline & pipeline, const NamesAndTypes & order_columns)
 {
     Int64 limit = query_block.limit_or_topn->topn().limit();
-    orderStreams(pipeline, max_streams, getSortDescription(order_columns, query_block.limit_or_topn->topn().order_by()), limit, false, context, log);
+    orderStreams(pipeline, max_streams, getSortDescription(order_columns, query_block.limit_or_topn->topn().order_by()), limit, false, context, log, topn_threshold);
 }
 
 void DAGQueryBlockInterpreter::recordProfileStreams(DAGPipeline & pipeline, const String & key)
@@ -629,6 +644,15 @@ void DAGQueryBlockInterpreter::executeImpl(DAGPipeline & pipeline)
     else if (query_block.isTableScanSource())
     {
         TiDBTableScan table_scan(query_block.source, query_block.source_name, dagContext());
+        if (query_block.aggregation && !query_block.selection && table_scan.getPushedDownFilters().empty()
+            && context.getSettingsRef().dt_enable_aggregation_from_pack_stats
+            && AggregationInterpreterHelper::canAggregateFromPackStats(query_block.aggregation->aggregation(), table_scan.getColumns()))
+            table_scan.setAggregationFromPackStats();
+        if (query_block.limit_or_topn && query_block.limit_or_topn->tp() == tipb::ExecType::TypeTopN && !query_block.aggregation)
+        {
+            topn_threshold = buildTopNThreshold(query_block.limit_or_topn->topn(), table_scan.getColumns(), context);
+            table_scan.setTopNThreshold(topn_threshold);
+        }
         if (unlikely(context.isTest()))
         {
             handleMockTableScan(table_scan, pipeline);
@@ -108,6 +108,9 @@ private:
 
     std::unique_ptr<DAGExpressionAnalyzer> analyzer;
 
+    /// The threshold published by the TopN of this query block to the table scan, see `TopNThreshold`.
+    TopNThresholdPtr topn_threshold;
+
     LoggerPtr log;
 };
 } // namespace DB
@@ -39,6 +39,9 @@ public:
     // ```
     virtual bool isReadyForWrite() const { throw Exception("Unsupport"); }
 
+    /// Whether `write` handles the blocks with a selection, see `Block::selectionCol`.
+    virtual bool supportSelection() const { return false; }
+
     /// flush cached blocks for batch writer
     virtual void flush() = 0;
     virtual ~DAGResponseWriter() = default;
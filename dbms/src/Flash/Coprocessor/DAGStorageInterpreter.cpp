@@ -263,6 +263,7 @@ DAGStorageInterpreter::DAGStorageInterpreter(
     , tmt(context.getTMTContext())
     , mvcc_query_info(new MvccQueryInfo(true, context.getSettingsRef().read_tso))
 {
+    mvcc_query_info->read_index_res = dagContext().read_index_res;
     if (unlikely(!hasRegionToRead(dagContext(), table_scan)))
     {
         throw TiFlashException(
@@ -749,6 +750,8 @@ std::unordered_map<TableID, SelectQueryInfo> DAGStorageInterpreter::generateSele
         query_info.req_id = fmt::format("{} table_id={}", log->identifier(), table_id);
         query_info.keep_order = table_scan.keepOrder();
         query_info.is_fast_scan = table_scan.isFastScan();
+        query_info.aggregation_from_pack_stats = table_scan.isAggregationFromPackStats();
+        query_info.topn_threshold = table_scan.getTopNThreshold();
         return query_info;
     };
     RUNTIME_CHECK_MSG(mvcc_query_info->scan_context != nullptr, "Unexpected null scan_context");
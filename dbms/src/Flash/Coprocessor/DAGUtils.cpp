@@ -1083,6 +1083,24 @@ bool isColumnExpr(const tipb::Expr & expr)
     return expr.tp() == tipb::ExprType::ColumnRef;
 }
 
+bool isPackStatsType(const ColumnInfo & column_info)
+{
+    switch (column_info.tp)
+    {
+    case TiDB::TypeTiny:
+    case TiDB::TypeShort:
+    case TiDB::TypeInt24:
+    case TiDB::TypeLong:
+    case TiDB::TypeLongLong:
+    case TiDB::TypeYear:
+    case TiDB::TypeDate:
+    case TiDB::TypeDatetime:
+        return true;
+    default:
+        return false;
+    }
+}
+
 Field decodeLiteral(const tipb::Expr & expr)
 {
     switch (expr.tp())
@@ -46,6 +46,9 @@ String getJoinTypeName(const tipb::JoinType & tp);
 String getFieldTypeName(Int32 tp);
 String getJoinExecTypeName(const tipb::JoinExecType & tp);
 bool isColumnExpr(const tipb::Expr & expr);
+// Whether the column has minmax index in DMFile and the order of the stored values is the same as TiDB.
+// Timestamp is excluded because it is casted to the timezone of the session after the table scan.
+bool isPackStatsType(const ColumnInfo & column_info);
 String getColumnNameForColumnExpr(const tipb::Expr & expr, const std::vector<NameAndTypePair> & input_col);
 void getColumnIDsFromExpr(const tipb::Expr & expr, const std::vector<ColumnInfo> & input_col, std::unordered_set<ColumnID> & col_id_set);
 NameAndTypePair getColumnNameAndTypeForColumnExpr(const tipb::Expr & expr, const std::vector<NameAndTypePair> & input_col);
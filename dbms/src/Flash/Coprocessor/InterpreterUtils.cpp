@@ -22,8 +22,11 @@
 #include <DataStreams/PartialSortingBlockInputStream.h>
 #include <DataStreams/SharedQueryBlockInputStream.h>
 #include <DataStreams/SortHelper.h>
+#include <DataStreams/TopNBlockInputStream.h>
 #include <DataStreams/UnionBlockInputStream.h>
+#include <Flash/Coprocessor/DAGCodec.h>
 #include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Coprocessor/DAGUtils.h>
 #include <Flash/Coprocessor/InterpreterUtils.h>
 #include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
 #include <Interpreters/Context.h>
@@ -124,15 +127,20 @@ void orderStreams(
     Int64 limit,
     bool enable_fine_grained_shuffle,
     const Context & context,
-    const LoggerPtr & log)
+    const LoggerPtr & log,
+    const TopNThresholdPtr & topn_threshold)
 {
     const Settings & settings = context.getSettingsRef();
     String extra_info;
     if (enable_fine_grained_shuffle)
         extra_info = enableFineGrainedShuffleExtraInfo;
 
+    const bool use_topn = limit > 0 && static_cast<UInt64>(limit) <= settings.topn_threshold_max_limit;
     pipeline.transform([&](auto & stream) {
-        stream = std::make_shared<PartialSortingBlockInputStream>(stream, order_descr, log->identifier(), limit);
+        if (use_topn)
+            stream = std::make_shared<TopNBlockInputStream>(stream, order_descr, limit, topn_threshold, log->identifier());
+        else
+            stream = std::make_shared<PartialSortingBlockInputStream>(stream, order_descr, log->identifier(), limit);
         stream->setExtraInfo(extra_info);
     });
 
@@ -168,6 +176,26 @@ void orderStreams(
     }
 }
 
+TopNThresholdPtr buildTopNThreshold(
+    const tipb::TopN & top_n,
+    const std::vector<TiDB::ColumnInfo> & table_scan_columns,
+    const Context & context)
+{
+    if (top_n.limit() == 0 || top_n.limit() > context.getSettingsRef().topn_threshold_max_limit || top_n.order_by_size() == 0)
+        return nullptr;
+
+    const auto & first_item = top_n.order_by(0);
+    if (!isColumnExpr(first_item.expr()))
+        return nullptr;
+    auto column_index = decodeDAGInt64(first_item.expr().val());
+    if (column_index < 0 || column_index >= static_cast<Int64>(table_scan_columns.size()))
+        return nullptr;
+    const auto & column_info = table_scan_columns[column_index];
+    if (!isPackStatsType(column_info))
+        return nullptr;
+    return std::make_shared<TopNThreshold>(column_info.id, first_item.desc());
+}
+
 void executeLocalSort(
     PipelineExecutorStatus & exec_status,
     PipelineExecGroupBuilder & group_builder,
@@ -300,12 +328,13 @@ void executePushedDownFilter(
 
     assert(remote_read_sources_start_index <= group_builder.group.size());
     auto input_header = group_builder.getCurrentHeader();
+    double selection_min_ratio = analyzer.getContext().getSettingsRef().filter_selection_min_ratio;
 
     // for remote read, filter had been pushed down, don't need to execute again.
     for (size_t i = 0; i < remote_read_sources_start_index; ++i)
     {
         auto & group = group_builder.group[i];
-        group.appendTransformOp(std::make_unique<FilterTransformOp>(exec_status, log->identifier(), input_header, before_where, filter_column_name));
+        group.appendTransformOp(std::make_unique<FilterTransformOp>(exec_status, log->identifier(), input_header, before_where, filter_column_name, selection_min_ratio));
         // after filter, do project action to keep the schema of local transforms and remote transforms the same.
         group.appendTransformOp(std::make_unique<ExpressionTransformOp>(exec_status, log->identifier(), project_after_where));
     }
@@ -16,6 +16,7 @@
 
 #include <Common/Logger.h>
 #include <Core/SortDescription.h>
+#include <DataStreams/TopNThreshold.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGPipeline.h>
 #include <Flash/Coprocessor/FilterConditions.h>
@@ -57,6 +58,7 @@ void executeExpression(
     const ExpressionActionsPtr & expr_actions,
     const LoggerPtr & log);
 
+/// If `limit` is not 0, each stream keeps its top `limit` rows, and publishes its threshold to `topn_threshold` if any.
 void orderStreams(
     DAGPipeline & pipeline,
     size_t max_streams,
@@ -64,7 +66,15 @@ void orderStreams(
     Int64 limit,
     bool enable_fine_grained_shuffle,
     const Context & context,
-    const LoggerPtr & log);
+    const LoggerPtr & log,
+    const TopNThresholdPtr & topn_threshold = nullptr);
+
+/// Returns the threshold shared by the TopN directly on the table scan and the table scan, or nullptr if the packs of
+/// the table scan can not be skipped by the first ORDER BY column, see `TopNThreshold`.
+TopNThresholdPtr buildTopNThreshold(
+    const tipb::TopN & top_n,
+    const std::vector<TiDB::ColumnInfo> & table_scan_columns,
+    const Context & context);
 
 void executeLocalSort(
     PipelineExecutorStatus & exec_status,
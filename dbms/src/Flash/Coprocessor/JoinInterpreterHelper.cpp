@@ -17,6 +17,7 @@
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypeString.h>
 #include <DataTypes/getLeastSupertype.h>
+#include <Flash/Coprocessor/DAGCodec.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGUtils.h>
 #include <Flash/Coprocessor/JoinInterpreterHelper.h>
@@ -341,6 +342,75 @@ NamesAndTypes TiFlashJoin::genJoinOutputColumns(
     return join_output_columns;
 }
 
+std::vector<JoinRangeCondition> TiFlashJoin::genRangeConditions(
+    const Block & left_input_header,
+    const Block & right_input_header) const
+{
+    std::vector<JoinRangeCondition> range_conditions;
+    if ((kind != ASTTableJoin::Kind::Cross && kind != ASTTableJoin::Kind::Cross_LeftOuter)
+        || strictness != ASTTableJoin::Strictness::All
+        || join.other_eq_conditions_from_in_size() > 0)
+        return range_conditions;
+
+    const size_t left_columns = left_input_header.columns();
+    auto get_column = [&](const tipb::Expr & expr) -> std::pair<const ColumnWithTypeAndName *, bool> {
+        if (!isColumnExpr(expr))
+            return {nullptr, false};
+        auto index = decodeDAGInt64(expr.val());
+        if (index < 0 || static_cast<size_t>(index) >= left_columns + right_input_header.columns())
+            return {nullptr, false};
+        bool is_left = static_cast<size_t>(index) < left_columns;
+        const auto & column = is_left ? left_input_header.getByPosition(index) : right_input_header.getByPosition(index - left_columns);
+        /// Is the column from the build side.
+        return {&column, is_left == (build_side_index == 0)};
+    };
+
+    static const std::unordered_map<String, JoinRangeCondition::Op> ops{
+        {"less", JoinRangeCondition::Op::Less},
+        {"lessOrEquals", JoinRangeCondition::Op::LessOrEquals},
+        {"greater", JoinRangeCondition::Op::Greater},
+        {"greaterOrEquals", JoinRangeCondition::Op::GreaterOrEquals},
+    };
+    /// `build op probe` is the same as `probe reversed_op build`.
+    auto reverse = [](JoinRangeCondition::Op op) {
+        switch (op)
+        {
+        case JoinRangeCondition::Op::Less:
+            return JoinRangeCondition::Op::Greater;
+        case JoinRangeCondition::Op::LessOrEquals:
+            return JoinRangeCondition::Op::GreaterOrEquals;
+        case JoinRangeCondition::Op::Greater:
+            return JoinRangeCondition::Op::Less;
+        case JoinRangeCondition::Op::GreaterOrEquals:
+            return JoinRangeCondition::Op::LessOrEquals;
+        }
+        __builtin_unreachable();
+    };
+
+    for (const auto & cond : join.other_conditions())
+    {
+        if (!isScalarFunctionExpr(cond) || cond.children_size() != 2)
+            continue;
+        auto op_it = ops.find(getFunctionName(cond));
+        if (op_it == ops.end())
+            continue;
+        auto [lhs, lhs_is_build] = get_column(cond.children(0));
+        auto [rhs, rhs_is_build] = get_column(cond.children(1));
+        if (lhs == nullptr || rhs == nullptr || lhs_is_build == rhs_is_build)
+            continue;
+        const auto * probe = lhs_is_build ? rhs : lhs;
+        const auto * build = lhs_is_build ? lhs : rhs;
+        /// The rows are compared by the columns directly, so the types must be the same and not depend on collations.
+        auto type = removeNullable(probe->type);
+        if (!type->equals(*removeNullable(build->type)) || !(type->isValueRepresentedByNumber() || type->isDecimal()))
+            continue;
+        if (!range_conditions.empty() && range_conditions.front().build_column != build->name)
+            continue;
+        range_conditions.push_back({probe->name, build->name, lhs_is_build ? reverse(op_it->second) : op_it->second});
+    }
+    return range_conditions;
+}
+
 void TiFlashJoin::fillJoinOtherConditionsAction(
     const Context & context,
     const Block & left_input_header,
@@ -374,6 +444,9 @@ void TiFlashJoin::fillJoinOtherConditionsAction(
         chain.addStep();
     }
 
+    if (join_non_equal_conditions.other_cond_expr != nullptr && context.getSettingsRef().enable_range_join)
+        join_non_equal_conditions.range_conditions = genRangeConditions(left_input_header, right_input_header);
+
     if (join.is_null_aware_semi_join())
     {
         join_non_equal_conditions.null_aware_eq_cond_name = dag_analyzer.appendNullAwareSemiJoinEqColumn(chain, probe_key_names, build_key_names, join_key_collators);
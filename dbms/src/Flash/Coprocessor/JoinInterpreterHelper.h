@@ -76,6 +76,26 @@ using JoinKeyTypes = std::vector<JoinKeyType>;
 ///      - join keys are `t1.col1` and `t2.col1`
 ///      - other_cond is `t1.col2 = t2.col2 and t1.col3 > t2.col3`
 ///      - null_aware_eq_cond is `t1.col1 = t2.col1`
+/// A condition like `probe_column < build_column` in the other conditions of a cross join.
+/// The cross join sorts the build rows by `build_column`, and then the build rows satisfying the condition
+/// can be found by binary search for each probe row instead of checking all the build rows.
+/// It only narrows the build rows to check, the other conditions are still evaluated on the joined rows.
+struct JoinRangeCondition
+{
+    enum class Op
+    {
+        Less,
+        LessOrEquals,
+        Greater,
+        GreaterOrEquals,
+    };
+
+    String probe_column;
+    String build_column;
+    /// `probe_column op build_column`
+    Op op;
+};
+
 struct JoinNonEqualConditions
 {
     String left_filter_column;
@@ -89,6 +109,9 @@ struct JoinNonEqualConditions
     String null_aware_eq_cond_name;
     ExpressionActionsPtr null_aware_eq_cond_expr;
 
+    /// The range conditions in other conditions, all of them are on the same build column.
+    std::vector<JoinRangeCondition> range_conditions;
+
     /// Validate this JoinNonEqualConditions and return error message if any.
     String validate(ASTTableJoin::Kind kind) const
     {
@@ -102,6 +125,9 @@ struct JoinNonEqualConditions
         if unlikely (other_cond_name.empty() && other_eq_cond_from_in_name.empty() && other_cond_expr != nullptr)
             return "other_cond_name and other_eq_cond_from_in_name are empty but other_cond_expr is not nullptr";
 
+        if unlikely (!range_conditions.empty() && other_cond_expr == nullptr)
+            return "range_conditions are not empty but other_cond_expr is nullptr";
+
         if (isNullAwareSemiFamily(kind))
         {
             if unlikely (null_aware_eq_cond_name.empty() || null_aware_eq_cond_expr == nullptr)
@@ -197,6 +223,13 @@ struct TiFlashJoin
         const Block & left_input_header,
         const Block & right_input_header,
         const ExpressionActionsPtr & probe_prepare_join_actions) const;
+
+    /// Collect the range conditions from the other conditions, which are comparisons between a probe column and a build
+    /// column of the same numeric, decimal or time type. Only inner and left outer cross join use the range conditions,
+    /// because the rows filtered out by them never match, and the semi joins need to know whether the other conditions are null.
+    std::vector<JoinRangeCondition> genRangeConditions(
+        const Block & left_input_header,
+        const Block & right_input_header) const;
 };
 
 /// @join_prepare_expr_actions: generates join key columns and join filter column
@@ -46,6 +46,17 @@ public:
         analyzer = std::move(storage->analyzer);
     }
 
+    SourceOps execute(PipelineExecutorStatus & exec_status)
+    {
+        return storage->readSourceOps(exec_status, context, max_streams);
+    }
+
+    void executeSuffix(PipelineExecutorStatus & exec_status, PipelineExecGroupBuilder & group_builder)
+    {
+        storage->filterConditions(exec_status, group_builder);
+        analyzer = std::move(storage->analyzer);
+    }
+
     // Members will be transferred to DAGQueryBlockInterpreter after execute
     std::unique_ptr<DAGExpressionAnalyzer> analyzer;
 
@@ -27,6 +27,8 @@
 #pragma clang diagnostic pop
 #endif
 #include <mutex>
+#include <optional>
+#include <vector>
 
 namespace mpp
 {
@@ -40,9 +42,19 @@ struct StreamWriter
     ::grpc::ServerWriter<::coprocessor::BatchResponse> * writer;
     std::mutex write_mutex;
 
-    explicit StreamWriter(::grpc::ServerWriter<::coprocessor::BatchResponse> * writer_)
+    /// Used by CopResponseCache. When `record_limit` > 0, the data of written responses are kept
+    /// until their total size exceeds `record_limit`.
+    size_t record_limit = 0;
+    size_t recorded_bytes = 0;
+    std::optional<std::vector<String>> recorded;
+
+    explicit StreamWriter(::grpc::ServerWriter<::coprocessor::BatchResponse> * writer_, size_t record_limit_ = 0)
         : writer(writer_)
-    {}
+        , record_limit(record_limit_)
+    {
+        if (record_limit > 0)
+            recorded.emplace();
+    }
     void write(tipb::SelectResponse & response)
     {
         ::coprocessor::BatchResponse resp;
@@ -54,6 +66,14 @@ struct StreamWriter
         std::lock_guard lk(write_mutex);
         if (!writer->Write(resp))
             throw Exception("Failed to write resp");
+        if (recorded)
+        {
+            recorded_bytes += resp.data().size();
+            if (recorded_bytes > record_limit)
+                recorded.reset();
+            else
+                recorded->push_back(std::move(*resp.mutable_data()));
+        }
     }
     bool isReadyForWrite() const { throw Exception("Unsupport async write"); }
 };
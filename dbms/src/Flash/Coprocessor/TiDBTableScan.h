@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <DataStreams/TopNThreshold.h>
 #include <Storages/Transaction/TypeMapping.h>
 #include <common/types.h>
 #include <tipb/executor.pb.h>
@@ -66,6 +67,26 @@ public:
         return is_fast_scan;
     }
 
+    bool isAggregationFromPackStats() const
+    {
+        return aggregation_from_pack_stats;
+    }
+
+    void setAggregationFromPackStats()
+    {
+        aggregation_from_pack_stats = true;
+    }
+
+    const TopNThresholdPtr & getTopNThreshold() const
+    {
+        return topn_threshold;
+    }
+
+    void setTopNThreshold(const TopNThresholdPtr & topn_threshold_)
+    {
+        topn_threshold = topn_threshold_;
+    }
+
     const tipb::Executor * getTableScanPB() const
     {
         return table_scan;
@@ -98,6 +119,11 @@ private:
 
     bool keep_order;
     bool is_fast_scan;
+    /// The upper aggregation only needs the number of rows and the min/max values of the columns,
+    /// see `AggregationInterpreterHelper::canAggregateFromPackStats`.
+    bool aggregation_from_pack_stats = false;
+    /// The threshold published by the TopN on the table scan, see `TopNThreshold`.
+    TopNThresholdPtr topn_threshold;
 };
 
 } // namespace DB
@@ -0,0 +1,225 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Coprocessor/CopResponseCache.h>
+#include <gtest/gtest.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace DB
+{
+namespace tests
+{
+namespace
+{
+coprocessor::Request makeCopRequest(UInt64 start_ts, RegionID region_id, UInt64 region_version, const String & range_end = "z")
+{
+    coprocessor::Request request;
+    request.set_tp(103);
+    request.set_data("dag request");
+    request.set_start_ts(start_ts);
+    request.mutable_context()->set_region_id(region_id);
+    request.mutable_context()->mutable_region_epoch()->set_version(region_version);
+    request.mutable_context()->mutable_region_epoch()->set_conf_ver(1);
+    auto * range = request.add_ranges();
+    range->set_start("a");
+    range->set_end(range_end);
+    return request;
+}
+
+tipb::DAGRequest makeDAGRequest(UInt64 start_ts, Int64 time_zone_offset = 0)
+{
+    tipb::DAGRequest dag_request;
+    dag_request.set_start_ts_fallback(start_ts);
+    dag_request.set_time_zone_offset(time_zone_offset);
+    dag_request.add_output_offsets(0);
+    return dag_request;
+}
+
+UInt128 hash(UInt64 start_ts, RegionID region_id, UInt64 region_version, const String & range_end = "z")
+{
+    return CopResponseCache::hash(makeCopRequest(start_ts, region_id, region_version, range_end), makeDAGRequest(start_ts));
+}
+
+CopResponseCacheEntryPtr makeEntry(UInt64 start_ts, std::vector<std::pair<RegionID, UInt64>> applied_indexes, const String & data)
+{
+    auto entry = std::make_shared<CopResponseCacheEntry>();
+    entry->start_ts = start_ts;
+    entry->applied_indexes = std::move(applied_indexes);
+    entry->responses.push_back(data);
+    return entry;
+}
+} // namespace
+
+class CopResponseCacheTest : public ::testing::Test
+{
+protected:
+    CopResponseCache::CheckRegion checkRegion()
+    {
+        return [this](RegionID region_id, UInt64 applied_index) {
+            auto it = applied_indexes.find(region_id);
+            return it != applied_indexes.end() && it->second == applied_index && !locked_regions.count(region_id);
+        };
+    }
+
+    std::unordered_map<RegionID, UInt64> applied_indexes;
+    std::unordered_set<RegionID> locked_regions;
+};
+
+TEST_F(CopResponseCacheTest, Hash)
+{
+    auto key = hash(100, 1, 1);
+    ASSERT_EQ(key, hash(100, 1, 1));
+    // The start_ts is not a part of the key, both in the request and in the DAG request.
+    ASSERT_EQ(key, hash(101, 1, 1));
+    ASSERT_EQ(key, CopResponseCache::hash(makeCopRequest(0, 1, 1), makeDAGRequest(102)));
+    // Different plan, region, region epoch or ranges should lead to different keys.
+    ASSERT_NE(key, CopResponseCache::hash(makeCopRequest(100, 1, 1), makeDAGRequest(100, 28800)));
+    ASSERT_NE(key, hash(100, 2, 1));
+    ASSERT_NE(key, hash(100, 1, 2));
+    ASSERT_NE(key, hash(100, 1, 1, "y"));
+
+    auto request = makeCopRequest(100, 1, 1);
+    request.mutable_context()->add_resolved_locks(99);
+    ASSERT_NE(key, CopResponseCache::hash(request, makeDAGRequest(100)));
+}
+
+TEST_F(CopResponseCacheTest, HitAndStale)
+{
+    CopResponseCache cache(1024 * 1024, 1024);
+    auto key = hash(100, 1, 1);
+
+    applied_indexes[1] = 10;
+    ASSERT_EQ(cache.get(key, 100, checkRegion()), nullptr);
+    cache.set(key, makeEntry(100, {{1, 10}}, "resp"));
+    ASSERT_EQ(cache.count(), 1);
+
+    auto entry = cache.get(key, 100, checkRegion());
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(entry->responses.front(), "resp");
+    // Requests with a bigger start_ts hit the entry as long as the region is not changed.
+    ASSERT_NE(cache.get(key, 200, checkRegion()), nullptr);
+    // Requests with a smaller start_ts may not see some rows in the response, but the entry is still valid.
+    ASSERT_EQ(cache.get(key, 99, checkRegion()), nullptr);
+    ASSERT_EQ(cache.count(), 1);
+
+    // The region has a lock blocking the read, the entry is removed.
+    locked_regions.insert(1);
+    ASSERT_EQ(cache.get(key, 200, checkRegion()), nullptr);
+    ASSERT_EQ(cache.count(), 0);
+    locked_regions.clear();
+
+    // The region applied a new raft log, the entry is stale and removed.
+    cache.set(key, makeEntry(100, {{1, 10}}, "resp"));
+    applied_indexes[1] = 11;
+    ASSERT_EQ(cache.get(key, 100, checkRegion()), nullptr);
+    ASSERT_EQ(cache.count(), 0);
+    ASSERT_EQ(cache.currentSize(), 0);
+
+    // The region is removed.
+    cache.set(key, makeEntry(100, {{1, 11}}, "resp"));
+    applied_indexes.erase(1);
+    ASSERT_EQ(cache.get(key, 100, checkRegion()), nullptr);
+    ASSERT_EQ(cache.count(), 0);
+}
+
+TEST_F(CopResponseCacheTest, ExecutionSummaries)
+{
+    CopResponseCacheEntry entry;
+    auto * summary = entry.execution_summaries.add_execution_summaries();
+    summary->set_time_processed_ns(1000000);
+    summary->set_num_produced_rows(10);
+    summary->set_num_iterations(2);
+    summary->set_concurrency(4);
+    summary->set_executor_id("TableFullScan_1");
+    summary->mutable_tiflash_scan_context()->set_total_dmfile_scanned_rows(8192);
+
+    // The result is reused, while the time and the scan details are regenerated.
+    auto response = entry.genExecutionSummaries(100);
+    ASSERT_EQ(response.execution_summaries_size(), 1);
+    const auto & generated = response.execution_summaries(0);
+    ASSERT_EQ(generated.time_processed_ns(), 100);
+    ASSERT_EQ(generated.num_produced_rows(), 10);
+    ASSERT_EQ(generated.num_iterations(), 2);
+    ASSERT_EQ(generated.concurrency(), 4);
+    ASSERT_EQ(generated.executor_id(), "TableFullScan_1");
+    ASSERT_EQ(generated.tiflash_scan_context().total_dmfile_scanned_rows(), 0);
+
+    ASSERT_EQ(CopResponseCacheEntry().genExecutionSummaries(100).execution_summaries_size(), 0);
+}
+
+TEST_F(CopResponseCacheTest, InvalidateRegion)
+{
+    CopResponseCache cache(1024 * 1024, 1024);
+    auto key1 = hash(100, 1, 1);
+    auto key2 = hash(100, 2, 1);
+    auto key12 = hash(100, 1, 1, "y");
+    applied_indexes[1] = 10;
+    applied_indexes[2] = 20;
+
+    cache.set(key1, makeEntry(100, {{1, 10}}, "resp1"));
+    cache.set(key2, makeEntry(100, {{2, 20}}, "resp2"));
+    // An entry of batch cop request which covers both regions.
+    cache.set(key12, makeEntry(100, {{1, 10}, {2, 20}}, "resp12"));
+    ASSERT_EQ(cache.count(), 3);
+
+    cache.invalidateRegion(1);
+    ASSERT_EQ(cache.count(), 1);
+    ASSERT_EQ(cache.get(key1, 100, checkRegion()), nullptr);
+    ASSERT_EQ(cache.get(key12, 100, checkRegion()), nullptr);
+    ASSERT_NE(cache.get(key2, 100, checkRegion()), nullptr);
+
+    cache.invalidateRegion(2);
+    ASSERT_EQ(cache.count(), 0);
+    ASSERT_EQ(cache.currentSize(), 0);
+    // Invalidate a region without any entry.
+    cache.invalidateRegion(3);
+}
+
+TEST_F(CopResponseCacheTest, Evict)
+{
+    const String data(100, 'a');
+    const size_t entry_size = makeEntry(100, {{1, 10}}, data)->bytes();
+    CopResponseCache cache(entry_size * 2, entry_size);
+    applied_indexes[1] = 10;
+
+    auto key1 = hash(100, 1, 1, "x");
+    auto key2 = hash(100, 1, 1, "y");
+    auto key3 = hash(100, 1, 1, "z");
+    cache.set(key1, makeEntry(100, {{1, 10}}, data));
+    cache.set(key2, makeEntry(100, {{1, 10}}, data));
+    // Touch key1 so that key2 is the least recently used one.
+    ASSERT_NE(cache.get(key1, 100, checkRegion()), nullptr);
+    cache.set(key3, makeEntry(100, {{1, 10}}, data));
+    ASSERT_EQ(cache.count(), 2);
+    ASSERT_EQ(cache.currentSize(), entry_size * 2);
+    ASSERT_NE(cache.get(key1, 100, checkRegion()), nullptr);
+    ASSERT_EQ(cache.get(key2, 100, checkRegion()), nullptr);
+    ASSERT_NE(cache.get(key3, 100, checkRegion()), nullptr);
+
+    // Entries larger than max_entry_size are ignored.
+    auto key4 = hash(100, 1, 1, "w");
+    cache.set(key4, makeEntry(100, {{1, 10}}, data + "a"));
+    ASSERT_EQ(cache.get(key4, 100, checkRegion()), nullptr);
+    ASSERT_EQ(cache.count(), 2);
+
+    // All entries of the region are removed from the region index as well.
+    cache.invalidateRegion(1);
+    ASSERT_EQ(cache.count(), 0);
+    ASSERT_EQ(cache.currentSize(), 0);
+}
+
+} // namespace tests
+} // namespace DB
@@ -15,6 +15,7 @@
 #include <Common/Stopwatch.h>
 #include <Common/TiFlashException.h>
 #include <Common/TiFlashMetrics.h>
+#include <Flash/Coprocessor/CopResponseCache.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGDriver.h>
 #include <Flash/Coprocessor/InterpreterDAG.h>
@@ -24,8 +25,11 @@
 #include <Interpreters/Context.h>
 #include <Interpreters/SharedContexts/Disagg.h>
 #include <Storages/IStorage.h>
+#include <Storages/Transaction/KVStore.h>
+#include <Storages/Transaction/LearnerRead.h>
 #include <Storages/Transaction/LockException.h>
 #include <Storages/Transaction/RegionException.h>
+#include <Storages/Transaction/RegionLockInfo.h>
 #include <Storages/Transaction/TMTContext.h>
 #include <TiDB/Schema/SchemaSyncer.h>
 
@@ -93,13 +97,40 @@ grpc::Status CoprocessorHandler::execute()
                 throw TiFlashException(
                     "DAG request with rpn expression is not supported in TiFlash",
                     Errors::Coprocessor::Unimplemented);
+            const UInt64 start_ts = cop_request->start_ts() > 0 ? cop_request->start_ts() : dag_request.start_ts_fallback();
+            const std::unordered_set<UInt64> bypass_lock_ts(
+                cop_context.kv_context.resolved_locks().begin(),
+                cop_context.kv_context.resolved_locks().end());
+
+            auto & tmt = cop_context.db_context.getTMTContext();
+            const RegionID region_id = cop_context.kv_context.region_id();
+            auto cop_response_cache = cop_context.db_context.getCopResponseCache();
+            UInt128 cache_key;
+            std::optional<UInt64> applied_index_before_read;
+            std::unordered_map<RegionID, UInt64> read_indexes;
+            if (cop_response_cache)
+            {
+                cache_key = CopResponseCache::hash(*cop_request, dag_request);
+                // Get the read index before looking up the cache, otherwise a replica which has not caught up with
+                // the read index of `start_ts` would serve a stale response.
+                read_indexes = batchGetReadIndex({region_id}, start_ts, tmt);
+                auto entry = cop_response_cache->get(cache_key, start_ts, [&](RegionID id, UInt64 applied_index) {
+                    return checkRegion(tmt, id, applied_index, start_ts, &bypass_lock_ts, read_indexes);
+                });
+                if (entry)
+                {
+                    // Append the regenerated execution summaries, the repeated fields of the serialized messages are merged.
+                    cop_response->set_data(entry->responses.front() + entry->genExecutionSummaries(watch.elapsed()).SerializeAsString());
+                    LOG_DEBUG(log, "Handle DAG request done, served by response cache");
+                    break;
+                }
+                applied_index_before_read = getRegionAppliedIndex(tmt, region_id);
+            }
+
             tipb::SelectResponse dag_response;
             TablesRegionsInfo tables_regions_info(true);
             auto & table_regions_info = tables_regions_info.getSingleTableRegions();
 
-            const std::unordered_set<UInt64> bypass_lock_ts(
-                cop_context.kv_context.resolved_locks().begin(),
-                cop_context.kv_context.resolved_locks().end());
             table_regions_info.local_regions.emplace(
                 cop_context.kv_context.region_id(),
                 RegionInfo(
@@ -117,10 +148,29 @@ grpc::Status CoprocessorHandler::execute()
                 /*is_batch_cop=*/false,
                 Logger::get("CoprocessorHandler"));
             cop_context.db_context.setDAGContext(&dag_context);
+            reuseReadIndexes(dag_context, read_indexes);
 
-            DAGDriver driver(cop_context.db_context, cop_request->start_ts() > 0 ? cop_request->start_ts() : dag_request.start_ts_fallback(), cop_request->schema_ver(), &dag_response);
+            DAGDriver driver(cop_context.db_context, start_ts, cop_request->schema_ver(), &dag_response);
             driver.execute();
-            cop_response->set_data(dag_response.SerializeAsString());
+
+            // Only cache the response if the region has not applied any raft log during the read, so the
+            // response is exactly computed on the data of `applied_index_before_read`, and the response
+            // does not change with a bigger start_ts.
+            if (applied_index_before_read && !dag_response.has_error() && !hasMetNewerVersion(dag_context)
+                && getRegionAppliedIndex(tmt, region_id) == applied_index_before_read)
+            {
+                auto entry = std::make_shared<CopResponseCacheEntry>();
+                entry->start_ts = start_ts;
+                entry->applied_indexes.emplace_back(region_id, *applied_index_before_read);
+                entry->execution_summaries.mutable_execution_summaries()->Swap(dag_response.mutable_execution_summaries());
+                entry->responses.push_back(dag_response.SerializeAsString());
+                cop_response->set_data(entry->responses.front() + entry->execution_summaries.SerializeAsString());
+                cop_response_cache->set(cache_key, std::move(entry));
+            }
+            else
+            {
+                cop_response->set_data(dag_response.SerializeAsString());
+            }
             LOG_DEBUG(log, "Handle DAG request done");
             break;
         }
@@ -197,6 +247,53 @@ grpc::Status CoprocessorHandler::execute()
     }
 }
 
+std::optional<UInt64> CoprocessorHandler::getRegionAppliedIndex(TMTContext & tmt, UInt64 region_id)
+{
+    if (auto region = tmt.getKVStore()->getRegion(region_id); region)
+        return region->appliedIndex();
+    return std::nullopt;
+}
+
+bool CoprocessorHandler::checkRegion(
+    TMTContext & tmt,
+    UInt64 region_id,
+    UInt64 applied_index,
+    UInt64 start_ts,
+    const std::unordered_set<UInt64> * bypass_lock_ts,
+    const std::unordered_map<UInt64, UInt64> & read_indexes)
+{
+    // The response is computed on the data of `applied_index`, it misses the data committed before `start_ts` if
+    // `applied_index` is less than the read index.
+    auto read_index = read_indexes.find(region_id);
+    if (read_index == read_indexes.end() || applied_index < read_index->second)
+        return false;
+    auto region = tmt.getKVStore()->getRegion(region_id);
+    if (!region || region->appliedIndex() != applied_index)
+        return false;
+    // The lock would block the read with `start_ts`, let the request go through the normal read path to resolve it.
+    return region->getLockInfo(RegionLockReadQuery{.read_tso = start_ts, .bypass_lock_ts = bypass_lock_ts}) == nullptr;
+}
+
+void CoprocessorHandler::reuseReadIndexes(DAGContext & dag_context, const std::unordered_map<UInt64, UInt64> & read_indexes)
+{
+    for (const auto & [region_id, read_index] : read_indexes)
+    {
+        // 0 means the region is read stale, which is checked again by the learner read.
+        if (read_index != 0)
+            dag_context.read_index_res.emplace(region_id, read_index);
+    }
+}
+
+bool CoprocessorHandler::hasMetNewerVersion(const DAGContext & dag_context)
+{
+    for (const auto & [executor_id, scan_context] : dag_context.scan_context_map)
+    {
+        if (scan_context->total_mvcc_newer_version_rows > 0)
+            return true;
+    }
+    return false;
+}
+
 grpc::Status CoprocessorHandler::recordError(grpc::StatusCode err_code, const String & err_msg)
 {
     cop_response->Clear();
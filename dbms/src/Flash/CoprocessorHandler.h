@@ -26,8 +26,14 @@
 #include <tipb/select.pb.h>
 #pragma GCC diagnostic pop
 
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace DB
 {
+class TMTContext;
+class DAGContext;
 struct DecodedTiKVKey;
 using DecodedTiKVKeyPtr = std::shared_ptr<DecodedTiKVKey>;
 
@@ -59,6 +65,25 @@ public:
 protected:
     virtual grpc::Status recordError(grpc::StatusCode err_code, const String & err_msg);
 
+    /// Return the applied index of the region in KVStore, or std::nullopt if the region is not found.
+    static std::optional<UInt64> getRegionAppliedIndex(TMTContext & tmt, UInt64 region_id);
+
+    /// Return true if the region is still at `applied_index`, `applied_index` is not less than the read index of
+    /// `start_ts` in `read_indexes`, and the region has no lock blocking the read with `start_ts`.
+    static bool checkRegion(
+        TMTContext & tmt,
+        UInt64 region_id,
+        UInt64 applied_index,
+        UInt64 start_ts,
+        const std::unordered_set<UInt64> * bypass_lock_ts,
+        const std::unordered_map<UInt64, UInt64> & read_indexes);
+
+    /// Keep the read indexes in `dag_context` so that the learner read does not get them again.
+    static void reuseReadIndexes(DAGContext & dag_context, const std::unordered_map<UInt64, UInt64> & read_indexes);
+
+    /// Return true if the table scans have met any row newer than the start_ts of the request.
+    static bool hasMetNewerVersion(const DAGContext & dag_context);
+
 protected:
     enum
     {
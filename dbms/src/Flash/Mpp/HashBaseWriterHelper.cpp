@@ -12,10 +12,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnDecimal.h>
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <Common/typeid_cast.h>
 #include <Flash/Coprocessor/DAGUtils.h>
 #include <Flash/Mpp/HashBaseWriterHelper.h>
 #include <Storages/Transaction/TypeMapping.h>
 
+#include <algorithm>
+#include <array>
+
 namespace DB::HashBaseWriterHelper
 {
 void materializeBlock(Block & input_block)
@@ -116,12 +124,235 @@ void computeHash(size_t rows,
         key_columns[i]->updateWeakHash32(hash, collators[i], partition_key_containers[i]);
 }
 
+void radixPartition(const IColumn::Selector & selector,
+                    size_t part_num,
+                    IColumn::Permutation & permutation,
+                    std::vector<size_t> & partition_offsets)
+{
+    const size_t rows = selector.size();
+
+    // 1st pass: build the histogram and turn it into the start offset of each partition.
+    partition_offsets.assign(part_num + 1, 0);
+    for (size_t i = 0; i < rows; ++i)
+        ++partition_offsets[selector[i] + 1];
+    for (size_t i = 0; i < part_num; ++i)
+        partition_offsets[i + 1] += partition_offsets[i];
+
+    // 2nd pass: write the row indexes of each partition contiguously.
+    permutation.resize(rows);
+    std::vector<size_t> cursors(partition_offsets.begin(), partition_offsets.end() - 1);
+
+    // Buffer a cache line of row indexes for each partition and flush the whole cache line at once
+    // (software write-combining), so that the writes do not touch `part_num` cache lines and pages
+    // alternately.
+    using Index = IColumn::Permutation::value_type;
+    static constexpr size_t buffer_size = 64 / sizeof(Index);
+    struct alignas(64) WriteCombiningBuffer
+    {
+        std::array<Index, buffer_size> data;
+    };
+    std::vector<WriteCombiningBuffer> buffers(part_num);
+    std::vector<UInt8> buffered(part_num, 0);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const auto part = selector[i];
+        auto & n = buffered[part];
+        buffers[part].data[n++] = i;
+        if (n == buffer_size)
+        {
+            memcpy(&permutation[cursors[part]], buffers[part].data.data(), sizeof(Index) * buffer_size);
+            cursors[part] += buffer_size;
+            n = 0;
+        }
+    }
+    for (size_t part = 0; part < part_num; ++part)
+    {
+        if (buffered[part] > 0)
+            memcpy(&permutation[cursors[part]], buffers[part].data.data(), sizeof(Index) * buffered[part]);
+    }
+}
+
+namespace
+{
+/// One cache line of values for each bucket, which is flushed to the bucket at once (software write-combining),
+/// so that the writes do not touch `part_num` cache lines and pages alternately.
+template <typename T>
+struct alignas(64) WriteCombiningBuffer
+{
+    static constexpr size_t capacity = std::max<size_t>(1, 64 / sizeof(T));
+    T data[capacity];
+};
+
+/// Append the values of `src` to the containers of their buckets in `dest`, `part_sizes` is the histogram of `selector`.
+template <typename Container>
+void radixScatterData(const Container & src, const IColumn::Selector & selector, const std::vector<size_t> & part_sizes, const std::vector<Container *> & dest)
+{
+    using T = typename Container::value_type;
+    using Buffer = WriteCombiningBuffer<T>;
+    const size_t part_num = dest.size();
+    std::vector<T *> cursors(part_num);
+    for (size_t part = 0; part < part_num; ++part)
+    {
+        const size_t old_size = dest[part]->size();
+        dest[part]->resize(old_size + part_sizes[part]);
+        cursors[part] = dest[part]->data() + old_size;
+    }
+
+    std::vector<Buffer> buffers(part_num);
+    std::vector<UInt8> buffered(part_num, 0);
+    for (size_t i = 0; i < selector.size(); ++i)
+    {
+        const auto part = selector[i];
+        auto & n = buffered[part];
+        buffers[part].data[n++] = src[i];
+        if (n == Buffer::capacity)
+        {
+            memcpy(cursors[part], buffers[part].data, sizeof(T) * Buffer::capacity);
+            cursors[part] += Buffer::capacity;
+            n = 0;
+        }
+    }
+    for (size_t part = 0; part < part_num; ++part)
+    {
+        if (buffered[part] > 0)
+            memcpy(cursors[part], buffers[part].data, sizeof(T) * buffered[part]);
+    }
+}
+
+template <typename ColumnType>
+bool tryRadixScatterData(const IColumn & src, const IColumn::Selector & selector, const std::vector<size_t> & part_sizes, const std::vector<IColumn *> & dest)
+{
+    const auto * src_column = typeid_cast<const ColumnType *>(&src);
+    if (!src_column)
+        return false;
+    std::vector<typename ColumnType::Container *> dest_data(dest.size());
+    for (size_t part = 0; part < dest.size(); ++part)
+        dest_data[part] = &static_cast<ColumnType &>(*dest[part]).getData();
+    radixScatterData(src_column->getData(), selector, part_sizes, dest_data);
+    return true;
+}
+
+/// The strings of each bucket are written after the space of the bucket is allocated, so every string is copied once.
+void radixScatterStrings(const ColumnString & src, const IColumn::Selector & selector, const std::vector<size_t> & part_sizes, const std::vector<IColumn *> & dest)
+{
+    const size_t part_num = dest.size();
+    const auto & src_offsets = src.getOffsets();
+    const auto & src_chars = src.getChars();
+
+    std::vector<size_t> part_bytes(part_num, 0);
+    for (size_t i = 0, prev_offset = 0; i < selector.size(); ++i)
+    {
+        part_bytes[selector[i]] += src_offsets[i] - prev_offset;
+        prev_offset = src_offsets[i];
+    }
+
+    std::vector<UInt8 *> chars_cursors(part_num);
+    std::vector<IColumn::Offset *> offsets_cursors(part_num);
+    std::vector<IColumn::Offset> last_offsets(part_num);
+    for (size_t part = 0; part < part_num; ++part)
+    {
+        auto & column = static_cast<ColumnString &>(*dest[part]);
+        auto & chars = column.getChars();
+        auto & offsets = column.getOffsets();
+        const size_t old_bytes = chars.size();
+        const size_t old_size = offsets.size();
+        chars.resize(old_bytes + part_bytes[part]);
+        offsets.resize(old_size + part_sizes[part]);
+        chars_cursors[part] = chars.data() + old_bytes;
+        offsets_cursors[part] = offsets.data() + old_size;
+        last_offsets[part] = old_bytes;
+    }
+
+    for (size_t i = 0, prev_offset = 0; i < selector.size(); ++i)
+    {
+        const auto part = selector[i];
+        const size_t size = src_offsets[i] - prev_offset;
+        inline_memcpy(chars_cursors[part], &src_chars[prev_offset], size);
+        prev_offset = src_offsets[i];
+        chars_cursors[part] += size;
+        last_offsets[part] += size;
+        *offsets_cursors[part]++ = last_offsets[part];
+    }
+}
+
+/// Returns false if the type of the column is not supported, and nothing is written.
+bool radixScatterColumn(const IColumn & src, const IColumn::Selector & selector, const std::vector<size_t> & part_sizes, const std::vector<IColumn *> & dest)
+{
+    if (const auto * nullable = typeid_cast<const ColumnNullable *>(&src))
+    {
+        std::vector<IColumn *> dest_nested(dest.size());
+        std::vector<IColumn *> dest_null_map(dest.size());
+        for (size_t part = 0; part < dest.size(); ++part)
+        {
+            auto & dest_nullable = static_cast<ColumnNullable &>(*dest[part]);
+            dest_nested[part] = &dest_nullable.getNestedColumn();
+            dest_null_map[part] = &dest_nullable.getNullMapColumn();
+        }
+        return radixScatterColumn(nullable->getNestedColumn(), selector, part_sizes, dest_nested)
+            && tryRadixScatterData<ColumnUInt8>(nullable->getNullMapColumn(), selector, part_sizes, dest_null_map);
+    }
+    if (const auto * str = typeid_cast<const ColumnString *>(&src))
+    {
+        radixScatterStrings(*str, selector, part_sizes, dest);
+        return true;
+    }
+    return tryRadixScatterData<ColumnUInt8>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnUInt16>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnUInt32>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnUInt64>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnUInt128>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnInt8>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnInt16>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnInt32>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnInt64>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnFloat32>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnFloat64>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnDecimal<Decimal32>>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnDecimal<Decimal64>>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnDecimal<Decimal128>>(src, selector, part_sizes, dest)
+        || tryRadixScatterData<ColumnDecimal<Decimal256>>(src, selector, part_sizes, dest);
+}
+
+/// Scatter each column of the block into the columns returned by `get_dest(col_id, part)` by radix partitioning.
+/// The values of numeric, decimal and string columns (and their nullable ones) are written to the destination
+/// directly in one pass. The other columns are copied by the row indexes of each partition from `radixPartition`.
+template <typename GetDest>
+void radixScatterColumns(const Block & block, const IColumn::Selector & selector, size_t part_num, GetDest && get_dest)
+{
+    std::vector<size_t> part_sizes(part_num, 0);
+    for (size_t i = 0; i < selector.size(); ++i)
+        ++part_sizes[selector[i]];
+
+    IColumn::Permutation permutation;
+    std::vector<size_t> partition_offsets;
+    std::vector<IColumn *> dest(part_num);
+    for (size_t col_id = 0; col_id < block.columns(); ++col_id)
+    {
+        for (size_t part = 0; part < part_num; ++part)
+            dest[part] = &get_dest(col_id, part);
+        const auto & src = *block.getByPosition(col_id).column;
+        if (radixScatterColumn(src, selector, part_sizes, dest))
+            continue;
+
+        if (permutation.empty())
+            radixPartition(selector, part_num, permutation, partition_offsets);
+        std::vector<size_t> positions;
+        for (size_t part = 0; part < part_num; ++part)
+        {
+            positions.assign(permutation.begin() + partition_offsets[part], permutation.begin() + partition_offsets[part + 1]);
+            dest[part]->insertDisjunctFrom(src, positions);
+        }
+    }
+}
+} // namespace
+
 void scatterColumns(const Block & input_block,
                     const std::vector<Int64> & partition_col_ids,
                     const TiDB::TiDBCollators & collators,
                     std::vector<String> & partition_key_containers,
                     uint32_t bucket_num,
-                    std::vector<std::vector<MutableColumnPtr>> & result_columns)
+                    std::vector<std::vector<MutableColumnPtr>> & result_columns,
+                    bool use_radix_partition)
 {
     if unlikely (input_block.rows() == 0)
         return;
@@ -132,11 +363,38 @@ void scatterColumns(const Block & input_block,
     IColumn::Selector selector;
     fillSelector(input_block.rows(), hash, bucket_num, selector);
 
+    /// The rows out of the selection of the block are scattered to an extra bucket, which is dropped.
+    size_t scatter_bucket_num = bucket_num;
+    if (const auto & selection = input_block.selectionCol())
+    {
+        const auto & filter = typeid_cast<const ColumnUInt8 &>(*selection).getData();
+        for (size_t i = 0; i < selector.size(); ++i)
+        {
+            if (!filter[i])
+                selector[i] = bucket_num;
+        }
+        scatter_bucket_num = bucket_num + 1;
+    }
+
+    if (use_radix_partition)
+    {
+        /// The rows out of the selection are scattered into `dropped`.
+        MutableColumns dropped(input_block.columns());
+        radixScatterColumns(input_block, selector, scatter_bucket_num, [&](size_t col_id, size_t bucket_idx) -> IColumn & {
+            if (bucket_idx < bucket_num)
+                return *result_columns[bucket_idx][col_id];
+            if (!dropped[col_id])
+                dropped[col_id] = input_block.getByPosition(col_id).column->cloneEmpty();
+            return *dropped[col_id];
+        });
+        return;
+    }
+
     for (size_t col_id = 0; col_id < input_block.columns(); ++col_id)
     {
         // Scatter columns to different partitions
-        std::vector<MutableColumnPtr> part_columns = input_block.getByPosition(col_id).column->scatter(bucket_num, selector);
-        assert(part_columns.size() == bucket_num);
+        std::vector<MutableColumnPtr> part_columns = input_block.getByPosition(col_id).column->scatter(scatter_bucket_num, selector);
+        assert(part_columns.size() == scatter_bucket_num);
         for (size_t bucket_idx = 0; bucket_idx < bucket_num; ++bucket_idx)
         {
             result_columns[bucket_idx][col_id] = std::move(part_columns[bucket_idx]);
@@ -152,7 +410,8 @@ void scatterColumnsForFineGrainedShuffle(const Block & block,
                                          uint32_t fine_grained_shuffle_stream_count,
                                          WeakHash32 & hash,
                                          IColumn::Selector & selector,
-                                         std::vector<IColumn::ScatterColumns> & scattered)
+                                         std::vector<IColumn::ScatterColumns> & scattered,
+                                         bool use_radix_partition)
 {
     if unlikely (block.rows() == 0)
         return;
@@ -163,6 +422,14 @@ void scatterColumnsForFineGrainedShuffle(const Block & block,
     /// fill selector using computed hash
     fillSelectorForFineGrainedShuffle(block.rows(), hash, part_num, fine_grained_shuffle_stream_count, selector);
 
+    if (use_radix_partition)
+    {
+        radixScatterColumns(block, selector, part_num * fine_grained_shuffle_stream_count, [&](size_t col_id, size_t bucket_idx) -> IColumn & {
+            return *scattered[col_id][bucket_idx];
+        });
+        return;
+    }
+
     // partition
     for (size_t i = 0; i < block.columns(); ++i)
     {
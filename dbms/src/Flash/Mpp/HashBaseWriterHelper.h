@@ -39,12 +39,36 @@ void computeHash(size_t rows,
                  std::vector<String> & partition_key_containers,
                  WeakHash32 & hash);
 
+/// Scattering the rows one by one into hundreds of buckets thrashes the cache and TLB, because every row
+/// writes to a different column of a different bucket. When the number of buckets is not less than
+/// `RADIX_PARTITION_MIN_BUCKETS`, the rows are radix partitioned and written through per-bucket write-combining
+/// buffers instead. The buffers only pay off if they are filled, so the block should also have at least
+/// `RADIX_PARTITION_MIN_ROWS_PER_BUCKET` rows for each bucket on average.
+static constexpr size_t RADIX_PARTITION_MIN_BUCKETS = 16;
+static constexpr size_t RADIX_PARTITION_MIN_ROWS_PER_BUCKET = 8;
+
+inline bool useRadixPartition(size_t bucket_num, size_t rows)
+{
+    return bucket_num >= RADIX_PARTITION_MIN_BUCKETS && rows >= bucket_num * RADIX_PARTITION_MIN_ROWS_PER_BUCKET;
+}
+
+/// Two-pass radix partitioning of the rows by `selector`:
+/// 1. build the histogram of partitions;
+/// 2. write the row indexes of each partition contiguously into `permutation`.
+/// The rows of partition i are `permutation[partition_offsets[i], partition_offsets[i + 1])`.
+void radixPartition(const IColumn::Selector & selector,
+                    size_t part_num,
+                    IColumn::Permutation & permutation,
+                    std::vector<size_t> & partition_offsets);
+
+/// Only the selected rows are scattered if `input_block` has a selection.
 void scatterColumns(const Block & input_block,
                     const std::vector<Int64> & partition_col_ids,
                     const TiDB::TiDBCollators & collators,
                     std::vector<String> & partition_key_containers,
                     uint32_t bucket_num,
-                    std::vector<std::vector<MutableColumnPtr>> & result_columns);
+                    std::vector<std::vector<MutableColumnPtr>> & result_columns,
+                    bool use_radix_partition);
 
 void scatterColumnsForFineGrainedShuffle(const Block & block,
                                          const std::vector<Int64> & partition_col_ids,
@@ -54,7 +78,8 @@ void scatterColumnsForFineGrainedShuffle(const Block & block,
                                          uint32_t fine_grained_shuffle_stream_count,
                                          WeakHash32 & hash,
                                          IColumn::Selector & selector,
-                                         std::vector<IColumn::ScatterColumns> & scattered);
+                                         std::vector<IColumn::ScatterColumns> & scattered,
+                                         bool use_radix_partition);
 
 // Used to hold expected types for codec
 struct HashPartitionWriterHelperV1
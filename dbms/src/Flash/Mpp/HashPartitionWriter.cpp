@@ -100,7 +100,7 @@ bool HashPartitionWriter<ExchangeWriterPtr>::isReadyForWrite() const
 template <class ExchangeWriterPtr>
 void HashPartitionWriter<ExchangeWriterPtr>::writeImplV1(const Block & block)
 {
-    size_t rows = block.rows();
+    size_t rows = block.selectedRows();
     if (rows > 0)
     {
         rows_in_blocks += rows;
@@ -115,7 +115,7 @@ void HashPartitionWriter<ExchangeWriterPtr>::writeImplV1(const Block & block)
 template <class ExchangeWriterPtr>
 void HashPartitionWriter<ExchangeWriterPtr>::writeImpl(const Block & block)
 {
-    size_t rows = block.rows();
+    size_t rows = block.selectedRows();
     if (rows > 0)
     {
         rows_in_blocks += rows;
@@ -167,7 +167,7 @@ void HashPartitionWriter<ExchangeWriterPtr>::partitionAndWriteBlocksV1()
             assertBlockSchema(expected_types, block, HashPartitionWriterLabels[MPPDataPacketV1]);
         }
         auto && dest_tbl_cols = HashBaseWriterHelper::createDestColumns(block, partition_num);
-        HashBaseWriterHelper::scatterColumns(block, partition_col_ids, collators, partition_key_containers, partition_num, dest_tbl_cols);
+        HashBaseWriterHelper::scatterColumns(block, partition_col_ids, collators, partition_key_containers, partition_num, dest_tbl_cols, HashBaseWriterHelper::useRadixPartition(partition_num, block.rows()));
         block.clear();
 
         for (size_t part_id = 0; part_id < partition_num; ++part_id)
@@ -210,7 +210,7 @@ void HashPartitionWriter<ExchangeWriterPtr>::partitionAndWriteBlocks()
         {
             const auto & block = blocks.back();
             auto dest_tbl_cols = HashBaseWriterHelper::createDestColumns(block, partition_num);
-            HashBaseWriterHelper::scatterColumns(block, partition_col_ids, collators, partition_key_containers, partition_num, dest_tbl_cols);
+            HashBaseWriterHelper::scatterColumns(block, partition_col_ids, collators, partition_key_containers, partition_num, dest_tbl_cols, HashBaseWriterHelper::useRadixPartition(partition_num, block.rows()));
             blocks.pop_back();
 
             for (size_t part_id = 0; part_id < partition_num; ++part_id)
@@ -39,6 +39,8 @@ public:
         tipb::CompressionMode compression_mode_);
     void write(const Block & block) override;
     bool isReadyForWrite() const override;
+    // Only the selected rows are scattered to the partitions.
+    bool supportSelection() const override { return true; }
     void flush() override;
 
 private:
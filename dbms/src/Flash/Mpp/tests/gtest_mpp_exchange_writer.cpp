@@ -12,11 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnFixedString.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeFixedString.h>
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypesNumber.h>
 #include <Flash/Coprocessor/CHBlockChunkCodec.h>
 #include <Flash/Coprocessor/ChunkDecodeAndSquash.h>
 #include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Mpp/HashBaseWriterHelper.h>
 #include <Flash/Mpp/MPPTunnelSetHelper.h>
 #include <Storages/Transaction/TiDB.h>
 #include <TestUtils/ColumnGenerator.h>
@@ -504,6 +508,129 @@ try
 }
 CATCH
 
+TEST_F(TestMPPExchangeWriter, testRadixPartitionScatter)
+try
+{
+    const size_t rows = 8192;
+    Block block;
+    block.insert(ColumnGenerator::instance().generate({rows, "Int64", RANDOM, "col0"}));
+    block.insert(ColumnGenerator::instance().generate({rows, "Nullable(Int32)", RANDOM, "col1"}));
+    block.insert(ColumnGenerator::instance().generate({rows, "String", RANDOM, "col2"}));
+    block.insert(ColumnGenerator::instance().generate({rows, "Nullable(String)", RANDOM, "col3"}));
+    block.insert(ColumnGenerator::instance().generate({rows, "Decimal", RANDOM, "col4"}));
+    // Not written directly by the radix partitioning, it is copied by the row indexes of each partition.
+    auto fixed_string = ColumnFixedString::create(4);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        auto value = fmt::format("{:04}", i % 10000);
+        fixed_string->insertData(value.data(), value.size());
+    }
+    block.insert({std::move(fixed_string), std::make_shared<DataTypeFixedString>(4), "col5"});
+    TiDB::TiDBCollators collators{nullptr};
+
+    auto assert_columns_equal = [](const IColumn & expected, const IColumn & actual) {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            ASSERT_EQ(expected.compareAt(i, i, actual, 1), 0);
+    };
+
+    for (const uint32_t part_num : {1, 7, 16, 128, 1000})
+    {
+        // The rows of each partition are in the same order as the row by row scattering.
+        std::vector<String> partition_key_containers(collators.size());
+        auto expected = HashBaseWriterHelper::createDestColumns(block, part_num);
+        HashBaseWriterHelper::scatterColumns(block, part_col_ids, collators, partition_key_containers, part_num, expected, false);
+        auto actual = HashBaseWriterHelper::createDestColumns(block, part_num);
+        HashBaseWriterHelper::scatterColumns(block, part_col_ids, collators, partition_key_containers, part_num, actual, true);
+        size_t total_rows = 0;
+        for (size_t part_id = 0; part_id < part_num; ++part_id)
+        {
+            for (size_t col_id = 0; col_id < block.columns(); ++col_id)
+                assert_columns_equal(*expected[part_id][col_id], *actual[part_id][col_id]);
+            total_rows += actual[part_id][0]->size();
+        }
+        ASSERT_EQ(total_rows, rows);
+
+        const uint32_t stream_count = 8;
+        auto init_scattered = [&]() {
+            std::vector<IColumn::ScatterColumns> scattered(block.columns());
+            for (size_t col_id = 0; col_id < block.columns(); ++col_id)
+            {
+                for (size_t bucket_idx = 0; bucket_idx < part_num * stream_count; ++bucket_idx)
+                    scattered[col_id].emplace_back(block.getByPosition(col_id).column->cloneEmpty());
+            }
+            return scattered;
+        };
+        WeakHash32 hash(0);
+        IColumn::Selector selector;
+        auto expected_scattered = init_scattered();
+        auto actual_scattered = init_scattered();
+        // Scatter twice to check that the rows are appended.
+        for (size_t i = 0; i < 2; ++i)
+        {
+            HashBaseWriterHelper::scatterColumnsForFineGrainedShuffle(block, part_col_ids, collators, partition_key_containers, part_num, stream_count, hash, selector, expected_scattered, false);
+            HashBaseWriterHelper::scatterColumnsForFineGrainedShuffle(block, part_col_ids, collators, partition_key_containers, part_num, stream_count, hash, selector, actual_scattered, true);
+        }
+        for (size_t col_id = 0; col_id < block.columns(); ++col_id)
+        {
+            for (size_t bucket_idx = 0; bucket_idx < part_num * stream_count; ++bucket_idx)
+                assert_columns_equal(*expected_scattered[col_id][bucket_idx], *actual_scattered[col_id][bucket_idx]);
+        }
+    }
+}
+CATCH
+
+TEST_F(TestMPPExchangeWriter, testScatterWithSelection)
+try
+{
+    const size_t rows = 8192;
+    Block block;
+    block.insert(ColumnGenerator::instance().generate({rows, "Int64", RANDOM, "col0"}));
+    block.insert(ColumnGenerator::instance().generate({rows, "Nullable(String)", RANDOM, "col1"}));
+    TiDB::TiDBCollators collators{nullptr};
+
+    auto selection = ColumnUInt8::create(rows, 0);
+    size_t selected_rows = 0;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        selection->getData()[i] = i % 3 != 0;
+        selected_rows += selection->getData()[i];
+    }
+    Block selected_block = block;
+    selected_block.setSelection(std::move(selection), selected_rows);
+    Block filtered_block = selected_block;
+    filtered_block.materializeSelection();
+    ASSERT_EQ(filtered_block.rows(), selected_rows);
+    ASSERT_EQ(filtered_block.selectedRows(), selected_rows);
+    ASSERT_EQ(selected_block.rows(), rows);
+    ASSERT_EQ(selected_block.selectedRows(), selected_rows);
+
+    for (const uint32_t part_num : {1, 7, 128})
+    {
+        for (const bool use_radix_partition : {false, true})
+        {
+            // Scattering the block with a selection is the same as scattering the filtered block.
+            std::vector<String> partition_key_containers(collators.size());
+            auto expected = HashBaseWriterHelper::createDestColumns(block, part_num);
+            HashBaseWriterHelper::scatterColumns(filtered_block, part_col_ids, collators, partition_key_containers, part_num, expected, use_radix_partition);
+            auto actual = HashBaseWriterHelper::createDestColumns(block, part_num);
+            HashBaseWriterHelper::scatterColumns(selected_block, part_col_ids, collators, partition_key_containers, part_num, actual, use_radix_partition);
+            for (size_t part_id = 0; part_id < part_num; ++part_id)
+            {
+                for (size_t col_id = 0; col_id < block.columns(); ++col_id)
+                {
+                    const auto & expected_column = *expected[part_id][col_id];
+                    const auto & actual_column = *actual[part_id][col_id];
+                    ASSERT_EQ(expected_column.size(), actual_column.size());
+                    for (size_t i = 0; i < expected_column.size(); ++i)
+                        ASSERT_EQ(expected_column.compareAt(i, i, actual_column, 1), 0);
+                }
+            }
+        }
+    }
+}
+CATCH
+
 TEST_F(TestMPPExchangeWriter, testBroadcastOrPassThroughWriter)
 try
 {
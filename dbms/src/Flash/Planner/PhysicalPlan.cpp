@@ -60,6 +60,28 @@ bool pushDownSelection(Context & context, const PhysicalPlanNodePtr & plan, cons
     }
     return false;
 }
+
+void pushDownAggregation(Context & context, const PhysicalPlanNodePtr & plan, const tipb::Aggregation & aggregation)
+{
+    if (plan->tp() == PlanType::TableScan && context.getSettingsRef().dt_enable_aggregation_from_pack_stats)
+    {
+        auto physical_table_scan = std::static_pointer_cast<PhysicalTableScan>(plan);
+        physical_table_scan->setAggregation(aggregation);
+    }
+}
+
+TopNThresholdPtr pushDownTopN(Context & context, const PhysicalPlanNodePtr & plan, const tipb::TopN & top_n)
+{
+    /// The rows filtered out by the selection on the table scan can not be the top rows,
+    /// so the threshold is pushed down through it, the same as DAGQueryBlockInterpreter.
+    auto scan = plan->tp() == PlanType::Filter ? plan->children(0) : plan;
+    if (scan->tp() == PlanType::TableScan)
+    {
+        auto physical_table_scan = std::static_pointer_cast<PhysicalTableScan>(scan);
+        return physical_table_scan->setTopN(top_n, context);
+    }
+    return nullptr;
+}
 } // namespace
 
 void PhysicalPlan::build(const tipb::DAGRequest * dag_request)
@@ -96,8 +118,12 @@ void PhysicalPlan::build(const tipb::Executor * executor)
         break;
     case tipb::ExecType::TypeTopN:
         GET_METRIC(tiflash_coprocessor_executor_count, type_topn).Increment();
-        pushBack(PhysicalTopN::build(context, executor_id, log, executor->topn(), popBack()));
+    {
+        auto child = popBack();
+        auto topn_threshold = pushDownTopN(context, child, executor->topn());
+        pushBack(PhysicalTopN::build(context, executor_id, log, executor->topn(), topn_threshold, child));
         break;
+    }
     case tipb::ExecType::TypeSelection:
     {
         GET_METRIC(tiflash_coprocessor_executor_count, type_sel).Increment();
@@ -111,9 +137,13 @@ void PhysicalPlan::build(const tipb::Executor * executor)
     case tipb::ExecType::TypeStreamAgg:
         RUNTIME_CHECK_MSG(executor->aggregation().group_by_size() == 0, "Group by key is not supported in StreamAgg");
     case tipb::ExecType::TypeAggregation:
+    {
         GET_METRIC(tiflash_coprocessor_executor_count, type_agg).Increment();
-        pushBack(PhysicalAggregation::build(context, executor_id, log, executor->aggregation(), FineGrainedShuffle(executor), popBack()));
+        auto child = popBack();
+        pushDownAggregation(context, child, executor->aggregation());
+        pushBack(PhysicalAggregation::build(context, executor_id, log, executor->aggregation(), FineGrainedShuffle(executor), child));
         break;
+    }
     case tipb::ExecType::TypeExchangeSender:
     {
         GET_METRIC(tiflash_coprocessor_executor_count, type_exchange_sender).Increment();
@@ -14,6 +14,7 @@
 
 #include <Common/Logger.h>
 #include <Common/TiFlashException.h>
+#include <DataStreams/AdaptivePreAggregatingBlockInputStream.h>
 #include <DataStreams/AggregatingBlockInputStream.h>
 #include <DataStreams/ParallelAggregatingBlockInputStream.h>
 #include <Flash/Coprocessor/AggregationInterpreterHelper.h>
@@ -48,6 +49,16 @@ PhysicalPlanNodePtr PhysicalAggregation::build(
         throw TiFlashException("Aggregation executor without group by/agg exprs", Errors::Planner::BadRequest);
     }
 
+    if (AggregationInterpreterHelper::canRewriteCountDistinct(context, aggregation))
+    {
+        /// The distinct values are deduplicated by the two-level hash table of `group by keys, x` in parallel,
+        /// instead of being merged into one hash set per group at the end.
+        auto [distinct_agg, count_agg] = AggregationInterpreterHelper::rewriteCountDistinct(aggregation);
+        auto physical_distinct = build(context, fmt::format("{}_distinct", executor_id), log, distinct_agg, fine_grained_shuffle, child);
+        physical_distinct->notTiDBOperator();
+        return build(context, executor_id, log, count_agg, fine_grained_shuffle, physical_distinct);
+    }
+
     DAGExpressionAnalyzer analyzer{child->getSchema(), context};
     ExpressionActionsPtr before_agg_actions = PhysicalPlanHelper::newActions(child->getSampleBlock());
     NamesAndTypes aggregated_columns;
@@ -96,6 +107,8 @@ void PhysicalAggregation::buildBlockInputStreamImpl(DAGPipeline & pipeline, Cont
     executeExpression(pipeline, before_agg_actions, log, "before aggregation");
 
     Block before_agg_header = pipeline.firstStream()->getHeader();
+    /// The partial aggregation of each stream can be done independently, since the final aggregation merges them.
+    bool enable_adaptive_pre_agg = !fine_grained_shuffle.enable() && !is_final_agg && !aggregation_keys.empty() && context.getSettingsRef().enable_adaptive_pre_aggregation;
     AggregationInterpreterHelper::fillArgColumnNumbers(aggregate_descriptions, before_agg_header);
     SpillConfig spill_config(
         context.getTemporaryPath(),
@@ -108,7 +121,7 @@ void PhysicalAggregation::buildBlockInputStreamImpl(DAGPipeline & pipeline, Cont
         context,
         before_agg_header,
         pipeline.streams.size(),
-        fine_grained_shuffle.enable() ? pipeline.streams.size() : 1,
+        fine_grained_shuffle.enable() || enable_adaptive_pre_agg ? pipeline.streams.size() : 1,
         aggregation_keys,
         aggregation_collators,
         aggregate_descriptions,
@@ -127,6 +140,18 @@ void PhysicalAggregation::buildBlockInputStreamImpl(DAGPipeline & pipeline, Cont
             stream->setExtraInfo(String(enableFineGrainedShuffleExtraInfo));
         });
     }
+    else if (enable_adaptive_pre_agg)
+    {
+        const Settings & settings = context.getSettingsRef();
+        pipeline.transform([&](auto & stream) {
+            stream = std::make_shared<AdaptivePreAggregatingBlockInputStream>(
+                stream,
+                params,
+                settings.pre_aggregation_sample_rows,
+                settings.pre_aggregation_pass_through_ratio,
+                log->identifier());
+        });
+    }
     else if (pipeline.streams.size() > 1)
     {
         /// If there are several sources, then we perform parallel aggregation
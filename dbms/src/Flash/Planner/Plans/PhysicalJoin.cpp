@@ -18,6 +18,7 @@
 #include <DataStreams/ExpressionBlockInputStream.h>
 #include <DataStreams/HashJoinBuildBlockInputStream.h>
 #include <DataStreams/HashJoinProbeBlockInputStream.h>
+#include <DataStreams/MergeJoinBlockInputStream.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGPipeline.h>
@@ -27,6 +28,8 @@
 #include <Flash/Planner/FinalizeHelper.h>
 #include <Flash/Planner/PhysicalPlanHelper.h>
 #include <Flash/Planner/Plans/PhysicalJoin.h>
+#include <Flash/Planner/Plans/PhysicalMockTableScan.h>
+#include <Flash/Planner/Plans/PhysicalTableScan.h>
 #include <Interpreters/Context.h>
 #include <common/logger_useful.h>
 #include <fmt/format.h>
@@ -53,6 +56,24 @@ void recordJoinExecuteInfo(
     dag_context.getJoinExecuteInfoMap()[executor_id] = std::move(join_execute_info);
 }
 
+/// Whether the output of the plan may be sorted, which is only decided after its streams are built.
+/// Only a table scan which keeps the order can be sorted, and projections and filters pass the order through.
+bool mayOutputSorted(const PhysicalPlanNodePtr & plan)
+{
+    switch (plan->tp())
+    {
+    case PlanType::TableScan:
+        return std::static_pointer_cast<PhysicalTableScan>(plan)->keepOrder();
+    case PlanType::MockTableScan:
+        return std::static_pointer_cast<PhysicalMockTableScan>(plan)->keepOrder();
+    case PlanType::Projection:
+    case PlanType::Filter:
+        return mayOutputSorted(plan->children(0));
+    default:
+        return false;
+    }
+}
+
 } // namespace
 
 PhysicalPlanNodePtr PhysicalJoin::build(
@@ -147,6 +168,17 @@ PhysicalPlanNodePtr PhysicalJoin::build(
 
     recordJoinExecuteInfo(dag_context, executor_id, build_plan->execId(), join_ptr);
 
+    /// The merge join only compares the equal join keys, so it can not be used if there are any other conditions.
+    bool support_merge_join = settings.enable_merge_join
+        && mayOutputSorted(probe_plan)
+        && mayOutputSorted(build_plan)
+        && MergeJoinBlockInputStream::isSupported(tiflash_join.kind, tiflash_join.strictness)
+        && !fine_grained_shuffle.enable()
+        && join_non_equal_conditions.left_filter_column.empty()
+        && join_non_equal_conditions.right_filter_column.empty()
+        && join_non_equal_conditions.other_cond_expr == nullptr
+        && std::all_of(tiflash_join.join_key_collators.begin(), tiflash_join.join_key_collators.end(), [](const auto & collator) { return collator == nullptr; });
+
     auto physical_join = std::make_shared<PhysicalJoin>(
         executor_id,
         join_output_schema,
@@ -157,7 +189,9 @@ PhysicalPlanNodePtr PhysicalJoin::build(
         join_ptr,
         probe_side_prepare_actions,
         build_side_prepare_actions,
-        Block(join_output_schema));
+        Block(join_output_schema),
+        support_merge_join ? original_probe_key_names : Names{},
+        support_merge_join ? original_build_key_names : Names{});
     return physical_join;
 }
 
@@ -211,8 +245,92 @@ void PhysicalJoin::buildSideTransform(DAGPipeline & build_pipeline, Context & co
     dag_context.addSubquery(execId(), std::move(build_query));
 }
 
+bool PhysicalJoin::canMergeJoin(const DAGPipeline & probe_pipeline, const DAGPipeline & build_pipeline) const
+{
+    auto is_sorted_by_keys = [](const DAGPipeline & pipeline, const Names & key_names) {
+        if (pipeline.streams.size() != 1 || !pipeline.streams.front()->isSortedOutput())
+            return false;
+        const auto & description = pipeline.streams.front()->getSortDescription();
+        if (description.size() < key_names.size())
+            return false;
+        for (size_t i = 0; i < key_names.size(); ++i)
+        {
+            if (description[i].column_name != key_names[i] || description[i].direction != 1 || description[i].collator != nullptr)
+                return false;
+        }
+        return true;
+    };
+    if (original_probe_key_names.empty()
+        || !is_sorted_by_keys(probe_pipeline, original_probe_key_names)
+        || !is_sorted_by_keys(build_pipeline, original_build_key_names))
+        return false;
+
+    /// The keys are compared by the types after the prepare actions, so the order is kept only if no cast is applied.
+    const Block & probe_header = probe_pipeline.streams.front()->getHeader();
+    const Block & build_header = build_pipeline.streams.front()->getHeader();
+    const Block & prepared_probe_header = probe_side_prepare_actions->getSampleBlock();
+    const Block & prepared_build_header = build_side_prepare_actions->getSampleBlock();
+    const auto & probe_key_names = join_ptr->getLeftJoinKeys();
+    const auto & build_key_names = join_ptr->getRightJoinKeys();
+    for (size_t i = 0; i < probe_key_names.size(); ++i)
+    {
+        const auto & probe_key_type = prepared_probe_header.getByName(probe_key_names[i]).type;
+        const auto & build_key_type = prepared_build_header.getByName(build_key_names[i]).type;
+        if (probe_key_type->isNullable()
+            || !probe_key_type->equals(*build_key_type)
+            || !probe_key_type->equals(*probe_header.getByName(original_probe_key_names[i]).type)
+            || !build_key_type->equals(*build_header.getByName(original_build_key_names[i]).type))
+            return false;
+    }
+    return true;
+}
+
+void PhysicalJoin::mergeJoinTransform(DAGPipeline & probe_pipeline, DAGPipeline & build_pipeline, Context & context)
+{
+    const auto & settings = context.getSettingsRef();
+    executeExpression(probe_pipeline, probe_side_prepare_actions, log, "append join key for probe side");
+    executeExpression(build_pipeline, build_side_prepare_actions, log, "append join key for build side");
+
+    /// The build side is read by the merge join directly, record it for the execution summaries as the hash join does.
+    auto & join_execute_info = context.getDAGContext()->getJoinExecuteInfoMap()[execId()];
+    join_execute_info.build_side_root_executor_id = build()->execId();
+    join_execute_info.join_ptr = join_ptr;
+    join_execute_info.join_build_streams.push_back(build_pipeline.firstStream());
+
+    probe_pipeline.firstStream() = std::make_shared<MergeJoinBlockInputStream>(
+        probe_pipeline.firstStream(),
+        build_pipeline.firstStream(),
+        join_ptr->getKind(),
+        join_ptr->getLeftJoinKeys(),
+        join_ptr->getRightJoinKeys(),
+        settings.max_block_size,
+        log->identifier());
+    probe_pipeline.firstStream()->setExtraInfo(fmt::format("merge join, join_executor_id = {}", execId()));
+}
+
 void PhysicalJoin::buildBlockInputStreamImpl(DAGPipeline & pipeline, Context & context, size_t max_streams)
 {
+    DAGPipeline & probe_pipeline = pipeline;
+    /// Both sides may be sorted, so the probe side is built before the build side is transformed to check
+    /// whether the merge join can be used.
+    if (!original_probe_key_names.empty())
+    {
+        DAGPipeline build_pipeline;
+        build()->buildBlockInputStream(build_pipeline, context, max_streams);
+        probe()->buildBlockInputStream(probe_pipeline, context, max_streams);
+        if (canMergeJoin(probe_pipeline, build_pipeline))
+        {
+            mergeJoinTransform(probe_pipeline, build_pipeline, context);
+        }
+        else
+        {
+            buildSideTransform(build_pipeline, context, max_streams);
+            probeSideTransform(probe_pipeline, context);
+        }
+        doSchemaProject(pipeline);
+        return;
+    }
+
     /// The build side needs to be transformed first.
     {
         DAGPipeline build_pipeline;
@@ -221,7 +339,6 @@ void PhysicalJoin::buildBlockInputStreamImpl(DAGPipeline & pipeline, Context & c
     }
 
     {
-        DAGPipeline & probe_pipeline = pipeline;
         probe()->buildBlockInputStream(probe_pipeline, context, max_streams);
         probeSideTransform(probe_pipeline, context);
     }
@@ -43,12 +43,16 @@ public:
         const JoinPtr & join_ptr_,
         const ExpressionActionsPtr & probe_side_prepare_actions_,
         const ExpressionActionsPtr & build_side_prepare_actions_,
-        const Block & sample_block_)
+        const Block & sample_block_,
+        const Names & original_probe_key_names_ = {},
+        const Names & original_build_key_names_ = {})
         : PhysicalBinary(executor_id_, PlanType::Join, schema_, fine_grained_shuffle_, req_id, probe_, build_)
         , join_ptr(join_ptr_)
         , probe_side_prepare_actions(probe_side_prepare_actions_)
         , build_side_prepare_actions(build_side_prepare_actions_)
         , sample_block(sample_block_)
+        , original_probe_key_names(original_probe_key_names_)
+        , original_build_key_names(original_build_key_names_)
     {}
 
     void buildPipeline(
@@ -65,6 +69,11 @@ private:
 
     void buildSideTransform(DAGPipeline & build_pipeline, Context & context, size_t max_streams);
 
+    /// Whether both sides are single streams sorted by the join keys, so the merge join can be used.
+    bool canMergeJoin(const DAGPipeline & probe_pipeline, const DAGPipeline & build_pipeline) const;
+
+    void mergeJoinTransform(DAGPipeline & probe_pipeline, DAGPipeline & build_pipeline, Context & context);
+
     void doSchemaProject(DAGPipeline & pipeline);
 
     void buildBlockInputStreamImpl(DAGPipeline & pipeline, Context & context, size_t max_streams) override;
@@ -80,5 +89,9 @@ private:
     ExpressionActionsPtr build_side_prepare_actions;
 
     Block sample_block;
+
+    /// The join keys in the input of both sides, which are not empty only if the join is supported by the merge join.
+    Names original_probe_key_names;
+    Names original_build_key_names;
 };
 } // namespace DB
@@ -61,6 +61,8 @@ public:
 
     Int64 getLogicalTableID() const;
 
+    bool keepOrder() const { return keep_order; }
+
     void updateStreams(Context & context);
 
     // generate sourceOps in compile time
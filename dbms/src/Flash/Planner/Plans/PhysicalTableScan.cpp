@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Flash/Coprocessor/AggregationInterpreterHelper.h>
 #include <Flash/Coprocessor/ChunkCodec.h>
 #include <Flash/Coprocessor/DAGPipeline.h>
 #include <Flash/Coprocessor/DAGStorageInterpreter.h>
@@ -77,12 +78,24 @@ void PhysicalTableScan::buildPipeline(
     Context & context,
     PipelineExecutorStatus & exec_status)
 {
-    storage_interpreter = std::make_unique<DAGStorageInterpreter>(
-        context,
-        tidb_table_scan,
-        filter_conditions,
-        context.getMaxStreams());
-    source_ops = storage_interpreter->execute(exec_status);
+    if (context.getSharedContextDisagg()->isDisaggregatedComputeMode())
+    {
+        disaggregated_interpreter = std::make_unique<StorageDisaggregatedInterpreter>(
+            context,
+            tidb_table_scan,
+            filter_conditions,
+            context.getMaxStreams());
+        source_ops = disaggregated_interpreter->execute(exec_status);
+    }
+    else
+    {
+        storage_interpreter = std::make_unique<DAGStorageInterpreter>(
+            context,
+            tidb_table_scan,
+            filter_conditions,
+            context.getMaxStreams());
+        source_ops = storage_interpreter->execute(exec_status);
+    }
     PhysicalPlanNode::buildPipeline(builder, context, exec_status);
 }
 
@@ -97,8 +110,16 @@ void PhysicalTableScan::buildPipelineExecGroup(
     group_builder.transform([&](auto & builder) {
         builder.setSourceOp(std::move(source_ops[i++]));
     });
-    storage_interpreter->executeSuffix(exec_status, group_builder);
-    buildProjection(exec_status, group_builder, storage_interpreter->analyzer->getCurrentInputColumns());
+    if (disaggregated_interpreter)
+    {
+        disaggregated_interpreter->executeSuffix(exec_status, group_builder);
+        buildProjection(exec_status, group_builder, disaggregated_interpreter->analyzer->getCurrentInputColumns());
+    }
+    else
+    {
+        storage_interpreter->executeSuffix(exec_status, group_builder);
+        buildProjection(exec_status, group_builder, storage_interpreter->analyzer->getCurrentInputColumns());
+    }
 }
 
 void PhysicalTableScan::buildProjection(DAGPipeline & pipeline, const NamesAndTypes & storage_schema)
@@ -152,6 +173,21 @@ bool PhysicalTableScan::hasFilterConditions() const
     return filter_conditions.hasValue();
 }
 
+void PhysicalTableScan::setAggregation(const tipb::Aggregation & aggregation)
+{
+    if (!hasFilterConditions()
+        && tidb_table_scan.getPushedDownFilters().empty()
+        && AggregationInterpreterHelper::canAggregateFromPackStats(aggregation, tidb_table_scan.getColumns()))
+        tidb_table_scan.setAggregationFromPackStats();
+}
+
+TopNThresholdPtr PhysicalTableScan::setTopN(const tipb::TopN & top_n, const Context & context)
+{
+    auto topn_threshold = buildTopNThreshold(top_n, tidb_table_scan.getColumns(), context);
+    tidb_table_scan.setTopNThreshold(topn_threshold);
+    return topn_threshold;
+}
+
 const String & PhysicalTableScan::getFilterConditionsId() const
 {
     assert(hasFilterConditions());
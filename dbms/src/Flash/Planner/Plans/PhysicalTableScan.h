@@ -16,6 +16,7 @@
 
 #include <Flash/Coprocessor/DAGStorageInterpreter.h>
 #include <Flash/Coprocessor/FilterConditions.h>
+#include <Flash/Coprocessor/StorageDisaggregatedInterpreter.h>
 #include <Flash/Coprocessor/TiDBTableScan.h>
 #include <Flash/Planner/Plans/PhysicalLeaf.h>
 #include <Operators/SourceOp_fwd.h>
@@ -49,6 +50,16 @@ public:
 
     const String & getFilterConditionsId() const;
 
+    bool keepOrder() const { return tidb_table_scan.keepOrder(); }
+
+    // Let the storage answer the fully visible packs from the pack statistics if the
+    // aggregation directly on this table scan only needs the count and min/max values.
+    void setAggregation(const tipb::Aggregation & aggregation);
+
+    // Let the storage skip the packs that can not beat the threshold of the TopN directly on this table scan.
+    // Returns the threshold to be published by the TopN, or nullptr if the packs can not be skipped.
+    TopNThresholdPtr setTopN(const tipb::TopN & top_n, const Context & context);
+
     void buildPipelineExecGroup(
         PipelineExecutorStatus & exec_status,
         PipelineExecGroupBuilder & group_builder,
@@ -76,6 +87,8 @@ private:
     TiDBTableScan tidb_table_scan;
 
     std::unique_ptr<DAGStorageInterpreter> storage_interpreter;
+    // Used instead of `storage_interpreter` in disaggregated compute mode.
+    std::unique_ptr<StorageDisaggregatedInterpreter> disaggregated_interpreter;
 
     Block sample_block;
 
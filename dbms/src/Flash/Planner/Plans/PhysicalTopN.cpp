@@ -31,6 +31,7 @@ PhysicalPlanNodePtr PhysicalTopN::build(
     const String & executor_id,
     const LoggerPtr & log,
     const tipb::TopN & top_n,
+    const TopNThresholdPtr & topn_threshold,
     const PhysicalPlanNodePtr & child)
 {
     assert(child);
@@ -55,7 +56,8 @@ PhysicalPlanNodePtr PhysicalTopN::build(
         child,
         order_descr,
         before_sort_actions,
-        top_n.limit());
+        top_n.limit(),
+        topn_threshold);
     return physical_top_n;
 }
 
@@ -65,7 +67,7 @@ void PhysicalTopN::buildBlockInputStreamImpl(DAGPipeline & pipeline, Context & c
 
     executeExpression(pipeline, before_sort_actions, log, "before TopN");
 
-    orderStreams(pipeline, max_streams, order_descr, limit, false, context, log);
+    orderStreams(pipeline, max_streams, order_descr, limit, false, context, log, topn_threshold);
 }
 
 void PhysicalTopN::buildPipelineExecGroup(
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Core/SortDescription.h>
+#include <DataStreams/TopNThreshold.h>
 #include <Flash/Planner/Plans/PhysicalUnary.h>
 #include <Interpreters/ExpressionActions.h>
 #include <tipb/executor.pb.h>
@@ -29,6 +30,7 @@ public:
         const String & executor_id,
         const LoggerPtr & log,
         const tipb::TopN & top_n,
+        const TopNThresholdPtr & topn_threshold,
         const PhysicalPlanNodePtr & child);
 
     PhysicalTopN(
@@ -39,11 +41,13 @@ public:
         const PhysicalPlanNodePtr & child_,
         const SortDescription & order_descr_,
         const ExpressionActionsPtr & before_sort_actions_,
-        size_t limit_)
+        size_t limit_,
+        const TopNThresholdPtr & topn_threshold_ = nullptr)
         : PhysicalUnary(executor_id_, PlanType::TopN, schema_, fine_grained_shuffle_, req_id, child_)
         , order_descr(order_descr_)
         , before_sort_actions(before_sort_actions_)
         , limit(limit_)
+        , topn_threshold(topn_threshold_)
     {}
 
     void finalize(const Names & parent_require) override;
@@ -62,5 +66,6 @@ private:
     SortDescription order_descr;
     ExpressionActionsPtr before_sort_actions;
     size_t limit;
+    TopNThresholdPtr topn_threshold;
 };
 } // namespace DB
@@ -188,7 +188,7 @@ try
         /*expected_streams=*/R"(
 Expression: <final projection>
  MergeSorting, limit = 1
-  PartialSorting: limit = 1
+  TopN: limit = 1
    MockExchangeReceiver)",
         {toNullableVec<String>({{}}),
          toNullableVec<String>({{}})});
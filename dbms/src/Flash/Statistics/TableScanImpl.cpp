@@ -33,6 +33,8 @@ void TableScanStatistics::appendExtraJson(FmtBuffer & fmt_buffer) const
         R"("connection_details":[{},{}])",
         local_table_scan_detail.toJson(),
         remote_table_scan_detail.toJson());
+    if (auto it = dag_context.scan_context_map.find(executor_id); it != dag_context.scan_context_map.end())
+        fmt_buffer.fmtAppend(R"(,"scan_context":"{}")", it->second->toString());
 }
 
 void TableScanStatistics::collectExtraRuntimeDetail()
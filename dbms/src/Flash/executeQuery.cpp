@@ -30,6 +30,7 @@
 #include <Interpreters/Quota.h>
 #include <Interpreters/SharedContexts/Disagg.h>
 #include <Interpreters/executeQuery.h>
+#include <Storages/S3/S3Common.h>
 
 namespace ProfileEvents
 {
@@ -158,6 +159,16 @@ QueryExecutorPtr executeAsBlockIO(Context & context, bool internal)
         return doExecuteAsBlockIO(dag, context, internal);
     }
 }
+
+bool isPipelineSupportedByStorage(const Context & context)
+{
+    const auto & disagg = context.getSharedContextDisagg();
+    if (disagg->notDisaggregatedMode())
+        return true;
+    // The compute node reads from the remote storage through `RNRemoteSegmentSourceOp`,
+    // fetching the data by MPP exchange from the write nodes is not supported.
+    return disagg->isDisaggregatedComputeMode() && S3::ClientFactory::instance().isEnabled();
+}
 } // namespace
 
 QueryExecutorPtr queryExecute(Context & context, bool internal)
@@ -165,7 +176,7 @@ QueryExecutorPtr queryExecute(Context & context, bool internal)
     // now only support pipeline model in test mode.
     if (context.getSettingsRef().enable_planner
         && context.getSettingsRef().enable_pipeline
-        && context.getSharedContextDisagg()->notDisaggregatedMode())
+        && isPipelineSupportedByStorage(context))
     {
         if (auto res = executeAsPipeline(context, internal); res)
             return std::move(*res);
@@ -12,12 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Flash/Mpp/HashBaseWriterHelper.h>
 #include <Flash/tests/bench_exchange.h>
 #include <fmt/core.h>
 
 #include <Flash/Mpp/ExchangeReceiver.cpp> // to include the implementation of ExchangeReceiver
 #include <Flash/Mpp/FineGrainedShuffleWriter.cpp> // to include the implementation of FineGrainedShuffleWriter
-#include <Flash/Mpp/HashParitionWriter.cpp> // to include the implementation of HashParitionWriter
+#include <Flash/Mpp/HashPartitionWriter.cpp> // to include the implementation of HashPartitionWriter
 #include <Flash/Mpp/MPPTunnel.cpp> // to include the implementation of MPPTunnel
 #include <Flash/Mpp/MPPTunnelSet.cpp> // to include the implementation of MPPTunnelSet
 #include <atomic>
@@ -450,6 +451,43 @@ BENCHMARK_REGISTER_F(ExchangeBench, basic_send_receive)
     ->Args({8, 1, 1024 * 1000, 8, 10000})
     ->Args({8, 1, 1024 * 1000, 8, 100000});
 
+BENCHMARK_DEFINE_F(ExchangeBench, scatter_columns)
+(benchmark::State & state)
+try
+{
+    const uint32_t part_num = state.range(0);
+    const bool use_radix_partition = state.range(1);
+    const int row_num = state.range(2);
+    // Scatter to `part_num` buckets like HashPartitionWriter/FineGrainedShuffleWriter.
+    const std::vector<Int64> partition_col_ids{0};
+    const TiDB::TiDBCollators collators{nullptr};
+    std::vector<String> partition_key_containers(collators.size());
+    auto blocks = makeBlocks(/*block_num=*/10, row_num);
+
+    for (auto _ : state)
+    {
+        for (const auto & block : blocks)
+        {
+            auto dest_tbl_cols = HashBaseWriterHelper::createDestColumns(block, part_num);
+            HashBaseWriterHelper::scatterColumns(block, partition_col_ids, collators, partition_key_containers, part_num, dest_tbl_cols, use_radix_partition);
+            benchmark::DoNotOptimize(dest_tbl_cols);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * blocks.size() * row_num);
+}
+CATCH
+BENCHMARK_REGISTER_F(ExchangeBench, scatter_columns)
+    ->Args({4, 0, 8192})
+    ->Args({4, 1, 8192})
+    ->Args({16, 0, 8192})
+    ->Args({16, 1, 8192})
+    ->Args({64, 0, 8192})
+    ->Args({64, 1, 8192})
+    ->Args({256, 0, 65536})
+    ->Args({256, 1, 65536})
+    ->Args({1024, 0, 65536})
+    ->Args({1024, 1, 65536});
+
 
 } // namespace tests
 } // namespace DB
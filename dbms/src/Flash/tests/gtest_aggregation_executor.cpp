@@ -12,12 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/FieldVisitors.h>
 #include <Core/BlockUtils.h>
 #include <Interpreters/Context.h>
 #include <TestUtils/ColumnGenerator.h>
 #include <TestUtils/ExecutorTestUtils.h>
 #include <TestUtils/mockExecutor.h>
 
+#include <map>
+
 namespace DB
 {
 namespace tests
@@ -730,6 +733,179 @@ try
 }
 CATCH
 
+TEST_F(AggExecutorTestRunner, PartitionedAggregation)
+try
+{
+    /// prepare data, the blocks must be large enough to be partitioned
+    size_t unique_rows = 10000;
+    DB::MockColumnInfoVec table_column_infos{{"key_32", TiDB::TP::TypeLong, false}, {"key_64", TiDB::TP::TypeLongLong, false}, {"key_string", TiDB::TP::TypeString, false}, {"value", TiDB::TP::TypeLong, false}};
+    ColumnsWithTypeAndName table_column_data;
+    for (const auto & column_info : mockColumnInfosToTiDBColumnInfos(table_column_infos))
+    {
+        ColumnGeneratorOpts opts{unique_rows, getDataTypeByColumnInfoForComputingLayer(column_info)->getName(), RANDOM, column_info.name};
+        table_column_data.push_back(ColumnGenerator::instance().generate(opts));
+    }
+    for (auto & table_column : table_column_data)
+    {
+        table_column.column->assumeMutable()->insertRangeFrom(*table_column.column, 0, unique_rows / 2);
+    }
+    ColumnWithTypeAndName shuffle_column = ColumnGenerator::instance().generate({unique_rows + unique_rows / 2, "UInt64", RANDOM});
+    IColumn::Permutation perm;
+    shuffle_column.column->getPermutation(false, 0, -1, perm);
+    for (auto & column : table_column_data)
+    {
+        column.column = column.column->permute(perm, 0);
+    }
+
+    context.addMockTable("test_db", "agg_table_for_partition", table_column_infos, table_column_data);
+
+    std::vector<std::vector<String>> group_by_keys{
+        {"key_32"},
+        {"key_64"},
+        {"key_string"},
+        /// fixed keys
+        {"key_32", "key_64"},
+        /// serialized keys, which are not partitioned
+        {"key_64", "key_string"},
+    };
+    context.context->setSetting("max_block_size", Field(static_cast<UInt64>(4096)));
+    for (const auto & keys : group_by_keys)
+    {
+        MockAstVec key_vec;
+        for (const auto & key : keys)
+            key_vec.push_back(col(key));
+        auto request = context
+                           .scan("test_db", "agg_table_for_partition")
+                           .aggregation({Max(col("value")), Count(col("value"))}, key_vec)
+                           .build(context);
+        context.context->setSetting("group_by_partition_threshold", Field(static_cast<UInt64>(0)));
+        auto reference = executeStreams(request, 1);
+        /// partition all the blocks after the first one
+        context.context->setSetting("group_by_partition_threshold", Field(static_cast<UInt64>(1)));
+        executeAndAssertColumnsEqual(request, reference);
+    }
+}
+CATCH
+
+TEST_F(AggExecutorTestRunner, AdaptivePreAggregation)
+try
+{
+    /// prepare data, each key appears in about two rows, so the partial aggregation hardly reduces the rows
+    size_t rows = 10000;
+    DB::MockColumnInfoVec table_column_infos{{"key", TiDB::TP::TypeLongLong, false}, {"value", TiDB::TP::TypeLong, false}};
+    std::vector<Int64> keys(rows);
+    std::vector<Int32> values(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        keys[i] = (i * 7919) % (rows / 2);
+        values[i] = static_cast<Int32>(i);
+    }
+    context.addMockTable("test_db", "agg_table_for_pre_agg", table_column_infos, {toVec<Int64>("key", keys), toVec<Int32>("value", values)});
+
+    auto request = context
+                       .scan("test_db", "agg_table_for_pre_agg")
+                       .aggregation({Max(col("value")), Count(col("value"))}, {col("key")})
+                       .build(context);
+    /// only the partial aggregation is pre-aggregated adaptively
+    auto * aggregation = request->mutable_root_executor()->mutable_aggregation();
+    for (auto & agg_func : *aggregation->mutable_agg_func())
+        agg_func.set_aggfuncmode(tipb::AggFunctionMode::Partial1Mode);
+
+    /// the partial results of the same key are merged as the final aggregation does
+    auto merge_partial_results = [](const ColumnsWithTypeAndName & columns) {
+        std::map<String, std::pair<Field, UInt64>> merged;
+        for (size_t i = 0; i < columns[0].column->size(); ++i)
+        {
+            auto key = applyVisitor(FieldVisitorToString(), (*columns[2].column)[i]);
+            auto max_value = (*columns[0].column)[i];
+            auto count = (*columns[1].column)[i].get<UInt64>();
+            auto [it, inserted] = merged.try_emplace(key, max_value, count);
+            if (!inserted)
+            {
+                if (applyVisitor(FieldVisitorAccurateLess(), it->second.first, max_value))
+                    it->second.first = max_value;
+                it->second.second += count;
+            }
+        }
+        return merged;
+    };
+
+    context.context->setSetting("max_block_size", Field(static_cast<UInt64>(1024)));
+    context.context->setSetting("enable_adaptive_pre_aggregation", Field(static_cast<UInt64>(0)));
+    auto reference = merge_partial_results(executeStreams(request, 1));
+    ASSERT_EQ(reference.size(), rows / 2);
+
+    context.context->setSetting("enable_adaptive_pre_aggregation", Field(static_cast<UInt64>(1)));
+    std::vector<std::pair<UInt64, double>> sample_rows_and_ratios{
+        /// pass through all the rows after the first block
+        {1, 0.0},
+        /// never pass through
+        {1, 2.0},
+        /// pass through after sampling a few blocks
+        {4096, 0.4},
+    };
+    for (const auto & [sample_rows, ratio] : sample_rows_and_ratios)
+    {
+        context.context->setSetting("pre_aggregation_sample_rows", Field(sample_rows));
+        context.context->setSetting("pre_aggregation_pass_through_ratio", Field(ratio));
+        for (size_t concurrency : {1, 4})
+            ASSERT_EQ(merge_partial_results(executeStreams(request, concurrency)), reference);
+    }
+    context.context->setSetting("enable_adaptive_pre_aggregation", Field(static_cast<UInt64>(0)));
+}
+CATCH
+
+TEST_F(AggExecutorTestRunner, CountDistinctRewrite)
+try
+{
+    /// the rewrite needs the distinct values to be grouped with collation
+    context.context->setSetting("group_by_collation_sensitive", Field(static_cast<UInt64>(1)));
+
+    /// select count(distinct string_) from test_db.types;
+    std::vector<std::pair<Int64, UInt64>> collator_and_expects{{TiDB::ITiDBCollator::UTF8MB4_BIN, 4}, {TiDB::ITiDBCollator::UTF8MB4_GENERAL_CI, 2}};
+    for (const auto & [collator_id, expect] : collator_and_expects)
+    {
+        context.setCollation(collator_id);
+        auto request = context
+                           .scan(db_name, table_types)
+                           .aggregation({CountDistinct(col(types_col_name[10]))}, {})
+                           .build(context);
+        for (UInt64 enable_rewrite : {0, 1})
+        {
+            context.context->setSetting("enable_count_distinct_rewrite", Field(enable_rewrite));
+            executeAndAssertColumnsEqual(request, {toVec<UInt64>("count(distinct string_)", ColumnWithUInt64{expect})});
+        }
+    }
+
+    /// select count(distinct bigint_) from test_db.types group by tinyint_;
+    /// select count(distinct string_) from test_db.types group by int_;
+    /// select count(distinct string_) from test_db.types group by int_, bigint_;
+    std::vector<std::pair<ASTPtr, MockAstVec>> aggs_and_keys{
+        {CountDistinct(col(types_col_name[5])), {col(types_col_name[2])}},
+        {CountDistinct(col(types_col_name[10])), {col(types_col_name[4])}},
+        {CountDistinct(col(types_col_name[10])), {col(types_col_name[4]), col(types_col_name[5])}},
+    };
+    for (const auto & [collator_id, expect] : collator_and_expects)
+    {
+        context.setCollation(collator_id);
+        for (const auto & [agg, keys] : aggs_and_keys)
+        {
+            auto request = context
+                               .scan(db_name, table_types)
+                               .aggregation({agg}, keys)
+                               .build(context);
+            context.context->setSetting("enable_count_distinct_rewrite", Field(static_cast<UInt64>(0)));
+            auto reference = executeStreams(request, 1);
+            context.context->setSetting("enable_count_distinct_rewrite", Field(static_cast<UInt64>(1)));
+            executeAndAssertColumnsEqual(request, reference);
+        }
+    }
+
+    context.setCollation(TiDB::ITiDBCollator::UTF8MB4_BIN);
+    context.context->setSetting("group_by_collation_sensitive", Field(static_cast<UInt64>(0)));
+}
+CATCH
+
 TEST_F(AggExecutorTestRunner, Empty)
 try
 {
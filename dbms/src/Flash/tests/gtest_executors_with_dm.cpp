@@ -13,9 +13,12 @@
 // limitations under the License.
 
 #include <Debug/MockStorage.h>
+#include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/executeQuery.h>
 #include <Interpreters/Context.h>
 #include <TestUtils/ExecutorTestUtils.h>
 #include <TestUtils/InputStreamTestUtils.h>
+#include <TestUtils/TiFlashTestEnv.h>
 #include <TestUtils/mockExecutor.h>
 
 namespace DB
@@ -86,6 +89,27 @@ public:
             {"test_db", "empty_table"},
             {{"col0", TiDB::TP::TypeLongLong}},
             {toVec<Int32>("col0", {})});
+
+        // The pk is not nullable, so that the merge join can be used.
+        context.addMockDeltaMerge(
+            {"test_db", "l_table"},
+            {{"k", TiDB::TP::TypeLongLong, false},
+             {"v", TiDB::TP::TypeString}},
+            {toVec<Int64>("k", {0, 1, 2, 3, 4, 5, 6, 7}),
+             toNullableVec<String>("v", {"l0", "l1", "l2", "l3", "l4", "l5", "l6", "l7"})});
+        context.addMockDeltaMerge(
+            {"test_db", "r_table"},
+            {{"k", TiDB::TP::TypeLongLong, false},
+             {"v", TiDB::TP::TypeString}},
+            {toVec<Int64>("k", {1, 3, 5, 7, 9}),
+             toNullableVec<String>("v", {"r1", "r3", "r5", "r7", "r9"})});
+    }
+
+    String getStreamsString(const std::shared_ptr<tipb::DAGRequest> & request)
+    {
+        DAGContext dag_context(*request, "executors_with_dm_test", 1);
+        TiFlashTestEnv::setUpTestContext(*context.context, &dag_context, context.mockStorage(), TestType::EXECUTOR_TEST);
+        return queryExecute(*context.context, /*internal=*/true)->toString();
     }
 
     ColumnWithInt64 col_id{1, 2, 3, 4, 5, 6, 7, 8, 9};
@@ -194,5 +218,48 @@ try
 }
 CATCH
 
+TEST_F(ExecutorsWithDMTestRunner, MergeJoin)
+try
+{
+    enablePlanner(true);
+    for (auto [enable_merge_join, keep_order] : std::vector<std::pair<bool, bool>>{{false, true}, {true, false}, {true, true}})
+    {
+        context.context->setSetting("enable_merge_join", Field(static_cast<UInt64>(enable_merge_join)));
+        for (auto join_type : {tipb::JoinType::TypeInnerJoin, tipb::JoinType::TypeLeftOuterJoin})
+        {
+            auto request = context
+                               .scan("test_db", "l_table", keep_order)
+                               .join(context.scan("test_db", "r_table", keep_order), join_type, {col("k")})
+                               .build(context);
+
+            // Both sides are single streams sorted by the pk only if the order is kept.
+            const bool use_merge_join = enable_merge_join && keep_order;
+            auto streams = getStreamsString(request);
+            ASSERT_EQ(use_merge_join, streams.find("MergeJoin") != String::npos) << streams;
+            ASSERT_EQ(!use_merge_join, streams.find("HashJoinProbe") != String::npos) << streams;
+
+            if (join_type == tipb::JoinType::TypeInnerJoin)
+            {
+                executeAndAssertColumnsEqual(
+                    request,
+                    {toVec<Int64>({1, 3, 5, 7}),
+                     toNullableVec<String>({"l1", "l3", "l5", "l7"}),
+                     toVec<Int64>({1, 3, 5, 7}),
+                     toNullableVec<String>({"r1", "r3", "r5", "r7"})});
+            }
+            else
+            {
+                executeAndAssertColumnsEqual(
+                    request,
+                    {toVec<Int64>({0, 1, 2, 3, 4, 5, 6, 7}),
+                     toNullableVec<String>({"l0", "l1", "l2", "l3", "l4", "l5", "l6", "l7"}),
+                     toNullableVec<Int64>({{}, 1, {}, 3, {}, 5, {}, 7}),
+                     toNullableVec<String>({{}, "r1", {}, "r3", {}, "r5", {}, "r7"})});
+            }
+        }
+    }
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
@@ -725,6 +725,47 @@ try
 }
 CATCH
 
+TEST_F(JoinExecutorTestRunner, CrossJoinWithRangeCondition)
+try
+{
+    context.addMockTable("range_join", "t1", {{"id", TiDB::TP::TypeLong}, {"ts", TiDB::TP::TypeLong}}, {toNullableVec<Int32>("id", {1, 2, 3, 4, 5}), toNullableVec<Int32>("ts", {1, 5, {}, 10, 3})});
+    context.addMockTable("range_join", "t2", {{"s", TiDB::TP::TypeLong}, {"e", TiDB::TP::TypeLong}}, {toNullableVec<Int32>("s", {0, 4, 2, {}, 9}), toNullableVec<Int32>("e", {3, 6, 10, 5, 20})});
+
+    /// t1.ts > t2.s and t1.ts < t2.e, written with the probe column on both sides of the comparisons.
+    const std::vector<MockAstVec> other_conds{
+        {gt(col("ts"), col("s")), lt(col("ts"), col("e"))},
+        {lt(col("s"), col("ts")), gt(col("e"), col("ts"))},
+    };
+    const ColumnsWithTypeAndName inner_expected{
+        toNullableVec<Int32>({1, 2, 2, 4, 5}),
+        toNullableVec<Int32>({1, 5, 5, 10, 3}),
+        toNullableVec<Int32>({0, 4, 2, 9, 2}),
+        toNullableVec<Int32>({3, 6, 10, 20, 10})};
+    const ColumnsWithTypeAndName left_expected{
+        toNullableVec<Int32>({1, 2, 2, 3, 4, 5}),
+        toNullableVec<Int32>({1, 5, 5, {}, 10, 3}),
+        toNullableVec<Int32>({0, 4, 2, {}, 9, 2}),
+        toNullableVec<Int32>({3, 6, 10, {}, 20, 10})};
+
+    for (bool enable_range_join : {true, false})
+    {
+        context.context->setSetting("enable_range_join", Field(static_cast<UInt64>(enable_range_join)));
+        for (const auto & conds : other_conds)
+        {
+            auto request = context.scan("range_join", "t1")
+                               .join(context.scan("range_join", "t2"), tipb::JoinType::TypeInnerJoin, {}, {}, {}, conds, {})
+                               .build(context);
+            executeAndAssertColumnsEqual(request, inner_expected);
+
+            request = context.scan("range_join", "t1")
+                          .join(context.scan("range_join", "t2"), tipb::JoinType::TypeLeftOuterJoin, {}, {}, {}, conds, {})
+                          .build(context);
+            executeAndAssertColumnsEqual(request, left_expected);
+        }
+    }
+}
+CATCH
+
 TEST_F(JoinExecutorTestRunner, JoinWithTableScan)
 try
 {
@@ -69,7 +69,7 @@ try
         "MockExchangeSender\n"
         " Expression: <final projection>\n"
         "  MergeSorting, limit = 10\n"
-        "   PartialSorting: limit = 10\n"
+        "   TopN: limit = 10\n"
         "    Expression: <before TopN>\n"
         "     Filter\n"
         "      Expression: <expr after aggregation>\n"
@@ -122,7 +122,7 @@ try
         " MockExchangeSender\n"
         "  Expression: <final projection>\n"
         "   MergeSorting, limit = 2\n"
-        "    PartialSorting: limit = 2\n"
+        "    TopN: limit = 2\n"
         "     Expression: <remove useless column after join>\n"
         "      HashJoinProbe: <join probe, join_executor_id = Join_2, scan_hash_map_after_probe = false>\n"
         "       Expression: <final projection>\n"
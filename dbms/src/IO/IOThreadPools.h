@@ -38,6 +38,10 @@ struct RNPreparerTrait
 {
 };
 
+struct SegmentRewriteTrait
+{
+};
+
 } // namespace io_pool_details
 
 // TODO: Move these out.
@@ -45,4 +49,6 @@ using DataStoreS3Pool = IOThreadPool<io_pool_details::DataStoreS3Trait>;
 using S3FileCachePool = IOThreadPool<io_pool_details::S3FileCacheTrait>;
 using RNRemoteReadTaskPool = IOThreadPool<io_pool_details::RemoteReadTaskTrait>;
 using RNPagePreparerPool = IOThreadPool<io_pool_details::RNPreparerTrait>;
+// Rewrite the key ranges of a segment concurrently in merge delta and physical split.
+using SegmentRewritePool = IOThreadPool<io_pool_details::SegmentRewriteTrait>;
 } // namespace DB
@@ -25,6 +25,7 @@
 
 #include <array>
 #include <cassert>
+#include <ext/scope_guard.h>
 
 namespace DB
 {
@@ -571,6 +572,26 @@ void Aggregator::createAggregateStates(AggregateDataPtr & aggregate_data) const
 }
 
 
+namespace
+{
+/// Partitioning a small block costs more than it saves, since only a few rows fall into each bucket.
+constexpr size_t min_rows_to_partition = 4096;
+
+/// Whether the rows can be partitioned by the buckets of the two-level hash table before being aggregated.
+/// The keys must be hashed without being emplaced, so the methods that serialize the keys into the arena are excluded.
+template <typename Method>
+constexpr bool canPartitionRows()
+{
+    if constexpr (!requires { Method::Data::NUM_BUCKETS; })
+        return false;
+    else
+    {
+        using KeyHolder = decltype(std::declval<typename Method::State &>().getKeyHolder(0, nullptr, std::declval<std::vector<String> &>()));
+        return !std::is_same_v<std::decay_t<KeyHolder>, SerializedKeyHolder>;
+    }
+}
+} // namespace
+
 /** It's interesting - if you remove `noinline`, then gcc for some reason will inline this function, and the performance decreases (~ 10%).
   * (Probably because after the inline of this function, more internal functions no longer be inlined.)
   * Inline does not make sense, since the inner loop is entirely inside this function.
@@ -582,11 +603,12 @@ void NO_INLINE Aggregator::executeImpl(
     size_t rows,
     ColumnRawPtrs & key_columns,
     TiDB::TiDBCollators & collators,
-    AggregateFunctionInstruction * aggregate_instructions) const
+    AggregateFunctionInstruction * aggregate_instructions,
+    bool partitioned) const
 {
     typename Method::State state(key_columns, key_sizes, collators);
 
-    executeImplBatch(method, state, aggregates_pool, rows, aggregate_instructions);
+    executeImplBatch(method, state, aggregates_pool, rows, aggregate_instructions, partitioned);
 }
 
 template <typename Method>
@@ -595,7 +617,8 @@ ALWAYS_INLINE void Aggregator::executeImplBatch(
     typename Method::State & state,
     Arena * aggregates_pool,
     size_t rows,
-    AggregateFunctionInstruction * aggregate_instructions) const
+    AggregateFunctionInstruction * aggregate_instructions,
+    [[maybe_unused]] bool partitioned) const
 {
     std::vector<std::string> sort_key_containers;
     sort_key_containers.resize(params.keys_size, "");
@@ -634,8 +657,7 @@ ALWAYS_INLINE void Aggregator::executeImplBatch(
 
     std::unique_ptr<AggregateDataPtr[]> places(new AggregateDataPtr[rows]);
 
-    for (size_t i = 0; i < rows; ++i)
-    {
+    auto emplace_row = [&](size_t i) {
         AggregateDataPtr aggregate_data = nullptr;
 
         auto emplace_result = state.emplaceKey(method.data, i, *aggregates_pool, sort_key_containers);
@@ -655,6 +677,41 @@ ALWAYS_INLINE void Aggregator::executeImplBatch(
             aggregate_data = emplace_result.getMapped();
 
         places[i] = aggregate_data;
+    };
+
+    bool rows_emplaced = false;
+    if constexpr (canPartitionRows<Method>())
+    {
+        if (partitioned)
+        {
+            /** Emplace the rows bucket by bucket, so that only the hash table of one bucket is accessed at a time.
+              * The rows are partitioned by a counting sort on their buckets, the keys are hashed again when emplaced.
+              */
+            using Data = typename Method::Data;
+            std::vector<UInt16> row_buckets(rows);
+            std::vector<size_t> bucket_offsets(Data::NUM_BUCKETS + 1, 0);
+            for (size_t i = 0; i < rows; ++i)
+            {
+                row_buckets[i] = Data::getBucketFromHash(state.getHash(method.data, i, *aggregates_pool, sort_key_containers));
+                ++bucket_offsets[row_buckets[i] + 1];
+            }
+            for (size_t bucket = 0; bucket < Data::NUM_BUCKETS; ++bucket)
+                bucket_offsets[bucket + 1] += bucket_offsets[bucket];
+
+            std::vector<size_t> partitioned_rows(rows);
+            for (size_t i = 0; i < rows; ++i)
+                partitioned_rows[bucket_offsets[row_buckets[i]]++] = i;
+
+            for (size_t i : partitioned_rows)
+                emplace_row(i);
+            rows_emplaced = true;
+        }
+    }
+
+    if (!rows_emplaced)
+    {
+        for (size_t i = 0; i < rows; ++i)
+            emplace_row(i);
     }
 
     /// Add values to the aggregate functions.
@@ -786,6 +843,10 @@ bool Aggregator::executeOnBlock(
         result.without_key = place;
     }
 
+    /// The hash table is estimated to be too large to stay in cache if it already has many keys.
+    bool partitioned = group_by_partition_threshold && result.isTwoLevel() && num_rows >= min_rows_to_partition
+        && result.size() >= group_by_partition_threshold;
+
     /// We select one of the aggregation methods and call it.
 
     /// For the case when there are no keys (all aggregate into one row).
@@ -795,11 +856,11 @@ bool Aggregator::executeOnBlock(
     }
     else
     {
-#define M(NAME, IS_TWO_LEVEL)                                                                                                                                                                 \
-    case AggregationMethodType(NAME):                                                                                                                                                         \
-    {                                                                                                                                                                                         \
-        executeImpl(*ToAggregationMethodPtr(NAME, result.aggregation_method_impl), result.aggregates_pool, num_rows, key_columns, params.collators, aggregate_functions_instructions.data()); \
-        break;                                                                                                                                                                                \
+#define M(NAME, IS_TWO_LEVEL)                                                                                                                                                                              \
+    case AggregationMethodType(NAME):                                                                                                                                                                      \
+    {                                                                                                                                                                                                      \
+        executeImpl(*ToAggregationMethodPtr(NAME, result.aggregation_method_impl), result.aggregates_pool, num_rows, key_columns, params.collators, aggregate_functions_instructions.data(), partitioned); \
+        break;                                                                                                                                                                                             \
     }
 
         switch (result.type)
@@ -818,9 +879,11 @@ bool Aggregator::executeOnBlock(
     /// worth_convert_to_two_level is set to true if
     /// 1. some other threads already convert to two level
     /// 2. the result size exceeds threshold
+    /// 3. the result size exceeds the threshold of partitioned aggregation, which partitions the rows by the buckets of the two-level hash table
     bool worth_convert_to_two_level
         = use_two_level_hash_table || (group_by_two_level_threshold && result_size >= group_by_two_level_threshold)
-        || (group_by_two_level_threshold_bytes && result_size_bytes >= group_by_two_level_threshold_bytes);
+        || (group_by_two_level_threshold_bytes && result_size_bytes >= group_by_two_level_threshold_bytes)
+        || (group_by_partition_threshold && result_size >= group_by_partition_threshold);
 
     /** Converting to a two-level data structure.
       * It allows you to make, in the subsequent, an effective merge - either economical from memory or parallel.
@@ -840,6 +903,69 @@ bool Aggregator::executeOnBlock(
 }
 
 
+Block Aggregator::passThroughBlock(const Block & block, AggregateColumns & aggregate_columns)
+{
+    RUNTIME_CHECK(params.keys_size > 0);
+
+    Block res = getHeader(/*final=*/true);
+    size_t rows = block.rows();
+    if (rows == 0)
+        return res;
+
+    Columns columns = block.getColumns();
+    for (size_t i = 0; i < params.keys_size; ++i)
+    {
+        ColumnPtr key_column = columns.at(params.keys[i]);
+        if (ColumnPtr converted = key_column->convertToFullColumnIfConst())
+            key_column = converted;
+        res.getByPosition(i).column = key_column;
+    }
+
+    Columns materialized_columns;
+    AggregateFunctionInstructions aggregate_functions_instructions;
+    prepareAggregateInstructions(columns, aggregate_columns, materialized_columns, aggregate_functions_instructions);
+
+    /// The states of each row are allocated in the arena and destroyed once their results are inserted into the columns.
+    auto arena = std::make_shared<Arena>();
+    std::vector<AggregateDataPtr> places(rows, nullptr);
+    SCOPE_EXIT({
+        for (auto & place : places)
+        {
+            if (place)
+            {
+                for (size_t i = 0; i < params.aggregates_size; ++i)
+                    aggregate_functions[i]->destroy(place + offsets_of_aggregate_states[i]);
+            }
+        }
+    });
+    for (auto & place : places)
+    {
+        AggregateDataPtr aggregate_data = arena->alignedAlloc(total_size_of_aggregate_states, align_aggregate_states);
+        createAggregateStates(aggregate_data);
+        place = aggregate_data;
+    }
+
+    for (AggregateFunctionInstruction * inst = aggregate_functions_instructions.data(); inst->that; ++inst)
+        inst->batch_that->addBatch(rows, places.data(), inst->state_offset, inst->batch_arguments, arena.get());
+
+    MutableColumns final_aggregate_columns(params.aggregates_size);
+    for (size_t i = 0; i < params.aggregates_size; ++i)
+    {
+        final_aggregate_columns[i] = res.getByPosition(params.keys_size + i).type->createColumn();
+        final_aggregate_columns[i]->reserve(rows);
+        /// The ColumnAggregateFunction column captures the shared ownership of the arena with the aggregate function states.
+        if (auto * column_aggregate_func = typeid_cast<ColumnAggregateFunction *>(final_aggregate_columns[i].get()))
+            column_aggregate_func->addArena(arena);
+    }
+    for (auto & place : places)
+        insertAggregatesIntoColumns(place, final_aggregate_columns, arena.get());
+
+    for (size_t i = 0; i < params.aggregates_size; ++i)
+        res.getByPosition(params.keys_size + i).column = std::move(final_aggregate_columns[i]);
+    return res;
+}
+
+
 void Aggregator::finishSpill()
 {
     assert(spiller != nullptr);
@@ -857,6 +983,7 @@ void Aggregator::initThresholdByAggregatedDataVariantsSize(size_t aggregated_dat
     group_by_two_level_threshold = params.getGroupByTwoLevelThreshold();
     group_by_two_level_threshold_bytes = getAverageThreshold(params.getGroupByTwoLevelThresholdBytes(), aggregated_data_variants_size);
     max_bytes_before_external_group_by = getAverageThreshold(params.getMaxBytesBeforeExternalGroupBy(), aggregated_data_variants_size);
+    group_by_partition_threshold = params.getGroupByPartitionThreshold();
 }
 
 void Aggregator::spill(AggregatedDataVariants & data_variants)
@@ -962,7 +962,8 @@ public:
             bool empty_result_for_aggregation_by_empty_set_,
             const SpillConfig & spill_config_,
             UInt64 max_block_size_,
-            const TiDB::TiDBCollators & collators_ = TiDB::dummy_collators)
+            const TiDB::TiDBCollators & collators_ = TiDB::dummy_collators,
+            size_t group_by_partition_threshold_ = 0)
             : src_header(src_header_)
             , keys(keys_)
             , aggregates(aggregates_)
@@ -975,6 +976,7 @@ public:
             , group_by_two_level_threshold(group_by_two_level_threshold_)
             , group_by_two_level_threshold_bytes(group_by_two_level_threshold_bytes_)
             , max_bytes_before_external_group_by(max_bytes_before_external_group_by_)
+            , group_by_partition_threshold(group_by_partition_threshold_)
         {
         }
 
@@ -1008,6 +1010,7 @@ public:
         size_t getGroupByTwoLevelThreshold() const { return group_by_two_level_threshold; }
         size_t getGroupByTwoLevelThresholdBytes() const { return group_by_two_level_threshold_bytes; }
         size_t getMaxBytesBeforeExternalGroupBy() const { return max_bytes_before_external_group_by; }
+        size_t getGroupByPartitionThreshold() const { return group_by_partition_threshold; }
 
     private:
         /// Note these thresholds should not be used directly, they are only used to
@@ -1015,6 +1018,7 @@ public:
         const size_t group_by_two_level_threshold;
         const size_t group_by_two_level_threshold_bytes;
         const size_t max_bytes_before_external_group_by; /// 0 - do not use external aggregation.
+        const size_t group_by_partition_threshold; /// 0 - do not use partitioned aggregation.
     };
 
 
@@ -1036,6 +1040,12 @@ public:
         AggregateColumns & aggregate_columns /// Passed to not create them anew for each block
     );
 
+    /** Convert each row of the block to a row of the final result, as if every row were a group of its own.
+      * It is used by the partial aggregation to pass the rows through when aggregating them hardly reduces the rows,
+      *  the rows of the same key are merged by the final aggregation.
+      */
+    Block passThroughBlock(const Block & block, AggregateColumns & aggregate_columns);
+
     /** Merge several aggregation data structures and output the MergingBucketsPtr used to merge.
       * Return nullptr if there are no non empty data_variant.
       */
@@ -1122,6 +1132,11 @@ protected:
     size_t group_by_two_level_threshold_bytes = 0;
     /// Settings to flush temporary data to the filesystem (external aggregation).
     size_t max_bytes_before_external_group_by = 0;
+    /** From how many keys, the rows of each block are partitioned by the buckets of the two-level hash table
+      *  and aggregated bucket by bucket, so that only one bucket is accessed at a time and it is likely to stay in cache.
+      * 0 - partitioned aggregation is not used.
+      */
+    size_t group_by_partition_threshold = 0;
 
     /// For external aggregation.
     std::unique_ptr<Spiller> spiller;
@@ -1148,7 +1163,8 @@ protected:
         size_t rows,
         ColumnRawPtrs & key_columns,
         TiDB::TiDBCollators & collators,
-        AggregateFunctionInstruction * aggregate_instructions) const;
+        AggregateFunctionInstruction * aggregate_instructions,
+        bool partitioned) const;
 
     template <typename Method>
     void executeImplBatch(
@@ -1156,7 +1172,8 @@ protected:
         typename Method::State & state,
         Arena * aggregates_pool,
         size_t rows,
-        AggregateFunctionInstruction * aggregate_instructions) const;
+        AggregateFunctionInstruction * aggregate_instructions,
+        bool partitioned) const;
 
     /// For case when there are no keys (all aggregate into one row).
     static void executeWithoutKeyImpl(
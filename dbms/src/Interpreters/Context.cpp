@@ -31,6 +31,7 @@
 #include <Encryption/DataKeyManager.h>
 #include <Encryption/FileProvider.h>
 #include <Encryption/RateLimiter.h>
+#include <Flash/Coprocessor/CopResponseCache.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <IO/ReadBufferFromFile.h>
 #include <IO/UncompressedCache.h>
@@ -148,6 +149,7 @@ struct ContextShared
     mutable MarkCachePtr mark_cache; /// Cache of marks in compressed files.
     mutable DM::MinMaxIndexCachePtr minmax_index_cache; /// Cache of minmax index in compressed files.
     mutable DM::DeltaIndexManagerPtr delta_index_manager; /// Manage the Delta Indies of Segments.
+    CopResponseCachePtr cop_response_cache; /// The cache of cop / batch cop responses.
     ProcessList process_list; /// Executing queries at the moment.
     ViewDependencies view_dependencies; /// Current dependencies
     ConfigurationPtr users_config; /// Config with the users, profiles and quotas sections.
@@ -579,7 +581,8 @@ void Context::setPathPool(
     const Strings & latest_data_paths,
     const Strings & kvstore_paths,
     PathCapacityMetricsPtr global_capacity_,
-    FileProviderPtr file_provider_)
+    FileProviderPtr file_provider_,
+    const Strings & cold_data_paths)
 {
     auto lock = getLock();
     shared->path_pool = PathPool(
@@ -587,7 +590,8 @@ void Context::setPathPool(
         latest_data_paths,
         kvstore_paths,
         global_capacity_,
-        file_provider_);
+        file_provider_,
+        cold_data_paths);
 }
 
 void Context::setConfig(const ConfigurationPtr & config)
@@ -1364,6 +1368,23 @@ void Context::dropMinMaxIndexCache() const
         shared->minmax_index_cache->reset();
 }
 
+void Context::setCopResponseCache(size_t cache_size_in_bytes, size_t max_entry_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->cop_response_cache)
+        throw Exception("Cop response cache has been already created.", ErrorCodes::LOGICAL_ERROR);
+
+    shared->cop_response_cache = std::make_shared<CopResponseCache>(cache_size_in_bytes, max_entry_size_in_bytes);
+}
+
+CopResponseCachePtr Context::getCopResponseCache() const
+{
+    // Don't need to use a lock here, as cop_response_cache should be set at starting up.
+    // It is accessed on the raft apply path, so avoid contending the context lock.
+    return shared->cop_response_cache;
+}
+
 bool Context::isDeltaIndexLimited() const
 {
     // Don't need to use a lock here, as delta_index_manager should be set at starting up.
@@ -103,6 +103,7 @@ using MockMPPServerInfo = DB::tests::MockMPPServerInfo;
 class TiFlashSecurityConfig;
 using TiFlashSecurityConfigPtr = std::shared_ptr<TiFlashSecurityConfig>;
 class MockStorage;
+class CopResponseCache;
 
 enum class PageStorageRunMode : UInt8;
 namespace DM
@@ -206,7 +207,8 @@ public:
                      const Strings & latest_data_paths,
                      const Strings & kvstore_paths,
                      PathCapacityMetricsPtr global_capacity_,
-                     FileProviderPtr file_provider);
+                     FileProviderPtr file_provider,
+                     const Strings & cold_data_paths = {});
 
     using ConfigurationPtr = Poco::AutoPtr<Poco::Util::AbstractConfiguration>;
 
@@ -376,6 +378,10 @@ public:
     std::shared_ptr<DM::MinMaxIndexCache> getMinMaxIndexCache() const;
     void dropMinMaxIndexCache() const;
 
+    /// Create a cache of cop / batch cop responses. This can be done only once.
+    void setCopResponseCache(size_t cache_size_in_bytes, size_t max_entry_size_in_bytes);
+    std::shared_ptr<CopResponseCache> getCopResponseCache() const;
+
     bool isDeltaIndexLimited() const;
     void setDeltaIndexManager(size_t cache_size_in_bytes);
     std::shared_ptr<DM::DeltaIndexManager> getDeltaIndexManager() const;
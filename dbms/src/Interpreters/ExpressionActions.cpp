@@ -14,6 +14,7 @@
 
 #include <Columns/ColumnArray.h>
 #include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsCommon.h>
 #include <Columns/ColumnsNumber.h>
 #include <Common/ProfileEvents.h>
 #include <Common/typeid_cast.h>
@@ -24,6 +25,8 @@
 #include <Interpreters/ExpressionActions.h>
 #include <Interpreters/Join.h>
 
+#include <algorithm>
+#include <numeric>
 #include <optional>
 #include <set>
 
@@ -40,10 +43,92 @@ extern const int TOO_MANY_TEMPORARY_COLUMNS;
 extern const int TOO_MANY_TEMPORARY_NON_CONST_COLUMNS;
 } // namespace ErrorCodes
 
+namespace
+{
+enum class ShortCircuitKind
+{
+    None,
+    /// `and` and `or`: an argument is needed by the rows not decided by the previous arguments.
+    And,
+    Or,
+    /// `if(cond, then, else)` and `multiIf(cond_1, then_1, ..., cond_n, then_n, else)`: a condition is needed by the rows
+    /// not taken by the previous conditions, and a branch is needed by the rows taking it.
+    If,
+};
+
+ShortCircuitKind getShortCircuitKind(const IFunctionBase & function)
+{
+    const auto & name = function.getName();
+    if (name == "and")
+        return ShortCircuitKind::And;
+    if (name == "or")
+        return ShortCircuitKind::Or;
+    if (name == "if" || name == "multiIf")
+        return ShortCircuitKind::If;
+    return ShortCircuitKind::None;
+}
+
+/// Evaluating an argument lazily costs filtering its inputs and expanding its result, which is about the same as evaluating
+/// a cheap function on all the rows. So only the arguments costing more than that are evaluated lazily.
+constexpr size_t short_circuit_min_cost = 2;
+
+/// A rough cost of evaluating the function on a row. The functions only on numbers are cheap, the others, such as the
+/// functions on strings or decimals, are considered much more expensive.
+size_t estimateFunctionCost(const ExpressionAction & action, const std::unordered_map<String, ColumnWithTypeAndName> & columns)
+{
+    auto is_number = [](const DataTypePtr & type) {
+        return type && removeNullable(type)->isValueRepresentedByNumber();
+    };
+    bool cheap = is_number(action.result_type);
+    for (const auto & name : action.argument_names)
+    {
+        auto it = columns.find(name);
+        cheap = cheap && it != columns.end() && is_number(it->second.type);
+    }
+    return cheap ? 1 : 4;
+}
+
+/// Returns the data and the null map of a condition, the data is nullptr if the condition is not a (nullable) UInt8 column,
+/// then no row is known to be true or false.
+std::pair<const ColumnUInt8::Container *, const NullMap *> getConditionData(const IColumn & condition)
+{
+    const IColumn * nested = &condition;
+    const NullMap * null_map = nullptr;
+    if (const auto * nullable = typeid_cast<const ColumnNullable *>(nested))
+    {
+        nested = &nullable->getNestedColumn();
+        null_map = &nullable->getNullMapData();
+    }
+    if (const auto * data = typeid_cast<const ColumnUInt8 *>(nested))
+        return {&data->getData(), null_map};
+    return {nullptr, nullptr};
+}
+} // namespace
+
+Names ExpressionAction::getArgumentColumns() const
+{
+    if (lazy_arguments.empty())
+        return argument_names;
+
+    Names res;
+    for (size_t i = 0; i < argument_names.size(); ++i)
+    {
+        if (lazy_arguments[i])
+        {
+            for (const auto & name : lazy_arguments[i]->getRequiredColumns())
+                res.push_back(name);
+        }
+        else
+        {
+            res.push_back(argument_names[i]);
+        }
+    }
+    return res;
+}
 
 Names ExpressionAction::getNeededColumns() const
 {
-    Names res = argument_names;
+    Names res = getArgumentColumns();
 
     for (const auto & column : projections)
         res.push_back(column.first);
@@ -318,6 +403,12 @@ void ExpressionAction::execute(Block & block) const
     {
     case APPLY_FUNCTION:
     {
+        if (!lazy_arguments.empty())
+        {
+            executeShortCircuitFunction(block);
+            break;
+        }
+
         ColumnNumbers arguments(argument_names.size());
         for (size_t i = 0; i < argument_names.size(); ++i)
         {
@@ -386,6 +477,109 @@ void ExpressionAction::execute(Block & block) const
 }
 
 
+void ExpressionAction::executeShortCircuitFunction(Block & block) const
+{
+    const auto kind = getShortCircuitKind(*function);
+    const size_t rows = block.rows();
+
+    /// The rows whose result is not decided by the arguments evaluated so far.
+    IColumn::Filter remaining(rows, 1);
+    /// For `if` and `multiIf`, the rows taking the branch after the current condition.
+    IColumn::Filter taken;
+
+    ColumnNumbers arguments(argument_names.size());
+    Names lazy_names;
+    for (size_t i = 0; i < argument_names.size(); ++i)
+    {
+        const bool is_branch = kind == ShortCircuitKind::If && (i % 2 == 1 || i + 1 == argument_names.size());
+        if (i < lazy_arguments.size() && lazy_arguments[i])
+        {
+            const auto & selected = is_branch && i + 1 != argument_names.size() ? taken : remaining;
+            ColumnPtr column = executeLazyArgument(block, i, selected);
+            const auto & type = lazy_arguments[i]->getSampleBlock().getByName(argument_names[i]).type;
+            block.insert({std::move(column), type, argument_names[i]});
+            lazy_names.push_back(argument_names[i]);
+        }
+        else if (!block.has(argument_names[i]))
+        {
+            throw Exception("Not found column: '" + argument_names[i] + "'", ErrorCodes::NOT_FOUND_COLUMN_IN_BLOCK);
+        }
+        arguments[i] = block.getPositionByName(argument_names[i]);
+
+        if (is_branch || i + 1 == argument_names.size())
+            continue;
+
+        ColumnPtr condition = block.getByPosition(arguments[i]).column->convertToFullColumnIfConst();
+        const auto [data, null_map] = getConditionData(*condition);
+        if (kind == ShortCircuitKind::If)
+        {
+            taken = remaining;
+            if (!data)
+                continue;
+            for (size_t row = 0; row < rows; ++row)
+            {
+                taken[row] = remaining[row] && !(null_map && (*null_map)[row]) && (*data)[row];
+                remaining[row] &= !taken[row];
+            }
+        }
+        else if (data)
+        {
+            /// `false and x` is false and `true or x` is true, no matter what x is.
+            const bool decided_value = kind == ShortCircuitKind::Or;
+            for (size_t row = 0; row < rows; ++row)
+            {
+                if (!(null_map && (*null_map)[row]) && static_cast<bool>((*data)[row]) == decided_value)
+                    remaining[row] = 0;
+            }
+        }
+    }
+
+    size_t num_columns_without_result = block.columns();
+    block.insert({nullptr, result_type, result_name});
+    function->execute(block, arguments, num_columns_without_result);
+
+    for (const auto & name : lazy_names)
+        block.erase(name);
+}
+
+ColumnPtr ExpressionAction::executeLazyArgument(const Block & block, size_t argument, const IColumn::Filter & selected) const
+{
+    const auto & lazy = lazy_arguments[argument];
+    const auto & argument_name = argument_names[argument];
+    const size_t rows = block.rows();
+    const size_t selected_rows = countBytesInFilter(selected);
+    if (selected_rows == 0)
+        return lazy->getSampleBlock().getByName(argument_name).type->createColumnConstWithDefaultValue(rows)->convertToFullColumnIfConst();
+
+    Block sub_block;
+    for (const auto & name : lazy->getRequiredColumns())
+    {
+        if (!block.has(name))
+            throw Exception("Not found column: '" + name + "'", ErrorCodes::NOT_FOUND_COLUMN_IN_BLOCK);
+        auto column = block.getByName(name);
+        if (selected_rows < rows)
+            column.column = column.column->filter(selected, selected_rows);
+        sub_block.insert(std::move(column));
+    }
+    lazy->execute(sub_block);
+
+    ColumnPtr column = sub_block.getByName(argument_name).column->convertToFullColumnIfConst();
+    if (selected_rows == rows)
+        return column;
+
+    /// The rows not selected never affect the result of the function, so they repeat the last selected row before
+    /// them, or the first selected row for the leading ones. Then the column is expanded by one `replicate` call.
+    IColumn::Offsets offsets(selected_rows, 0);
+    for (size_t row = 0, pos = 0; row < rows; ++row)
+    {
+        pos += selected[row] != 0;
+        ++offsets[pos == 0 ? 0 : pos - 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    return column->replicate(offsets);
+}
+
+
 String ExpressionAction::toString() const
 {
     std::stringstream ss;
@@ -414,6 +608,8 @@ String ExpressionAction::toString() const
             if (i)
                 ss << ", ";
             ss << argument_names[i];
+            if (i < lazy_arguments.size() && lazy_arguments[i])
+                ss << " (lazy)";
         }
         ss << ")";
         break;
@@ -505,6 +701,67 @@ void ExpressionActions::execute(Block & block) const
         action.execute(block);
 }
 
+SortDescription ExpressionActions::getOutputSortDescription(const SortDescription & input_description) const
+{
+    SortDescription res = input_description;
+    for (const auto & action : actions)
+    {
+        size_t kept = res.size();
+        for (size_t i = 0; i < kept; ++i)
+        {
+            auto & name = res[i].column_name;
+            switch (action.type)
+            {
+            case ExpressionAction::PROJECT:
+            {
+                auto it = std::find_if(action.projections.begin(), action.projections.end(), [&](const auto & projection) {
+                    return projection.first == name;
+                });
+                if (it == action.projections.end())
+                    kept = i;
+                else if (!it->second.empty())
+                    name = it->second;
+                break;
+            }
+            case ExpressionAction::REMOVE_COLUMN:
+                if (action.source_name == name)
+                    kept = i;
+                break;
+            case ExpressionAction::JOIN:
+            case ExpressionAction::EXPAND:
+                /// The rows are not kept in order.
+                kept = 0;
+                break;
+            default:
+                /// The sort column is replaced by a new column.
+                if (action.result_name == name)
+                    kept = i;
+                break;
+            }
+        }
+        res.erase(res.begin() + kept, res.end());
+    }
+    return res;
+}
+
+bool ExpressionActions::isProjectionOnly() const
+{
+    for (const auto & action : actions)
+    {
+        switch (action.type)
+        {
+        case ExpressionAction::ADD_COLUMN:
+        case ExpressionAction::REMOVE_COLUMN:
+        case ExpressionAction::COPY_COLUMN:
+        case ExpressionAction::PROJECT:
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
 std::string ExpressionActions::getSmallestColumn(const NamesAndTypesList & columns)
 {
     std::optional<size_t> min_size;
@@ -633,6 +890,8 @@ void ExpressionActions::finalize(const Names & output_columns)
         std::cerr << action.toString() << "\n";
     std::cerr << "\n";*/
 
+    extractLazyArguments(final_columns);
+
     /// Deletes unnecessary temporary columns.
 
     /// If the column after performing the function `refcount = 0`, it can be deleted.
@@ -646,7 +905,7 @@ void ExpressionActions::finalize(const Names & output_columns)
         if (!action.source_name.empty())
             ++columns_refcount[action.source_name];
 
-        for (const auto & name : action.argument_names)
+        for (const auto & name : action.getArgumentColumns())
             ++columns_refcount[name];
 
         for (const auto & name_alias : action.projections)
@@ -673,7 +932,7 @@ void ExpressionActions::finalize(const Names & output_columns)
         if (!action.source_name.empty())
             process(action.source_name);
 
-        for (const auto & name : action.argument_names)
+        for (const auto & name : action.getArgumentColumns())
             process(name);
 
         /// For `projection`, there is no reduction in `refcount`, because the `project` action replaces the names of the columns, in effect, already deleting them under the old names.
@@ -682,6 +941,172 @@ void ExpressionActions::finalize(const Names & output_columns)
     actions.swap(new_actions);
 }
 
+void ExpressionActions::extractLazyArguments(const NameSet & final_columns)
+{
+    /// The lazy arguments are executed on a part of the rows of the block, only the actions before the first one that changes
+    /// the structure of the block are considered.
+    size_t end = 0;
+    for (; end < actions.size(); ++end)
+    {
+        const auto type = actions[end].type;
+        if (type == ExpressionAction::PROJECT || type == ExpressionAction::JOIN || type == ExpressionAction::EXPAND)
+            break;
+    }
+
+    /// The columns that can be the inputs of the lazy arguments.
+    std::unordered_map<String, ColumnWithTypeAndName> columns;
+    for (const auto & input_column : input_columns)
+    {
+        if (sample_block.has(input_column.name))
+            columns[input_column.name] = sample_block.getByName(input_column.name);
+        else
+            columns[input_column.name] = ColumnWithTypeAndName(nullptr, input_column.type, input_column.name);
+    }
+
+    /// The actions using each column, with the position of the column in the arguments, or -1 for other kinds of usage.
+    /// The output of the expression is used by the position `actions.size()`.
+    std::unordered_map<String, std::vector<std::pair<size_t, Int64>>> usages;
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+        const auto & action = actions[i];
+        if (i < end)
+        {
+            if (action.type == ExpressionAction::ADD_COLUMN)
+                columns[action.result_name] = ColumnWithTypeAndName(action.added_column, action.result_type, action.result_name);
+            else if (action.type == ExpressionAction::APPLY_FUNCTION)
+                columns[action.result_name] = ColumnWithTypeAndName(nullptr, action.result_type, action.result_name);
+            else if (action.type == ExpressionAction::COPY_COLUMN && columns.count(action.source_name))
+                columns[action.result_name] = ColumnWithTypeAndName(columns[action.source_name].column, action.result_type, action.result_name);
+        }
+
+        if (action.type == ExpressionAction::APPLY_FUNCTION)
+        {
+            for (size_t arg = 0; arg < action.argument_names.size(); ++arg)
+            {
+                if (arg < action.lazy_arguments.size() && action.lazy_arguments[arg])
+                {
+                    for (const auto & name : action.lazy_arguments[arg]->getRequiredColumns())
+                        usages[name].emplace_back(i, -1);
+                }
+                else
+                {
+                    usages[action.argument_names[arg]].emplace_back(i, arg);
+                }
+            }
+        }
+        else
+        {
+            for (const auto & name : action.getNeededColumns())
+                usages[name].emplace_back(i, -1);
+        }
+    }
+    for (const auto & name : final_columns)
+        usages[name].emplace_back(actions.size(), -1);
+
+    std::vector<UInt8> extracted(actions.size(), 0);
+    bool any_extracted = false;
+    /// Go from the end, so that the short-circuit functions inside a lazy argument are handled when finalizing the lazy argument.
+    for (size_t f = end; f-- > 0;)
+    {
+        auto & action = actions[f];
+        if (extracted[f] || action.type != ExpressionAction::APPLY_FUNCTION || !action.short_circuit || !action.function
+            || getShortCircuitKind(*action.function) == ShortCircuitKind::None)
+            continue;
+
+        /// The first argument is always needed by all the rows.
+        for (size_t arg = 1; arg < action.argument_names.size(); ++arg)
+        {
+            if (arg < action.lazy_arguments.size() && action.lazy_arguments[arg])
+                continue;
+
+            /// The actions whose results are only used by the argument, directly or by other such actions.
+            std::vector<size_t> lazy_actions;
+            std::unordered_set<size_t> lazy_action_set;
+            for (size_t i = f; i-- > 0;)
+            {
+                const auto & candidate = actions[i];
+                if (extracted[i] || candidate.type != ExpressionAction::APPLY_FUNCTION || !candidate.function
+                    || !candidate.function->isDeterministic() || !candidate.function->isSuitableForConstantFolding()
+                    || final_columns.count(candidate.result_name))
+                    continue;
+                auto it = usages.find(candidate.result_name);
+                if (it == usages.end() || it->second.empty())
+                    continue;
+                bool only_used_by_argument = true;
+                for (const auto & [user, position] : it->second)
+                {
+                    if (!(user == f && position == static_cast<Int64>(arg)) && !lazy_action_set.count(user))
+                    {
+                        only_used_by_argument = false;
+                        break;
+                    }
+                }
+                if (only_used_by_argument)
+                {
+                    lazy_actions.push_back(i);
+                    lazy_action_set.insert(i);
+                }
+            }
+            if (lazy_actions.empty() || actions[lazy_actions.front()].result_name != action.argument_names[arg])
+                continue;
+            std::reverse(lazy_actions.begin(), lazy_actions.end());
+
+            size_t cost = 0;
+            for (size_t i : lazy_actions)
+                cost += estimateFunctionCost(actions[i], columns);
+            if (cost < short_circuit_min_cost)
+                continue;
+
+            ColumnsWithTypeAndName lazy_inputs;
+            NameSet lazy_names;
+            for (size_t i : lazy_actions)
+            {
+                for (const auto & name : actions[i].argument_names)
+                {
+                    if (lazy_names.count(name))
+                        continue;
+                    auto it = columns.find(name);
+                    if (it == columns.end())
+                        throw Exception("Unknown column: " + name, ErrorCodes::UNKNOWN_IDENTIFIER);
+                    lazy_inputs.push_back(it->second);
+                    lazy_names.insert(name);
+                }
+                lazy_names.insert(actions[i].result_name);
+            }
+            /// The number of rows can not be known without any input column.
+            if (lazy_inputs.empty())
+                continue;
+
+            auto lazy = std::make_shared<ExpressionActions>(lazy_inputs);
+            for (size_t i : lazy_actions)
+                lazy->add(actions[i]);
+            lazy->finalize({action.argument_names[arg]});
+
+            if (action.lazy_arguments.empty())
+                action.lazy_arguments.resize(action.argument_names.size());
+            action.lazy_arguments[arg] = lazy;
+            for (size_t i : lazy_actions)
+            {
+                extracted[i] = 1;
+                if (sample_block.has(actions[i].result_name))
+                    sample_block.erase(actions[i].result_name);
+            }
+            any_extracted = true;
+        }
+    }
+
+    if (!any_extracted)
+        return;
+
+    Actions new_actions;
+    new_actions.reserve(actions.size());
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+        if (!extracted[i])
+            new_actions.push_back(std::move(actions[i]));
+    }
+    actions.swap(new_actions);
+}
 
 std::string ExpressionActions::dumpActions() const
 {
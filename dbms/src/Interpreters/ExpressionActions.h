@@ -17,6 +17,7 @@
 #include <Core/Block.h>
 #include <Core/ColumnWithTypeAndName.h>
 #include <Core/Names.h>
+#include <Core/SortDescription.h>
 #include <Interpreters/Expand.h>
 #include <Storages/Transaction/Collator.h>
 
@@ -49,6 +50,9 @@ using DataTypePtr = std::shared_ptr<const IDataType>;
 class IBlockInputStream;
 using BlockInputStreamPtr = std::shared_ptr<IBlockInputStream>;
 
+class ExpressionActions;
+using ExpressionActionsPtr = std::shared_ptr<ExpressionActions>;
+
 
 /** Action on the block.
   */
@@ -86,6 +90,13 @@ public:
     FunctionBasePtr function;
     Names argument_names;
     TiDB::TiDBCollatorPtr collator = nullptr;
+    /// For the short-circuit functions `and`, `or`, `if` and `multiIf`: the actions computing an argument, if they are only used
+    /// by the argument, are taken out of the expression and kept here by the position of the argument, so that they are executed
+    /// only on the rows whose result depends on the argument. Empty if no argument is evaluated lazily.
+    std::vector<ExpressionActionsPtr> lazy_arguments;
+    /// Whether the arguments of the short-circuit function can be evaluated lazily, set by the caller according to
+    /// the setting `enable_short_circuit_evaluation`.
+    bool short_circuit = false;
 
     /// For JOIN
     std::shared_ptr<const Join> join;
@@ -115,6 +126,9 @@ public:
     /// Which columns necessary to perform this action.
     Names getNeededColumns() const;
 
+    /// The arguments of APPLY_FUNCTION in the block, the lazy arguments are replaced by the columns they need.
+    Names getArgumentColumns() const;
+
     std::string toString() const;
 
 private:
@@ -122,6 +136,9 @@ private:
 
     void prepare(Block & sample_block);
     void execute(Block & block) const;
+
+    void executeShortCircuitFunction(Block & block) const;
+    ColumnPtr executeLazyArgument(const Block & block, size_t argument, const IColumn::Filter & selected) const;
 };
 
 
@@ -176,6 +193,7 @@ public:
     /// - Does not reorder the columns.
     /// - Does not remove "unexpected" columns (for example, added by functions).
     /// - If output_columns is empty, leaves one arbitrary column (so that the number of rows in the block is not lost).
+    /// - Makes the arguments of short-circuit functions lazy if possible, see `ExpressionAction::lazy_arguments`.
     void finalize(const Names & output_columns);
 
     const Actions & getActions() const { return actions; }
@@ -194,6 +212,13 @@ public:
     /// Execute the expression on the block. The block must contain all the columns returned by getRequiredColumns.
     void execute(Block & block) const;
 
+    /// Whether the actions only add constants, copy, remove or rename the columns, which don't compute anything on the rows.
+    bool isProjectionOnly() const;
+
+    /// The order of the result if the input is sorted by `input_description`, which is the leading sort columns kept
+    /// by the actions with their names in the result. It is empty if the first sort column is not kept.
+    SortDescription getOutputSortDescription(const SortDescription & input_description) const;
+
     /// Obtain a sample block that contains the names and types of result columns.
     const Block & getSampleBlock() const { return sample_block; }
 
@@ -207,9 +232,9 @@ private:
     Block sample_block;
 
     void addImpl(ExpressionAction action, Names & new_names);
-};
 
-using ExpressionActionsPtr = std::shared_ptr<ExpressionActions>;
+    void extractLazyArguments(const NameSet & final_columns);
+};
 
 
 /** The sequence of transformations over the block.
@@ -210,6 +210,7 @@ size_t Join::getTotalByteCount()
         {
             for (const auto & block : blocks)
                 res += block.bytes();
+            res += range_join_build_block.bytes();
         }
         else
         {
@@ -1368,7 +1369,17 @@ Block Join::joinBlockCross(ProbeProcessInfo & probe_process_info) const
     else                                                                             \
         throw Exception("Logical error: unknown combination of JOIN", ErrorCodes::LOGICAL_ERROR);
 
-    if (null_map)
+    if (!non_equal_conditions.range_conditions.empty())
+    {
+        RUNTIME_CHECK(strictness == All);
+        if (kind == Cross)
+            null_map ? joinBlockRangeImpl<Cross, true>(block, null_map) : joinBlockRangeImpl<Cross, false>(block, null_map);
+        else if (kind == Cross_LeftOuter)
+            null_map ? joinBlockRangeImpl<Cross_LeftOuter, true>(block, null_map) : joinBlockRangeImpl<Cross_LeftOuter, false>(block, null_map);
+        else
+            throw Exception("Logical error: unknown combination of range JOIN", ErrorCodes::LOGICAL_ERROR);
+    }
+    else if (null_map)
     {
         DISPATCH(true)
     }
@@ -1382,6 +1393,189 @@ Block Join::joinBlockCross(ProbeProcessInfo & probe_process_info) const
     return block;
 }
 
+namespace
+{
+/// Returns the nested column and the null map of a nullable column, or the column itself and nullptr.
+std::pair<const IColumn *, const NullMap *> splitNullable(const IColumn & column)
+{
+    if (const auto * nullable = typeid_cast<const ColumnNullable *>(&column))
+        return {&nullable->getNestedColumn(), &nullable->getNullMapData()};
+    return {&column, nullptr};
+}
+} // namespace
+
+void Join::buildRangeJoinBlock()
+{
+    const auto & build_column_name = non_equal_conditions.range_conditions.front().build_column;
+    Blocks non_empty_blocks;
+    for (auto & block : blocks)
+    {
+        if (block.rows() > 0)
+            non_empty_blocks.push_back(std::move(block));
+    }
+    /// Only the sorted block is used to probe, so release the build blocks to not keep two copies of the build rows.
+    blocks.clear();
+    original_blocks.clear();
+    if (non_empty_blocks.empty())
+    {
+        range_join_build_block = sample_block_with_columns_to_add.cloneEmpty();
+        return;
+    }
+
+    Block merged = vstackBlocks(std::move(non_empty_blocks));
+    auto [build_column, null_map] = splitNullable(*merged.getByName(build_column_name).column);
+    IColumn::Permutation perm;
+    build_column->getPermutation(false, 0, 1, perm);
+    if (null_map != nullptr)
+    {
+        auto it = std::remove_if(perm.begin(), perm.end(), [&](size_t row) { return (*null_map)[row]; });
+        perm.resize(it - perm.begin());
+    }
+    const size_t rows = perm.size();
+    if (rows == 0)
+    {
+        range_join_build_block = sample_block_with_columns_to_add.cloneEmpty();
+        return;
+    }
+    for (auto & column : merged)
+        column.column = column.column->permute(perm, rows);
+    range_join_build_block = std::move(merged);
+    LOG_DEBUG(log, "Sort {} build rows of cross join by {} for range conditions", rows, build_column_name);
+}
+
+template <ASTTableJoin::Kind KIND, bool has_null_map>
+void Join::joinBlockRangeImpl(Block & block, ConstNullMapPtr null_map [[maybe_unused]]) const
+{
+    size_t num_existing_columns = block.columns();
+    size_t num_columns_to_add = sample_block_with_columns_to_add.columns();
+    size_t rows_left = block.rows();
+
+    ColumnRawPtrs src_left_columns(num_existing_columns);
+    for (size_t i = 0; i < num_existing_columns; ++i)
+        src_left_columns[i] = block.getByPosition(i).column.get();
+
+    /// The probe columns of the range conditions, materialized in case they are constant.
+    const auto & range_conditions = non_equal_conditions.range_conditions;
+    Columns probe_column_holders;
+    std::vector<std::pair<const IColumn *, const NullMap *>> probe_columns;
+    for (const auto & cond : range_conditions)
+    {
+        probe_column_holders.push_back(block.getByName(cond.probe_column).column->convertToFullColumnIfConst());
+        probe_columns.push_back(splitNullable(*probe_column_holders.back()));
+    }
+
+    for (size_t i = 0; i < num_columns_to_add; ++i)
+    {
+        const ColumnWithTypeAndName & src_column = sample_block_with_columns_to_add.getByPosition(i);
+        RUNTIME_CHECK_MSG(!block.has(src_column.name), "block from probe side has a column with the same name: {} as a column in sample_block_with_columns_to_add", src_column.name);
+        block.insert(src_column);
+    }
+
+    const size_t right_rows = range_join_build_block.rows();
+    const IColumn * build_column = right_rows > 0
+        ? splitNullable(*range_join_build_block.getByName(range_conditions.front().build_column).column).first
+        : nullptr;
+    /// The first build row whose value is not less than (or greater than if `upper`) the probe value.
+    auto bound = [&](const IColumn & probe_column, size_t probe_row, bool upper) {
+        size_t low = 0;
+        size_t high = right_rows;
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            int res = build_column->compareAt(mid, probe_row, probe_column, 1);
+            if (upper ? res <= 0 : res < 0)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        return low;
+    };
+
+    std::vector<size_t> right_column_index;
+    for (size_t i = 0; i < num_columns_to_add; ++i)
+        right_column_index.push_back(num_existing_columns + i);
+
+    std::vector<Block> result_blocks;
+    size_t start = 0;
+    do
+    {
+        MutableColumns dst_columns(block.columns());
+        for (size_t i = 0; i < block.columns(); ++i)
+            dst_columns[i] = block.getByPosition(i).column->cloneEmpty();
+        auto offsets = std::make_unique<IColumn::Offsets>();
+        IColumn::Offset current_offset = 0;
+
+        size_t i = start;
+        /// Stop once the joined rows are enough for a block, the other conditions are evaluated per block.
+        for (; i < rows_left && (max_block_size == 0 || current_offset < max_block_size); ++i)
+        {
+            size_t begin = 0;
+            size_t end = right_rows;
+            if constexpr (has_null_map)
+            {
+                if ((*null_map)[i])
+                    end = 0;
+            }
+            for (size_t c = 0; c < range_conditions.size() && begin < end; ++c)
+            {
+                const auto & [probe_column, probe_null_map] = probe_columns[c];
+                if (probe_null_map != nullptr && (*probe_null_map)[i])
+                {
+                    end = 0;
+                    break;
+                }
+                switch (range_conditions[c].op)
+                {
+                case JoinRangeCondition::Op::Less:
+                    begin = std::max(begin, bound(*probe_column, i, true));
+                    break;
+                case JoinRangeCondition::Op::LessOrEquals:
+                    begin = std::max(begin, bound(*probe_column, i, false));
+                    break;
+                case JoinRangeCondition::Op::Greater:
+                    end = std::min(end, bound(*probe_column, i, false));
+                    break;
+                case JoinRangeCondition::Op::GreaterOrEquals:
+                    end = std::min(end, bound(*probe_column, i, true));
+                    break;
+                }
+            }
+
+            if (begin < end)
+            {
+                const size_t matched_rows = end - begin;
+                for (size_t col_num = 0; col_num < num_existing_columns; ++col_num)
+                    dst_columns[col_num]->insertManyFrom(*src_left_columns[col_num], i, matched_rows);
+                for (size_t col_num = 0; col_num < num_columns_to_add; ++col_num)
+                    dst_columns[num_existing_columns + col_num]->insertRangeFrom(*range_join_build_block.getByPosition(col_num).column, begin, matched_rows);
+                current_offset += matched_rows;
+            }
+            else if constexpr (KIND == ASTTableJoin::Kind::Cross_LeftOuter)
+            {
+                for (size_t col_num = 0; col_num < num_existing_columns; ++col_num)
+                    dst_columns[col_num]->insertFrom(*src_left_columns[col_num], i);
+                for (size_t col_num = 0; col_num < num_columns_to_add; ++col_num)
+                    dst_columns[num_existing_columns + col_num]->insertDefault();
+                current_offset += 1;
+            }
+            offsets->push_back(current_offset);
+        }
+
+        auto block_per_iter = block.cloneWithColumns(std::move(dst_columns));
+        std::unique_ptr<IColumn::Filter> is_row_matched;
+        handleOtherConditions(block_per_iter, is_row_matched, offsets, right_column_index);
+        if (start == 0 || block_per_iter.rows() > 0)
+            /// always need to generate at least one block
+            result_blocks.push_back(std::move(block_per_iter));
+        start = i;
+    } while (start < rows_left);
+
+    if (result_blocks.size() == 1)
+        block = std::move(result_blocks[0]);
+    else
+        block = vstackBlocks(std::move(result_blocks));
+}
+
 void Join::checkTypes(const Block & block) const
 {
     checkTypesOfKeys(block, sample_block_with_keys);
@@ -1652,6 +1846,8 @@ void Join::workAfterBuildFinish()
     else
     {
         has_build_data_in_memory = !original_blocks.empty();
+        if (isCrossJoin(kind) && !non_equal_conditions.range_conditions.empty())
+            buildRangeJoinBlock();
     }
 }
 
@@ -206,6 +206,8 @@ public:
 
     const Names & getLeftJoinKeys() const { return key_names_left; }
 
+    const Names & getRightJoinKeys() const { return key_names_right; }
+
     void setInitActiveBuildThreads()
     {
         std::unique_lock lock(build_probe_mutex);
@@ -335,6 +337,10 @@ private:
 
     bool has_build_data_in_memory = false;
 
+    /// For cross join with range conditions, the build rows sorted by the build column of the range conditions.
+    /// The rows with null in the build column are removed because they never satisfy the range conditions.
+    Block range_join_build_block;
+
 private:
     JoinMapMethod join_map_method = JoinMapMethod::EMPTY;
 
@@ -399,6 +405,13 @@ private:
     template <ASTTableJoin::Kind KIND, ASTTableJoin::Strictness STRICTNESS, bool has_null_map>
     void joinBlockCrossImpl(Block & block, ConstNullMapPtr null_map) const;
 
+    /// Sort the build rows of cross join by the build column of the range conditions.
+    void buildRangeJoinBlock();
+
+    /// Cross join that only joins each probe row with the build rows satisfying the range conditions.
+    template <ASTTableJoin::Kind KIND, bool has_null_map>
+    void joinBlockRangeImpl(Block & block, ConstNullMapPtr null_map) const;
+
     template <ASTTableJoin::Kind KIND, ASTTableJoin::Strictness STRICTNESS, typename Maps>
     void joinBlockNullAwareImpl(
         Block & block,
@@ -90,6 +90,10 @@ struct Settings
     M(SettingUInt64, group_by_two_level_threshold, 100000, "From what number of keys, a two-level aggregation starts. 0 - the threshold is not set.")                                                                                   \
     M(SettingUInt64, group_by_two_level_threshold_bytes, 100000000, "From what size of the aggregation state in bytes, a two-level aggregation begins to be used. 0 - the threshold is not set. "                                       \
                                                                     "Two-level aggregation is used when at least one of the thresholds is triggered.")                                                                                  \
+    M(SettingUInt64, group_by_partition_threshold, 1000000, "From what number of keys, the rows of each block are partitioned by the buckets of the two-level hash table and aggregated bucket by bucket. 0 means disabled.")           \
+    M(SettingBool, enable_adaptive_pre_aggregation, false, "Do the partial aggregation of each stream independently, pass the rows through if they are hardly reduced and flush the aggregated data instead of spilling it.")           \
+    M(SettingUInt64, pre_aggregation_sample_rows, 65536, "The partial aggregation decides whether to pass the rows through after aggregating this number of rows. 0 means never passing through.")                                      \
+    M(SettingDouble, pre_aggregation_pass_through_ratio, 0.9, "The partial aggregation passes the rows through if the number of keys is more than this ratio of the aggregated rows.")                                                  \
     M(SettingUInt64, aggregation_memory_efficient_merge_threads, 0, "Number of threads to use for merge intermediate aggregation results in memory efficient mode. When bigger, then more memory is "                                   \
                                                                     "consumed. 0 means - same as 'max_threads'.")                                                                                                                       \
                                                                                                                                                                                                                                         \
@@ -116,6 +120,7 @@ struct Settings
     M(SettingInt64, memory_tracker_accuracy_diff_for_test, 0, "For testing of the accuracy of the memory tracker - throw an exception when real_rss is much larger than tracked amount.")                                               \
                                                                                                                                                                                                                                         \
     M(SettingString, count_distinct_implementation, "uniqExact", "What aggregate function to use for implementation of count(DISTINCT ...)")                                                                                            \
+    M(SettingBool, enable_count_distinct_rewrite, false, "Rewrite the final count(distinct x) into a group by on the keys and x followed by a count of x.")                                                                              \
                                                                                                                                                                                                                                         \
     M(SettingBool, output_format_write_statistics, true, "Write statistics about read rows, bytes, time elapsed in suitable output formats.")                                                                                           \
                                                                                                                                                                                                                                         \
@@ -139,6 +144,7 @@ struct Settings
     M(SettingUInt64, max_bytes_before_external_group_by, 0, "")                                                                                                                                                                         \
                                                                                                                                                                                                                                         \
     M(SettingUInt64, max_bytes_before_external_sort, 0, "")                                                                                                                                                                             \
+    M(SettingUInt64, topn_threshold_max_limit, 65536, "TopN with a limit not greater than this value filters its input by the last of its current top rows, and pushes it down to the table scan to skip packs. 0 to disable.")         \
                                                                                                                                                                                                                                         \
                                                                                                                                                                                                                                         \
     /* TODO: Check also when merging and finalizing aggregate functions. */                                                                                                                                                             \
@@ -156,6 +162,8 @@ struct Settings
     M(SettingUInt64, dt_segment_limit_rows, 1000000, "Base rows of segments in DeltaTree Engine.")                                                                                                                                      \
     M(SettingUInt64, dt_segment_limit_size, 536870912, "Base size of segments in DeltaTree Engine. 500MB by default.")                                                                                                                  \
     M(SettingUInt64, dt_segment_force_split_size, 1610612736, "The threshold of the foreground split segment. in DeltaTree Engine. 1.5GB by default.")                                                                                  \
+    M(SettingUInt64, dt_segment_hot_read_per_minute, 60, "Segments read more times per minute than this are split at dt_segment_limit_rows/size instead of twice of them. 0 means disabled.")                                           \
+    M(SettingDouble, dt_segment_cold_merge_ratio, 1.0, "Rarely read segments are merged until the merged one reaches dt_segment_limit_rows/size * dt_segment_cold_merge_ratio (at most 2).")                                            \
     M(SettingUInt64, dt_segment_delta_limit_rows, 80000, "Max rows of segment delta in DeltaTree Engine")                                                                                                                               \
     M(SettingUInt64, dt_segment_delta_limit_size, 42991616, "Max size of segment delta in DeltaTree Engine. 41 MB by default.")                                                                                                         \
     M(SettingUInt64, dt_segment_force_merge_delta_deletes, 10, "Delta delete ranges before force merge into stable.")                                                                                                                   \
@@ -176,6 +184,11 @@ struct Settings
     M(SettingFloat, dt_bg_gc_ratio_threhold_to_trigger_gc, 1.2, "Trigger segment's gc when the ratio of invalid version exceed this threhold. Values smaller than or equal to 1.0 means gc all "                                        \
                                                                 "segments")                                                                                                                                                             \
     M(SettingFloat, dt_bg_gc_delta_delete_ratio_to_trigger_gc, 0.3, "Trigger segment's gc when the ratio of delta delete range to stable exceeds this ratio.")                                                                          \
+    M(SettingUInt64, dt_bg_task_max_heavy_per_disk, 0, "Max number of running background merge delta and split tasks of the segments on the same disk. Tasks relieving write stalls are not limited. 0 means unlimited.")               \
+    M(SettingUInt64, dt_bg_task_throttle_read_latency_ms, 0, "Defer background tasks that neither relieve write stalls nor exceed their deadlines when queries wait longer than this for blocks from the storage on average. 0 means disabled.")\
+    M(SettingUInt64, dt_tier_cold_after_days, 0, "Move the stable of the segments that are not written for this number of days and rarely read to the cold data paths (storage.cold.dir). 0 means disabled.")                           \
+    M(SettingDouble, dt_tier_promote_read_per_minute, 10, "Move the stable of the segments on the cold data paths back to the main data paths when they are read more times per minute than this.")                                     \
+    M(SettingUInt64, dt_tier_migration_max_bytes_per_sec, 64 * 1024 * 1024, "Max bytes per second of the stable data moved between the main and the cold data paths of all tables. 0 means unlimited.")                                 \
     M(SettingUInt64, dt_insert_max_rows, 0, "Max rows of insert blocks when write into DeltaTree Engine. By default 0 means no limit.")                                                                                                 \
     M(SettingBool, dt_enable_rough_set_filter, true, "Whether to parse where expression as Rough Set Index filter or not.")                                                                                                             \
     M(SettingBool, dt_raw_filter_range, true, "[unused] Do range filter or not when read data in raw mode in DeltaTree Engine.")                                                                                                        \
@@ -185,7 +198,13 @@ struct Settings
     M(SettingBool, dt_flush_after_write, false, "Flush cache or not after write in DeltaTree Engine.")                                                                                                                                  \
     M(SettingBool, dt_enable_relevant_place, false, "Enable relevant place or not in DeltaTree Engine.")                                                                                                                                \
     M(SettingBool, dt_enable_skippable_place, true, "Enable skippable place or not in DeltaTree Engine.")                                                                                                                               \
+    M(SettingUInt64, dt_place_batch_rows, 262144, "Max rows of the consecutive delta blocks that are sorted and placed into the delta index together. 0 means placing the blocks one by one.")                                          \
     M(SettingBool, dt_enable_stable_column_cache, true, "Enable column cache for StorageDeltaMerge.")                                                                                                                                   \
+    M(SettingBool, dt_enable_incremental_merge_delta, false, "Only rewrite the DTFiles of the stable affected by the delta when merging delta in DeltaTree Engine.")                                                                    \
+    M(SettingUInt64, dt_segment_stable_file_limit_rows, 131072, "Max rows of a DTFile in the stable when incremental merge delta is enabled.")                                                                                          \
+    M(SettingUInt64, dt_segment_stable_max_files, 16, "Rewrite the whole stable when merging delta if the stable consists of more DTFiles than this.")                                                                                  \
+    M(SettingUInt64, dt_segment_rewrite_concurrency, 4, "Max number of key ranges that merge delta and physical split of a segment are divided into and rewritten concurrently. 0 or 1 means rewriting in one thread.")                 \
+    M(SettingUInt64, dt_segment_rewrite_min_rows_per_task, 262144, "Min stable rows of each key range when merge delta and physical split of a segment are rewritten concurrently.")                                                    \
     \
     /* These PageStorage V2 settings are deprecated */ \
     M(SettingUInt64, dt_open_file_max_idle_seconds, 15, "Deprecated. Max idle time of opening files, 0 means infinite.")                                                                                                                \
@@ -217,17 +236,21 @@ struct Settings
     M(SettingDouble, dt_page_gc_threshold, 0.5, "Max valid rate of deciding to do a GC in PageStorage")                                                                                                                                 \
     M(SettingBool, dt_enable_read_thread, true, "Enable storage read thread or not")                                                                                                                                                    \
     M(SettingBool, dt_enable_bitmap_filter, true, "Use bitmap filter to read data or not")                                                                                                                                              \
+    M(SettingBool, dt_enable_adaptive_filter_order, true, "Evaluate the pushed down filter conditions in the order of their observed selectivity and cost")                                                                             \
+    M(SettingBool, dt_enable_aggregation_from_pack_stats, false, "Answer COUNT/MIN/MAX without filter from the pack statistics of the fully visible stable packs")                                                                       \
     M(SettingDouble, dt_read_thread_count_scale, 1.0, "Number of read thread = number of logical cpu cores * dt_read_thread_count_scale.  Only has meaning at server startup.")                                                         \
     M(SettingDouble, dt_filecache_max_downloading_count_scale, 1.0, "Max downloading task count of FileCache = io thread count * dt_filecache_max_downloading_count_scale.")                                                            \
     M(SettingUInt64, dt_filecache_min_age_seconds, 1800, "Files of the same priority can only be evicted from files that were not accessed within `dt_filecache_min_age_seconds` seconds.")                                             \
     M(SettingUInt64, dt_small_file_size_threshold, 128 * 1024, "When S3 is enabled, file size less than dt_small_file_size_threshold will be merged before uploading to S3")                                                            \
     M(SettingDouble, dt_merged_file_max_size, 1024 * 1024, "Small files are merged into one or more files not larger than dt_merged_file_max_size")                                                                                     \
     M(SettingDouble, io_thread_count_scale, 5.0, "Number of thread of IOThreadPool = number of logical cpu cores * io_thread_count_scale.  Only has meaning at server startup.")                                                        \
+    M(SettingDouble, dt_segment_rewrite_thread_count_scale, 0.5, "Number of thread of SegmentRewritePool = number of logical cpu cores * dt_segment_rewrite_thread_count_scale.  Only has meaning at server startup.")                  \
     M(SettingUInt64, init_thread_count_scale, 100, "Number of thread = number of logical cpu cores * init_thread_count_scale. It just works for thread pool for initStores and loadMetadata")                                           \
                                                                                                                                                                                                                                         \
     M(SettingChecksumAlgorithm, dt_checksum_algorithm, ChecksumAlgo::XXH3, "Checksum algorithm for delta tree stable storage")                                                                                                          \
     M(SettingCompressionMethod, dt_compression_method, CompressionMethod::LZ4, "The method of data compression when writing.")                                                                                                          \
     M(SettingInt64, dt_compression_level, 1, "The compression level.")                                                                                                                                                                  \
+    M(SettingString, dt_column_compression, "", "The compression of the columns of DTFiles by table and column, e.g. \"45.comment=zstd:9,45.*=lz4,*.*=auto\". Each rule is <physical table id>.<column name>=<lz4|lz4hc|zstd|none|auto>[:level], where the table id and the column name can be *. auto tries all methods on the first pack. The first matching rule is used, and other columns use dt_compression_method.")\
     \
     M(SettingInt64, remote_checkpoint_interval_seconds, 30, "The interval of uploading checkpoint to the remote store. Unit is second.")                                                                                                \
     M(SettingInt64, remote_gc_method, 1, "The method of running GC task on the remote store. 1 - lifecycle, 2 - scan.")                                                                                                                 \
@@ -284,6 +307,9 @@ struct Settings
     M(SettingUInt64, manual_compact_more_until_ms, 60000, "Continuously compact more segments until reaching specified elapsed time. If 0 is specified, only one segment will be compacted each round.")                                \
     M(SettingUInt64, max_bytes_before_external_join, 0, "max bytes used by join before spill, 0 as the default value, 0 means no limit")                                                                                                \
     M(SettingInt64, join_restore_concurrency, 0, "join restore concurrency, negative value means restore join serially, 0 means TiFlash choose restore concurrency automatically, 0 as the default value")                              \
+    M(SettingBool, enable_merge_join, false, "Use merge join instead of hash join when both sides of an inner or left outer join are read in the order of the join keys.")                                                               \
+    M(SettingBool, enable_range_join, false, "Sort the build side of a cross join by the column compared with the probe side in other conditions, and only check the build rows in range.")                                              \
+    M(SettingBool, enable_short_circuit_evaluation, false, "Evaluate the expensive non-first arguments of and, or, if and multiIf only on the rows whose result depends on them.")                                                       \
     M(SettingUInt64, max_cached_data_bytes_in_spiller, 1024ULL * 1024 * 100, "Max cached data bytes in spiller before spilling, 100MB as the default value, 0 means no limit")                                                          \
     M(SettingUInt64, max_spilled_rows_per_file, 200000, "Max spilled data rows per spill file, 200000 as the default value, 0 means no limit.")                                                                                         \
     M(SettingUInt64, max_spilled_bytes_per_file, 0, "Max spilled data bytes per spill file, 0 as the default value, 0 means no limit.")                                                                                                 \
@@ -291,6 +317,7 @@ struct Settings
     M(SettingBool, enable_pipeline, false, "Enable pipeline model")                                                                                                                                                                     \
     M(SettingUInt64, pipeline_cpu_task_thread_pool_size, 0, "The size of cpu task thread pool. 0 means using number_of_logical_cpu_cores.")                                                                                             \
     M(SettingUInt64, pipeline_io_task_thread_pool_size, 0, "The size of io task thread pool. 0 means using number_of_logical_cpu_cores.")                                                                                               \
+    M(SettingFloat, filter_selection_min_ratio, 0.5, "In pipeline model, the filter keeps its result as a selection of the block instead of filtering the columns if at least this ratio of rows pass, then only the columns kept by the following projections are filtered. 0 means disabled.") \
     M(SettingUInt64, local_tunnel_version, 2, "1: not refined, 2: refined")
 // clang-format on
 #define DECLARE(TYPE, NAME, DEFAULT, DESCRIPTION) TYPE NAME{DEFAULT};
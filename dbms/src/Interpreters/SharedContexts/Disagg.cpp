@@ -61,14 +61,21 @@ void SharedContextDisagg::initReadNodePageCache(const PathPool & path_pool, cons
     }
 }
 
-void SharedContextDisagg::initReadNodeDeltaIndexCache(size_t max_size)
+void SharedContextDisagg::initReadNodeDeltaIndexCache(size_t max_size, const String & persist_dir, size_t max_persist_bytes, size_t warmup_count)
 {
     RUNTIME_CHECK(rn_delta_index_cache == nullptr);
 
     if (max_size > 0)
     {
-        LOG_INFO(Logger::get(), "Initialize Read Node delta index cache, max_size={}", max_size);
-        rn_delta_index_cache = std::make_shared<DM::Remote::RNDeltaIndexCache>(max_size);
+        LOG_INFO(
+            Logger::get(),
+            "Initialize Read Node delta index cache, max_size={} persist_dir={} max_persist_bytes={} warmup_count={}",
+            max_size,
+            persist_dir,
+            max_persist_bytes,
+            warmup_count);
+        rn_delta_index_cache = std::make_shared<DM::Remote::RNDeltaIndexCache>(max_size, persist_dir, max_persist_bytes);
+        rn_delta_index_cache->startBackgroundPersist(global_context.getBackgroundPool(), warmup_count);
     }
     else
     {
@@ -66,7 +66,8 @@ struct SharedContextDisagg : private boost::noncopyable
     DB::DM::Remote::RNLocalPageCachePtr rn_page_cache;
 
     /// Only for read node.
-    /// It is a cache for the delta index, stores in the memory.
+    /// It is a cache for the delta index, stores in the memory. It is also persisted to the local disk
+    /// when the remote cache directory is configured, so that it survives restarts.
     DB::DM::Remote::RNDeltaIndexCachePtr rn_delta_index_cache;
 
     static SharedContextDisaggPtr create(Context & global_context_) { return std::make_shared<SharedContextDisagg>(global_context_); }
@@ -80,7 +81,9 @@ struct SharedContextDisagg : private boost::noncopyable
 
     /// Note that the unit of max_size is quantity, not byte size. It controls how
     /// **many** of delta index will be maintained.
-    void initReadNodeDeltaIndexCache(size_t max_size);
+    /// If persist_dir is not empty, the hottest delta indexes within max_persist_bytes are persisted
+    /// into it, and at most warmup_count hottest delta indexes are reloaded in the background at startup.
+    void initReadNodeDeltaIndexCache(size_t max_size, const String & persist_dir, size_t max_persist_bytes, size_t warmup_count);
 
     void initWriteNodeSnapManager();
 
@@ -0,0 +1,169 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Functions/FunctionFactory.h>
+#include <Functions/registerFunctions.h>
+#include <Interpreters/ExpressionActions.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace DB
+{
+namespace tests
+{
+/// The first argument of the benchmarks is the percentage of the rows that need the lazy arguments, all the rows
+/// are evaluated with 100. The second argument is whether the short-circuit evaluation is enabled, the arguments
+/// are evaluated eagerly with 0 as a baseline.
+class ShortCircuitEvaluationBench : public benchmark::Fixture
+{
+public:
+    static constexpr size_t rows = 65536;
+
+    void SetUp(const benchmark::State & state) override
+    {
+        try
+        {
+            registerFunctions();
+        }
+        catch (DB::Exception &)
+        {
+            // Maybe another bench has already registered, ignore exception here.
+        }
+        context = TiFlashTestEnv::getContext();
+
+        std::mt19937_64 rand_gen(0);
+        std::uniform_int_distribution<Int64> percent_dist(0, 99);
+        std::uniform_real_distribution<Float64> real_dist(0, 1);
+        auto returnflag = ColumnString::create();
+        auto url = ColumnString::create();
+        auto price = ColumnFloat64::create();
+        auto discount = ColumnFloat64::create();
+        for (size_t i = 0; i < rows; ++i)
+        {
+            const bool selected = percent_dist(rand_gen) < state.range(0);
+            const String flag = selected ? "R" : "N";
+            returnflag->insertData(flag.data(), flag.size());
+            const String url_value = selected ? fmt::format("http://www.example.com/search?q={}&from=google", i) : "";
+            url->insertData(url_value.data(), url_value.size());
+            price->insert(Field(real_dist(rand_gen) * 100000));
+            discount->insert(Field(real_dist(rand_gen) / 10));
+        }
+        data.insert({std::move(returnflag), std::make_shared<DataTypeString>(), "l_returnflag"});
+        data.insert({std::move(url), std::make_shared<DataTypeString>(), "URL"});
+        data.insert({std::move(price), std::make_shared<DataTypeFloat64>(), "l_extendedprice"});
+        data.insert({std::move(discount), std::make_shared<DataTypeFloat64>(), "l_discount"});
+    }
+
+    void TearDown(const benchmark::State &) override { data.clear(); }
+
+    ExpressionActionsPtr createActions() const
+    {
+        auto actions = std::make_shared<ExpressionActions>(data.getNamesAndTypesList());
+        actions->add(ExpressionAction::addColumn(createConstColumn<String>(1, "R", "'R'")));
+        actions->add(ExpressionAction::addColumn(createConstColumn<String>(1, "", "''")));
+        actions->add(ExpressionAction::addColumn(createConstColumn<String>(1, "%google%", "'%google%'")));
+        actions->add(ExpressionAction::addColumn(createConstColumn<Float64>(1, 0, "0")));
+        actions->add(ExpressionAction::addColumn(createConstColumn<Float64>(1, 1, "1")));
+        actions->add(ExpressionAction::addColumn(createConstColumn<Float64>(1, 1000, "1000")));
+        return actions;
+    }
+
+    String applyFunction(const benchmark::State & state, const ExpressionActionsPtr & actions, const String & func_name, const Names & arguments) const
+    {
+        auto action = ExpressionAction::applyFunction(FunctionFactory::instance().get(func_name, *context), arguments);
+        action.short_circuit = state.range(1) != 0;
+        actions->add(action);
+        return action.result_name;
+    }
+
+    void run(benchmark::State & state, const ExpressionActionsPtr & actions) const
+    {
+        for (auto _ : state)
+        {
+            Block block = data;
+            actions->execute(block);
+            benchmark::DoNotOptimize(block);
+        }
+    }
+
+    ContextPtr context;
+    Block data;
+};
+
+static void shortCircuitArgs(benchmark::internal::Benchmark * bench)
+{
+    for (Int64 percent : {1, 10, 50, 100})
+    {
+        for (Int64 short_circuit : {0, 1})
+            bench->Args({percent, short_circuit});
+    }
+}
+
+/// TPC-H style: sum(case when l_returnflag = 'R' then l_extendedprice * (1 - l_discount) else 0 end).
+BENCHMARK_DEFINE_F(ShortCircuitEvaluationBench, caseWhen)
+(benchmark::State & state)
+try
+{
+    auto actions = createActions();
+    auto is_r = applyFunction(state, actions, "equals", {"l_returnflag", "'R'"});
+    auto minus = applyFunction(state, actions, "minus", {"1", "l_discount"});
+    auto revenue = applyFunction(state, actions, "multiply", {"l_extendedprice", minus});
+    auto result = applyFunction(state, actions, "multiIf", {is_r, revenue, "0"});
+    actions->finalize({result});
+    run(state, actions);
+}
+CATCH
+BENCHMARK_REGISTER_F(ShortCircuitEvaluationBench, caseWhen)->Apply(shortCircuitArgs);
+
+/// ClickBench style: where URL <> '' and URL like '%google%'.
+BENCHMARK_DEFINE_F(ShortCircuitEvaluationBench, andLike)
+(benchmark::State & state)
+try
+{
+    auto actions = createActions();
+    auto not_empty = applyFunction(state, actions, "notEquals", {"URL", "''"});
+    auto like = applyFunction(state, actions, "like", {"URL", "'%google%'"});
+    auto result = applyFunction(state, actions, "and", {not_empty, like});
+    actions->finalize({result});
+    run(state, actions);
+}
+CATCH
+BENCHMARK_REGISTER_F(ShortCircuitEvaluationBench, andLike)->Apply(shortCircuitArgs);
+
+/// Cheap arguments: where l_returnflag = 'R' and l_extendedprice * l_discount > 1000. The lazy argument only has two
+/// functions on numbers, which is the cheapest argument evaluated lazily, compare it with the eager baseline.
+BENCHMARK_DEFINE_F(ShortCircuitEvaluationBench, andCheap)
+(benchmark::State & state)
+try
+{
+    auto actions = createActions();
+    auto is_r = applyFunction(state, actions, "equals", {"l_returnflag", "'R'"});
+    auto discounted = applyFunction(state, actions, "multiply", {"l_extendedprice", "l_discount"});
+    auto greater = applyFunction(state, actions, "greater", {discounted, "1000"});
+    auto result = applyFunction(state, actions, "and", {is_r, greater});
+    actions->finalize({result});
+    run(state, actions);
+}
+CATCH
+BENCHMARK_REGISTER_F(ShortCircuitEvaluationBench, andCheap)->Apply(shortCircuitArgs);
+
+} // namespace tests
+} // namespace DB
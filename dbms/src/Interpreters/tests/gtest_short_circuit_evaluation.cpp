@@ -0,0 +1,253 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Functions/FunctionFactory.h>
+#include <Interpreters/ExpressionActions.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+namespace DB
+{
+namespace tests
+{
+/// `intDiv` throws on division by zero, so an expression only succeeds if the divisions of the rows with `a = 0` are skipped.
+class ShortCircuitEvaluationTest : public FunctionTest
+{
+protected:
+    ExpressionActionsPtr createActions()
+    {
+        auto actions = std::make_shared<ExpressionActions>(NamesAndTypesList{
+            {"a", std::make_shared<DataTypeInt64>()},
+            {"b", std::make_shared<DataTypeInt64>()},
+            {"c", makeNullable(std::make_shared<DataTypeInt64>())},
+        });
+        actions->add(ExpressionAction::addColumn(createConstColumn<Int64>(1, 0, "zero")));
+        actions->add(ExpressionAction::addColumn(createConstColumn<Int64>(1, 1, "one")));
+        return actions;
+    }
+
+    String applyFunction(const ExpressionActionsPtr & actions, const String & func_name, const Names & arguments)
+    {
+        auto action = ExpressionAction::applyFunction(FunctionFactory::instance().get(func_name, *context), arguments);
+        action.short_circuit = short_circuit;
+        actions->add(action);
+        return action.result_name;
+    }
+
+    static Block executeActions(const ExpressionActionsPtr & actions)
+    {
+        Block input{
+            createColumn<Int64>({0, 1, 2, 0, -1}, "a"),
+            createColumn<Int64>({5, 5, 5, 7, 3}, "b"),
+            createColumn<Nullable<Int64>>({0, {}, 1, 0, {}}, "c"),
+        };
+        Block block;
+        for (const auto & name : actions->getRequiredColumns())
+            block.insert(input.getByName(name));
+        actions->execute(block);
+        return block;
+    }
+
+    /// Count the lazy arguments, including the ones inside the lazy arguments.
+    static size_t countLazyArguments(const ExpressionActionsPtr & actions)
+    {
+        size_t count = 0;
+        for (const auto & action : actions->getActions())
+        {
+            for (const auto & lazy : action.lazy_arguments)
+            {
+                if (lazy)
+                    count += 1 + countLazyArguments(lazy);
+            }
+        }
+        return count;
+    }
+
+    bool short_circuit = true;
+};
+
+TEST_F(ShortCircuitEvaluationTest, And)
+try
+{
+    auto actions = createActions();
+    auto not_zero = applyFunction(actions, "notEquals", {"a", "zero"});
+    auto quotient = applyFunction(actions, "intDiv", {"b", "a"});
+    auto greater = applyFunction(actions, "greater", {quotient, "one"});
+    auto result = applyFunction(actions, "and", {not_zero, greater});
+    actions->finalize({result});
+    ASSERT_EQ(countLazyArguments(actions), 1);
+
+    Block block = executeActions(actions);
+    ASSERT_EQ(block.columns(), 1);
+    ASSERT_COLUMN_EQ(createColumn<UInt8>({0, 1, 1, 0, 0}), block.getByName(result));
+}
+CATCH
+
+TEST_F(ShortCircuitEvaluationTest, Or)
+try
+{
+    auto actions = createActions();
+    auto is_zero = applyFunction(actions, "equals", {"a", "zero"});
+    auto quotient = applyFunction(actions, "intDiv", {"b", "a"});
+    auto greater = applyFunction(actions, "greater", {quotient, "one"});
+    auto result = applyFunction(actions, "or", {is_zero, greater});
+    actions->finalize({result});
+    ASSERT_EQ(countLazyArguments(actions), 1);
+
+    Block block = executeActions(actions);
+    ASSERT_COLUMN_EQ(createColumn<UInt8>({1, 1, 1, 1, 0}), block.getByName(result));
+}
+CATCH
+
+TEST_F(ShortCircuitEvaluationTest, MultiIf)
+try
+{
+    auto actions = createActions();
+    auto is_zero = applyFunction(actions, "equals", {"a", "zero"});
+    auto quotient = applyFunction(actions, "intDiv", {"b", "a"});
+    auto is_one = applyFunction(actions, "equals", {"a", "one"});
+    auto negative_quotient = applyFunction(actions, "negate", {quotient});
+    auto inner = applyFunction(actions, "multiIf", {is_one, "b", negative_quotient});
+    auto result = applyFunction(actions, "multiIf", {is_zero, "b", inner});
+    actions->finalize({result});
+    /// `inner` is lazy with all the actions it needs, and `negative_quotient` is lazy again inside it.
+    ASSERT_EQ(countLazyArguments(actions), 2);
+
+    Block block = executeActions(actions);
+    ASSERT_COLUMN_EQ(createColumn<Int64>({5, 5, -2, 7, 3}), block.getByName(result));
+}
+CATCH
+
+TEST_F(ShortCircuitEvaluationTest, SharedArgument)
+try
+{
+    auto actions = createActions();
+    auto not_zero = applyFunction(actions, "notEquals", {"a", "zero"});
+    auto quotient = applyFunction(actions, "intDiv", {"b", "a"});
+    auto negative_quotient = applyFunction(actions, "negate", {quotient});
+    auto greater = applyFunction(actions, "greater", {negative_quotient, "one"});
+    auto result = applyFunction(actions, "and", {not_zero, greater});
+    /// The quotient is also an output, so it is computed for all the rows, but `greater` can still be lazy.
+    actions->finalize({result, quotient});
+    ASSERT_EQ(countLazyArguments(actions), 1);
+    ASSERT_THROW(executeActions(actions), Exception);
+}
+CATCH
+
+TEST_F(ShortCircuitEvaluationTest, NullableCondition)
+try
+{
+    {
+        /// `null and x` depends on x, so x is evaluated on the rows with `c` is null.
+        auto actions = createActions();
+        auto not_zero = applyFunction(actions, "notEquals", {"c", "zero"});
+        auto quotient = applyFunction(actions, "intDiv", {"b", "a"});
+        auto greater = applyFunction(actions, "greater", {quotient, "one"});
+        auto result = applyFunction(actions, "and", {not_zero, greater});
+        actions->finalize({result});
+        ASSERT_EQ(countLazyArguments(actions), 1);
+
+        Block block = executeActions(actions);
+        ASSERT_COLUMN_EQ(createColumn<Nullable<UInt8>>({0, {}, 1, 0, 0}), block.getByName(result));
+    }
+    {
+        /// A null condition of multiIf is not taken, the rows go to the next branches.
+        auto actions = createActions();
+        auto not_zero = applyFunction(actions, "notEquals", {"c", "zero"});
+        auto quotient = applyFunction(actions, "intDiv", {"b", "a"});
+        auto negative_quotient = applyFunction(actions, "negate", {quotient});
+        auto result = applyFunction(actions, "multiIf", {not_zero, negative_quotient, "b"});
+        actions->finalize({result});
+        ASSERT_EQ(countLazyArguments(actions), 1);
+
+        Block block = executeActions(actions);
+        ASSERT_COLUMN_EQ(createColumn<Int64>({5, 5, -2, 7, 3}), block.getByName(result));
+    }
+}
+CATCH
+
+TEST_F(ShortCircuitEvaluationTest, MoreOperands)
+try
+{
+    auto actions = createActions();
+    auto not_zero = applyFunction(actions, "notEquals", {"a", "zero"});
+    auto quotient = applyFunction(actions, "intDiv", {"b", "a"});
+    auto greater = applyFunction(actions, "greater", {quotient, "one"});
+    auto remainder = applyFunction(actions, "modulo", {"b", "a"});
+    auto less = applyFunction(actions, "less", {remainder, "one"});
+    /// The third operand is only evaluated on the rows not decided by the first two.
+    auto result = applyFunction(actions, "and", {not_zero, greater, less});
+    actions->finalize({result});
+    ASSERT_EQ(countLazyArguments(actions), 2);
+
+    Block block = executeActions(actions);
+    ASSERT_COLUMN_EQ(createColumn<UInt8>({0, 1, 0, 0, 0}), block.getByName(result));
+}
+CATCH
+
+TEST_F(ShortCircuitEvaluationTest, Nested)
+try
+{
+    auto actions = createActions();
+    auto is_zero = applyFunction(actions, "equals", {"a", "zero"});
+    auto greater_one = applyFunction(actions, "greater", {"a", "one"});
+    auto quotient = applyFunction(actions, "intDiv", {"b", "a"});
+    auto greater = applyFunction(actions, "greater", {quotient, "one"});
+    auto inner_and = applyFunction(actions, "and", {greater_one, greater});
+    auto inner_if = applyFunction(actions, "multiIf", {inner_and, "one", "zero"});
+    auto result = applyFunction(actions, "or", {is_zero, inner_if});
+    actions->finalize({result});
+    /// `inner_if` is lazy in `or`, `inner_and` is the condition of `inner_if` and its second operand is lazy again.
+    ASSERT_EQ(countLazyArguments(actions), 2);
+
+    Block block = executeActions(actions);
+    ASSERT_COLUMN_EQ(createColumn<UInt8>({1, 0, 1, 1, 0}), block.getByName(result));
+}
+CATCH
+
+TEST_F(ShortCircuitEvaluationTest, CheapArgument)
+try
+{
+    auto actions = createActions();
+    auto not_zero = applyFunction(actions, "notEquals", {"a", "zero"});
+    auto greater = applyFunction(actions, "greater", {"b", "one"});
+    auto result = applyFunction(actions, "and", {not_zero, greater});
+    actions->finalize({result});
+    /// Filtering the inputs of a single cheap function costs more than evaluating it on all the rows.
+    ASSERT_EQ(countLazyArguments(actions), 0);
+
+    Block block = executeActions(actions);
+    ASSERT_COLUMN_EQ(createColumn<UInt8>({0, 1, 1, 0, 1}), block.getByName(result));
+}
+CATCH
+
+TEST_F(ShortCircuitEvaluationTest, Disabled)
+try
+{
+    short_circuit = false;
+    auto actions = createActions();
+    auto not_zero = applyFunction(actions, "notEquals", {"a", "zero"});
+    auto quotient = applyFunction(actions, "intDiv", {"b", "a"});
+    auto greater = applyFunction(actions, "greater", {quotient, "one"});
+    auto result = applyFunction(actions, "and", {not_zero, greater});
+    actions->finalize({result});
+    ASSERT_EQ(countLazyArguments(actions), 0);
+    ASSERT_THROW(executeActions(actions), Exception);
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
@@ -55,7 +55,7 @@ OperatorStatus ExchangeSenderSinkOp::writeImpl(Block && block)
         return OperatorStatus::FINISHED;
     }
 
-    total_rows += block.rows();
+    total_rows += block.selectedRows();
     writer->write(block);
     return OperatorStatus::NEED_INPUT;
 }
@@ -37,6 +37,8 @@ public:
         return "ExchangeSenderSinkOp";
     }
 
+    bool supportSelection() const override { return writer->supportSelection(); }
+
     void operatePrefix() override;
     void operateSuffix() override;
 
@@ -17,10 +17,26 @@
 
 namespace DB
 {
+ExpressionTransformOp::ExpressionTransformOp(
+    PipelineExecutorStatus & exec_status_,
+    const String & req_id,
+    const ExpressionActionsPtr & expression_)
+    : TransformOp(exec_status_, req_id)
+    , expression(expression_)
+    , is_projection_only(expression->isProjectionOnly())
+{}
+
 OperatorStatus ExpressionTransformOp::transformImpl(Block & block)
 {
     if (likely(block))
+    {
+        /// The projection rebuilds the block, so keep its selection.
+        ColumnPtr selection = block.selectionCol();
+        const size_t selected_rows = block.selectedRows();
         expression->execute(block);
+        if (selection)
+            block.setSelection(std::move(selection), selected_rows);
+    }
     return OperatorStatus::HAS_OUTPUT;
 }
 
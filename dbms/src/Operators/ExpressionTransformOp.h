@@ -28,16 +28,16 @@ public:
     ExpressionTransformOp(
         PipelineExecutorStatus & exec_status_,
         const String & req_id,
-        const ExpressionActionsPtr & expression_)
-        : TransformOp(exec_status_, req_id)
-        , expression(expression_)
-    {}
+        const ExpressionActionsPtr & expression_);
 
     String getName() const override
     {
         return "ExpressionTransformOp";
     }
 
+    // A projection only moves the columns, so the input selection is kept and the dropped columns are never filtered.
+    bool supportSelection() const override { return is_projection_only; }
+
 protected:
     OperatorStatus transformImpl(Block & block) override;
 
@@ -45,5 +45,6 @@ protected:
 
 private:
     ExpressionActionsPtr expression;
+    bool is_projection_only;
 };
 } // namespace DB
@@ -28,9 +28,10 @@ public:
         const String & req_id,
         const Block & input_header,
         const ExpressionActionsPtr & expression,
-        const String & filter_column_name)
+        const String & filter_column_name,
+        double selection_min_ratio = 0)
         : TransformOp(exec_status_, req_id)
-        , filter_transform_action(input_header, expression, filter_column_name)
+        , filter_transform_action(input_header, expression, filter_column_name, selection_min_ratio)
     {}
 
     String getName() const override
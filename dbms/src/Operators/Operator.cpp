@@ -77,6 +77,8 @@ OperatorStatus TransformOp::transform(Block & block)
 {
     CHECK_IS_CANCELLED
     // TODO collect operator profile info here.
+    if (block.selectionCol() && !supportSelection())
+        block.materializeSelection();
     auto op_status = transformImpl(block);
 #ifndef NDEBUG
     if (block)
@@ -131,6 +133,8 @@ OperatorStatus SinkOp::write(Block && block)
     }
 #endif
     // TODO collect operator profile info here.
+    if (block.selectionCol() && !supportSelection())
+        block.materializeSelection();
     auto op_status = writeImpl(std::move(block));
 #ifndef NDEBUG
     assertOperatorStatus(op_status, {OperatorStatus::FINISHED, OperatorStatus::NEED_INPUT});
@@ -71,6 +71,10 @@ public:
 
     virtual String getName() const = 0;
 
+    /// Whether the operator handles the input blocks with a selection, see `Block::selectionCol`.
+    /// If not, the selection of the input block is materialized before the block is passed to the operator.
+    virtual bool supportSelection() const { return false; }
+
     /** Get data structure of the operator in a form of "header" block (it is also called "sample block").
       * Header block contains column names, data types, columns of size 0. Constant columns must have corresponding values.
       */
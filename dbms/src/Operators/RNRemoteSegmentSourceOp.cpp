@@ -0,0 +1,161 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/TiFlashMetrics.h>
+#include <Flash/Disaggregated/RNPagePreparer.h>
+#include <Interpreters/Context.h>
+#include <Operators/RNRemoteSegmentSourceOp.h>
+#include <Storages/DeltaMerge/DeltaMergeHelpers.h>
+
+#include <magic_enum.hpp>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+} // namespace ErrorCodes
+
+RNRemoteSegmentSourceOp::RNRemoteSegmentSourceOp(
+    PipelineExecutorStatus & exec_status_,
+    const Context & db_context_,
+    DM::RNRemoteReadTaskPtr read_tasks_,
+    RNPagePreparerPtr page_preparer_,
+    const DM::ColumnDefines & columns_to_read_,
+    const DM::PushDownFilterPtr & push_down_filter_,
+    UInt64 max_version_,
+    size_t expected_block_size_,
+    DM::ReadMode read_mode_,
+    int extra_table_id_index_,
+    const String & req_id)
+    : SourceOp(exec_status_, req_id)
+    , db_context(db_context_)
+    , read_tasks(std::move(read_tasks_))
+    , page_preparer(std::move(page_preparer_))
+    , columns_to_read(columns_to_read_)
+    , push_down_filter(push_down_filter_)
+    , max_version(max_version_)
+    , expected_block_size(std::max(expected_block_size_, static_cast<size_t>(db_context.getSettingsRef().dt_segment_stable_pack_rows)))
+    , read_mode(read_mode_)
+    , extra_table_id_index(extra_table_id_index_)
+{
+    setHeader(DM::toEmptyBlock(columns_to_read));
+    if (extra_table_id_index != InvalidColumnID)
+    {
+        const auto & extra_table_id_col_define = DM::getExtraTableIDColumnDefine();
+        ColumnWithTypeAndName col{extra_table_id_col_define.type->createColumn(), extra_table_id_col_define.type, extra_table_id_col_define.name, extra_table_id_col_define.id, extra_table_id_col_define.default_value};
+        header.insert(extra_table_id_index, col);
+    }
+}
+
+void RNRemoteSegmentSourceOp::operateSuffix()
+{
+    LOG_DEBUG(log, "Finish read {} rows from remote segments, total_wait_task={:.3f}sec, total_build_stream={:.3f}sec", total_rows, seconds_wait_task, seconds_build_stream);
+    GET_METRIC(tiflash_disaggregated_breakdown_duration_seconds, type_seg_next_task).Observe(seconds_wait_task);
+    GET_METRIC(tiflash_disaggregated_breakdown_duration_seconds, type_seg_build_stream).Observe(seconds_build_stream);
+}
+
+OperatorStatus RNRemoteSegmentSourceOp::startNextTask()
+{
+    assert(!cur_read_task);
+    if (!read_tasks->tryNextReadyTask(cur_read_task))
+        return OperatorStatus::WAITING;
+    seconds_wait_task += watch.elapsedSeconds();
+    watch.restart();
+
+    if (!cur_read_task)
+    {
+        // There is no task left or error happen
+        done = true;
+        if (!read_tasks->getErrorMessage().empty())
+            throw Exception(read_tasks->getErrorMessage(), ErrorCodes::LOGICAL_ERROR);
+        LOG_DEBUG(log, "Read from remote segment done");
+        return OperatorStatus::HAS_OUTPUT;
+    }
+    // The segment stream is built in `executeIOImpl`.
+    return OperatorStatus::IO;
+}
+
+OperatorStatus RNRemoteSegmentSourceOp::readImpl(Block & block)
+{
+    if (done)
+    {
+        block = {};
+        return OperatorStatus::HAS_OUTPUT;
+    }
+    if (t_block.has_value())
+    {
+        std::swap(block, t_block.value());
+        t_block.reset();
+        return OperatorStatus::HAS_OUTPUT;
+    }
+    return cur_read_task ? OperatorStatus::IO : startNextTask();
+}
+
+OperatorStatus RNRemoteSegmentSourceOp::awaitImpl()
+{
+    if (done || t_block.has_value())
+        return OperatorStatus::HAS_OUTPUT;
+    return cur_read_task ? OperatorStatus::IO : startNextTask();
+}
+
+OperatorStatus RNRemoteSegmentSourceOp::executeIOImpl()
+{
+    if (done || t_block.has_value())
+        return OperatorStatus::HAS_OUTPUT;
+    assert(cur_read_task);
+
+    if (!cur_stream)
+    {
+        // Note that the segment task could come from different physical tables
+        physical_table_id = cur_read_task->ks_table_id.second;
+        cur_stream = cur_read_task->getInputStream(
+            columns_to_read,
+            cur_read_task->getReadRanges(),
+            max_version,
+            push_down_filter,
+            expected_block_size,
+            read_mode);
+        seconds_build_stream += watch.elapsedSeconds();
+        LOG_TRACE(log, "Read blocks from remote segment begin, segment_id={} state={}", cur_read_task->segment_id, magic_enum::enum_name(cur_read_task->state));
+    }
+
+    FilterPtr filter_ignored = nullptr;
+    Block res = cur_stream->read(filter_ignored, false);
+    if (!res)
+    {
+        LOG_TRACE(log, "Read blocks from remote segment end, segment_id={}", cur_read_task->segment_id);
+        cur_stream = {};
+        cur_read_task = nullptr;
+        watch.restart();
+        // try read from next task
+        return startNextTask();
+    }
+    if (!res.rows())
+        return OperatorStatus::IO;
+
+    if (extra_table_id_index != InvalidColumnID)
+    {
+        assert(physical_table_id != -1);
+
+        const auto & extra_table_id_col_define = DM::getExtraTableIDColumnDefine();
+        ColumnWithTypeAndName col{{}, extra_table_id_col_define.type, extra_table_id_col_define.name, extra_table_id_col_define.id};
+        col.column = col.type->createColumnConst(res.rows(), Field(physical_table_id));
+        res.insert(extra_table_id_index, std::move(col));
+    }
+    total_rows += res.rows();
+    t_block.emplace(std::move(res));
+    return OperatorStatus::HAS_OUTPUT;
+}
+} // namespace DB
@@ -0,0 +1,90 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Stopwatch.h>
+#include <Operators/Operator.h>
+#include <Storages/DeltaMerge/Remote/RNRemoteReadTask.h>
+
+namespace DB
+{
+class RNPagePreparer;
+using RNPagePreparerPtr = std::shared_ptr<RNPagePreparer>;
+
+/// Read blocks from the segment tasks of an RNRemoteReadTask on the disaggregated compute node.
+/// It is the pipeline version of `RNRemoteSegmentThreadInputStream`:
+/// - Waiting for the pages of a segment task being fetched from write nodes is done in `awaitImpl`,
+///   which is polled by the WaitReactor instead of blocking a thread.
+/// - Building the segment stream and reading blocks from it may download files from the remote
+///   storage through FileCache, so they are done in `executeIOImpl` by the IO thread pool.
+class RNRemoteSegmentSourceOp : public SourceOp
+{
+    static constexpr auto NAME = "RNRemoteSegment";
+
+public:
+    RNRemoteSegmentSourceOp(
+        PipelineExecutorStatus & exec_status_,
+        const Context & db_context_,
+        DM::RNRemoteReadTaskPtr read_tasks_,
+        RNPagePreparerPtr page_preparer_,
+        const DM::ColumnDefines & columns_to_read_,
+        const DM::PushDownFilterPtr & push_down_filter_,
+        UInt64 max_version_,
+        size_t expected_block_size_,
+        DM::ReadMode read_mode_,
+        int extra_table_id_index_,
+        const String & req_id);
+
+    String getName() const override { return NAME; }
+
+    void operateSuffix() override;
+
+protected:
+    OperatorStatus readImpl(Block & block) override;
+
+    OperatorStatus awaitImpl() override;
+
+    OperatorStatus executeIOImpl() override;
+
+private:
+    // Try to fetch the next segment task that is ready for reading without blocking.
+    OperatorStatus startNextTask();
+
+private:
+    const Context & db_context;
+    DM::RNRemoteReadTaskPtr read_tasks;
+    // Keep the page preparer alive until all the source ops are finished.
+    RNPagePreparerPtr page_preparer;
+    DM::ColumnDefines columns_to_read;
+    DM::PushDownFilterPtr push_down_filter;
+    const UInt64 max_version;
+    const size_t expected_block_size;
+    const DM::ReadMode read_mode;
+    const int extra_table_id_index;
+    TableID physical_table_id = -1;
+
+    Stopwatch watch;
+    double seconds_wait_task = 0.0;
+    double seconds_build_stream = 0.0;
+
+    size_t total_rows = 0;
+    bool done = false;
+
+    BlockInputStreamPtr cur_stream;
+    DM::RNRemoteSegmentReadTaskPtr cur_read_task; // When reading from cur_stream we need cur_read_task is alive.
+
+    std::optional<Block> t_block;
+};
+} // namespace DB
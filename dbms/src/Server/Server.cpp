@@ -754,6 +754,11 @@ void initThreadPool(Poco::Util::LayeredConfiguration & config)
         /*max_free_threads*/ default_num_threads,
         /*queue_size*/ default_num_threads * 8);
 
+    SegmentRewritePool::initialize(
+        /*max_threads*/ default_num_threads / 2,
+        /*max_free_threads*/ default_num_threads / 4,
+        /*queue_size*/ default_num_threads * 8);
+
     auto disaggregated_mode = getDisaggregatedMode(config);
     if (disaggregated_mode == DisaggregatedMode::Compute)
     {
@@ -789,6 +794,15 @@ void adjustThreadPoolSize(const Settings & settings, size_t logical_cores)
     GlobalThreadPool::instance().setMaxFreeThreads(max_io_thread_count);
     GlobalThreadPool::instance().setQueueSize(max_io_thread_count * 400);
 
+    if (SegmentRewritePool::instance)
+    {
+        // The tasks are CPU bound, so it is bounded by the number of logical cores instead of io threads.
+        size_t max_rewrite_thread_count = std::max(1UL, static_cast<size_t>(std::ceil(settings.dt_segment_rewrite_thread_count_scale * logical_cores)));
+        SegmentRewritePool::instance->setMaxThreads(max_rewrite_thread_count);
+        SegmentRewritePool::instance->setMaxFreeThreads(std::max(1UL, max_rewrite_thread_count / 2));
+        SegmentRewritePool::instance->setQueueSize(max_rewrite_thread_count * 8);
+    }
+
     if (RNPagePreparerPool::instance)
     {
         RNPagePreparerPool::instance->setMaxThreads(max_io_thread_count);
@@ -1096,10 +1110,15 @@ int Server::main(const std::vector<std::string> & /*args*/)
 
     const auto is_compute_mode = global_context->getSharedContextDisagg()->isDisaggregatedComputeMode();
     const auto [remote_cache_paths, remote_cache_capacity_quota] = storage_config.remote_cache_config.getCacheDirInfos(is_compute_mode);
+    // The cold data paths store the stable data like the main data paths.
+    auto stable_data_paths = storage_config.main_data_paths;
+    stable_data_paths.insert(stable_data_paths.end(), storage_config.cold_data_paths.begin(), storage_config.cold_data_paths.end());
+    auto stable_capacity_quota = storage_config.main_capacity_quota;
+    stable_capacity_quota.insert(stable_capacity_quota.end(), storage_config.cold_capacity_quota.begin(), storage_config.cold_capacity_quota.end());
     global_context->initializePathCapacityMetric( //
         global_capacity_quota, //
-        storage_config.main_data_paths,
-        storage_config.main_capacity_quota, //
+        stable_data_paths,
+        stable_capacity_quota, //
         storage_config.latest_data_paths,
         storage_config.latest_capacity_quota,
         remote_cache_paths,
@@ -1110,7 +1129,8 @@ int Server::main(const std::vector<std::string> & /*args*/)
         storage_config.latest_data_paths, //
         storage_config.kvstore_data_path, //
         global_context->getPathCapacity(),
-        global_context->getFileProvider());
+        global_context->getFileProvider(),
+        storage_config.cold_data_paths);
     if (const auto & config = storage_config.remote_cache_config; config.isCacheEnabled() && is_compute_mode)
     {
         config.initCacheDir();
@@ -1387,7 +1407,13 @@ int Server::main(const std::vector<std::string> & /*args*/)
         // TODO: Currently RNDeltaIndexCache caches by number of entities, instead of
         // number of bytes!
 
-        global_context->getSharedContextDisagg()->initReadNodeDeltaIndexCache(n);
+        // The delta indexes are persisted to the local cache directory, so that the compute node
+        // does not need to rebuild them by sorting the whole delta after restarts.
+        const auto & remote_cache_config = storage_config.remote_cache_config;
+        const String persist_dir = remote_cache_config.isCacheEnabled() ? remote_cache_config.getDeltaIndexCacheDir() : "";
+        size_t max_persist_bytes = config().getUInt64("delta_index_cache_disk_size", 1024 * 1024 * 1024);
+        size_t warmup_count = config().getUInt64("delta_index_cache_warmup_count", 200);
+        global_context->getSharedContextDisagg()->initReadNodeDeltaIndexCache(n, persist_dir, max_persist_bytes, warmup_count);
     }
     else
     {
@@ -1395,6 +1421,15 @@ int Server::main(const std::vector<std::string> & /*args*/)
         global_context->setDeltaIndexManager(n);
     }
 
+    /// Size of cache for the responses of cop / batch cop requests. Zero means disabled.
+    /// Compute nodes never handle cop requests, so the cache is useless there.
+    size_t cop_response_cache_size = config().getUInt64("cop_response_cache_size", 0);
+    if (cop_response_cache_size && !global_context->getSharedContextDisagg()->isDisaggregatedComputeMode())
+    {
+        size_t max_entry_size = config().getUInt64("cop_response_cache_max_entry_size", 4 * 1024 * 1024);
+        global_context->setCopResponseCache(cop_response_cache_size, max_entry_size);
+    }
+
     /// Set path for format schema files
     auto format_schema_path = Poco::File(config().getString("format_schema_path", path + "format_schemas/"));
     global_context->setFormatSchemaPath(format_schema_path.path() + "/");
@@ -189,6 +189,34 @@ void TiFlashStorageConfig::parseStoragePath(const String & storage, const Logger
         LOG_INFO(log, "Latest data candidate path: {}, capacity_quota: {}", latest_data_paths[i], latest_capacity_quota[i]);
     }
 
+    // cold
+    if (auto cold_paths = get_checked_qualified_array(table, "cold.dir"); cold_paths)
+        cold_data_paths = *cold_paths;
+    if (auto cold_capacity = table->get_qualified_array_of<int64_t>("cold.capacity"); cold_capacity)
+    {
+        for (const auto & c : *cold_capacity)
+            cold_capacity_quota.emplace_back(static_cast<size_t>(c));
+    }
+    if (!cold_capacity_quota.empty() && cold_capacity_quota.size() != cold_data_paths.size())
+    {
+        String error_msg = fmt::format(
+            "The array size of \"storage.cold.dir\"[size={}] "
+            "is not equal to \"storage.cold.capacity\"[size={}]. "
+            "Please check your configuration file.",
+            cold_data_paths.size(),
+            cold_capacity_quota.size());
+        LOG_ERROR(log, "{}", error_msg);
+        throw Exception(error_msg, ErrorCodes::INVALID_CONFIG_PARAMETER);
+    }
+    for (size_t i = 0; i < cold_data_paths.size(); ++i)
+    {
+        // normalized
+        cold_data_paths[i] = getNormalizedPath(cold_data_paths[i]);
+        if (cold_capacity_quota.size() <= i)
+            cold_capacity_quota.emplace_back(0);
+        LOG_INFO(log, "Cold data candidate path: {}, capacity_quota: {}", cold_data_paths[i], cold_capacity_quota[i]);
+    }
+
     // Raft
     if (auto kvstore_paths = get_checked_qualified_array(table, "raft.dir"); kvstore_paths)
         kvstore_data_path = *kvstore_paths;
@@ -257,6 +285,8 @@ Strings TiFlashStorageConfig::getAllNormalPaths() const
         path_set.insert(s);
     for (const auto & s : latest_data_paths)
         path_set.insert(s);
+    for (const auto & s : cold_data_paths)
+        path_set.insert(s);
     // keep the first path
     all_normal_path.emplace_back(latest_data_paths[0]);
     path_set.erase(latest_data_paths[0]);
@@ -663,6 +693,7 @@ void StorageRemoteCacheConfig::initCacheDir() const
     {
         std::filesystem::create_directories(getDTFileCacheDir());
         std::filesystem::create_directories(getPageCacheDir());
+        std::filesystem::create_directories(getDeltaIndexCacheDir());
     }
 }
 
@@ -684,6 +715,15 @@ String StorageRemoteCacheConfig::getPageCacheDir() const
     // {dir}/page
     return cache_root /= "page";
 }
+String StorageRemoteCacheConfig::getDeltaIndexCacheDir() const
+{
+    if (dir.empty())
+        return "";
+
+    std::filesystem::path cache_root(dir);
+    // {dir}/delta_index
+    return cache_root /= "delta_index";
+}
 
 UInt64 StorageRemoteCacheConfig::getDTFileCapacity() const
 {
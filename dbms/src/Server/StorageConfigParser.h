@@ -132,6 +132,7 @@ struct StorageRemoteCacheConfig
     void initCacheDir() const;
     String getDTFileCacheDir() const;
     String getPageCacheDir() const;
+    String getDeltaIndexCacheDir() const;
     UInt64 getDTFileCapacity() const;
     UInt64 getPageCapacity() const;
     UInt64 getReservedCapacity() const;
@@ -147,6 +148,9 @@ public:
     std::vector<size_t> main_capacity_quota;
     Strings latest_data_paths;
     std::vector<size_t> latest_capacity_quota;
+    // The paths to store the stable data of the segments that are rarely accessed. Empty means disabled.
+    Strings cold_data_paths;
+    std::vector<size_t> cold_capacity_quota;
     Strings kvstore_data_path;
 
     UInt64 format_version = 0;
@@ -0,0 +1,191 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnsCommon.h>
+#include <Columns/FilterDescription.h>
+#include <Common/Stopwatch.h>
+#include <Storages/DeltaMerge/AdaptiveFilterBlockInputStream.h>
+#include <common/logger_useful.h>
+#include <fmt/ranges.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace DB::DM
+{
+namespace
+{
+// The smaller the rank, the earlier the predicate should be evaluated.
+// A predicate that never evaluated has the smallest rank, so that its statistics can be collected.
+double rank(const ScanContext::PushDownPredicateStat & stat)
+{
+    if (stat.input_rows == 0)
+        return 0;
+    const double cost_per_row = (stat.eval_time_ns + 1.0) / stat.input_rows;
+    const double filtered_ratio = 1.0 - static_cast<double>(stat.passed_rows) / stat.input_rows;
+    return cost_per_row / std::max(filtered_ratio, 0.001);
+}
+} // namespace
+
+AdaptiveFilterBlockInputStream::AdaptiveFilterBlockInputStream(
+    const BlockInputStreamPtr & input,
+    const PushDownPredicates & predicates_,
+    const ScanContextPtr & scan_context_,
+    const String & req_id)
+    : predicates(predicates_)
+    , scan_context(scan_context_)
+    , order(predicates.size())
+    , local_stats(predicates.size())
+    , unreported_stats(predicates.size())
+    , log(Logger::get(req_id))
+{
+    RUNTIME_CHECK(!predicates.empty());
+    children.push_back(input);
+    std::iota(order.begin(), order.end(), 0);
+    // Start with the order learned by the other streams of the same table scan.
+    if (auto stats = scan_context->getPushDownPredicateStats(); stats.size() == predicates.size())
+        reorder(stats);
+}
+
+Block AdaptiveFilterBlockInputStream::readImpl(FilterPtr & res_filter, bool return_filter)
+{
+    // Until non-empty block after filtering or end of stream.
+    while (true)
+    {
+        Block block = children.back()->read();
+        if (!block)
+            return block;
+
+        const size_t rows = block.rows();
+        const size_t passed_rows = evaluate(block);
+
+        if (++blocks_since_reorder >= REORDER_INTERVAL_BLOCKS)
+        {
+            if (reorder(local_stats))
+                scan_context->total_pushdown_predicate_reorder_times += 1;
+            // Decay the statistics, so that the recent blocks weigh more.
+            for (auto & stat : local_stats)
+            {
+                stat.input_rows /= 2;
+                stat.passed_rows /= 2;
+                stat.eval_time_ns /= 2;
+            }
+            reportStats();
+            blocks_since_reorder = 0;
+        }
+
+        if (return_filter)
+        {
+            res_filter = passed_rows == rows ? nullptr : &filter;
+            return block;
+        }
+
+        if (passed_rows == 0)
+            continue;
+        if (passed_rows < rows)
+        {
+            for (auto & col : block)
+                col.column = col.column->filter(filter, passed_rows);
+        }
+        return block;
+    }
+}
+
+size_t AdaptiveFilterBlockInputStream::evaluate(const Block & block)
+{
+    const size_t rows = block.rows();
+    filter.assign(rows, static_cast<UInt8>(1));
+
+    // Only the rows that passed the evaluated predicates are kept in `working_block`.
+    Block working_block = block;
+    size_t working_rows = rows;
+    for (size_t k = 0; k < order.size() && working_rows > 0; ++k)
+    {
+        const auto & predicate = predicates[order[k]];
+        Stopwatch watch;
+
+        Block eval_block = working_block;
+        predicate.actions->execute(eval_block);
+        const auto & filter_column = eval_block.getByName(predicate.filter_column_name).column;
+
+        size_t passed_rows = working_rows;
+        ConstantFilterDescription constant_filter_description(*filter_column);
+        if (constant_filter_description.always_false)
+        {
+            passed_rows = 0;
+            std::fill(filter.begin(), filter.end(), 0);
+        }
+        else if (!constant_filter_description.always_true)
+        {
+            FilterDescription filter_description(*filter_column);
+            const auto & predicate_filter = *filter_description.data;
+            passed_rows = countBytesInFilter(predicate_filter);
+            if (passed_rows < working_rows)
+            {
+                // Map the filter of the working rows back to the whole block.
+                for (size_t pos = 0, j = 0; pos < rows; ++pos)
+                {
+                    if (filter[pos])
+                        filter[pos] = predicate_filter[j++] != 0;
+                }
+                if (passed_rows > 0 && k + 1 < order.size())
+                {
+                    for (auto & col : working_block)
+                        col.column = col.column->filter(predicate_filter, passed_rows);
+                }
+            }
+        }
+
+        const auto elapsed = watch.elapsed();
+        for (auto * stats : {&local_stats, &unreported_stats})
+        {
+            auto & stat = (*stats)[order[k]];
+            stat.input_rows += working_rows;
+            stat.passed_rows += passed_rows;
+            stat.eval_time_ns += elapsed;
+        }
+        working_rows = passed_rows;
+    }
+    return working_rows;
+}
+
+bool AdaptiveFilterBlockInputStream::reorder(const ScanContext::PushDownPredicateStats & stats)
+{
+    std::vector<double> ranks(stats.size());
+    for (size_t i = 0; i < stats.size(); ++i)
+        ranks[i] = rank(stats[i]);
+
+    auto new_order = order;
+    // Stable sort to keep the current order of predicates with the same rank.
+    std::stable_sort(new_order.begin(), new_order.end(), [&](size_t lhs, size_t rhs) { return ranks[lhs] < ranks[rhs]; });
+    if (new_order == order)
+        return false;
+
+    LOG_DEBUG(log, "Reorder pushed down predicates from [{}] to [{}]", fmt::join(order, ","), fmt::join(new_order, ","));
+    order.swap(new_order);
+    return true;
+}
+
+void AdaptiveFilterBlockInputStream::reportStats()
+{
+    scan_context->mergePushDownPredicateStats(unreported_stats);
+    std::fill(unreported_stats.begin(), unreported_stats.end(), ScanContext::PushDownPredicateStat{});
+}
+
+void AdaptiveFilterBlockInputStream::readSuffixImpl()
+{
+    reportStats();
+}
+
+} // namespace DB::DM
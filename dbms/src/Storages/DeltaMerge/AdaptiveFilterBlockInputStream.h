@@ -0,0 +1,93 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <DataStreams/IProfilingBlockInputStream.h>
+#include <Storages/DeltaMerge/Filter/PushDownFilter.h>
+#include <Storages/DeltaMerge/ScanContext.h>
+
+namespace DB::DM
+{
+
+/** BlockInputStream to evaluate the pushed down predicates one by one in an adaptive order.
+  * 1. Evaluate the predicates in the ascending order of `cost_per_row / (1 - selectivity)`,
+  *    each predicate is only evaluated on the rows that passed the predicates before it.
+  * 2. Collect the selectivity and cost of each predicate, and re-sort the predicates every
+  *    `REORDER_INTERVAL_BLOCKS` blocks. The statistics decay so that the order follows
+  *    the change of data distribution.
+  * 3. Report the statistics to ScanContext, the streams created later by the same table scan
+  *    start with the order learned by the previous ones.
+  *
+  * The returned block is not filtered when `return_filter` is true, like FilterBlockInputStream.
+  * Different from FilterBlockInputStream, no tmp filter column is added to the returned block.
+  */
+class AdaptiveFilterBlockInputStream : public IProfilingBlockInputStream
+{
+    static constexpr auto NAME = "AdaptiveFilter";
+
+public:
+    static constexpr size_t REORDER_INTERVAL_BLOCKS = 8;
+
+    AdaptiveFilterBlockInputStream(
+        const BlockInputStreamPtr & input,
+        const PushDownPredicates & predicates_,
+        const ScanContextPtr & scan_context_,
+        const String & req_id);
+
+    String getName() const override { return NAME; }
+    Block getHeader() const override { return children.back()->getHeader(); }
+
+    /// The current evaluation order, each element is the index of a predicate in the DAG request.
+    const std::vector<size_t> & getOrder() const { return order; }
+
+protected:
+    Block readImpl() override
+    {
+        FilterPtr filter_ignored;
+        return readImpl(filter_ignored, false);
+    }
+
+    // Note: When return_filter is true, res_filter will be point to a filter owned by this stream,
+    // which is valid until the next read. If res_filter is nullptr, it means all rows passed.
+    Block readImpl(FilterPtr & res_filter, bool return_filter) override;
+
+    void readSuffixImpl() override;
+
+private:
+    // Evaluate the predicates on the block and fill `filter`, return the number of passed rows.
+    size_t evaluate(const Block & block);
+
+    // Sort the predicates by their rank, return true if the order is changed.
+    bool reorder(const ScanContext::PushDownPredicateStats & stats);
+
+    void reportStats();
+
+private:
+    const PushDownPredicates predicates;
+    const ScanContextPtr scan_context;
+
+    std::vector<size_t> order;
+    // Decayed statistics used for ordering.
+    ScanContext::PushDownPredicateStats local_stats;
+    // Statistics not reported to scan_context yet.
+    ScanContext::PushDownPredicateStats unreported_stats;
+    size_t blocks_since_reorder = 0;
+
+    IColumn::Filter filter;
+
+    const LoggerPtr log;
+};
+
+} // namespace DB::DM
@@ -0,0 +1,194 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Storages/DeltaMerge/BackgroundTaskScheduler.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace DB::DM
+{
+namespace
+{
+constexpr double LATENCY_DECAY_SECONDS = 10.0;
+} // namespace
+
+BackgroundTaskScheduler & BackgroundTaskScheduler::instance()
+{
+    static BackgroundTaskScheduler scheduler;
+    return scheduler;
+}
+
+void BackgroundTaskScheduler::addPendingTask(Priority priority)
+{
+    if (priority != Priority::WriteStallRelief)
+        return;
+    std::lock_guard lock(mutex);
+    ++pending_urgent_tasks;
+}
+
+void BackgroundTaskScheduler::removePendingTask(Priority priority)
+{
+    if (priority != Priority::WriteStallRelief)
+        return;
+    std::vector<WakeHandle> handles;
+    {
+        std::lock_guard lock(mutex);
+        RUNTIME_CHECK(pending_urgent_tasks > 0);
+        --pending_urgent_tasks;
+        if (pending_urgent_tasks == 0)
+            handles = takeWaitingHandles();
+    }
+    wakeAll(handles);
+}
+
+BackgroundTaskScheduler::Decision BackgroundTaskScheduler::tryStartTask(
+    const TaskDesc & task,
+    const Limits & limits,
+    const WakeHandle & waker,
+    Clock::time_point now)
+{
+    std::lock_guard lock(mutex);
+
+    auto decision = Decision::Run;
+    // Tasks that relieve write stalls are never deferred, and tasks that have exceeded their deadlines are
+    // not deferred by the foreground. Both of them still take the slots of the disk, so that other tasks
+    // on the same disk are deferred.
+    if (task.priority != Priority::WriteStallRelief)
+    {
+        if (task.priority == Priority::Low && pending_urgent_tasks > 0 && !task.deadline_exceeded)
+            decision = Decision::DeferByUrgentTasks;
+        else if (limits.throttle_read_latency_ms > 0 && !task.deadline_exceeded)
+        {
+            decayLatency(now);
+            if (latency_count >= 1.0 && latency_sum / latency_count * 1000 > limits.throttle_read_latency_ms)
+                decision = Decision::DeferByForegroundLatency;
+        }
+
+        if (decision == Decision::Run && task.is_heavy && limits.max_heavy_tasks_per_disk > 0)
+        {
+            if (auto iter = running_heavy_tasks.find(task.disk);
+                iter != running_heavy_tasks.end() && iter->second >= limits.max_heavy_tasks_per_disk)
+                decision = Decision::DeferByDiskBudget;
+        }
+    }
+
+    if (decision != Decision::Run)
+    {
+        auto same_handle = [&](const WakeHandle & h) {
+            return !h.owner_before(waker) && !waker.owner_before(h);
+        };
+        if (!waker.expired() && std::none_of(waiting_handles.begin(), waiting_handles.end(), same_handle))
+            waiting_handles.push_back(waker);
+        return decision;
+    }
+
+    if (task.is_heavy)
+        ++running_heavy_tasks[task.disk];
+    return decision;
+}
+
+void BackgroundTaskScheduler::finishTask(const TaskDesc & task)
+{
+    if (!task.is_heavy)
+        return;
+    std::vector<WakeHandle> handles;
+    {
+        std::lock_guard lock(mutex);
+        auto iter = running_heavy_tasks.find(task.disk);
+        RUNTIME_CHECK(iter != running_heavy_tasks.end() && iter->second > 0, task.disk);
+        if (--iter->second == 0)
+            running_heavy_tasks.erase(iter);
+        handles = takeWaitingHandles();
+    }
+    wakeAll(handles);
+}
+
+void BackgroundTaskScheduler::recordForegroundReadLatency(double seconds, Clock::time_point now)
+{
+    std::lock_guard lock(mutex);
+    decayLatency(now);
+    latency_sum += seconds;
+    latency_count += 1;
+}
+
+double BackgroundTaskScheduler::getForegroundReadLatency(Clock::time_point now)
+{
+    std::lock_guard lock(mutex);
+    decayLatency(now);
+    // Too few samples in the recent seconds means there are almost no foreground reads.
+    return latency_count >= 1.0 ? latency_sum / latency_count : 0.0;
+}
+
+bool BackgroundTaskScheduler::tryAcquireMigrationBytes(size_t bytes, UInt64 max_bytes_per_sec, Clock::time_point now)
+{
+    if (max_bytes_per_sec == 0)
+        return true;
+
+    std::lock_guard lock(mutex);
+    const auto max_budget = static_cast<double>(max_bytes_per_sec);
+    if (!migration_last_refill)
+        migration_budget = max_budget;
+    else if (now > *migration_last_refill)
+        migration_budget = std::min(max_budget, migration_budget + std::chrono::duration<double>(now - *migration_last_refill).count() * max_budget);
+    migration_last_refill = std::max(now, migration_last_refill.value_or(now));
+
+    if (migration_budget <= 0)
+        return false;
+    migration_budget -= bytes;
+    return true;
+}
+
+size_t BackgroundTaskScheduler::pendingUrgentTasks()
+{
+    std::lock_guard lock(mutex);
+    return pending_urgent_tasks;
+}
+
+size_t BackgroundTaskScheduler::runningHeavyTasks(const String & disk)
+{
+    std::lock_guard lock(mutex);
+    auto iter = running_heavy_tasks.find(disk);
+    return iter == running_heavy_tasks.end() ? 0 : iter->second;
+}
+
+void BackgroundTaskScheduler::decayLatency(Clock::time_point now)
+{
+    if (now <= latency_last_update)
+        return;
+    auto factor = std::exp(-std::chrono::duration<double>(now - latency_last_update).count() / LATENCY_DECAY_SECONDS);
+    latency_sum *= factor;
+    latency_count *= factor;
+    latency_last_update = now;
+}
+
+std::vector<BackgroundTaskScheduler::WakeHandle> BackgroundTaskScheduler::takeWaitingHandles()
+{
+    std::vector<WakeHandle> handles;
+    handles.swap(waiting_handles);
+    return handles;
+}
+
+void BackgroundTaskScheduler::wakeAll(const std::vector<WakeHandle> & handles)
+{
+    // Must be called without holding `mutex`, because waking up a handle locks the background pool.
+    for (const auto & h : handles)
+    {
+        if (auto handle = h.lock(); handle)
+            handle->wake();
+    }
+}
+
+} // namespace DB::DM
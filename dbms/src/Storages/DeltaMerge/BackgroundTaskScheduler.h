@@ -0,0 +1,130 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Storages/BackgroundProcessingPool.h>
+#include <common/types.h>
+
+#include <boost/noncopyable.hpp>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace DB::DM
+{
+/// BackgroundTaskScheduler gives the background tasks of all DeltaMergeStores a global view of
+/// - the tasks that relieve write stalls, which are pending in any store,
+/// - the heavy tasks (merge delta and split) that are running on each disk,
+/// - the latency of the foreground reads,
+/// - the bytes moved between the storage tiers.
+/// Each store still keeps its own task queues, and asks the scheduler whether the first task of a queue
+/// can run now before popping it. A deferred store is woken up when the reason of deferring is gone.
+class BackgroundTaskScheduler : private boost::noncopyable
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// A smaller value means a higher priority.
+    enum class Priority
+    {
+        // Tasks that keep the write threads away from the foreground flush, merge delta and split.
+        WriteStallRelief = 0,
+        Normal = 1,
+        // Tasks that only improve the read performance, e.g. compact and place delta index.
+        Low = 2,
+    };
+
+    enum class Decision
+    {
+        Run,
+        DeferByDiskBudget,
+        DeferByUrgentTasks,
+        DeferByForegroundLatency,
+    };
+
+    struct Limits
+    {
+        // 0 means unlimited.
+        size_t max_heavy_tasks_per_disk = 0;
+        // 0 means never throttled by the foreground latency.
+        UInt64 throttle_read_latency_ms = 0;
+    };
+
+    struct TaskDesc
+    {
+        Priority priority = Priority::Normal;
+        bool is_heavy = false;
+        bool deadline_exceeded = false;
+        // The disk that the task mainly reads from and writes to.
+        String disk;
+    };
+
+    using WakeHandle = std::weak_ptr<BackgroundProcessingPool::TaskInfo>;
+
+    static BackgroundTaskScheduler & instance();
+
+    /// Called when a task is pushed into or popped from (or dropped with) the queue of a store.
+    void addPendingTask(Priority priority);
+    void removePendingTask(Priority priority);
+
+    /// Decide whether the task can run now. If the decision is `Run` and the task is heavy, a slot of the disk
+    /// is taken and must be returned by `finishTask`. Otherwise `waker` is woken up when a slot is returned
+    /// or when there are no pending tasks that relieve write stalls.
+    Decision tryStartTask(const TaskDesc & task, const Limits & limits, const WakeHandle & waker, Clock::time_point now = Clock::now());
+    void finishTask(const TaskDesc & task);
+
+    /// Record the time that a query waits for a block from the storage layer.
+    void recordForegroundReadLatency(double seconds, Clock::time_point now = Clock::now());
+    /// The average waiting time in the recent seconds, which decays exponentially with a time constant of 10 seconds.
+    double getForegroundReadLatency(Clock::time_point now = Clock::now());
+
+    /// Take `bytes` from the budget of moving the stable data between the storage tiers, which is refilled at
+    /// `max_bytes_per_sec` and holds at most one second of it. Returns false if the budget is used up. A migration
+    /// may take more than the budget left, and the following ones wait until the debt is paid off, so that the
+    /// average rate is bounded. 0 means unlimited.
+    bool tryAcquireMigrationBytes(size_t bytes, UInt64 max_bytes_per_sec, Clock::time_point now = Clock::now());
+
+    size_t pendingUrgentTasks();
+    size_t runningHeavyTasks(const String & disk);
+
+#ifndef DBMS_PUBLIC_GTEST
+private:
+#else
+public:
+#endif
+    BackgroundTaskScheduler() = default;
+
+    void decayLatency(Clock::time_point now);
+    std::vector<WakeHandle> takeWaitingHandles();
+    static void wakeAll(const std::vector<WakeHandle> & handles);
+
+    std::mutex mutex;
+
+    size_t pending_urgent_tasks = 0;
+    std::unordered_map<String, size_t> running_heavy_tasks;
+    std::vector<WakeHandle> waiting_handles;
+
+    double latency_sum = 0;
+    double latency_count = 0;
+    Clock::time_point latency_last_update;
+
+    double migration_budget = 0;
+    std::optional<Clock::time_point> migration_last_refill;
+};
+
+} // namespace DB::DM
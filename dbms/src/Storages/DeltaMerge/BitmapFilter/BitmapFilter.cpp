@@ -105,6 +105,16 @@ void BitmapFilter::rangeAnd(IColumn::Filter & f, UInt32 start, UInt32 limit) con
     }
 }
 
+bool BitmapFilter::isAllMatch(UInt32 start, UInt32 limit) const
+{
+    RUNTIME_CHECK(start + limit <= filter.size(), start, limit, filter.size());
+    if (all_match)
+        return true;
+    auto begin = filter.cbegin() + start;
+    auto end = filter.cbegin() + start + limit;
+    return std::find(begin, end, false) == end;
+}
+
 void BitmapFilter::runOptimize()
 {
     all_match = std::find(filter.begin(), filter.end(), false) == filter.end();
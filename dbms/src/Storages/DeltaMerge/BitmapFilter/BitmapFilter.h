@@ -33,6 +33,8 @@ public:
     bool get(IColumn::Filter & f, UInt32 start, UInt32 limit) const;
     // filter[start, limit] & f -> f
     void rangeAnd(IColumn::Filter & f, UInt32 start, UInt32 limit) const;
+    // Return true if all data in [start, start + limit) is match.
+    bool isAllMatch(UInt32 start, UInt32 limit) const;
 
     void runOptimize();
 
@@ -64,6 +64,10 @@ struct DMContext : private boost::noncopyable
     const size_t segment_limit_bytes;
     // The bytes threshold of fg split segment.
     const size_t segment_force_split_bytes;
+    // Segments read more times per minute than this are split at a smaller size and are not merged.
+    const size_t segment_hot_read_per_minute;
+    // Cold segments are merged until the merged one reaches the segment limit * this ratio.
+    const double segment_cold_merge_ratio;
     // The rows threshold of delta.
     const size_t delta_limit_rows;
     // The bytes threshold of delta.
@@ -87,6 +91,28 @@ struct DMContext : private boost::noncopyable
     const bool read_stable_only;
     const bool enable_relevant_place;
     const bool enable_skippable_place;
+    // Max rows of the consecutive delta blocks that are placed together.
+    const size_t place_batch_rows;
+    // Only rewrite the DTFiles of the stable that are affected by the delta when merging delta.
+    const bool enable_incremental_merge_delta;
+    // The max rows of a DTFile in the stable when incremental merge delta is enabled.
+    const size_t stable_file_limit_rows;
+    // Rewrite the whole stable when it consists of more DTFiles than this.
+    const size_t stable_max_files;
+    // Max number of key ranges that merge delta and physical split are divided into and rewritten concurrently.
+    const size_t segment_rewrite_concurrency;
+    // Min stable rows of each key range that is rewritten concurrently.
+    const size_t segment_rewrite_min_rows_per_task;
+    // Max number of running merge delta and split tasks on the same disk. 0 means unlimited.
+    const size_t bg_task_max_heavy_per_disk;
+    // Defer background tasks when the foreground read latency is above this value. 0 means disabled.
+    const UInt64 bg_task_throttle_read_latency_ms;
+    // Move the stable of the segments not written for this number of days and rarely read to the cold tier. 0 means disabled.
+    const UInt64 tier_cold_after_days;
+    // Move the stable of the segments on the cold tier back when they are read more times per minute than this.
+    const double tier_promote_read_per_minute;
+    // Max bytes per second moved between tiers. 0 means unlimited.
+    const UInt64 tier_migration_max_bytes_per_sec;
 
     String tracing_id;
 
@@ -115,6 +141,8 @@ public:
         , segment_limit_rows(settings.dt_segment_limit_rows)
         , segment_limit_bytes(settings.dt_segment_limit_size)
         , segment_force_split_bytes(settings.dt_segment_force_split_size)
+        , segment_hot_read_per_minute(settings.dt_segment_hot_read_per_minute)
+        , segment_cold_merge_ratio(settings.dt_segment_cold_merge_ratio)
         , delta_limit_rows(settings.dt_segment_delta_limit_rows)
         , delta_limit_bytes(settings.dt_segment_delta_limit_size)
         , delta_cache_limit_rows(settings.dt_segment_delta_cache_limit_rows)
@@ -127,6 +155,17 @@ public:
         , read_stable_only(settings.dt_read_stable_only)
         , enable_relevant_place(settings.dt_enable_relevant_place)
         , enable_skippable_place(settings.dt_enable_skippable_place)
+        , place_batch_rows(settings.dt_place_batch_rows)
+        , enable_incremental_merge_delta(settings.dt_enable_incremental_merge_delta)
+        , stable_file_limit_rows(settings.dt_segment_stable_file_limit_rows)
+        , stable_max_files(settings.dt_segment_stable_max_files)
+        , segment_rewrite_concurrency(settings.dt_segment_rewrite_concurrency)
+        , segment_rewrite_min_rows_per_task(settings.dt_segment_rewrite_min_rows_per_task)
+        , bg_task_max_heavy_per_disk(settings.dt_bg_task_max_heavy_per_disk)
+        , bg_task_throttle_read_latency_ms(settings.dt_bg_task_throttle_read_latency_ms)
+        , tier_cold_after_days(settings.dt_tier_cold_after_days)
+        , tier_promote_read_per_minute(settings.dt_tier_promote_read_per_minute)
+        , tier_migration_max_bytes_per_sec(settings.dt_tier_migration_max_bytes_per_sec)
         , tracing_id(tracing_id_)
         , scan_context(scan_context_ ? scan_context_ : std::make_shared<ScanContext>())
     {
@@ -40,6 +40,7 @@ class DMSegmentThreadInputStream : public IProfilingBlockInputStream
 
 public:
     /// If handle_real_type_ is empty, means do not convert handle column back to real type.
+    /// `sort_description_` is the order of the output, which is not empty only if the tasks are read in order of their ranges.
     DMSegmentThreadInputStream(
         const DMContextPtr & dm_context_,
         const SegmentReadTaskPoolPtr & task_pool_,
@@ -51,7 +52,8 @@ public:
         ReadMode read_mode_,
         const int extra_table_id_index,
         const TableID physical_table_id,
-        const String & req_id)
+        const String & req_id,
+        const SortDescription & sort_description_ = {})
         : dm_context(dm_context_)
         , task_pool(task_pool_)
         , after_segment_read(after_segment_read_)
@@ -62,6 +64,7 @@ public:
         , expected_block_size(expected_block_size_)
         , read_mode(read_mode_)
         , action(header, extra_table_id_index, physical_table_id)
+        , sort_description(sort_description_)
         , log(Logger::get(req_id))
     {
         if (extra_table_id_index != InvalidColumnID)
@@ -76,6 +79,9 @@ public:
 
     Block getHeader() const override { return header; }
 
+    bool isSortedOutput() const override { return !sort_description.empty(); }
+    const SortDescription & getSortDescription() const override { return sort_description; }
+
 protected:
     Block readImpl() override
     {
@@ -151,6 +157,7 @@ private:
 
     SegmentPtr cur_segment;
     SegmentReadTransformAction action;
+    SortDescription sort_description;
 
     LoggerPtr log;
 };
@@ -72,6 +72,20 @@ Block DMVersionFilterBlockInputStream<MODE>::read(FilterPtr & res_filter, bool r
             return getNewBlock(cur_raw_block);
         }
 
+        if constexpr (MODE == DM_VERSION_FILTER_MODE_MVCC)
+        {
+            if (scan_context)
+            {
+                // Rows in a clean read block are never newer than `version_limit`, only count the rows here.
+                size_t newer_version_rows = 0;
+                const auto * version_pos = version_col_data->data();
+                for (size_t i = 0; i < rows; ++i)
+                    newer_version_rows += version_pos[i] > version_limit;
+                if (newer_version_rows > 0)
+                    scan_context->total_mvcc_newer_version_rows += newer_version_rows;
+            }
+        }
+
         filter.resize(rows);
 
         const size_t batch_rows = (rows - 1) / UNROLL_BATCH * UNROLL_BATCH;
@@ -21,6 +21,7 @@
 #include <DataStreams/SelectionByColumnIdTransformAction.h>
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
+#include <Storages/DeltaMerge/ScanContext.h>
 #include <common/logger_useful.h>
 
 namespace DB
@@ -48,9 +49,11 @@ public:
                                     const ColumnDefines & read_columns,
                                     UInt64 version_limit_,
                                     bool is_common_handle_,
-                                    const String & tracing_id = "")
+                                    const String & tracing_id = "",
+                                    const ScanContextPtr & scan_context_ = nullptr)
         : version_limit(version_limit_)
         , is_common_handle(is_common_handle_)
+        , scan_context(scan_context_)
         , header(toEmptyBlock(read_columns))
         , select_by_colid_action(input->getHeader(), header)
         , log(Logger::get((MODE == DM_VERSION_FILTER_MODE_MVCC ? MVCC_FILTER_NAME : COMPACT_FILTER_NAME),
@@ -220,6 +223,8 @@ private:
 private:
     const UInt64 version_limit;
     const bool is_common_handle;
+    // Used for reporting the rows newer than `version_limit` in MVCC mode, can be nullptr.
+    const ScanContextPtr scan_context;
     // A sample block of `read` get
     const Block header;
 
@@ -104,8 +104,94 @@ namespace DM
 //   MergeDeltaTaskPool
 // ================================================
 
+namespace
+{
+// The expected time from a task being added to it being started. Tasks that exceed their deadlines are popped
+// before other tasks with the same priority, and are not deferred by the foreground any more.
+BackgroundTaskScheduler::Clock::duration getTaskDeadlineBudget(DeltaMergeStore::TaskType type)
+{
+    using namespace std::chrono_literals;
+    switch (type)
+    {
+    case DeltaMergeStore::TaskType::Flush:
+        return 10s;
+    case DeltaMergeStore::TaskType::MergeDelta:
+    case DeltaMergeStore::TaskType::PlaceIndex:
+        return 60s;
+    case DeltaMergeStore::TaskType::Split:
+    case DeltaMergeStore::TaskType::Compact:
+        return 120s;
+    }
+    return 60s;
+}
+
+// Heavy tasks are limited by the disk that the stable of the segment is stored on. The disk is identified by
+// the root data path instead of the path of the table, so that the tasks of all tables on it share the budget.
+String getTaskDisk(const DeltaMergeStore::BackgroundTask & task)
+{
+    const auto & files = task.segment->getStable()->getDMFiles();
+    if (files.empty())
+        return "";
+    return task.dm_context->path_pool->getStableDiskDelegator().getDTFileStorageRoot(files.front()->fileId());
+}
+
+void observeTaskStarted(const DeltaMergeStore::BackgroundTask & task, BackgroundTaskScheduler::Clock::time_point now)
+{
+    auto wait_seconds = std::chrono::duration<double>(now - task.add_time).count();
+    bool deadline_exceeded = now >= task.deadline;
+    switch (task.type)
+    {
+#define M(TYPE, METRIC_TYPE)                                                                         \
+    case DeltaMergeStore::TaskType::TYPE:                                                            \
+        GET_METRIC(tiflash_storage_bg_task_wait_seconds, METRIC_TYPE).Observe(wait_seconds);         \
+        if (deadline_exceeded)                                                                       \
+            GET_METRIC(tiflash_storage_bg_task_deadline_exceeded_count, METRIC_TYPE).Increment();    \
+        break;
+        M(Flush, type_flush)
+        M(Compact, type_compact)
+        M(MergeDelta, type_merge_delta)
+        M(Split, type_split)
+        M(PlaceIndex, type_place_index)
+#undef M
+    }
+}
+
+void observeTaskDeferred(BackgroundTaskScheduler::Decision decision)
+{
+    switch (decision)
+    {
+    case BackgroundTaskScheduler::Decision::DeferByDiskBudget:
+        GET_METRIC(tiflash_storage_bg_task_deferred_count, type_disk_budget).Increment();
+        break;
+    case BackgroundTaskScheduler::Decision::DeferByUrgentTasks:
+        GET_METRIC(tiflash_storage_bg_task_deferred_count, type_urgent_tasks).Increment();
+        break;
+    case BackgroundTaskScheduler::Decision::DeferByForegroundLatency:
+        GET_METRIC(tiflash_storage_bg_task_deferred_count, type_foreground_latency).Increment();
+        break;
+    case BackgroundTaskScheduler::Decision::Run:
+        break;
+    }
+}
+} // namespace
+
+DeltaMergeStore::MergeDeltaTaskPool::~MergeDeltaTaskPool()
+{
+    auto & scheduler = BackgroundTaskScheduler::instance();
+    for (auto * tasks : {&light_tasks, &heavy_tasks})
+    {
+        for (; !tasks->empty(); tasks->pop())
+            scheduler.removePendingTask(tasks->top().priority);
+    }
+}
+
 std::pair<bool, bool> DeltaMergeStore::MergeDeltaTaskPool::tryAddTask(const BackgroundTask & task, const ThreadType & whom, const size_t max_task_num, const LoggerPtr & log_)
 {
+    auto new_task = task;
+    new_task.add_time = BackgroundTaskScheduler::Clock::now();
+    new_task.deadline = new_task.add_time + getTaskDeadlineBudget(task.type);
+    new_task.disk = getTaskDisk(task);
+
     std::scoped_lock lock(mutex);
     if (light_tasks.size() + heavy_tasks.size() >= max_task_num)
         return std::make_pair(false, false);
@@ -119,7 +205,7 @@ std::pair<bool, bool> DeltaMergeStore::MergeDeltaTaskPool::tryAddTask(const Back
         // reserve some task space for light tasks
         if (max_task_num > 1 && heavy_tasks.size() >= static_cast<size_t>(max_task_num * 0.9))
             return std::make_pair(false, is_heavy);
-        heavy_tasks.push(task);
+        heavy_tasks.push(new_task);
         break;
     case TaskType::Compact:
     case TaskType::Flush:
@@ -128,36 +214,62 @@ std::pair<bool, bool> DeltaMergeStore::MergeDeltaTaskPool::tryAddTask(const Back
         // reserve some task space for heavy tasks
         if (max_task_num > 1 && light_tasks.size() >= static_cast<size_t>(max_task_num * 0.9))
             return std::make_pair(false, is_heavy);
-        light_tasks.push(task);
+        light_tasks.push(new_task);
         break;
     default:
         throw Exception(fmt::format("Unsupported task type: {}", magic_enum::enum_name(task.type)));
     }
+    BackgroundTaskScheduler::instance().addPendingTask(task.priority);
 
     LOG_DEBUG(
         log_,
-        "Segment task add to background task pool, segment={} task={} by_whom={}",
+        "Segment task add to background task pool, segment={} task={} priority={} by_whom={}",
         task.segment->simpleInfo(),
         magic_enum::enum_name(task.type),
+        magic_enum::enum_name(task.priority),
         magic_enum::enum_name(whom));
     return std::make_pair(true, is_heavy);
 }
 
-DeltaMergeStore::BackgroundTask DeltaMergeStore::MergeDeltaTaskPool::nextTask(bool is_heavy, const LoggerPtr & log_)
+DeltaMergeStore::BackgroundTask DeltaMergeStore::MergeDeltaTaskPool::nextTask(bool is_heavy, const BackgroundTaskScheduler::WakeHandle & waker, const LoggerPtr & log_)
 {
-    std::scoped_lock lock(mutex);
+    auto & scheduler = BackgroundTaskScheduler::instance();
+    auto now = BackgroundTaskScheduler::Clock::now();
+    BackgroundTask task;
+    {
+        std::scoped_lock lock(mutex);
 
-    auto & tasks = is_heavy ? heavy_tasks : light_tasks;
-    if (tasks.empty())
-        return {};
-    auto task = tasks.front();
-    tasks.pop();
+        auto & tasks = is_heavy ? heavy_tasks : light_tasks;
+        if (tasks.empty())
+            return {};
 
-    LOG_DEBUG(log_, "Segment task pop from background task pool, segment={} task={}", task.segment->simpleInfo(), magic_enum::enum_name(task.type));
+        // Tasks in the queue are ordered by priority, so the following tasks can not run either if the first one is deferred.
+        const auto & dm_context = tasks.top().dm_context;
+        BackgroundTaskScheduler::Limits limits{dm_context->bg_task_max_heavy_per_disk, dm_context->bg_task_throttle_read_latency_ms};
+        auto decision = scheduler.tryStartTask(tasks.top().toDesc(is_heavy, now), limits, waker, now);
+        if (decision != BackgroundTaskScheduler::Decision::Run)
+        {
+            observeTaskDeferred(decision);
+            LOG_TRACE(log_, "Segment task deferred, segment={} task={} decision={}", tasks.top().segment->simpleInfo(), magic_enum::enum_name(tasks.top().type), magic_enum::enum_name(decision));
+            return {};
+        }
+
+        task = tasks.top();
+        tasks.pop();
+    }
+    scheduler.removePendingTask(task.priority);
+    observeTaskStarted(task, now);
+
+    LOG_DEBUG(log_, "Segment task pop from background task pool, segment={} task={} priority={}", task.segment->simpleInfo(), magic_enum::enum_name(task.type), magic_enum::enum_name(task.priority));
 
     return task;
 }
 
+void DeltaMergeStore::MergeDeltaTaskPool::finishTask(const BackgroundTask & task, bool is_heavy)
+{
+    BackgroundTaskScheduler::instance().finishTask(task.toDesc(is_heavy, BackgroundTaskScheduler::Clock::now()));
+}
+
 // ================================================
 //   DeltaMergeStore
 // ================================================
@@ -1079,6 +1191,19 @@ BlockInputStreams DeltaMergeStore::read(const Context & db_context,
         enable_read_thread,
         final_num_stream);
 
+    // A single stream reads the ordered tasks one by one, so its output is sorted by the int handle if the versions are merged.
+    // The handle is read either as `_tidb_rowid` or as the primary key column if the primary key is the handle.
+    SortDescription sort_description;
+    if (keep_order && final_num_stream == 1 && !is_fast_scan && !is_common_handle)
+    {
+        const auto handle_id = getHandle().id;
+        for (const auto & cd : columns_to_read)
+        {
+            if ((cd.id == EXTRA_HANDLE_COLUMN_ID || cd.id == handle_id) && !cd.type->isUnsignedInteger())
+                sort_description.emplace_back(cd.name, 1, 1);
+        }
+    }
+
     BlockInputStreams res;
     for (size_t i = 0; i < final_num_stream; ++i)
     {
@@ -1105,7 +1230,8 @@ BlockInputStreams DeltaMergeStore::read(const Context & db_context,
                 /* read_mode = */ is_fast_scan ? ReadMode::Fast : ReadMode::Normal,
                 extra_table_id_index,
                 physical_table_id,
-                log_tracing_id);
+                log_tracing_id,
+                sort_description);
         }
         res.push_back(stream);
     }
@@ -1300,6 +1426,17 @@ void DeltaMergeStore::waitForDeleteRange(const DB::DM::DMContextPtr &, const DB:
     // TODO: maybe we should wait, if there are too many delete ranges?
 }
 
+bool DeltaMergeStore::isHotSegment(const DMContext & context, const SegmentPtr & segment)
+{
+    return context.segment_hot_read_per_minute > 0
+        && segment->getReadHeat()->get().reads_per_minute >= context.segment_hot_read_per_minute;
+}
+
+bool DeltaMergeStore::isColdSegment(const SegmentPtr & segment)
+{
+    return segment->getReadHeat()->get().reads_per_minute < SegmentReadHeat::COLD_READS_PER_MINUTE;
+}
+
 void DeltaMergeStore::checkSegmentUpdate(const DMContextPtr & dm_context, const SegmentPtr & segment, ThreadType thread_type)
 {
     fiu_do_on(FailPoints::skip_check_segment_update, { return; });
@@ -1362,13 +1499,18 @@ void DeltaMergeStore::checkSegmentUpdate(const DMContextPtr & dm_context, const
 
     // Note that, we must use || to combine rows and bytes checks in split check, and use && in merge check.
     // Otherwise, segments could be split and merged over and over again.
-    // Do background split in the following two cases:
+    // Do background split in the following cases:
     //   1. The segment is large enough, and there are some data in the delta layer. (A hot segment which is large enough)
     //   2. The segment is too large. (A segment which is too large, although it is cold)
     bool should_bg_split = ((segment_rows >= segment_limit_rows * 2 || segment_bytes >= segment_limit_bytes * 2)
                             && (delta_rows - delta_last_try_split_rows >= delta_cache_limit_rows
                                 || delta_bytes - delta_last_try_split_bytes >= delta_cache_limit_bytes))
         || (segment_rows >= segment_limit_rows * 3 || segment_bytes >= segment_limit_bytes * 3);
+    // 3. The segment is hot and large enough. Split it to read by more threads. As the split point may not be found,
+    //    it is tried at most once per minute.
+    if (!should_bg_split && (segment_rows >= segment_limit_rows || segment_bytes >= segment_limit_bytes)
+        && isHotSegment(*dm_context, segment) && segment->getReadHeat()->tryMarkSplit(std::chrono::minutes(1)))
+        should_bg_split = true;
 
     // Don't do compact on starting up.
     bool should_compact = (thread_type != ThreadType::Init) && std::max(static_cast<Int64>(column_file_count) - delta_last_try_compact_column_files, 0) >= 15;
@@ -1378,13 +1520,37 @@ void DeltaMergeStore::checkSegmentUpdate(const DMContextPtr & dm_context, const
         && (delta_rows - placed_delta_rows >= delta_cache_limit_rows * 3
             && delta_rows - delta_last_try_place_delta_index_rows >= delta_cache_limit_rows);
 
+    // Background tasks that keep the segment away from the foreground flush, merge delta and split of the write
+    // threads relieve write stalls, and are scheduled before the tasks of all other segments.
+    // Compact and place delta index only improve the read performance, and are scheduled last.
+    auto get_task_priority = [&](TaskType type) {
+        using Priority = BackgroundTaskScheduler::Priority;
+        switch (type)
+        {
+        case TaskType::Flush:
+            return (unsaved_rows >= delta_cache_limit_rows * 2 || unsaved_bytes >= delta_cache_limit_bytes * 2) ? Priority::WriteStallRelief : Priority::Normal;
+        case TaskType::MergeDelta:
+            return (delta_check_rows * 2 >= forceMergeDeltaRows(dm_context) || delta_check_bytes * 2 >= forceMergeDeltaBytes(dm_context)
+                    || delta_deletes * 2 >= forceMergeDeltaDeletes(dm_context))
+                ? Priority::WriteStallRelief
+                : Priority::Normal;
+        case TaskType::Split:
+            return segment_bytes * 2 >= dm_context->segment_force_split_bytes ? Priority::WriteStallRelief : Priority::Normal;
+        case TaskType::Compact:
+        case TaskType::PlaceIndex:
+            return Priority::Low;
+        }
+        return Priority::Normal;
+    };
+
     fiu_do_on(FailPoints::force_triggle_background_merge_delta, { should_background_merge_delta = true; });
     fiu_do_on(FailPoints::force_triggle_foreground_flush, { should_foreground_flush = true; });
 
-    auto try_add_background_task = [&](const BackgroundTask & task) {
+    auto try_add_background_task = [&](BackgroundTask task) {
         if (shutdown_called.load(std::memory_order_relaxed))
             return;
 
+        task.priority = get_task_priority(task.type);
         auto [added, heavy] = background_tasks.tryAddTask(task, thread_type, std::max(id_to_segment.size() * 2, background_pool.getNumberOfThreads() * 3), log);
         // Prevent too many tasks.
         if (!added)
@@ -22,6 +22,7 @@
 #include <Operators/Operator.h>
 #include <Storages/AlterCommands.h>
 #include <Storages/BackgroundProcessingPool.h>
+#include <Storages/DeltaMerge/BackgroundTaskScheduler.h>
 #include <Storages/DeltaMerge/ColumnFile/ColumnFilePersisted.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <Storages/DeltaMerge/Filter/PushDownFilter.h>
@@ -30,6 +31,7 @@
 #include <Storages/DeltaMerge/ScanContext.h>
 #include <Storages/DeltaMerge/SegmentReadTaskPool.h>
 #include <Storages/Page/PageStorage_fwd.h>
+#include <Storages/PathPool_fwd.h>
 #include <Storages/Transaction/DecodingStorageSchemaSnapshot.h>
 #include <Storages/Transaction/TiDB.h>
 
@@ -100,6 +102,9 @@ struct SegmentStats
     UInt64 stable_dmfiles_size = 0;
     UInt64 stable_dmfiles_size_on_disk = 0;
     UInt64 stable_dmfiles_packs = 0;
+
+    Float64 read_per_minute = 0;
+    Float64 read_rows_per_minute = 0;
 };
 using SegmentsStats = std::vector<SegmentStats>;
 
@@ -210,7 +215,29 @@ public:
         DMContextPtr dm_context;
         SegmentPtr segment;
 
+        BackgroundTaskScheduler::Priority priority = BackgroundTaskScheduler::Priority::Normal;
+        // Filled when the task is added into MergeDeltaTaskPool.
+        BackgroundTaskScheduler::Clock::time_point add_time{};
+        BackgroundTaskScheduler::Clock::time_point deadline{};
+        String disk;
+
         explicit operator bool() const { return segment != nullptr; }
+
+        BackgroundTaskScheduler::TaskDesc toDesc(bool is_heavy, BackgroundTaskScheduler::Clock::time_point now) const
+        {
+            return BackgroundTaskScheduler::TaskDesc{priority, is_heavy, now >= deadline, disk};
+        }
+    };
+
+    // Tasks with a higher priority are popped first, and tasks with the same priority are popped by deadline.
+    struct BackgroundTaskOrder
+    {
+        bool operator()(const BackgroundTask & lhs, const BackgroundTask & rhs) const
+        {
+            if (lhs.priority != rhs.priority)
+                return lhs.priority > rhs.priority;
+            return lhs.deadline > rhs.deadline;
+        }
     };
 
     class MergeDeltaTaskPool
@@ -221,13 +248,15 @@ public:
     public:
 #endif
 
-        using TaskQueue = std::queue<BackgroundTask, std::list<BackgroundTask>>;
+        using TaskQueue = std::priority_queue<BackgroundTask, std::vector<BackgroundTask>, BackgroundTaskOrder>;
         TaskQueue light_tasks;
         TaskQueue heavy_tasks;
 
         std::mutex mutex;
 
     public:
+        ~MergeDeltaTaskPool();
+
         size_t length()
         {
             std::scoped_lock lock(mutex);
@@ -238,7 +267,11 @@ public:
         // second element of return value means whether task is heavy or not
         std::pair<bool, bool> tryAddTask(const BackgroundTask & task, const ThreadType & whom, size_t max_task_num, const LoggerPtr & log_);
 
-        BackgroundTask nextTask(bool is_heavy, const LoggerPtr & log_);
+        // Return the first task of the queue if BackgroundTaskScheduler allows it to run now, otherwise an empty task.
+        // `finishTask` must be called after a non-empty task is done.
+        BackgroundTask nextTask(bool is_heavy, const BackgroundTaskScheduler::WakeHandle & waker, const LoggerPtr & log_);
+
+        static void finishTask(const BackgroundTask & task, bool is_heavy);
     };
 
     DeltaMergeStore(Context & db_context, //
@@ -425,6 +458,14 @@ public:
      */
     SegmentPtr gcTrySegmentMergeDelta(const DMContextPtr & dm_context, const SegmentPtr & segment, const SegmentPtr & prev_segment, const SegmentPtr & next_segment, DB::Timestamp gc_safe_point);
 
+    /**
+     * Try to move the stable of the segment between the main and the cold data paths in the current thread as the GC operation.
+     * The stable of a segment that is not written for `dt_tier_cold_after_days` and rarely read is moved to the cold data paths,
+     * and it is moved back when the segment is read frequently again.
+     * This function may be blocking, and should be called in the GC background thread.
+     */
+    SegmentPtr gcTrySegmentMigrateTier(const DMContextPtr & dm_context, const SegmentPtr & segment);
+
     /**
      * Starting from the given base segment, find continuous segments that could be merged.
      *
@@ -516,6 +557,11 @@ private:
      */
     void checkSegmentUpdate(const DMContextPtr & context, const SegmentPtr & segment, ThreadType thread_type);
 
+    /// Hot segments are split at a smaller size so that they can be read by more threads, and are only merged up to the normal segment limit.
+    static bool isHotSegment(const DMContext & context, const SegmentPtr & segment);
+    /// Cold segments can be merged into a larger one to reduce the number of segments.
+    static bool isColdSegment(const SegmentPtr & segment);
+
     enum class SegmentSplitReason
     {
         ForegroundWrite,
@@ -580,12 +626,14 @@ private:
     /**
      * Merge the delta (major compaction) in the segment.
      * After delta-merging, the segment will be abandoned (with `segment->hasAbandoned() == true`) and a new segment will be returned.
+     * When `target_tier` is specified, the whole stable is rewritten to the paths of `target_tier`.
      */
     SegmentPtr segmentMergeDelta(
         DMContext & dm_context,
         const SegmentPtr & segment,
         MergeDeltaReason reason,
-        SegmentSnapshotPtr segment_snap = nullptr);
+        SegmentSnapshotPtr segment_snap = nullptr,
+        std::optional<StorageTier> target_tier = std::nullopt);
 
     /**
      * Ingest a DMFile into the segment, optionally causing a new segment being created.
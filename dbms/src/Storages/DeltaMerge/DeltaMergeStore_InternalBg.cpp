@@ -18,6 +18,7 @@
 #include <Encryption/FileProvider.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/SharedContexts/Disagg.h>
+#include <Poco/File.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/GCOptions.h>
 #include <Storages/DeltaMerge/Segment.h>
@@ -25,6 +26,7 @@
 #include <Storages/PathPool.h>
 #include <Storages/Transaction/TMTContext.h>
 
+#include <ext/scope_guard.h>
 #include <magic_enum.hpp>
 #include <memory>
 
@@ -287,6 +289,22 @@ void DeltaMergeStore::setUpBackgroundTask(const DMContextPtr & dm_context)
     blockable_background_pool_handle->wake();
 }
 
+namespace
+{
+/// The max rows and bytes of the merged segment. The merged segment of cold segments can be larger, but it
+/// should not reach the size that triggers background split.
+std::pair<size_t, size_t> getMergeLimit(const DMContext & context, bool merge_cold)
+{
+    if (!merge_cold)
+        return {context.segment_limit_rows, context.segment_limit_bytes};
+    auto ratio = std::min(context.segment_cold_merge_ratio, 2.0);
+    return {
+        static_cast<size_t>(context.segment_limit_rows * ratio),
+        static_cast<size_t>(context.segment_limit_bytes * ratio),
+    };
+}
+} // namespace
+
 std::vector<SegmentPtr> DeltaMergeStore::getMergeableSegments(const DMContextPtr & context, const SegmentPtr & baseSegment)
 {
     // Last segment cannot be merged.
@@ -297,8 +315,9 @@ std::vector<SegmentPtr> DeltaMergeStore::getMergeableSegments(const DMContextPtr
     // Note: it is possible that there is a very small segment close to a very large segment.
     // In this case, the small segment will not get merged. It is possible that we can allow
     // segment merging for this case in future.
-    auto max_total_rows = context->segment_limit_rows;
-    auto max_total_bytes = context->segment_limit_bytes;
+    // Cold segments are merged into a larger one. Once a segment which is not cold is involved, e.g. a small
+    // hot segment, the merged segment is limited by the normal segment limit.
+    bool merge_cold = isColdSegment(baseSegment) && context->segment_cold_merge_ratio > 1.0;
 
     std::vector<SegmentPtr> results;
     {
@@ -316,6 +335,8 @@ std::vector<SegmentPtr> DeltaMergeStore::getMergeableSegments(const DMContextPtr
         while (it != segments.end())
         {
             const auto & this_seg = it->second;
+            merge_cold = merge_cold && isColdSegment(this_seg);
+            const auto [max_total_rows, max_total_bytes] = getMergeLimit(*context, merge_cold);
             const auto this_rows = this_seg->getEstimatedRows();
             const auto this_bytes = this_seg->getEstimatedBytes();
             if (accumulated_rows + this_rows >= max_total_rows || accumulated_bytes + this_bytes >= max_total_bytes)
@@ -349,9 +370,11 @@ bool DeltaMergeStore::updateGCSafePoint()
 
 bool DeltaMergeStore::handleBackgroundTask(bool heavy)
 {
-    auto task = background_tasks.nextTask(heavy, log);
+    // The deferred handle is woken up by BackgroundTaskScheduler, so that the task is retried as soon as possible.
+    auto task = background_tasks.nextTask(heavy, heavy ? blockable_background_pool_handle : background_task_handle, log);
     if (!task)
         return false;
+    SCOPE_EXIT({ MergeDeltaTaskPool::finishTask(task, heavy); });
 
     // Update GC safe point before background task
     // Foreground task don't get GC safe point from remote, but we better make it as up to date as possible.
@@ -652,9 +675,12 @@ bool shouldCompactStableWithTooMuchDataOutOfSegmentRange(const DMContext & conte
 
 SegmentPtr DeltaMergeStore::gcTrySegmentMerge(const DMContextPtr & dm_context, const SegmentPtr & segment)
 {
+    // Small hot segments are merged as well, but only up to the normal segment limit, so that the merged
+    // segment is not split by the hot split policy again.
     auto segment_rows = segment->getEstimatedRows();
     auto segment_bytes = segment->getEstimatedBytes();
-    if (segment_rows >= dm_context->segment_limit_rows || segment_bytes >= dm_context->segment_limit_bytes)
+    auto [limit_rows, limit_bytes] = getMergeLimit(*dm_context, isColdSegment(segment) && dm_context->segment_cold_merge_ratio > 1.0);
+    if (segment_rows >= limit_rows || segment_bytes >= limit_bytes)
     {
         LOG_TRACE(
             log,
@@ -811,6 +837,100 @@ SegmentPtr DeltaMergeStore::gcTrySegmentMergeDelta(const DMContextPtr & dm_conte
     return new_segment;
 }
 
+namespace
+{
+/// Whether the stable of the segment has not been rewritten for `days` days. The stable is rewritten by merging the
+/// delta, so it means that the segment has not been written since then. The modification time of the DTFiles is used
+/// so that the time is kept across restarts.
+bool isStableUntouchedFor(const SegmentPtr & segment, UInt64 days)
+{
+    const auto since = Poco::Timestamp() - static_cast<Poco::Timestamp::TimeDiff>(days) * 24 * 3600 * Poco::Timestamp::resolution();
+    for (const auto & dtfile : segment->getStable()->getDMFiles())
+    {
+        if (Poco::File(dtfile->path()).getLastModified() > since)
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+SegmentPtr DeltaMergeStore::gcTrySegmentMigrateTier(const DMContextPtr & dm_context, const SegmentPtr & segment)
+{
+    // The DTFiles on the remote store have no local tier.
+    if (dm_context->tier_cold_after_days == 0 || global_context.getSharedContextDisagg()->remote_data_store)
+        return {};
+    if (!path_pool->getStableDiskDelegator().hasPaths(StorageTier::Cold))
+        return {};
+
+    const auto current_tier = segment->getStableTier(*dm_context);
+    const auto reads_per_minute = segment->getReadHeat()->get().reads_per_minute;
+    std::optional<StorageTier> target_tier;
+    if (current_tier == StorageTier::Hot)
+    {
+        const auto & delta = segment->getDelta();
+        if (isColdSegment(segment) && delta->getRows() == 0 && delta->getDeletes() == 0
+            && isStableUntouchedFor(segment, dm_context->tier_cold_after_days))
+            target_tier = StorageTier::Cold;
+    }
+    else if (reads_per_minute >= dm_context->tier_promote_read_per_minute)
+    {
+        target_tier = StorageTier::Hot;
+    }
+
+    if (!target_tier)
+    {
+        LOG_TRACE(
+            log,
+            "GC - MigrateTier skipped, tier={} read_per_minute={:.2f} segment={} table={}",
+            magic_enum::enum_name(current_tier),
+            reads_per_minute,
+            segment->simpleInfo(),
+            table_name);
+        return {};
+    }
+
+    const auto stable_bytes = segment->getStable()->getBytes();
+    if (!BackgroundTaskScheduler::instance().tryAcquireMigrationBytes(stable_bytes, dm_context->tier_migration_max_bytes_per_sec))
+    {
+        GET_METRIC(tiflash_storage_tier_migration_count, type_throttled).Increment();
+        LOG_DEBUG(
+            log,
+            "GC - MigrateTier throttled, target_tier={} stable_bytes={} segment={} table={}",
+            magic_enum::enum_name(*target_tier),
+            stable_bytes,
+            segment->simpleInfo(),
+            table_name);
+        return {};
+    }
+
+    LOG_INFO(
+        log,
+        "GC - Trigger MigrateTier, target_tier={} read_per_minute={:.2f} stable_bytes={} segment={} table={}",
+        magic_enum::enum_name(*target_tier),
+        reads_per_minute,
+        stable_bytes,
+        segment->simpleInfo(),
+        table_name);
+    auto new_segment = segmentMergeDelta(*dm_context, segment, MergeDeltaReason::BackgroundGCThread, nullptr, target_tier);
+    if (!new_segment)
+    {
+        LOG_DEBUG(
+            log,
+            "GC - MigrateTier aborted, target_tier={} segment={} table={}",
+            magic_enum::enum_name(*target_tier),
+            segment->simpleInfo(),
+            table_name);
+        return {};
+    }
+
+    if (*target_tier == StorageTier::Cold)
+        GET_METRIC(tiflash_storage_tier_migration_count, type_to_cold).Increment();
+    else
+        GET_METRIC(tiflash_storage_tier_migration_count, type_to_hot).Increment();
+    checkSegmentUpdate(dm_context, new_segment, ThreadType::BG_GC);
+    return new_segment;
+}
+
 UInt64 DeltaMergeStore::onSyncGc(Int64 limit, const GCOptions & gc_options)
 {
     if (shutdown_called.load(std::memory_order_relaxed))
@@ -889,6 +1009,8 @@ UInt64 DeltaMergeStore::onSyncGc(Int64 limit, const GCOptions & gc_options)
                 new_seg = gcTrySegmentMerge(dm_context, segment);
             if (!new_seg && gc_options.do_merge_delta)
                 new_seg = gcTrySegmentMergeDelta(dm_context, segment, prev_segment, next_segment, gc_safe_point);
+            if (!new_seg && gc_options.do_migrate_tier)
+                new_seg = gcTrySegmentMigrateTier(dm_context, segment);
 
             if (!new_seg)
             {
@@ -347,13 +347,15 @@ SegmentPtr DeltaMergeStore::segmentMergeDelta(
     DMContext & dm_context,
     const SegmentPtr & segment,
     const MergeDeltaReason reason,
-    SegmentSnapshotPtr segment_snap)
+    SegmentSnapshotPtr segment_snap,
+    std::optional<StorageTier> target_tier)
 {
     LOG_INFO(
         log,
-        "MergeDelta - Begin, reason={} safe_point={} segment={}",
+        "MergeDelta - Begin, reason={} safe_point={} target_tier={} segment={}",
         magic_enum::enum_name(reason),
         dm_context.min_version,
+        target_tier ? magic_enum::enum_name(*target_tier) : "none",
         segment->info());
 
     ColumnDefinesPtr schema_snap;
@@ -428,7 +430,10 @@ SegmentPtr DeltaMergeStore::segmentMergeDelta(
 
     WriteBatches wbs(*storage_pool, dm_context.getWriteLimiter());
 
-    auto new_stable = segment->prepareMergeDelta(dm_context, schema_snap, segment_snap, wbs);
+    // The gc thread and manual compaction need to rewrite the whole stable to clean the outdated versions
+    // and bound the fragmentation produced by incremental merge delta.
+    const bool allow_incremental = reason == MergeDeltaReason::BackgroundThreadPool || reason == MergeDeltaReason::ForegroundWrite;
+    auto new_stable = segment->prepareMergeDelta(dm_context, schema_snap, segment_snap, wbs, allow_incremental, target_tier);
     wbs.writeLogAndData();
     new_stable->enableDMFilesGC(dm_context);
 
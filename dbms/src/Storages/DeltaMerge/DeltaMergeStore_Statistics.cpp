@@ -179,6 +179,10 @@ SegmentsStats DeltaMergeStore::getSegmentsStats()
         stat.stable_dmfiles_size_on_disk = stable->getDMFilesBytesOnDisk();
         stat.stable_dmfiles_packs = stable->getDMFilesPacks();
 
+        auto read_heat = segment->getReadHeat()->get();
+        stat.read_per_minute = read_heat.reads_per_minute;
+        stat.read_rows_per_minute = read_heat.rows_per_minute;
+
         stats.emplace_back(stat);
     }
     return stats;
@@ -0,0 +1,170 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Logger.h>
+#include <IO/CompressedWriteBuffer.h>
+#include <IO/WriteBufferFromString.h>
+#include <Storages/DeltaMerge/File/ColumnCompression.h>
+#include <common/logger_useful.h>
+
+#include <boost/algorithm/string.hpp>
+#include <charconv>
+
+namespace DB::DM
+{
+namespace
+{
+template <typename T>
+std::optional<T> parseNumber(std::string_view s)
+{
+    T value{};
+    const auto * end = s.data() + s.size();
+    auto [ptr, ec] = std::from_chars(s.data(), end, value);
+    if (ec != std::errc() || ptr != end)
+        return std::nullopt;
+    return value;
+}
+
+std::optional<ColumnCompression> parseCompression(std::string_view s)
+{
+    std::string_view method_name = s;
+    std::optional<int> level;
+    if (auto pos = s.find(':'); pos != std::string_view::npos)
+    {
+        method_name = s.substr(0, pos);
+        level = parseNumber<int>(s.substr(pos + 1));
+        if (!level)
+            return std::nullopt;
+    }
+
+    ColumnCompression res;
+    if (method_name == "auto")
+    {
+        res.is_auto = true;
+        return level ? std::nullopt : std::make_optional(res);
+    }
+
+    CompressionMethod method;
+    if (method_name == "lz4")
+        method = CompressionMethod::LZ4;
+    else if (method_name == "lz4hc")
+        method = CompressionMethod::LZ4HC;
+    else if (method_name == "zstd")
+        method = CompressionMethod::ZSTD;
+    else if (method_name == "none")
+        method = CompressionMethod::NONE;
+    else
+        return std::nullopt;
+    res.settings = level ? CompressionSettings(method, *level) : CompressionSettings(method);
+    return res;
+}
+
+size_t compressedSize(std::string_view data, const CompressionSettings & settings)
+{
+    WriteBufferFromOwnString out;
+    CompressedWriteBuffer<false> compressed(out, settings);
+    compressed.write(data.data(), data.size());
+    compressed.next();
+    return out.count();
+}
+} // namespace
+
+ColumnCompressionRulesPtr ColumnCompressionRules::parse(const String & spec, TableID physical_table_id)
+{
+    if (spec.empty())
+        return nullptr;
+
+    auto res = std::make_shared<ColumnCompressionRules>();
+    std::vector<String> items;
+    boost::split(items, spec, boost::is_any_of(","));
+    for (auto & item : items)
+    {
+        boost::trim(item);
+        if (item.empty())
+            continue;
+
+        auto eq_pos = item.find('=');
+        auto dot_pos = item.find('.');
+        std::optional<ColumnCompression> compression;
+        if (eq_pos != String::npos && dot_pos < eq_pos)
+            compression = parseCompression(std::string_view(item).substr(eq_pos + 1));
+        if (!compression)
+        {
+            LOG_WARNING(Logger::get(), "Ignore invalid rule of dt_column_compression, rule={}", item);
+            continue;
+        }
+
+        auto table = std::string_view(item).substr(0, dot_pos);
+        if (table != "*")
+        {
+            auto table_id = parseNumber<TableID>(table);
+            if (!table_id)
+            {
+                LOG_WARNING(Logger::get(), "Ignore invalid rule of dt_column_compression, rule={}", item);
+                continue;
+            }
+            if (*table_id != physical_table_id)
+                continue;
+        }
+
+        auto column = item.substr(dot_pos + 1, eq_pos - dot_pos - 1);
+        res->rules.push_back(Rule{column == "*" ? "" : column, *compression});
+    }
+
+    if (res->rules.empty())
+        return nullptr;
+    return res;
+}
+
+std::optional<ColumnCompression> ColumnCompressionRules::match(const String & column_name) const
+{
+    for (const auto & rule : rules)
+    {
+        if (rule.column_name.empty() || rule.column_name == column_name)
+            return rule.compression;
+    }
+    return std::nullopt;
+}
+
+CompressionSettings chooseCompressionByTrial(std::string_view data)
+{
+    // LZ4HC and ZSTD with a higher level compress much slower, which costs the CPU of merge delta.
+    static constexpr double SLOWER_COMPRESS_MIN_RATIO = 1.1;
+    // ZSTD decompresses several times slower than LZ4, which costs the latency of queries. So it must save notably
+    // more space, both relative to LZ4 and relative to the raw data.
+    static constexpr double ZSTD_MIN_RATIO = 1.25;
+    static constexpr size_t ZSTD_MIN_SAVING_DIVISOR = 32;
+    // Compressing can not save much space.
+    static constexpr double NONE_MAX_RATIO = 1.05;
+    static constexpr int ZSTD_HIGH_LEVEL = 9;
+
+    if (data.empty())
+        return CompressionSettings(CompressionMethod::LZ4);
+
+    auto choose = [&](const CompressionSettings & fast, const CompressionSettings & slow) {
+        auto fast_size = compressedSize(data, fast);
+        auto slow_size = compressedSize(data, slow);
+        return slow_size * SLOWER_COMPRESS_MIN_RATIO <= fast_size ? std::make_pair(slow, slow_size) : std::make_pair(fast, fast_size);
+    };
+    auto [lz4, lz4_size] = choose(CompressionSettings(CompressionMethod::LZ4), CompressionSettings(CompressionMethod::LZ4HC));
+    auto [zstd, zstd_size] = choose(CompressionSettings(CompressionMethod::ZSTD), CompressionSettings(CompressionMethod::ZSTD, ZSTD_HIGH_LEVEL));
+
+    if (zstd_size * ZSTD_MIN_RATIO <= lz4_size && (lz4_size - zstd_size) * ZSTD_MIN_SAVING_DIVISOR >= data.size())
+        return zstd;
+    if (lz4_size * NONE_MAX_RATIO >= data.size())
+        return CompressionSettings(CompressionMethod::NONE);
+    return lz4;
+}
+
+} // namespace DB::DM
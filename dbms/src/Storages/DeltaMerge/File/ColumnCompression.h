@@ -0,0 +1,66 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <IO/CompressionSettings.h>
+#include <Storages/Transaction/Types.h>
+#include <common/types.h>
+
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace DB::DM
+{
+struct ColumnCompression
+{
+    // Choose the compression method by trying all methods on the first pack of the column.
+    bool is_auto = false;
+    CompressionSettings settings;
+};
+
+class ColumnCompressionRules;
+using ColumnCompressionRulesPtr = std::shared_ptr<const ColumnCompressionRules>;
+
+/// The compression rules of the columns of the DTFiles of a table, which are parsed from `dt_column_compression`.
+/// For example, "45.comment=zstd:9,45.*=lz4,*.*=auto". Each rule is `<physical table id>.<column name>=<method>[:<level>]`,
+/// where both of the table id and the column name can be `*`, and the method is one of lz4, lz4hc, zstd, none and auto.
+/// The first matching rule of a column is used. Columns without any matching rule use `dt_compression_method` and
+/// `dt_compression_level`.
+class ColumnCompressionRules
+{
+public:
+    /// Returns nullptr if no rule applies to the table. Invalid rules are ignored with a warning.
+    static ColumnCompressionRulesPtr parse(const String & spec, TableID physical_table_id);
+
+    std::optional<ColumnCompression> match(const String & column_name) const;
+
+private:
+    struct Rule
+    {
+        // Empty means any column.
+        String column_name;
+        ColumnCompression compression;
+    };
+    std::vector<Rule> rules;
+};
+
+/// Compress `data` by LZ4, LZ4HC and ZSTD, and choose the one with the best trade-off between the compression ratio
+/// and the decompression speed. ZSTD decompresses several times slower than LZ4, so it is only chosen when it is
+/// notably smaller. NONE is chosen for incompressible data.
+CompressionSettings chooseCompressionByTrial(std::string_view data);
+
+} // namespace DB::DM
@@ -19,7 +19,8 @@ namespace DB::DM
 {
 DMFileBlockOutputStream::DMFileBlockOutputStream(const Context & context,
                                                  const DMFilePtr & dmfile,
-                                                 const ColumnDefines & write_columns)
+                                                 const ColumnDefines & write_columns,
+                                                 TableID physical_table_id)
     : writer(
         dmfile,
         write_columns,
@@ -28,7 +29,8 @@ DMFileBlockOutputStream::DMFileBlockOutputStream(const Context & context,
         DMFileWriter::Options{
             CompressionSettings(context.getSettingsRef().dt_compression_method, context.getSettingsRef().dt_compression_level),
             context.getSettingsRef().min_compress_block_size,
-            context.getSettingsRef().max_compress_block_size})
+            context.getSettingsRef().max_compress_block_size,
+            physical_table_id == InvalidTableID ? nullptr : ColumnCompressionRules::parse(context.getSettingsRef().dt_column_compression, physical_table_id)})
 {
 }
 
@@ -32,9 +32,11 @@ namespace DM
 class DMFileBlockOutputStream
 {
 public:
+    /// The columns are compressed by `dt_column_compression` of the table if `physical_table_id` is valid.
     DMFileBlockOutputStream(const Context & context,
                             const DMFilePtr & dmfile,
-                            const ColumnDefines & write_columns);
+                            const ColumnDefines & write_columns,
+                            TableID physical_table_id = InvalidTableID);
 
     DMFilePtr getFile() const { return writer.getFile(); }
 
@@ -81,6 +81,22 @@ public:
         return minmax_index->getStringMinMax(pack_id).first;
     }
 
+    // Rows in a DMFile are sorted by rowkey, so they are the first and the last rowkey of the pack.
+    std::pair<RowKeyValue, RowKeyValue> getRowKeyMinMax(size_t pack_id, bool is_common_handle)
+    {
+        if (!param.indexes.count(EXTRA_HANDLE_COLUMN_ID))
+            tryLoadIndex(EXTRA_HANDLE_COLUMN_ID);
+        auto & minmax_index = param.indexes.find(EXTRA_HANDLE_COLUMN_ID)->second.minmax;
+        if (is_common_handle)
+        {
+            auto [min, max] = minmax_index->getStringMinMax(pack_id);
+            return {RowKeyValue(true, std::make_shared<String>(min.toString())),
+                    RowKeyValue(true, std::make_shared<String>(max.toString()))};
+        }
+        auto [min, max] = minmax_index->getIntMinMax(pack_id);
+        return {RowKeyValue::fromHandle(min), RowKeyValue::fromHandle(max)};
+    }
+
     UInt64 getMaxVersion(size_t pack_id)
     {
         if (!param.indexes.count(VERSION_COLUMN_ID))
@@ -89,6 +105,15 @@ public:
         return minmax_index->getUInt64MinMax(pack_id).second;
     }
 
+    // Return nullptr if the column does not have a minmax index in this DMFile.
+    MinMaxIndexPtr getMinMaxIndex(ColId col_id)
+    {
+        if (!param.indexes.count(col_id))
+            tryLoadIndex(col_id);
+        auto iter = param.indexes.find(col_id);
+        return iter == param.indexes.end() ? nullptr : iter->second.minmax;
+    }
+
     // Get valid rows and bytes after filter invalid packs by handle_range and filter
     std::pair<size_t, size_t> validRowsAndBytes()
     {
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/TiFlashException.h>
+#include <IO/WriteBufferFromString.h>
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 #include <Storages/DeltaMerge/File/DMFileWriter.h>
 #include <Storages/S3/S3Common.h>
@@ -48,7 +49,15 @@ DMFileWriter::DMFileWriter(const DMFilePtr & dmfile_,
         /// for handle column always generate index
         auto type = removeNullable(cd.type);
         bool do_index = cd.id == EXTRA_HANDLE_COLUMN_ID || type->isInteger() || type->isDateOrDateTime();
-        addStreams(cd.id, cd.type, do_index);
+        auto compression_settings = options.compression_settings;
+        if (auto compression = options.column_compression ? options.column_compression->match(cd.name) : std::nullopt; compression)
+        {
+            if (compression->is_auto)
+                auto_compression_columns.insert(cd.id);
+            else
+                compression_settings = compression->settings;
+        }
+        addStreams(cd.id, cd.type, do_index, compression_settings);
         dmfile->column_stats.emplace(cd.id, ColumnStat{cd.id, cd.type, /*avg_size=*/0});
     }
 }
@@ -97,7 +106,7 @@ DMFileWriter::WriteBufferFromFileBasePtr DMFileWriter::createPackStatsFile()
                                      options.max_compress_block_size);
 }
 
-void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index)
+void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index, CompressionSettings compression_settings)
 {
     auto callback = [&](const IDataType::SubstreamPath & substream_path) {
         const auto stream_name = DMFile::getFileNameBase(col_id, substream_path);
@@ -105,7 +114,7 @@ void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index)
             dmfile,
             stream_name,
             type,
-            options.compression_settings,
+            compression_settings,
             options.max_compress_block_size,
             file_provider,
             write_limiter,
@@ -116,6 +125,26 @@ void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index)
     type->enumerateStreams(callback, {});
 }
 
+void DMFileWriter::chooseColumnCompression(ColId col_id, const IDataType & type, const IColumn & column)
+{
+    WriteBufferFromOwnString buf;
+    type.serializeBinaryBulkWithMultipleStreams(
+        column,
+        [&](const IDataType::SubstreamPath &) { return &buf; },
+        0,
+        column.size(),
+        true,
+        {});
+    auto compression_settings = chooseCompressionByTrial(static_cast<std::string_view>(buf.stringRef()));
+
+    type.enumerateStreams(
+        [&](const IDataType::SubstreamPath & substream) {
+            const auto name = DMFile::getFileNameBase(col_id, substream);
+            column_streams.at(name)->resetCompression(*dmfile, compression_settings);
+        },
+        {});
+}
+
 
 void DMFileWriter::write(const Block & block, const BlockProperty & block_property)
 {
@@ -194,6 +223,9 @@ void DMFileWriter::writeColumn(ColId col_id, const IDataType & type, const IColu
 {
     size_t rows = column.size();
 
+    if (unlikely(!auto_compression_columns.empty()) && auto_compression_columns.erase(col_id) > 0)
+        chooseColumnCompression(col_id, type, column);
+
     type.enumerateStreams(
         [&](const IDataType::SubstreamPath & substream) {
             const auto name = DMFile::getFileNameBase(col_id, substream);
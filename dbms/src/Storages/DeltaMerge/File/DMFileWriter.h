@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Common/Exception.h>
 #include <DataStreams/IBlockOutputStream.h>
 #include <DataStreams/MarkInCompressedFile.h>
 #include <Encryption/WriteBufferFromFileProvider.h>
@@ -21,9 +22,12 @@
 #include <IO/CompressedWriteBuffer.h>
 #include <IO/WriteBufferFromOStream.h>
 #include <Storages/DeltaMerge/DMChecksumConfig.h>
+#include <Storages/DeltaMerge/File/ColumnCompression.h>
 #include <Storages/DeltaMerge/File/DMFile.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
 
+#include <unordered_set>
+
 namespace DB
 {
 namespace DM
@@ -66,9 +70,7 @@ public:
                     .with_checksum_algorithm(detail::getAlgorithmOrNone(*dmfile))
                     .with_checksum_frame_size(detail::getFrameSizeOrDefault(*dmfile))
                     .build())
-            , compressed_buf(dmfile->configuration
-                                 ? std::unique_ptr<WriteBuffer>(new CompressedWriteBuffer<false>(*plain_file, compression_settings))
-                                 : std::unique_ptr<WriteBuffer>(new CompressedWriteBuffer<true>(*plain_file, compression_settings)))
+            , compressed_buf(createCompressedBuffer(*dmfile, *plain_file, compression_settings))
             , minmaxes(do_index ? std::make_shared<MinMaxIndex>(*type) : nullptr)
             , mark_file(WriteBufferByFileProviderBuilder(
                             dmfile->configuration.has_value(),
@@ -83,6 +85,20 @@ public:
         {
         }
 
+        static WriteBufferPtr createCompressedBuffer(const DMFile & dmfile, WriteBuffer & plain_file, CompressionSettings compression_settings)
+        {
+            return dmfile.configuration
+                ? std::unique_ptr<WriteBuffer>(new CompressedWriteBuffer<false>(plain_file, compression_settings))
+                : std::unique_ptr<WriteBuffer>(new CompressedWriteBuffer<true>(plain_file, compression_settings));
+        }
+
+        // Change the compression settings before any data is written.
+        void resetCompression(const DMFile & dmfile, CompressionSettings compression_settings)
+        {
+            RUNTIME_CHECK(compressed_buf->count() == 0, compressed_buf->count());
+            compressed_buf = createCompressedBuffer(dmfile, *plain_file, compression_settings);
+        }
+
         void flush()
         {
             // Note that this method won't flush minmaxes.
@@ -121,13 +137,16 @@ public:
         CompressionSettings compression_settings;
         size_t min_compress_block_size{};
         size_t max_compress_block_size{};
+        // The compression of the columns that are different from `compression_settings`. Can be nullptr.
+        ColumnCompressionRulesPtr column_compression;
 
         Options() = default;
 
-        Options(CompressionSettings compression_settings_, size_t min_compress_block_size_, size_t max_compress_block_size_)
+        Options(CompressionSettings compression_settings_, size_t min_compress_block_size_, size_t max_compress_block_size_, ColumnCompressionRulesPtr column_compression_ = nullptr)
             : compression_settings(compression_settings_)
             , min_compress_block_size(min_compress_block_size_)
             , max_compress_block_size(max_compress_block_size_)
+            , column_compression(std::move(column_compression_))
         {
         }
 
@@ -157,7 +176,9 @@ private:
     /// Add streams with specified column id. Since a single column may have more than one Stream,
     /// for example Nullable column has a NullMap column, we would track them with a mapping
     /// FileNameBase -> Stream.
-    void addStreams(ColId col_id, DataTypePtr type, bool do_index);
+    void addStreams(ColId col_id, DataTypePtr type, bool do_index, CompressionSettings compression_settings);
+    /// Choose the compression of the column by the data of its first pack.
+    void chooseColumnCompression(ColId col_id, const IDataType & type, const IColumn & column);
 
     WriteBufferFromFileBasePtr createMetaFile();
     WriteBufferFromFileBasePtr createMetaV2File();
@@ -171,6 +192,8 @@ private:
     Options options;
 
     ColumnStreams column_streams;
+    // The columns whose compression is chosen automatically, and has not been chosen yet.
+    std::unordered_set<ColId> auto_compression_columns;
 
     FileProviderPtr file_provider;
     WriteLimiterPtr write_limiter;
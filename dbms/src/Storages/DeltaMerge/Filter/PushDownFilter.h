@@ -24,6 +24,14 @@ class PushDownFilter;
 using PushDownFilterPtr = std::shared_ptr<PushDownFilter>;
 inline static const PushDownFilterPtr EMPTY_FILTER{};
 
+// One of the pushed down conditions, compiled separately from the others.
+struct PushDownPredicate
+{
+    ExpressionActionsPtr actions;
+    String filter_column_name;
+};
+using PushDownPredicates = std::vector<PushDownPredicate>;
+
 class PushDownFilter : public std::enable_shared_from_this<PushDownFilter>
 {
 public:
@@ -31,12 +39,14 @@ public:
                    const ExpressionActionsPtr & beofre_where_,
                    const ColumnDefines & filter_columns_,
                    const String filter_column_name_,
-                   const ExpressionActionsPtr & extra_cast_)
+                   const ExpressionActionsPtr & extra_cast_,
+                   PushDownPredicates predicates_ = {})
         : rs_operator(rs_operator_)
         , before_where(beofre_where_)
         , filter_column_name(std::move(filter_column_name_))
         , filter_columns(std::move(filter_columns_))
         , extra_cast(extra_cast_)
+        , predicates(std::move(predicates_))
     {}
 
     explicit PushDownFilter(const RSOperatorPtr & rs_operator_)
@@ -56,6 +66,14 @@ public:
     ColumnDefines filter_columns;
     // The expression actions used to cast the timestamp/datetime column
     ExpressionActionsPtr extra_cast;
+    // The pushed down conditions in the order of the DAG request, each can be evaluated alone
+    // on the output of `extra_cast`. Used to evaluate the conditions in an adaptive order,
+    // empty if there is only one condition or adaptive order is disabled.
+    PushDownPredicates predicates;
+    // The upper aggregation only needs the number of rows and the min/max values of the columns to read,
+    // so the stable packs whose rows are all visible can be generated from their statistics instead of reading.
+    // Only take effect when reading in bitmap mode without filter expression.
+    bool aggregation_from_pack_stats = false;
 };
 
 } // namespace DB::DM
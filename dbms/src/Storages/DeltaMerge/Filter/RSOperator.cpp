@@ -27,6 +27,7 @@
 #include <Storages/DeltaMerge/Filter/NotLike.h>
 #include <Storages/DeltaMerge/Filter/Or.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Filter/TopN.h>
 #include <Storages/DeltaMerge/Filter/Unsupported.h>
 
 namespace DB
@@ -48,6 +49,7 @@ RSOperatorPtr createNotIn(const Attr & attr, const Fields & values)
 RSOperatorPtr createNotLike(const Attr & attr, const Field & value)                             { return std::make_shared<NotLike>(attr, value); }
 RSOperatorPtr createOr(const RSOperators & children)                                            { return std::make_shared<Or>(children); }
 RSOperatorPtr createIsNull(const Attr & attr)                                                   { return std::make_shared<IsNull>(attr);}
+RSOperatorPtr createTopN(const Attr & attr, const TopNThresholdPtr & threshold)                 { return std::make_shared<TopN>(attr, threshold); }
 RSOperatorPtr createUnsupported(const String & content, const String & reason, bool is_not)     { return std::make_shared<Unsupported>(content, reason, is_not); }
 // clang-format on
 } // namespace DM
@@ -21,6 +21,9 @@
 
 namespace DB
 {
+class TopNThreshold;
+using TopNThresholdPtr = std::shared_ptr<TopNThreshold>;
+
 namespace DM
 {
 class RSOperator;
@@ -145,6 +148,8 @@ RSOperatorPtr createNotLike(const Attr & attr, const Field & values);
 //
 RSOperatorPtr createIsNull(const Attr & attr);
 //
+RSOperatorPtr createTopN(const Attr & attr, const TopNThresholdPtr & threshold);
+//
 RSOperatorPtr createUnsupported(const String & content, const String & reason, bool is_not);
 
 
@@ -0,0 +1,72 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <DataStreams/TopNThreshold.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
+
+namespace DB
+{
+namespace DM
+{
+/// Skip the packs that can not beat the threshold of the TopN on the table scan. The threshold is read each time
+/// a pack is checked, so the packs checked later are skipped by a tighter threshold.
+/// It never returns All, because it is not a filter on the rows.
+class TopN : public RSOperator
+{
+    Attr attr;
+    TopNThresholdPtr threshold;
+
+public:
+    TopN(const Attr & attr_, const TopNThresholdPtr & threshold_)
+        : attr(attr_)
+        , threshold(threshold_)
+    {
+    }
+
+    String name() override { return "topn"; }
+
+    Attrs getAttrs() override { return {attr}; }
+
+    String toDebugString() override
+    {
+        return fmt::format(
+            R"({{"op":"{}","col":"{}","desc":{},"threshold":"{}"}})",
+            name(),
+            attr.col_name,
+            threshold->isDesc(),
+            threshold->toDebugString());
+    }
+
+    RSResult roughCheck(size_t pack_id, const RSCheckParam & param) override
+    {
+        const auto value = threshold->get();
+        if (value.isNull())
+            return Some;
+
+        GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME(param, attr, rsindex);
+        // NULL is the minimum value in TiDB, so it is ordered last by DESC and first by ASC.
+        RSResult res;
+        if (threshold->isDesc())
+            res = rsindex.minmax->checkGreaterEqual(pack_id, value, rsindex.type, /*nan_direction*/ -1);
+        else
+            res = rsindex.minmax->checkIsNull(pack_id) || !rsindex.minmax->checkGreater(pack_id, value, rsindex.type, /*nan_direction*/ -1);
+        return res == None ? None : Some;
+    }
+};
+
+} // namespace DM
+
+} // namespace DB
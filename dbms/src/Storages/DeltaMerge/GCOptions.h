@@ -27,6 +27,7 @@ struct GCOptions
 {
     bool do_merge = true;
     bool do_merge_delta = true;
+    bool do_migrate_tier = true;
     bool update_safe_point = true;
 
     static GCOptions newAll()
@@ -34,6 +35,7 @@ struct GCOptions
         return GCOptions{
             .do_merge = true,
             .do_merge_delta = true,
+            .do_migrate_tier = true,
             .update_safe_point = true,
         };
     }
@@ -43,6 +45,7 @@ struct GCOptions
         return GCOptions{
             .do_merge = false,
             .do_merge_delta = false,
+            .do_migrate_tier = false,
             .update_safe_point = false,
         };
     }
@@ -52,13 +55,14 @@ struct GCOptions
         return GCOptions{
             .do_merge = true,
             .do_merge_delta = true,
+            .do_migrate_tier = true,
             .update_safe_point = false,
         };
     }
 
     std::string toString() const
     {
-        return fmt::format("<merge={} merge_delta={} update_safe_point={}>", do_merge, do_merge_delta, update_safe_point);
+        return fmt::format("<merge={} merge_delta={} migrate_tier={} update_safe_point={}>", do_merge, do_merge_delta, do_migrate_tier, update_safe_point);
     }
 };
 
@@ -193,6 +193,20 @@ std::pair<UInt64, UInt64> MinMaxIndex::getUInt64MinMax(size_t pack_index)
     return {minmaxes->get64(pack_index * 2), minmaxes->get64(pack_index * 2 + 1)};
 }
 
+std::optional<std::pair<Field, Field>> MinMaxIndex::getMinMax(size_t pack_index)
+{
+    if (pack_index >= has_value_marks->size())
+        return std::nullopt;
+    if (!(*has_value_marks)[pack_index])
+        return std::make_pair(Field(), Field());
+    auto min = (*minmaxes)[pack_index * 2];
+    auto max = (*minmaxes)[pack_index * 2 + 1];
+    // The min value of a nullable column is null if the minmax index is generated by the version before v6.4.
+    if (min.isNull() || max.isNull())
+        return std::nullopt;
+    return std::make_pair(std::move(min), std::move(max));
+}
+
 RSResult MinMaxIndex::checkNullableEqual(size_t pack_index, const Field & value, const DataTypePtr & type)
 {
     const auto & column_nullable = static_cast<const ColumnNullable &>(*minmaxes);
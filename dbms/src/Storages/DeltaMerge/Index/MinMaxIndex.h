@@ -24,6 +24,8 @@
 #include <DataTypes/IDataType.h>
 #include <Storages/DeltaMerge/Index/RSResult.h>
 
+#include <optional>
+
 namespace DB
 {
 namespace DM
@@ -77,6 +79,10 @@ public:
 
     std::pair<UInt64, UInt64> getUInt64MinMax(size_t pack_index);
 
+    /// Return the min and max value of the pack. Both of them are Null if the pack has no value.
+    /// Return std::nullopt if they are unknown.
+    std::optional<std::pair<Field, Field>> getMinMax(size_t pack_index);
+
     RSResult checkEqual(size_t pack_index, const Field & value, const DataTypePtr & type);
     RSResult checkGreater(size_t pack_index, const Field & value, const DataTypePtr & type, int nan_direction);
     RSResult checkGreaterEqual(size_t pack_index, const Field & value, const DataTypePtr & type, int nan_direction);
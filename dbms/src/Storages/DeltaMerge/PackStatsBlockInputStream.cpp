@@ -0,0 +1,55 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Storages/DeltaMerge/DeltaMergeHelpers.h>
+#include <Storages/DeltaMerge/PackStatsBlockInputStream.h>
+#include <common/logger_useful.h>
+
+namespace DB::DM
+{
+PackStatsBlockInputStream::PackStatsBlockInputStream(
+    const ColumnDefines & columns_to_read,
+    std::vector<PackStats> && packs_,
+    const String & req_id)
+    : header(toEmptyBlock(columns_to_read))
+    , packs(std::move(packs_))
+    , log(Logger::get(NAME, req_id))
+{}
+
+Block PackStatsBlockInputStream::readImpl()
+{
+    if (next_pack >= packs.size())
+        return {};
+
+    const auto & pack = packs[next_pack++];
+    RUNTIME_CHECK(pack.rows > 0 && pack.minmaxes.size() == header.columns(), pack.rows, pack.minmaxes.size(), header.columns());
+    Block block = header.cloneEmpty();
+    for (size_t i = 0; i < block.columns(); ++i)
+    {
+        auto & col = block.getByPosition(i);
+        auto column = col.type->createColumn();
+        column->reserve(pack.rows);
+        column->insertFrom(*pack.minmaxes[i], 1);
+        column->insertManyFrom(*pack.minmaxes[i], 0, pack.rows - 1);
+        col.column = std::move(column);
+    }
+    return block;
+}
+
+void PackStatsBlockInputStream::readSuffixImpl()
+{
+    LOG_DEBUG(log, "Generated {} packs from the pack statistics", next_pack);
+}
+
+} // namespace DB::DM
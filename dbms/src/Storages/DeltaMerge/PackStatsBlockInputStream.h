@@ -0,0 +1,59 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <DataStreams/IProfilingBlockInputStream.h>
+#include <Storages/DeltaMerge/DeltaMergeDefines.h>
+
+namespace DB::DM
+{
+
+/** BlockInputStream to generate the packs of the stable from their statistics instead of reading them.
+  * It is only used when all rows of the pack are visible, and the upper aggregation only needs the number
+  * of rows and the min/max values of the columns (see `PushDownFilter::aggregation_from_pack_stats`).
+  *
+  * For a pack of `n` rows, a block of `n` rows is generated: the first row is the max values and the other
+  * rows are the min values of the columns. So the count, min and max of the block are the same as the pack.
+  */
+class PackStatsBlockInputStream : public IProfilingBlockInputStream
+{
+    static constexpr auto NAME = "PackStats";
+
+public:
+    struct PackStats
+    {
+        size_t rows;
+        // One column for each column to read, which contains two rows: [min, max].
+        Columns minmaxes;
+    };
+
+    PackStatsBlockInputStream(const ColumnDefines & columns_to_read, std::vector<PackStats> && packs_, const String & req_id);
+
+    String getName() const override { return NAME; }
+    Block getHeader() const override { return header; }
+
+protected:
+    Block readImpl() override;
+
+    void readSuffixImpl() override;
+
+private:
+    Block header;
+    std::vector<PackStats> packs;
+    size_t next_pack = 0;
+    const LoggerPtr log;
+};
+
+} // namespace DB::DM
@@ -12,18 +12,545 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/Exception.h>
+#include <IO/ReadBufferFromFile.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteBufferFromFile.h>
+#include <IO/WriteHelpers.h>
 #include <Storages/DeltaMerge/Remote/RNDeltaIndexCache.h>
 
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+
 namespace DB::DM::Remote
 {
+namespace
+{
+constexpr UInt64 DELTA_INDEX_FORMAT_VERSION = 2;
+constexpr UInt64 DELTA_INDEX_FILE_MAGIC = 0x44454C5441494458; // "DELTAIDX"
+constexpr auto MANIFEST_FILE_NAME = "manifest";
+constexpr auto INDEX_FILE_SUFFIX = ".idx";
+constexpr auto TMP_FILE_SUFFIX = ".tmp";
+constexpr size_t PERSIST_INTERVAL_MS = 60 * 1000;
+
+// Write to a tmp file then rename it, so that a crash never leaves a partial file.
+template <typename WriteFunc>
+void writeFileAtomically(const String & path, WriteFunc && write_func)
+{
+    const auto tmp_path = path + TMP_FILE_SUFFIX;
+    {
+        WriteBufferFromFile buf(tmp_path);
+        write_func(buf);
+        buf.next();
+        buf.sync();
+    }
+    std::filesystem::rename(tmp_path, path);
+}
+
+std::optional<RNDeltaIndexCache::PersistKey> parseIndexFileName(const String & file_name)
+{
+    RNDeltaIndexCache::PersistKey key{};
+    char suffix[8] = {};
+    auto n = std::sscanf( // NOLINT(cert-err34-c)
+        file_name.c_str(),
+        "%" SCNu64 "_%" SCNd64 "_%" SCNu64 "_%" SCNu64 "%7s",
+        &key.store_id,
+        &key.table_id,
+        &key.segment_id,
+        &key.segment_epoch,
+        suffix);
+    if (n != 5 || std::string_view(suffix) != INDEX_FILE_SUFFIX)
+        return std::nullopt;
+    return key;
+}
+
+void writePersistKey(const RNDeltaIndexCache::PersistKey & key, WriteBuffer & buf)
+{
+    writeIntBinary(key.store_id, buf);
+    writeIntBinary(key.table_id, buf);
+    writeIntBinary(key.segment_id, buf);
+    writeIntBinary(key.segment_epoch, buf);
+}
 
-DeltaIndexPtr RNDeltaIndexCache::getDeltaIndex(const RNDeltaIndexCache::CacheKey & key)
+RNDeltaIndexCache::PersistKey readPersistKey(ReadBuffer & buf)
 {
-    auto [index_ptr, _] = cache.getOrSet(key, [] {
+    RNDeltaIndexCache::PersistKey key{};
+    readIntBinary(key.store_id, buf);
+    readIntBinary(key.table_id, buf);
+    readIntBinary(key.segment_id, buf);
+    readIntBinary(key.segment_epoch, buf);
+    return key;
+}
+
+template <typename KeyHeats>
+void sortByHeat(KeyHeats & key_heats)
+{
+    std::sort(key_heats.begin(), key_heats.end(), [](const auto & lhs, const auto & rhs) { return std::get<1>(lhs) > std::get<1>(rhs); });
+}
+
+bool isPrefixOf(const RNDeltaIndexCache::PersistedColumnFiles & prefix, const RNDeltaIndexCache::PersistedColumnFiles & files)
+{
+    return prefix.size() <= files.size() && std::equal(prefix.begin(), prefix.end(), files.begin());
+}
+} // namespace
+
+RNDeltaIndexCache::RNDeltaIndexCache(size_t max_cache_keys_, const String & persist_dir_, size_t max_persist_bytes_)
+    : cache(max_cache_keys_)
+    , persist_dir(persist_dir_)
+    , max_persist_bytes(max_persist_bytes_)
+    , log(Logger::get())
+{
+    if (isPersistEnabled())
+    {
+        std::filesystem::create_directories(persist_dir);
+        loadPersistStates();
+    }
+}
+
+RNDeltaIndexCache::~RNDeltaIndexCache()
+{
+    if (persist_handle)
+    {
+        bg_pool->removeTask(persist_handle);
+        persist_handle = nullptr;
+    }
+
+    if (isPersistEnabled())
+    {
+        try
+        {
+            persist();
+        }
+        catch (...)
+        {
+            tryLogCurrentException(log, "Failed to persist delta indexes at shutdown");
+        }
+    }
+}
+
+RNDeltaIndexCache::PersistKey RNDeltaIndexCache::toPersistKey(const CacheKey & key)
+{
+    return PersistKey{
+        .store_id = key.store_id,
+        .table_id = key.table_id,
+        .segment_id = key.segment_id,
+        .segment_epoch = key.segment_epoch,
+    };
+}
+
+DeltaIndexPtr RNDeltaIndexCache::getDeltaIndex(const RNDeltaIndexCache::CacheKey & key, const PersistedColumnFiles & persisted_files)
+{
+    const auto persist_key = toPersistKey(key);
+    std::optional<PersistedColumnFiles> restored_files;
+    auto [index_ptr, _] = cache.getOrSet(key, [&] {
+        if (isPersistEnabled())
+        {
+            if (auto restored = restoreDeltaIndex(persist_key, persisted_files); restored)
+            {
+                restored_files = std::move(restored->covered_files);
+                return restored->index;
+            }
+        }
         auto index = std::make_shared<DeltaIndex>();
         return index;
     });
+
+    if (isPersistEnabled())
+    {
+        std::lock_guard lock(mtx_persist);
+        auto & state = persist_states[persist_key];
+        state.index = index_ptr;
+        state.persisted_files = persisted_files;
+        ++state.heat;
+        if (restored_files)
+        {
+            state.persisted_status = index_ptr->getPlacedStatus();
+            state.persisted_files_covered = std::move(*restored_files);
+        }
+    }
     return index_ptr;
 }
 
+std::optional<RNDeltaIndexCache::PersistedColumnFiles> RNDeltaIndexCache::getCoveredFiles(
+    const PersistedColumnFiles & persisted_files,
+    std::pair<size_t, size_t> placed_status)
+{
+    const auto [placed_rows, placed_deletes] = placed_status;
+    size_t rows = 0;
+    size_t deletes = 0;
+    for (size_t i = 0; i <= persisted_files.size(); ++i)
+    {
+        if (rows == placed_rows && deletes == placed_deletes)
+            return PersistedColumnFiles(persisted_files.begin(), persisted_files.begin() + i);
+        if (i == persisted_files.size() || rows > placed_rows || deletes > placed_deletes)
+            break;
+        rows += persisted_files[i].rows;
+        deletes += persisted_files[i].deletes;
+    }
+    return std::nullopt;
+}
+
+size_t RNDeltaIndexCache::persist()
+{
+    if (!isPersistEnabled())
+        return 0;
+
+    std::vector<std::tuple<PersistKey, DeltaIndexPtr, PersistedColumnFiles>> to_persist;
+    {
+        std::lock_guard lock(mtx_persist);
+        for (auto iter = persist_states.begin(); iter != persist_states.end(); /* empty */)
+        {
+            auto & state = iter->second;
+            auto index = state.index.lock();
+            if (!index)
+            {
+                // The delta index is evicted from the memory, and it has nothing to be reloaded from disk.
+                if (!state.persisted)
+                {
+                    iter = persist_states.erase(iter);
+                    continue;
+                }
+            }
+            else if (auto status = index->getPlacedStatus(); status != std::pair<size_t, size_t>{0, 0})
+            {
+                auto covered_files = getCoveredFiles(state.persisted_files, status);
+                if (covered_files && (!state.persisted || status != state.persisted_status || *covered_files != state.persisted_files_covered))
+                    to_persist.emplace_back(iter->first, index, state.persisted_files);
+            }
+            ++iter;
+        }
+    }
+
+    // Serialize the delta indexes without holding the lock.
+    size_t persisted = 0;
+    for (const auto & [key, index, persisted_files] : to_persist)
+    {
+        // Take a copy, so that the placed status and the delta tree are consistent.
+        auto index_copy = index->tryClone(0, std::numeric_limits<size_t>::max());
+        const auto status = index_copy->getPlacedStatus();
+        auto covered_files = getCoveredFiles(persisted_files, status);
+        // The delta index covers the mem table, whose rows may be placed differently after the write node restarts.
+        if (!covered_files)
+            continue;
+
+        size_t persisted_bytes = 0;
+        try
+        {
+            writeFileAtomically(getIndexPath(key), [&](WriteBuffer & buf) {
+                serializeDeltaIndex(PersistedDeltaIndex{.index = index_copy, .covered_files = *covered_files}, buf);
+            });
+            persisted_bytes = std::filesystem::file_size(getIndexPath(key));
+        }
+        catch (...)
+        {
+            tryLogCurrentException(log, fmt::format("Failed to persist delta index, path={}", getIndexPath(key)));
+            continue;
+        }
+        std::lock_guard lock(mtx_persist);
+        auto & state = persist_states[key];
+        state.persisted = true;
+        state.persisted_bytes = persisted_bytes;
+        // If the delta index advanced meanwhile, it will be persisted again next time.
+        state.persisted_status = status;
+        state.persisted_files_covered = std::move(*covered_files);
+        ++persisted;
+    }
+
+    // Keep the hottest delta indexes within `max_persist_bytes` on disk, and decay the heat so that the recent accesses weigh more.
+    // The size of the delta indexes varies a lot with the size of the delta, so the disk usage is bounded by bytes instead of count.
+    std::vector<std::tuple<PersistKey, UInt64, size_t>> key_heat_bytes;
+    std::vector<std::pair<PersistKey, UInt64>> key_heats;
+    std::vector<PersistKey> to_remove;
+    size_t total_bytes = 0;
+    {
+        std::lock_guard lock(mtx_persist);
+        for (auto & [key, state] : persist_states)
+        {
+            state.heat = (state.heat + 1) / 2;
+            if (state.persisted)
+                key_heat_bytes.emplace_back(key, state.heat, state.persisted_bytes);
+        }
+        sortByHeat(key_heat_bytes);
+        for (const auto & [key, heat, bytes] : key_heat_bytes)
+        {
+            if (total_bytes + bytes <= max_persist_bytes)
+            {
+                total_bytes += bytes;
+                key_heats.emplace_back(key, heat);
+                continue;
+            }
+            // Forget the key, it will be tracked again when it is accessed.
+            persist_states.erase(key);
+            to_remove.push_back(key);
+        }
+    }
+    for (const auto & key : to_remove)
+    {
+        std::error_code ec;
+        std::filesystem::remove(getIndexPath(key), ec);
+    }
+    writeManifest(key_heats);
+
+    if (persisted > 0 || !to_remove.empty())
+        LOG_DEBUG(log, "Persist delta indexes done, persisted={} removed={} total={} total_bytes={}", persisted, to_remove.size(), key_heats.size(), total_bytes);
+    return persisted;
+}
+
+size_t RNDeltaIndexCache::warmup(size_t max_count)
+{
+    if (!isPersistEnabled())
+        return 0;
+
+    std::vector<std::pair<PersistKey, UInt64>> key_heats;
+    {
+        std::lock_guard lock(mtx_persist);
+        for (const auto & [key, state] : persist_states)
+        {
+            if (state.persisted && state.index.expired() && !state.warmed_up)
+                key_heats.emplace_back(key, state.heat);
+        }
+    }
+    sortByHeat(key_heats);
+    if (key_heats.size() > max_count)
+        key_heats.resize(max_count);
+
+    // The current persisted column files of the delta are unknown until the segment is read, so the
+    // delta indexes are kept aside and checked when they are accessed.
+    size_t restored_count = 0;
+    for (const auto & [key, heat] : key_heats)
+    {
+        auto persisted = readDeltaIndex(key);
+        if (!persisted)
+            continue;
+
+        std::lock_guard lock(mtx_persist);
+        auto iter = persist_states.find(key);
+        if (iter == persist_states.end() || !iter->second.index.expired())
+            continue;
+        iter->second.warmed_up = std::move(persisted);
+        ++restored_count;
+    }
+    LOG_INFO(log, "Warmup delta indexes done, restored={} candidates={}", restored_count, key_heats.size());
+    return restored_count;
+}
+
+void RNDeltaIndexCache::startBackgroundPersist(BackgroundProcessingPool & pool, size_t warmup_count)
+{
+    RUNTIME_CHECK(bg_pool == nullptr);
+    if (!isPersistEnabled())
+        return;
+
+    bg_pool = &pool;
+    persist_handle = pool.addTask(
+        [this, warmup_count, warmed_up = false]() mutable {
+            if (!warmed_up)
+            {
+                warmed_up = true;
+                warmup(warmup_count);
+                return false;
+            }
+            persist();
+            return false;
+        },
+        /*multi*/ false,
+        PERSIST_INTERVAL_MS);
+}
+
+void RNDeltaIndexCache::serializeDeltaIndex(const PersistedDeltaIndex & persisted, WriteBuffer & buf)
+{
+    const auto [placed_rows, placed_deletes] = persisted.index->getPlacedStatus();
+    const auto delta_tree = persisted.index->getDeltaTree();
+
+    writeIntBinary(DELTA_INDEX_FORMAT_VERSION, buf);
+    writeIntBinary(static_cast<UInt64>(persisted.covered_files.size()), buf);
+    for (const auto & file : persisted.covered_files)
+    {
+        writeIntBinary(file.page_id, buf);
+        writeIntBinary(file.rows, buf);
+        writeIntBinary(file.deletes, buf);
+    }
+    writeIntBinary(static_cast<UInt64>(placed_rows), buf);
+    writeIntBinary(static_cast<UInt64>(placed_deletes), buf);
+    writeIntBinary(static_cast<UInt64>(delta_tree->numEntries()), buf);
+    for (auto it = delta_tree->begin(), end = delta_tree->end(); it != end; ++it)
+    {
+        writeIntBinary(static_cast<UInt64>(it.getRid()), buf);
+        writeIntBinary(static_cast<UInt8>(it.isInsert()), buf);
+        writeIntBinary(static_cast<UInt32>(it.getCount()), buf);
+        writeIntBinary(static_cast<UInt64>(it.getValue()), buf);
+    }
+    writeIntBinary(DELTA_INDEX_FILE_MAGIC, buf);
+}
+
+RNDeltaIndexCache::PersistedDeltaIndex RNDeltaIndexCache::deserializeDeltaIndex(ReadBuffer & buf)
+{
+    UInt64 version = 0;
+    readIntBinary(version, buf);
+    RUNTIME_CHECK_MSG(version == DELTA_INDEX_FORMAT_VERSION, "Unknown delta index format version {}", version);
+
+    UInt64 num_files = 0;
+    readIntBinary(num_files, buf);
+    PersistedColumnFiles covered_files(num_files);
+    for (auto & file : covered_files)
+    {
+        readIntBinary(file.page_id, buf);
+        readIntBinary(file.rows, buf);
+        readIntBinary(file.deletes, buf);
+    }
+
+    UInt64 placed_rows = 0;
+    UInt64 placed_deletes = 0;
+    UInt64 num_entries = 0;
+    readIntBinary(placed_rows, buf);
+    readIntBinary(placed_deletes, buf);
+    readIntBinary(num_entries, buf);
+
+    // The entries are in the order of rid, replaying them rebuilds the same delta tree
+    // without reading and sorting the delta again.
+    auto delta_tree = std::make_shared<DefaultDeltaTree>();
+    for (UInt64 i = 0; i < num_entries; ++i)
+    {
+        UInt64 rid = 0;
+        UInt8 is_insert = 0;
+        UInt32 count = 0;
+        UInt64 value = 0;
+        readIntBinary(rid, buf);
+        readIntBinary(is_insert, buf);
+        readIntBinary(count, buf);
+        readIntBinary(value, buf);
+        if (is_insert)
+        {
+            delta_tree->addInsert(rid, value);
+        }
+        else
+        {
+            for (UInt32 n = 0; n < count; ++n)
+                delta_tree->addDelete(rid);
+        }
+    }
+
+    UInt64 magic = 0;
+    readIntBinary(magic, buf);
+    RUNTIME_CHECK_MSG(magic == DELTA_INDEX_FILE_MAGIC, "Broken delta index file, magic={:x}", magic);
+    return PersistedDeltaIndex{
+        .index = std::make_shared<DeltaIndex>(delta_tree, placed_rows, placed_deletes),
+        .covered_files = std::move(covered_files),
+    };
+}
+
+String RNDeltaIndexCache::getIndexPath(const PersistKey & key) const
+{
+    return std::filesystem::path(persist_dir) / fmt::format("{}_{}_{}_{}{}", key.store_id, key.table_id, key.segment_id, key.segment_epoch, INDEX_FILE_SUFFIX);
+}
+
+std::optional<RNDeltaIndexCache::PersistedDeltaIndex> RNDeltaIndexCache::restoreDeltaIndex(const PersistKey & key, const PersistedColumnFiles & persisted_files)
+{
+    std::optional<PersistedDeltaIndex> persisted;
+    {
+        std::lock_guard lock(mtx_persist);
+        auto iter = persist_states.find(key);
+        if (iter == persist_states.end() || !iter->second.persisted)
+            return std::nullopt;
+        persisted.swap(iter->second.warmed_up);
+    }
+    if (!persisted)
+        persisted = readDeltaIndex(key);
+    if (!persisted)
+        return std::nullopt;
+
+    // The delta has been compacted or is changed after the write node restarts, the delta index can not be reused.
+    if (!isPrefixOf(persisted->covered_files, persisted_files))
+    {
+        LOG_DEBUG(log, "Skip restoring outdated delta index, path={}", getIndexPath(key));
+        return std::nullopt;
+    }
+    LOG_DEBUG(log, "Restored delta index, path={} index={}", getIndexPath(key), persisted->index->toString());
+    return persisted;
+}
+
+std::optional<RNDeltaIndexCache::PersistedDeltaIndex> RNDeltaIndexCache::readDeltaIndex(const PersistKey & key) const
+{
+    const auto path = getIndexPath(key);
+    if (!std::filesystem::exists(path))
+        return std::nullopt;
+
+    try
+    {
+        ReadBufferFromFile buf(path);
+        return deserializeDeltaIndex(buf);
+    }
+    catch (...)
+    {
+        tryLogCurrentException(log, fmt::format("Failed to restore delta index, path={}", path));
+    }
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    return std::nullopt;
+}
+
+void RNDeltaIndexCache::loadPersistStates()
+{
+    std::unordered_map<PersistKey, UInt64, PersistKeyHasher> heats;
+    const auto manifest_path = std::filesystem::path(persist_dir) / MANIFEST_FILE_NAME;
+    if (std::filesystem::exists(manifest_path))
+    {
+        try
+        {
+            ReadBufferFromFile buf(manifest_path);
+            UInt64 version = 0;
+            UInt64 count = 0;
+            readIntBinary(version, buf);
+            RUNTIME_CHECK_MSG(version == DELTA_INDEX_FORMAT_VERSION, "Unknown delta index manifest version {}", version);
+            readIntBinary(count, buf);
+            for (UInt64 i = 0; i < count; ++i)
+            {
+                auto key = readPersistKey(buf);
+                readIntBinary(heats[key], buf);
+            }
+        }
+        catch (...)
+        {
+            // The heat is only used for choosing the delta indexes to warmup, it is fine to lose it.
+            tryLogCurrentException(log, fmt::format("Failed to read delta index manifest, path={}", manifest_path.string()));
+        }
+    }
+
+    for (const auto & entry : std::filesystem::directory_iterator(persist_dir))
+    {
+        const auto file_name = entry.path().filename().string();
+        auto key = parseIndexFileName(file_name);
+        if (!key && file_name != MANIFEST_FILE_NAME)
+        {
+            // Left by a crash during persisting, or written in an unknown format.
+            std::error_code ec;
+            std::filesystem::remove(entry.path(), ec);
+            continue;
+        }
+        if (key)
+        {
+            auto & state = persist_states[*key];
+            state.persisted = true;
+            state.persisted_bytes = entry.file_size();
+            if (auto iter = heats.find(*key); iter != heats.end())
+                state.heat = iter->second;
+        }
+    }
+    LOG_INFO(log, "Found persisted delta indexes, dir={} count={}", persist_dir, persist_states.size());
+}
+
+void RNDeltaIndexCache::writeManifest(const std::vector<std::pair<PersistKey, UInt64>> & key_heats) const
+{
+    writeFileAtomically(std::filesystem::path(persist_dir) / MANIFEST_FILE_NAME, [&](WriteBuffer & buf) {
+        writeIntBinary(DELTA_INDEX_FORMAT_VERSION, buf);
+        writeIntBinary(static_cast<UInt64>(key_heats.size()), buf);
+        for (const auto & [key, heat] : key_heats)
+        {
+            writePersistKey(key, buf);
+            writeIntBinary(heat, buf);
+        }
+    });
+}
+
 } // namespace DB::DM::Remote
@@ -15,27 +15,53 @@
 #pragma once
 
 #include <Common/LRUCache.h>
+#include <Common/Logger.h>
+#include <Storages/BackgroundProcessingPool.h>
 #include <Storages/DeltaMerge/DeltaIndex.h>
 #include <Storages/DeltaMerge/Remote/RNDeltaIndexCache_fwd.h>
 #include <common/types.h>
 
 #include <boost/noncopyable.hpp>
+#include <limits>
+#include <optional>
+
+namespace DB
+{
+class ReadBuffer;
+class WriteBuffer;
+} // namespace DB
 
 namespace DB::DM::Remote
 {
 /**
  * A LRU cache that holds delta-tree indexes from different remote write nodes.
  * Delta-tree indexes are used as much as possible when same segments are accessed multiple times.
+ *
+ * When `persist_dir` is not empty, the delta indexes are also persisted to the local disk, so that
+ * they survive restarts of the compute node:
+ * - `persist` writes the delta indexes that advanced since last persisted. It is called periodically
+ *   by the background pool after `startBackgroundPersist`, and at shutdown.
+ * - `getDeltaIndex` lazily reloads the persisted delta index when it is not in the memory.
+ * - `warmup` reloads the hottest persisted delta indexes. It is called by the background pool at startup.
+ * The persisted files take at most `max_persist_bytes` on disk, the coldest ones are removed.
+ *
+ * `delta_index_epoch` is only kept in the memory of the write node, and starts from 0 again after the write
+ * node restarts, so it is not a part of the persisted key. Instead, a persisted delta index records the
+ * persisted column files it covers, which are identified by their page ids. The page ids are persisted on the
+ * write node and never reused. The persisted delta index is only reused when these column files are still the
+ * first ones of the delta, and only the delta indexes that do not cover the mem table are persisted.
  */
 class RNDeltaIndexCache : private boost::noncopyable
 {
 public:
-    // TODO: Currently we use a quantity based cache size. We could change to memory-size based.
+    // TODO: Currently the memory cache uses a quantity based cache size. We could change to memory-size based.
     //       However, as the delta index's size could be changing, we need to implement our own LRU instead.
-    explicit RNDeltaIndexCache(size_t max_cache_keys)
-        : cache(max_cache_keys)
-    {
-    }
+    explicit RNDeltaIndexCache(
+        size_t max_cache_keys,
+        const String & persist_dir_ = "",
+        size_t max_persist_bytes_ = std::numeric_limits<size_t>::max());
+
+    ~RNDeltaIndexCache();
 
     struct CacheKey
     {
@@ -69,13 +95,118 @@ public:
         }
     };
 
+    /// The key of the persisted delta indexes, see the comments of the class for why `delta_index_epoch` is excluded.
+    struct PersistKey
+    {
+        UInt64 store_id;
+        Int64 table_id;
+        UInt64 segment_id;
+        UInt64 segment_epoch;
+
+        bool operator==(const PersistKey & other) const = default;
+    };
+
+    struct PersistKeyHasher
+    {
+        size_t operator()(const PersistKey & k) const
+        {
+            using std::hash;
+
+            return hash<UInt64>()(k.store_id) ^ //
+                hash<Int64>()(k.table_id) ^ //
+                hash<UInt64>()(k.segment_id) ^ //
+                hash<UInt64>()(k.segment_epoch);
+        }
+    };
+
+    /// A persisted column file of the delta. Delete ranges have no page id, they are identified by their
+    /// position among the other column files.
+    struct PersistedColumnFile
+    {
+        UInt64 page_id;
+        UInt64 rows;
+        UInt64 deletes;
+
+        bool operator==(const PersistedColumnFile & other) const = default;
+    };
+    using PersistedColumnFiles = std::vector<PersistedColumnFile>;
+
     /**
      * Returns a cached or newly created delta index, which is assigned to the specified segment(at)epoch.
+     * `persisted_files` are the persisted column files of the delta, which are used to check whether the persisted
+     * delta index can be reused, and to decide which delta indexes can be persisted.
      */
-    DeltaIndexPtr getDeltaIndex(const CacheKey & key);
+    DeltaIndexPtr getDeltaIndex(const CacheKey & key, const PersistedColumnFiles & persisted_files = {});
+
+    /// Persist the delta indexes that advanced since last persisted. Returns the number of persisted delta indexes.
+    size_t persist();
+
+    /// Reload at most `max_count` hottest persisted delta indexes. They are put into the cache once they are
+    /// accessed and the persisted column files of the delta are known. Returns the number of reloaded delta indexes.
+    size_t warmup(size_t max_count);
+
+    /// Warmup at first, then persist the delta indexes periodically in the background pool.
+    void startBackgroundPersist(BackgroundProcessingPool & pool, size_t warmup_count);
+
+    bool isPersistEnabled() const { return !persist_dir.empty(); }
+
+    /// Returns the leading `persisted_files` covered by the placed rows and deletes exactly, or std::nullopt if the
+    /// delta index covers the mem table.
+    static std::optional<PersistedColumnFiles> getCoveredFiles(
+        const PersistedColumnFiles & persisted_files,
+        std::pair<size_t, size_t> placed_status);
+
+    struct PersistedDeltaIndex
+    {
+        DeltaIndexPtr index;
+        PersistedColumnFiles covered_files;
+    };
+    /// `index` should not be updated concurrently.
+    static void serializeDeltaIndex(const PersistedDeltaIndex & persisted, WriteBuffer & buf);
+    static PersistedDeltaIndex deserializeDeltaIndex(ReadBuffer & buf);
+
+private:
+    static PersistKey toPersistKey(const CacheKey & key);
+
+    String getIndexPath(const PersistKey & key) const;
+
+    // Returns the persisted delta index if it covers the leading `persisted_files`.
+    std::optional<PersistedDeltaIndex> restoreDeltaIndex(const PersistKey & key, const PersistedColumnFiles & persisted_files);
+    std::optional<PersistedDeltaIndex> readDeltaIndex(const PersistKey & key) const;
+
+    // Load the keys of the persisted delta indexes and their heat.
+    void loadPersistStates();
+    void writeManifest(const std::vector<std::pair<PersistKey, UInt64>> & key_heats) const;
 
 private:
     LRUCache<CacheKey, DeltaIndex, CacheKeyHasher> cache;
+    const String persist_dir;
+    const size_t max_persist_bytes;
+
+    struct PersistState
+    {
+        // The delta index of the latest delta_index_epoch.
+        std::weak_ptr<DeltaIndex> index;
+        // The persisted column files of the delta when the delta index was last accessed.
+        PersistedColumnFiles persisted_files;
+        // The access count of the key, it decays every time the delta indexes are persisted.
+        UInt64 heat = 0;
+        bool persisted = false;
+        // The size of the persisted file.
+        size_t persisted_bytes = 0;
+        // The {placed_rows, placed_deletes} and the covered column files of the persisted delta index.
+        std::pair<size_t, size_t> persisted_status{0, 0};
+        PersistedColumnFiles persisted_files_covered;
+        // Reloaded by `warmup`, and moved into the cache once it is accessed.
+        std::optional<PersistedDeltaIndex> warmed_up;
+    };
+    std::mutex mtx_persist;
+    std::unordered_map<PersistKey, PersistState, PersistKeyHasher> persist_states;
+
+    BackgroundProcessingPool * bg_pool = nullptr;
+    BackgroundProcessingPool::TaskHandle persist_handle;
+
+    LoggerPtr log;
 };
 
 } // namespace DB::DM::Remote
@@ -245,30 +245,31 @@ RNRemoteSegmentReadTaskPtr RNRemoteReadTask::nextReadyTask()
 {
     std::unique_lock ready_lock(mtx_ready_tasks);
     RNRemoteSegmentReadTaskPtr seg_task = nullptr;
-    cv_ready_tasks.wait(ready_lock, [this, &seg_task] {
-        // All segment task are processed, return a nullptr
-        if (doneOrErrorHappen())
-            return true;
+    cv_ready_tasks.wait(ready_lock, [this, &seg_task, &ready_lock] {
+        return popReadyTask(seg_task, ready_lock);
+    });
 
-        // First check whether there are prepared segment task
-        if (auto iter = ready_segment_tasks.find(SegmentReadTaskState::DataReadyAndPrepared); iter != ready_segment_tasks.end())
-        {
-            if (!iter->second.empty())
-            {
-                seg_task = iter->second.front();
-                iter->second.pop_front();
-                if (iter->second.empty())
-                {
-                    ready_segment_tasks.erase(iter);
-                }
-                return true;
-            }
-        }
-        // Else fallback to check whether there are segment task ready for reading
-        if (auto iter = ready_segment_tasks.find(SegmentReadTaskState::DataReady); iter != ready_segment_tasks.end())
+    return seg_task;
+}
+
+bool RNRemoteReadTask::tryNextReadyTask(RNRemoteSegmentReadTaskPtr & seg_task)
+{
+    seg_task = nullptr;
+    std::unique_lock ready_lock(mtx_ready_tasks);
+    return popReadyTask(seg_task, ready_lock);
+}
+
+bool RNRemoteReadTask::popReadyTask(RNRemoteSegmentReadTaskPtr & seg_task, std::unique_lock<std::mutex> &)
+{
+    // All segment task are processed, return a nullptr
+    if (doneOrErrorHappen())
+        return true;
+
+    // First check whether there are prepared segment task
+    if (auto iter = ready_segment_tasks.find(SegmentReadTaskState::DataReadyAndPrepared); iter != ready_segment_tasks.end())
+    {
+        if (!iter->second.empty())
         {
-            if (iter->second.empty())
-                return false; // yield and wait for next check
             seg_task = iter->second.front();
             iter->second.pop_front();
             if (iter->second.empty())
@@ -277,10 +278,21 @@ RNRemoteSegmentReadTaskPtr RNRemoteReadTask::nextReadyTask()
             }
             return true;
         }
-        return false; // yield and wait for next check
-    });
-
-    return seg_task;
+    }
+    // Else fallback to check whether there are segment task ready for reading
+    if (auto iter = ready_segment_tasks.find(SegmentReadTaskState::DataReady); iter != ready_segment_tasks.end())
+    {
+        if (iter->second.empty())
+            return false; // yield and wait for next check
+        seg_task = iter->second.front();
+        iter->second.pop_front();
+        if (iter->second.empty())
+        {
+            ready_segment_tasks.erase(iter);
+        }
+        return true;
+    }
+    return false; // yield and wait for next check
 }
 
 const String & RNRemoteReadTask::getErrorMessage() const
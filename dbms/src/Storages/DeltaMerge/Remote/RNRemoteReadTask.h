@@ -90,6 +90,11 @@ public:
     // Return a segment read task that is ready for reading.
     RNRemoteSegmentReadTaskPtr nextReadyTask();
 
+    // The non-blocking version of `nextReadyTask`. Return false if no segment task
+    // is ready for reading yet. Otherwise return true and `seg_task` is set to the
+    // ready segment task, or nullptr if there is no task left or error happen.
+    bool tryNextReadyTask(RNRemoteSegmentReadTaskPtr & seg_task);
+
     void wakeAll() { cv_ready_tasks.notify_all(); }
 
     const String & getErrorMessage() const;
@@ -100,6 +105,8 @@ public:
 private:
     void insertTask(const RNRemoteSegmentReadTaskPtr & seg_task, std::unique_lock<std::mutex> &);
 
+    bool popReadyTask(RNRemoteSegmentReadTaskPtr & seg_task, std::unique_lock<std::mutex> &);
+
     bool doneOrErrorHappen() const;
 
 private:
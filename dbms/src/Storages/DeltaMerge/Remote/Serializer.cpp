@@ -138,13 +138,29 @@ SegmentSnapshotPtr Serializer::deserializeSegmentSnapshotFrom(
     auto delta_index_cache = dm_context.db_context.getSharedContextDisagg()->rn_delta_index_cache;
     if (delta_index_cache)
     {
-        delta_snap->shared_delta_index = delta_index_cache->getDeltaIndex({
-            .store_id = remote_store_id,
-            .table_id = table_id,
-            .segment_id = proto.segment_id(),
-            .segment_epoch = proto.segment_epoch(),
-            .delta_index_epoch = proto.delta_index_epoch(),
-        });
+        // The persisted column files identify the delta across the restarts of the write node, see RNDeltaIndexCache.
+        RNDeltaIndexCache::PersistedColumnFiles persisted_files;
+        if (delta_index_cache->isPersistEnabled())
+        {
+            for (const auto & column_file : delta_snap->persisted_files_snap->getColumnFiles())
+            {
+                UInt64 page_id = 0;
+                if (auto * cf_tiny = column_file->tryToTinyFile(); cf_tiny)
+                    page_id = cf_tiny->getDataPageId();
+                else if (auto * cf_big = column_file->tryToBigFile(); cf_big)
+                    page_id = cf_big->getFile()->pageId();
+                persisted_files.push_back({.page_id = page_id, .rows = column_file->getRows(), .deletes = column_file->getDeletes()});
+            }
+        }
+        delta_snap->shared_delta_index = delta_index_cache->getDeltaIndex(
+            {
+                .store_id = remote_store_id,
+                .table_id = table_id,
+                .segment_id = proto.segment_id(),
+                .segment_epoch = proto.segment_epoch(),
+                .delta_index_epoch = proto.delta_index_epoch(),
+            },
+            persisted_files);
     }
     else
     {
@@ -0,0 +1,295 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <Storages/DeltaMerge/Remote/RNDeltaIndexCache.h>
+#include <TestUtils/TiFlashStorageTestBasic.h>
+
+#include <filesystem>
+#include <random>
+
+namespace DB::DM::Remote::tests
+{
+
+class RNDeltaIndexCacheTest : public DB::base::TiFlashStorageTestBasic
+{
+public:
+    void SetUp() override
+    {
+        TiFlashStorageTestBasic::SetUp();
+        persist_dir = getTemporaryPath();
+        dropDataOnDisk(persist_dir);
+    }
+
+    // Build a delta index with random inserts and deletes.
+    static DeltaIndexPtr buildDeltaIndex(size_t ops, UInt64 seed)
+    {
+        std::mt19937_64 rng(seed);
+        auto delta_tree = std::make_shared<DefaultDeltaTree>();
+        UInt64 tuple_id = 0;
+        size_t deletes = 0;
+        for (size_t i = 0; i < ops; ++i)
+        {
+            if (rng() % 3 == 0)
+            {
+                delta_tree->addDelete(rng() % 500);
+                ++deletes;
+            }
+            else
+            {
+                delta_tree->addInsert(rng() % 500, tuple_id++);
+            }
+        }
+        return std::make_shared<DeltaIndex>(delta_tree, tuple_id, deletes);
+    }
+
+    static void assertDeltaIndexEqual(const DeltaIndexPtr & expected, const DeltaIndexPtr & actual)
+    {
+        ASSERT_EQ(expected->getPlacedStatus(), actual->getPlacedStatus());
+        auto expected_tree = expected->getDeltaTree();
+        auto actual_tree = actual->getDeltaTree();
+        ASSERT_EQ(expected_tree->numEntries(), actual_tree->numEntries());
+        ASSERT_EQ(expected_tree->numInserts(), actual_tree->numInserts());
+        ASSERT_EQ(expected_tree->numDeletes(), actual_tree->numDeletes());
+        auto actual_it = actual_tree->begin();
+        for (auto it = expected_tree->begin(); it != expected_tree->end(); ++it, ++actual_it)
+        {
+            ASSERT_EQ(it.getRid(), actual_it.getRid());
+            ASSERT_EQ(it.getSid(), actual_it.getSid());
+            ASSERT_EQ(it.isInsert(), actual_it.isInsert());
+            ASSERT_EQ(it.getCount(), actual_it.getCount());
+            ASSERT_EQ(it.getValue(), actual_it.getValue());
+        }
+        ASSERT_TRUE(actual_it == actual_tree->end());
+    }
+
+    static RNDeltaIndexCache::CacheKey makeKey(UInt64 segment_id, UInt64 delta_index_epoch = 3)
+    {
+        return {.store_id = 1, .table_id = 100, .segment_id = segment_id, .segment_epoch = 2, .delta_index_epoch = delta_index_epoch};
+    }
+
+    // The persisted column files covered by the delta index exactly: a tiny file with all the rows, then delete ranges.
+    static RNDeltaIndexCache::PersistedColumnFiles makeFiles(const DeltaIndexPtr & index, UInt64 page_id)
+    {
+        const auto [rows, deletes] = index->getPlacedStatus();
+        RNDeltaIndexCache::PersistedColumnFiles files{{.page_id = page_id, .rows = rows, .deletes = 0}};
+        for (size_t i = 0; i < deletes; ++i)
+            files.push_back({.page_id = 0, .rows = 0, .deletes = 1});
+        return files;
+    }
+
+    static RNDeltaIndexCache::PersistedColumnFiles appendFile(RNDeltaIndexCache::PersistedColumnFiles files, UInt64 page_id)
+    {
+        files.push_back({.page_id = page_id, .rows = 10, .deletes = 0});
+        return files;
+    }
+
+    static size_t serializedBytes(const DeltaIndexPtr & index, UInt64 page_id)
+    {
+        WriteBufferFromOwnString wb;
+        RNDeltaIndexCache::serializeDeltaIndex({.index = index, .covered_files = makeFiles(index, page_id)}, wb);
+        return wb.str().size();
+    }
+
+    size_t numPersistedFiles() const
+    {
+        size_t n = 0;
+        for (const auto & entry : std::filesystem::directory_iterator(persist_dir))
+            n += entry.path().extension() == ".idx";
+        return n;
+    }
+
+protected:
+    String persist_dir;
+};
+
+TEST_F(RNDeltaIndexCacheTest, SerializeDeltaIndex)
+try
+{
+    for (size_t ops : {0, 1, 100, 10000})
+    {
+        auto index = buildDeltaIndex(ops, ops);
+        auto files = makeFiles(index, 10);
+        WriteBufferFromOwnString wb;
+        RNDeltaIndexCache::serializeDeltaIndex({.index = index, .covered_files = files}, wb);
+        ReadBufferFromString rb(wb.str());
+        auto restored = RNDeltaIndexCache::deserializeDeltaIndex(rb);
+        assertDeltaIndexEqual(index, restored.index);
+        ASSERT_EQ(files, restored.covered_files);
+    }
+}
+CATCH
+
+TEST_F(RNDeltaIndexCacheTest, GetCoveredFiles)
+try
+{
+    RNDeltaIndexCache::PersistedColumnFiles files{
+        {.page_id = 10, .rows = 5, .deletes = 0},
+        {.page_id = 0, .rows = 0, .deletes = 1},
+        {.page_id = 11, .rows = 3, .deletes = 0},
+    };
+    using Files = RNDeltaIndexCache::PersistedColumnFiles;
+    ASSERT_EQ(Files{}, RNDeltaIndexCache::getCoveredFiles(files, {0, 0}).value());
+    ASSERT_EQ(Files(files.begin(), files.begin() + 1), RNDeltaIndexCache::getCoveredFiles(files, {5, 0}).value());
+    ASSERT_EQ(Files(files.begin(), files.begin() + 2), RNDeltaIndexCache::getCoveredFiles(files, {5, 1}).value());
+    ASSERT_EQ(files, RNDeltaIndexCache::getCoveredFiles(files, {8, 1}).value());
+    // Placed in the middle of a column file.
+    ASSERT_FALSE(RNDeltaIndexCache::getCoveredFiles(files, {4, 0}).has_value());
+    // Covers the mem table.
+    ASSERT_FALSE(RNDeltaIndexCache::getCoveredFiles(files, {9, 1}).has_value());
+    ASSERT_FALSE(RNDeltaIndexCache::getCoveredFiles(files, {8, 2}).has_value());
+}
+CATCH
+
+TEST_F(RNDeltaIndexCacheTest, PersistAndRestore)
+try
+{
+    auto expected1 = buildDeltaIndex(1000, 1);
+    auto expected2 = buildDeltaIndex(2000, 2);
+    auto files1 = makeFiles(expected1, 10);
+    auto files2 = makeFiles(expected2, 20);
+    {
+        RNDeltaIndexCache cache(10, persist_dir);
+        ASSERT_EQ(cache.persist(), 0);
+        cache.getDeltaIndex(makeKey(1), files1)->swap(*buildDeltaIndex(1000, 1));
+        cache.getDeltaIndex(makeKey(2), files2)->swap(*buildDeltaIndex(1000, 2));
+        // Empty delta index is not persisted.
+        cache.getDeltaIndex(makeKey(3));
+        // The delta index of key 2 is placed in the middle of the column files, so it is not persisted.
+        ASSERT_EQ(cache.persist(), 1);
+        // Nothing changed.
+        ASSERT_EQ(cache.persist(), 0);
+        ASSERT_EQ(numPersistedFiles(), 1);
+
+        cache.getDeltaIndex(makeKey(2), files2)->swap(*buildDeltaIndex(2000, 2));
+        ASSERT_EQ(cache.persist(), 1);
+        // Make key 2 hotter than key 1.
+        for (size_t i = 0; i < 10; ++i)
+            cache.getDeltaIndex(makeKey(2), files2);
+    }
+    {
+        RNDeltaIndexCache cache(10, persist_dir);
+        // Warmup the hottest one.
+        ASSERT_EQ(cache.warmup(1), 1);
+        // New column files are appended to the delta, the persisted delta index can be reused.
+        assertDeltaIndexEqual(expected2, cache.getDeltaIndex(makeKey(2), appendFile(files2, 21)));
+        // Lazily reload the other one.
+        assertDeltaIndexEqual(expected1, cache.getDeltaIndex(makeKey(1), files1));
+        // Not persisted, a new empty one is returned.
+        ASSERT_EQ(cache.getDeltaIndex(makeKey(3))->getPlacedStatus(), std::make_pair<size_t, size_t>(0, 0));
+        // The restored ones are not changed, no need to persist again.
+        ASSERT_EQ(cache.persist(), 0);
+    }
+}
+CATCH
+
+TEST_F(RNDeltaIndexCacheTest, RestartWriteNode)
+try
+{
+    auto expected = buildDeltaIndex(1000, 1);
+    auto files = makeFiles(expected, 10);
+    {
+        RNDeltaIndexCache cache(10, persist_dir);
+        cache.getDeltaIndex(makeKey(1, /*delta_index_epoch*/ 3), files)->swap(*buildDeltaIndex(1000, 1));
+        ASSERT_EQ(cache.persist(), 1);
+    }
+    {
+        // The delta_index_epoch starts from 0 again after the write node restarts, the persisted delta index is
+        // reused as long as the column files are the same.
+        RNDeltaIndexCache cache(10, persist_dir);
+        assertDeltaIndexEqual(expected, cache.getDeltaIndex(makeKey(1, /*delta_index_epoch*/ 0), files));
+    }
+    {
+        // The delta is compacted into a new column file, the persisted delta index is not reused even with the same epoch.
+        RNDeltaIndexCache cache(10, persist_dir);
+        ASSERT_EQ(cache.warmup(10), 1);
+        ASSERT_EQ(cache.getDeltaIndex(makeKey(1, /*delta_index_epoch*/ 3), makeFiles(expected, 11))->getPlacedStatus(), std::make_pair<size_t, size_t>(0, 0));
+    }
+}
+CATCH
+
+TEST_F(RNDeltaIndexCacheTest, NotPersistMemTable)
+try
+{
+    auto index = buildDeltaIndex(1000, 1);
+    RNDeltaIndexCache cache(10, persist_dir);
+    // Only a part of the rows are in the persisted column files, the others are in the mem table.
+    auto files = makeFiles(buildDeltaIndex(100, 1), 10);
+    cache.getDeltaIndex(makeKey(1), files)->swap(*index);
+    ASSERT_EQ(cache.persist(), 0);
+    ASSERT_EQ(numPersistedFiles(), 0);
+
+    // The mem table is flushed.
+    ASSERT_EQ(cache.getDeltaIndex(makeKey(1), makeFiles(index, 10))->getPlacedStatus(), index->getPlacedStatus());
+    ASSERT_EQ(cache.persist(), 1);
+    ASSERT_EQ(numPersistedFiles(), 1);
+}
+CATCH
+
+TEST_F(RNDeltaIndexCacheTest, KeepHottestOnDisk)
+try
+{
+    // The larger segment_id, the hotter. Segment 1 has a small delta index, segment 2 and 3 have large ones.
+    auto ops = [](UInt64 segment_id) -> size_t {
+        return segment_id == 1 ? 100 : 1000;
+    };
+    // Only the hottest large one and the small one fit in the disk.
+    const size_t max_persist_bytes = serializedBytes(buildDeltaIndex(ops(3), 3), 3) + serializedBytes(buildDeltaIndex(ops(1), 1), 1);
+    {
+        RNDeltaIndexCache cache(10, persist_dir, max_persist_bytes);
+        for (UInt64 segment_id = 1; segment_id <= 3; ++segment_id)
+        {
+            auto files = makeFiles(buildDeltaIndex(ops(segment_id), segment_id), segment_id);
+            for (UInt64 i = 0; i < segment_id * 10; ++i)
+                cache.getDeltaIndex(makeKey(segment_id), files);
+            cache.getDeltaIndex(makeKey(segment_id), files)->swap(*buildDeltaIndex(ops(segment_id), segment_id));
+        }
+        cache.persist();
+        ASSERT_EQ(numPersistedFiles(), 2);
+    }
+    {
+        RNDeltaIndexCache cache(10, persist_dir, max_persist_bytes);
+        ASSERT_EQ(cache.warmup(10), 2);
+        assertDeltaIndexEqual(buildDeltaIndex(ops(1), 1), cache.getDeltaIndex(makeKey(1), makeFiles(buildDeltaIndex(ops(1), 1), 1)));
+        ASSERT_EQ(cache.getDeltaIndex(makeKey(2), makeFiles(buildDeltaIndex(ops(2), 2), 2))->getPlacedStatus(), std::make_pair<size_t, size_t>(0, 0));
+        assertDeltaIndexEqual(buildDeltaIndex(ops(3), 3), cache.getDeltaIndex(makeKey(3), makeFiles(buildDeltaIndex(ops(3), 3), 3)));
+    }
+}
+CATCH
+
+TEST_F(RNDeltaIndexCacheTest, BrokenFile)
+try
+{
+    auto files = makeFiles(buildDeltaIndex(100, 1), 10);
+    {
+        RNDeltaIndexCache cache(10, persist_dir);
+        cache.getDeltaIndex(makeKey(1), files)->swap(*buildDeltaIndex(100, 1));
+        ASSERT_EQ(cache.persist(), 1);
+    }
+    // Truncate the persisted file.
+    for (const auto & entry : std::filesystem::directory_iterator(persist_dir))
+    {
+        if (entry.path().extension() == ".idx")
+            std::filesystem::resize_file(entry.path(), 10);
+    }
+    {
+        RNDeltaIndexCache cache(10, persist_dir);
+        ASSERT_EQ(cache.getDeltaIndex(makeKey(1), files)->getPlacedStatus(), std::make_pair<size_t, size_t>(0, 0));
+        ASSERT_EQ(numPersistedFiles(), 0);
+    }
+}
+CATCH
+
+} // namespace DB::DM::Remote::tests
@@ -230,5 +230,44 @@ TEST_F(RNRemoteReadTaskTest, failTask)
     ASSERT_EQ(read_task->nextTaskForPrepare(), nullptr);
 }
 
+TEST_F(RNRemoteReadTaskTest, tryPopReadyTasks)
+{
+    auto read_task = buildTestTask();
+    const auto num_segments = read_task->numSegments();
+    ASSERT_EQ(num_segments, 3 + 1 + 3 + 4);
+
+    RNRemoteSegmentReadTaskPtr ready_seg_task;
+    for (size_t i = 0; i < num_segments; ++i)
+    {
+        // no task is ready yet
+        ASSERT_FALSE(read_task->tryNextReadyTask(ready_seg_task));
+
+        auto seg_task = read_task->nextFetchTask();
+        read_task->updateTaskState(seg_task, SegmentReadTaskState::DataReady, false); // mock fetch done
+        ASSERT_TRUE(read_task->tryNextReadyTask(ready_seg_task));
+        ASSERT_NE(ready_seg_task, nullptr);
+        ASSERT_EQ(ready_seg_task->state, SegmentReadTaskState::DataReady) << magic_enum::enum_name(ready_seg_task->state);
+        ASSERT_EQ(seg_task->segment_id, ready_seg_task->segment_id);
+        ASSERT_EQ(seg_task->store_id, ready_seg_task->store_id);
+        ASSERT_EQ(seg_task->ks_table_id, ready_seg_task->ks_table_id);
+    }
+
+    // all tasks are popped
+    ASSERT_TRUE(read_task->tryNextReadyTask(ready_seg_task));
+    ASSERT_EQ(ready_seg_task, nullptr);
+}
+
+TEST_F(RNRemoteReadTaskTest, tryPopTasksWithFailTask)
+{
+    auto read_task = buildTestTask();
+    RNRemoteSegmentReadTaskPtr ready_seg_task;
+    ASSERT_FALSE(read_task->tryNextReadyTask(ready_seg_task));
+
+    // mock meet error for this segment task
+    auto seg_task = read_task->nextFetchTask();
+    read_task->updateTaskState(seg_task, SegmentReadTaskState::DataReady, /*meet_error*/ true);
+    ASSERT_TRUE(read_task->tryNextReadyTask(ready_seg_task));
+    ASSERT_EQ(ready_seg_task, nullptr);
+}
 
 } // namespace DB::DM::tests
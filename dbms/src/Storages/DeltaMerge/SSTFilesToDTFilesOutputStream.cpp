@@ -151,7 +151,8 @@ bool SSTFilesToDTFilesOutputStream<ChildStream>::newDTFileStream()
     RUNTIME_CHECK(dt_stream == nullptr);
 
     // The parent_path and file_id are generated by the storage.
-    auto [parent_path, file_id] = storage->getStore()->preAllocateIngestFile();
+    auto store = storage->getStore();
+    auto [parent_path, file_id] = store->preAllocateIngestFile();
     if (parent_path.empty())
     {
         // Can not allocate path and id for storing DTFiles (the storage may be dropped / shutdown)
@@ -159,7 +160,7 @@ bool SSTFilesToDTFilesOutputStream<ChildStream>::newDTFileStream()
     }
 
     auto dt_file = DMFile::create(file_id, parent_path, storage->createChecksumConfig());
-    dt_stream = std::make_unique<DMFileBlockOutputStream>(context, dt_file, *(schema_snap->column_defines));
+    dt_stream = std::make_unique<DMFileBlockOutputStream>(context, dt_file, *(schema_snap->column_defines), store->physical_table_id);
     dt_stream->writePrefix();
     ingest_files.emplace_back(dt_file);
     ingest_files_range.emplace_back(std::nullopt);
@@ -14,12 +14,15 @@
 
 #pragma once
 
+#include <Common/FmtUtils.h>
 #include <common/types.h>
 #include <fmt/format.h>
 #include <sys/types.h>
 #include <tipb/executor.pb.h>
 
 #include <atomic>
+#include <mutex>
+#include <vector>
 
 namespace DB::DM
 {
@@ -48,9 +51,30 @@ public:
     std::atomic<uint64_t> total_remote_region_num{0};
     std::atomic<uint64_t> total_local_region_num{0};
 
+    /// times that late materialization changes the evaluation order of the pushed down predicates
+    std::atomic<uint64_t> total_pushdown_predicate_reorder_times{0};
+
+    /// rows with a version newer than the read ts met by the MVCC version filter, the result of
+    /// the table scan may change with a bigger read ts if it is not zero
+    std::atomic<uint64_t> total_mvcc_newer_version_rows{0};
+
+    /// The observed statistics of a pushed down predicate, only collected when
+    /// late materialization evaluates the predicates one by one.
+    struct PushDownPredicateStat
+    {
+        /// rows evaluated by the predicate, the rows filtered out by the predicates
+        /// evaluated before it are not counted.
+        uint64_t input_rows = 0;
+        uint64_t passed_rows = 0;
+        uint64_t eval_time_ns = 0;
+    };
+    using PushDownPredicateStats = std::vector<PushDownPredicateStat>;
 
     ScanContext() = default;
 
+    /// tipb::TiFlashScanContext has no fields for `total_pushdown_predicate_reorder_times`, `total_mvcc_newer_version_rows`
+    /// and the stats of the pushed down predicates, so they are not sent back with the execution summaries. They are only
+    /// kept in the ScanContext of this node and shown by `toString`, e.g. in the executor statistics of the table scan.
     void deserialize(const tipb::TiFlashScanContext & tiflash_scan_context_pb)
     {
         total_dmfile_scanned_packs = tiflash_scan_context_pb.total_dmfile_scanned_packs();
@@ -90,6 +114,9 @@ public:
         total_create_snapshot_time_ns += other.total_create_snapshot_time_ns;
         total_local_region_num += other.total_local_region_num;
         total_remote_region_num += other.total_remote_region_num;
+        total_pushdown_predicate_reorder_times += other.total_pushdown_predicate_reorder_times;
+        total_mvcc_newer_version_rows += other.total_mvcc_newer_version_rows;
+        mergePushDownPredicateStats(other.getPushDownPredicateStats());
     }
 
     void merge(const tipb::TiFlashScanContext & other)
@@ -104,6 +131,62 @@ public:
         total_local_region_num += other.total_local_region_num();
         total_remote_region_num += other.total_remote_region_num();
     }
+
+    String toString() const
+    {
+        FmtBuffer buffer;
+        buffer.fmtAppend(
+            "{{dmfile_scanned_packs={} dmfile_skipped_packs={} dmfile_scanned_rows={} dmfile_skipped_rows={} "
+            "rough_set_index_load_time={:.3f}ms dmfile_read_time={:.3f}ms create_snapshot_time={:.3f}ms "
+            "local_regions={} remote_regions={} pushdown_predicate_reorder_times={} mvcc_newer_version_rows={} pushdown_predicate_stats=[",
+            total_dmfile_scanned_packs.load(),
+            total_dmfile_skipped_packs.load(),
+            total_dmfile_scanned_rows.load(),
+            total_dmfile_skipped_rows.load(),
+            total_dmfile_rough_set_index_load_time_ns / 1000000.0,
+            total_dmfile_read_time_ns / 1000000.0,
+            total_create_snapshot_time_ns / 1000000.0,
+            total_local_region_num.load(),
+            total_remote_region_num.load(),
+            total_pushdown_predicate_reorder_times.load(),
+            total_mvcc_newer_version_rows.load());
+        const auto stats = getPushDownPredicateStats();
+        buffer.joinStr(
+            stats.begin(),
+            stats.end(),
+            [](const PushDownPredicateStat & stat, FmtBuffer & fb) {
+                fb.fmtAppend("{{input_rows={} passed_rows={} eval_time={:.3f}ms}}", stat.input_rows, stat.passed_rows, stat.eval_time_ns / 1000000.0);
+            },
+            ", ");
+        buffer.append("]}");
+        return buffer.toString();
+    }
+
+    /// `stats` is indexed by the order of the pushed down predicates in the DAG request.
+    void mergePushDownPredicateStats(const PushDownPredicateStats & stats)
+    {
+        std::lock_guard lock(pushdown_predicate_mutex);
+        if (pushdown_predicate_stats.size() < stats.size())
+            pushdown_predicate_stats.resize(stats.size());
+        for (size_t i = 0; i < stats.size(); ++i)
+        {
+            pushdown_predicate_stats[i].input_rows += stats[i].input_rows;
+            pushdown_predicate_stats[i].passed_rows += stats[i].passed_rows;
+            pushdown_predicate_stats[i].eval_time_ns += stats[i].eval_time_ns;
+        }
+    }
+
+    PushDownPredicateStats getPushDownPredicateStats() const
+    {
+        std::lock_guard lock(pushdown_predicate_mutex);
+        return pushdown_predicate_stats;
+    }
+
+private:
+    mutable std::mutex pushdown_predicate_mutex;
+    /// Shared by all the read streams of the table scan, so that the streams
+    /// created later can start with the order learned by the previous ones.
+    PushDownPredicateStats pushdown_predicate_stats;
 };
 
 using ScanContextPtr = std::shared_ptr<ScanContext>;
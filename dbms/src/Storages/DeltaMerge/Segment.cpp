@@ -20,9 +20,11 @@
 #include <DataStreams/ExpressionBlockInputStream.h>
 #include <DataStreams/FilterBlockInputStream.h>
 #include <DataStreams/SquashingBlockInputStream.h>
+#include <IO/IOThreadPools.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/SharedContexts/Disagg.h>
 #include <Poco/Logger.h>
+#include <Storages/DeltaMerge/AdaptiveFilterBlockInputStream.h>
 #include <Storages/DeltaMerge/BitmapFilter/BitmapFilterBlockInputStream.h>
 #include <Storages/DeltaMerge/DMContext.h>
 #include <Storages/DeltaMerge/DMDecoratorStreams.h>
@@ -37,6 +39,7 @@
 #include <Storages/DeltaMerge/File/DMFileBlockOutputStream.h>
 #include <Storages/DeltaMerge/Filter/FilterHelper.h>
 #include <Storages/DeltaMerge/LateMaterializationBlockInputStream.h>
+#include <Storages/DeltaMerge/PackStatsBlockInputStream.h>
 #include <Storages/DeltaMerge/PKSquashingBlockInputStream.h>
 #include <Storages/DeltaMerge/Remote/DataStore/DataStore.h>
 #include <Storages/DeltaMerge/Remote/ObjectId.h>
@@ -44,6 +47,7 @@
 #include <Storages/DeltaMerge/Segment.h>
 #include <Storages/DeltaMerge/StoragePool.h>
 #include <Storages/DeltaMerge/WriteBatchesImpl.h>
+#include <Storages/DeltaMerge/convertColumnTypeHelpers.h>
 #include <Storages/Page/V3/PageEntryCheckpointInfo.h>
 #include <Storages/Page/V3/Universal/UniversalPageIdFormatImpl.h>
 #include <Storages/Page/V3/Universal/UniversalPageStorage.h>
@@ -57,6 +61,8 @@
 #include <fmt/core.h>
 
 #include <ext/scope_guard.h>
+#include <future>
+#include <magic_enum.hpp>
 
 namespace ProfileEvents
 {
@@ -118,19 +124,16 @@ namespace DM
 {
 const static size_t SEGMENT_BUFFER_SIZE = 128; // More than enough.
 
-DMFilePtr writeIntoNewDMFile(DMContext & dm_context, //
-                             const ColumnDefinesPtr & schema_snap,
-                             const BlockInputStreamPtr & input_stream,
-                             UInt64 file_id,
-                             const String & parent_path)
+namespace
+{
+/// Write blocks from `input_stream` into `output_stream` until `input_stream` is exhausted, or at least `max_rows`
+/// rows are written when `max_rows` is not 0. Return whether `input_stream` is exhausted.
+bool writeBlocksIntoDMFile(const BlockInputStreamPtr & input_stream, DMFileBlockOutputStream & output_stream, size_t max_rows)
 {
-    auto dmfile = DMFile::create(file_id, parent_path, dm_context.createChecksumConfig());
-    auto output_stream = std::make_shared<DMFileBlockOutputStream>(dm_context.db_context, dmfile, *schema_snap);
     const auto * mvcc_stream = typeid_cast<const DMVersionFilterBlockInputStream<DM_VERSION_FILTER_MODE_COMPACT> *>(input_stream.get());
 
-    input_stream->readPrefix();
-    output_stream->writePrefix();
-    while (true)
+    size_t written_rows = 0;
+    while (max_rows == 0 || written_rows < max_rows)
     {
         size_t last_effective_num_rows = 0;
         size_t last_not_clean_rows = 0;
@@ -143,7 +146,7 @@ DMFilePtr writeIntoNewDMFile(DMContext & dm_context, //
         }
         Block block = input_stream->read();
         if (!block)
-            break;
+            return true;
         if (!block.rows())
             continue;
 
@@ -167,9 +170,193 @@ DMFilePtr writeIntoNewDMFile(DMContext & dm_context, //
         block_property.not_clean_rows = cur_not_clean_rows - last_not_clean_rows;
         block_property.deleted_rows = cur_deleted_rows - last_deleted_rows;
         block_property.gc_hint_version = gc_hint_version;
-        output_stream->write(block, block_property);
+        output_stream.write(block, block_property);
+        written_rows += block.rows();
     }
+    return false;
+}
 
+void registerNewDMFile(DMContext & context, StableDiskDelegator & delegator, const DMFilePtr & dtfile, WriteBatches & wbs)
+{
+    if (auto data_store = context.db_context.getSharedContextDisagg()->remote_data_store; !data_store)
+    {
+        wbs.data.putExternal(dtfile->fileId(), 0);
+        delegator.addDTFile(dtfile->fileId(), dtfile->getBytesOnDisk(), dtfile->parentPath());
+    }
+    else
+    {
+        auto store_id = context.db_context.getTMTContext().getKVStore()->getStoreID();
+        Remote::DMFileOID oid{.store_id = store_id, .keyspace_id = context.keyspace_id, .table_id = context.physical_table_id, .file_id = dtfile->fileId()};
+        data_store->putDMFile(dtfile, oid, /*remove_local*/ true);
+        PS::V3::CheckpointLocation loc{
+            .data_file_id = std::make_shared<String>(S3::S3Filename::fromDMFileOID(oid).toFullKey()),
+            .offset_in_file = 0,
+            .size_in_file = 0,
+        };
+        delegator.addRemoteDTFileWithGCDisabled(dtfile->fileId(), dtfile->getBytesOnDisk());
+        wbs.data.putRemoteExternal(dtfile->fileId(), loc);
+    }
+}
+
+/// The DTFiles rewritten from `dtfiles` are written to the same tier. The stable is on the cold tier only if all of its
+/// DTFiles are on the cold tier. The tier of a segment is only changed by `DeltaMergeStore::gcTrySegmentMigrateTier`.
+StorageTier getTierOfDMFiles(const DMContext & context, const DMFiles & dtfiles)
+{
+    if (dtfiles.empty())
+        return StorageTier::Hot;
+    auto delegator = context.path_pool->getStableDiskDelegator();
+    for (const auto & dtfile : dtfiles)
+    {
+        if (delegator.getDTFileTier(dtfile->fileId()) != StorageTier::Cold)
+            return StorageTier::Hot;
+    }
+    return StorageTier::Cold;
+}
+
+/// Write the data of `input_stream` into new DTFiles on `tier`, without registering them.
+/// The data is split into several DTFiles when incremental merge delta is enabled, so that the following
+/// merge delta only need to rewrite the DTFiles affected by the delta. A DTFile is only cut at the boundary of
+/// blocks, so `input_stream` must put the rows with the same rowkey into the same block.
+/// If `keep_empty_file` is true, an empty DTFile is returned when there is no data.
+DMFiles writeDMFiles(DMContext & context, //
+                     const ColumnDefinesPtr & schema_snap,
+                     const BlockInputStreamPtr & input_stream,
+                     StableDiskDelegator & delegator,
+                     StorageTier tier,
+                     bool keep_empty_file)
+{
+    const bool is_remote = context.db_context.getSharedContextDisagg()->remote_data_store != nullptr;
+    const size_t max_file_rows = context.enable_incremental_merge_delta && !is_remote ? context.stable_file_limit_rows : 0;
+
+    DMFiles dtfiles;
+    input_stream->readPrefix();
+    bool exhausted = false;
+    while (!exhausted)
+    {
+        auto store_path = delegator.choosePath(tier);
+        PageIdU64 dtfile_id = context.storage_pool->newDataPageIdForDTFile(delegator, __PRETTY_FUNCTION__);
+        auto dtfile = DMFile::create(dtfile_id, store_path, context.createChecksumConfig());
+        auto output_stream = std::make_shared<DMFileBlockOutputStream>(context.db_context, dtfile, *schema_snap, context.physical_table_id);
+        output_stream->writePrefix();
+        exhausted = writeBlocksIntoDMFile(input_stream, *output_stream, max_file_rows);
+        output_stream->writeSuffix();
+
+        // The last DTFile could be empty when the previous one is cut right at the end of the data.
+        if (dtfile->getRows() == 0 && (!dtfiles.empty() || !keep_empty_file))
+        {
+            dtfile->remove(context.db_context.getFileProvider());
+            break;
+        }
+        dtfiles.push_back(dtfile);
+    }
+    input_stream->readSuffix();
+    return dtfiles;
+}
+
+/// Write the data of `input_stream` into new DTFiles, and register them in `wbs`. See `writeDMFiles`.
+DMFiles writeIntoNewDMFiles(DMContext & context, //
+                            const ColumnDefinesPtr & schema_snap,
+                            const BlockInputStreamPtr & input_stream,
+                            StorageTier tier,
+                            WriteBatches & wbs,
+                            bool keep_empty_file = true)
+{
+    auto delegator = context.path_pool->getStableDiskDelegator();
+    auto dtfiles = writeDMFiles(context, schema_snap, input_stream, delegator, tier, keep_empty_file);
+    for (const auto & dtfile : dtfiles)
+        registerNewDMFile(context, delegator, dtfile, wbs);
+    return dtfiles;
+}
+
+bool isConcurrentRewriteEnabled(const DMContext & context)
+{
+    // The stable of the remote data store must consist of only one DTFile, same as incremental merge delta.
+    return context.segment_rewrite_concurrency > 1 && SegmentRewritePool::isInitialized()
+        && !context.db_context.getSharedContextDisagg()->remote_data_store;
+}
+
+/// Write the data of each stream in `input_streams` into new DTFiles concurrently by `SegmentRewritePool`, and register
+/// them in `wbs`. Returns the DTFiles of each stream in the order of `input_streams`. No DTFile is returned for a stream
+/// if all of its rows are deleted.
+/// Returns std::nullopt without registering any DTFile if the tasks can not be scheduled, e.g. the queue of the pool is
+/// full, then the caller should fall back to the sequential rewrite.
+std::optional<std::vector<DMFiles>> writeIntoNewDMFilesConcurrently(DMContext & context, //
+                                                                    const ColumnDefinesPtr & schema_snap,
+                                                                    const BlockInputStreams & input_streams,
+                                                                    StorageTier tier,
+                                                                    WriteBatches & wbs,
+                                                                    const LoggerPtr & log)
+{
+    auto delegator = context.path_pool->getStableDiskDelegator();
+    std::vector<DMFiles> results(input_streams.size());
+    std::vector<std::future<void>> futures;
+    futures.reserve(input_streams.size());
+    bool scheduled = true;
+    for (size_t i = 0; i < input_streams.size(); ++i)
+    {
+        auto task = std::make_shared<std::packaged_task<void()>>([&, i] {
+            results[i] = writeDMFiles(context, schema_snap, input_streams[i], delegator, tier, /*keep_empty_file*/ false);
+        });
+        try
+        {
+            SegmentRewritePool::get().scheduleOrThrowOnError([task] { (*task)(); });
+        }
+        catch (...)
+        {
+            tryLogCurrentException(log, "Failed to schedule the concurrent rewrite, fall back to the sequential rewrite");
+            scheduled = false;
+            break;
+        }
+        futures.push_back(task->get_future());
+    }
+
+    // The tasks reference the local variables, wait for all of them before throwing the exception.
+    std::exception_ptr first_exception;
+    for (auto & f : futures)
+    {
+        try
+        {
+            f.get();
+        }
+        catch (...)
+        {
+            if (!first_exception)
+                first_exception = std::current_exception();
+        }
+    }
+    if (first_exception || !scheduled)
+    {
+        for (const auto & dtfiles : results)
+        {
+            for (const auto & dtfile : dtfiles)
+                dtfile->remove(context.db_context.getFileProvider());
+        }
+        if (first_exception)
+            std::rethrow_exception(first_exception);
+        return std::nullopt;
+    }
+
+    for (const auto & dtfiles : results)
+    {
+        for (const auto & dtfile : dtfiles)
+            registerNewDMFile(context, delegator, dtfile, wbs);
+    }
+    return results;
+}
+} // namespace
+
+DMFilePtr writeIntoNewDMFile(DMContext & dm_context, //
+                             const ColumnDefinesPtr & schema_snap,
+                             const BlockInputStreamPtr & input_stream,
+                             UInt64 file_id,
+                             const String & parent_path)
+{
+    auto dmfile = DMFile::create(file_id, parent_path, dm_context.createChecksumConfig());
+    auto output_stream = std::make_shared<DMFileBlockOutputStream>(dm_context.db_context, dmfile, *schema_snap, dm_context.physical_table_id);
+
+    input_stream->readPrefix();
+    output_stream->writePrefix();
+    writeBlocksIntoDMFile(input_stream, *output_stream, /*max_rows*/ 0);
     input_stream->readSuffix();
     output_stream->writeSuffix();
 
@@ -181,36 +368,36 @@ StableValueSpacePtr createNewStable( //
     const ColumnDefinesPtr & schema_snap,
     const BlockInputStreamPtr & input_stream,
     PageIdU64 stable_id,
+    StorageTier tier,
     WriteBatches & wbs)
 {
-    auto delegator = context.path_pool->getStableDiskDelegator();
-    auto store_path = delegator.choosePath();
-
-    PageIdU64 dtfile_id = context.storage_pool->newDataPageIdForDTFile(delegator, __PRETTY_FUNCTION__);
-    auto dtfile = writeIntoNewDMFile(context, schema_snap, input_stream, dtfile_id, store_path);
+    auto dtfiles = writeIntoNewDMFiles(context, schema_snap, input_stream, tier, wbs);
 
     auto stable = std::make_shared<StableValueSpace>(stable_id);
-    stable->setFiles({dtfile}, RowKeyRange::newAll(context.is_common_handle, context.rowkey_column_size));
+    stable->setFiles(dtfiles, RowKeyRange::newAll(context.is_common_handle, context.rowkey_column_size));
     stable->saveMeta(wbs.meta);
-    if (auto data_store = context.db_context.getSharedContextDisagg()->remote_data_store; !data_store)
-    {
-        wbs.data.putExternal(dtfile_id, 0);
-        delegator.addDTFile(dtfile_id, dtfile->getBytesOnDisk(), store_path);
-    }
-    else
-    {
-        auto store_id = context.db_context.getTMTContext().getKVStore()->getStoreID();
-        Remote::DMFileOID oid{.store_id = store_id, .keyspace_id = context.keyspace_id, .table_id = context.physical_table_id, .file_id = dtfile_id};
-        data_store->putDMFile(dtfile, oid, /*remove_local*/ true);
-        PS::V3::CheckpointLocation loc{
-            .data_file_id = std::make_shared<String>(S3::S3Filename::fromDMFileOID(oid).toFullKey()),
-            .offset_in_file = 0,
-            .size_in_file = 0,
-        };
-        delegator.addRemoteDTFileWithGCDisabled(dtfile_id, dtfile->getBytesOnDisk());
-        wbs.data.putRemoteExternal(dtfile_id, loc);
-    }
+    return stable;
+}
 
+/// Create a new stable from the DTFiles written by `writeIntoNewDMFilesConcurrently`, which are ordered by the rowkey.
+StableValueSpacePtr createNewStable( //
+    DMContext & context,
+    const ColumnDefinesPtr & schema_snap,
+    const std::vector<DMFiles> & written_dtfiles,
+    PageIdU64 stable_id,
+    StorageTier tier,
+    WriteBatches & wbs)
+{
+    DMFiles dtfiles;
+    for (const auto & files : written_dtfiles)
+        dtfiles.insert(dtfiles.end(), files.begin(), files.end());
+    // Keep an empty DTFile like the stable written by a single stream.
+    if (dtfiles.empty())
+        dtfiles = writeIntoNewDMFiles(context, schema_snap, std::make_shared<EmptyBlockInputStream>(toEmptyBlock(*schema_snap)), tier, wbs);
+
+    auto stable = std::make_shared<StableValueSpace>(stable_id);
+    stable->setFiles(dtfiles, RowKeyRange::newAll(context.is_common_handle, context.rowkey_column_size));
+    stable->saveMeta(wbs.meta);
     return stable;
 }
 
@@ -256,7 +443,7 @@ SegmentPtr Segment::newSegment( //
     WriteBatches wbs(*context.storage_pool, context.getWriteLimiter());
 
     auto delta = std::make_shared<DeltaValueSpace>(delta_id);
-    auto stable = createNewStable(context, schema, std::make_shared<EmptySkippableBlockInputStream>(*schema), stable_id, wbs);
+    auto stable = createNewStable(context, schema, std::make_shared<EmptySkippableBlockInputStream>(*schema), stable_id, StorageTier::Hot, wbs);
 
     auto segment = std::make_shared<Segment>(parent_log, INITIAL_EPOCH, range, segment_id, next_segment_id, delta, stable);
 
@@ -443,6 +630,11 @@ void Segment::serialize(WriteBatchWrapper & wb)
     wb.putPage(segment_id, 0, buf.tryGetReadBuffer(), data_size);
 }
 
+StorageTier Segment::getStableTier(const DMContext & dm_context) const
+{
+    return getTierOfDMFiles(dm_context, stable->getDMFiles());
+}
+
 bool Segment::writeToDisk(DMContext & dm_context, const ColumnFilePtr & column_file)
 {
     LOG_TRACE(log, "Segment write to disk, rows={} isBigFile={}", column_file->getRows(), column_file->isBigFile());
@@ -697,6 +889,9 @@ BlockInputStreamPtr Segment::getInputStream(const ReadMode & read_mode,
                                             UInt64 max_version,
                                             size_t expected_block_size)
 {
+    // The rows to scan are estimated by the rows of the snapshot.
+    read_heat->recordRead(segment_snap->getRows());
+
     switch (read_mode)
     {
     case ReadMode::Normal:
@@ -794,7 +989,8 @@ BlockInputStreamPtr Segment::getInputStreamModeNormal(const DMContext & dm_conte
         columns_to_read,
         max_version,
         is_common_handle,
-        dm_context.tracing_id);
+        dm_context.tracing_id,
+        dm_context.scan_context);
 
     LOG_TRACE(
         log->getChild(dm_context.tracing_id),
@@ -853,6 +1049,96 @@ BlockInputStreamPtr Segment::getInputStreamForDataExport(const DMContext & dm_co
     return data_stream;
 }
 
+RowKeyRanges Segment::splitRangeForConcurrentRewrite(const DMContext & dm_context,
+                                                     const SegmentSnapshotPtr & segment_snap,
+                                                     const RowKeyRange & range) const
+{
+    if (!isConcurrentRewriteEnabled(dm_context))
+        return {range};
+
+    // The first rowkey and the rows of the stable packs inside `range`, which are ordered by the rowkey.
+    std::vector<std::pair<RowKeyValue, size_t>> packs;
+    size_t total_rows = 0;
+    for (const auto & dtfile : segment_snap->stable->getDMFiles())
+    {
+        auto pack_filter = DMFilePackFilter::loadFrom(
+            dtfile,
+            dm_context.db_context.getGlobalContext().getMinMaxIndexCache(),
+            /*set_cache_if_miss*/ true,
+            {range},
+            EMPTY_RS_OPERATOR,
+            {},
+            dm_context.db_context.getFileProvider(),
+            dm_context.getReadLimiter(),
+            dm_context.scan_context,
+            dm_context.tracing_id);
+        const auto & handle_res = pack_filter.getHandleRes();
+        const auto & pack_stats = dtfile->getPackStats();
+        for (size_t i = 0; i < handle_res.size(); ++i)
+        {
+            if (handle_res[i] == RSResult::None)
+                continue;
+            packs.emplace_back(pack_filter.getRowKeyMinMax(i, is_common_handle).first, pack_stats[i].rows);
+            total_rows += pack_stats[i].rows;
+        }
+    }
+
+    const size_t num_ranges = std::min(dm_context.segment_rewrite_concurrency, total_rows / std::max<size_t>(dm_context.segment_rewrite_min_rows_per_task, 1));
+    if (num_ranges <= 1)
+        return {range};
+
+    // Only cut at the first rowkey of a pack, so that all versions of a rowkey are in the same range.
+    const size_t rows_per_range = (total_rows + num_ranges - 1) / num_ranges;
+    RowKeyRanges ranges;
+    RowKeyValue start = range.start;
+    size_t accumulated_rows = 0;
+    for (const auto & [first_key, rows] : packs)
+    {
+        if (accumulated_rows >= rows_per_range * (ranges.size() + 1)
+            && compare(first_key.toRowKeyValueRef(), start.toRowKeyValueRef()) > 0
+            && compare(first_key.toRowKeyValueRef(), range.getEnd()) < 0)
+        {
+            ranges.emplace_back(start, first_key, is_common_handle, rowkey_column_size);
+            start = first_key;
+        }
+        accumulated_rows += rows;
+    }
+    ranges.emplace_back(start, range.end, is_common_handle, rowkey_column_size);
+    return ranges;
+}
+
+BlockInputStreams Segment::getInputStreamsForConcurrentRewrite(const DMContext & dm_context,
+                                                               const SegmentSnapshotPtr & segment_snap,
+                                                               const ReadInfo & read_info,
+                                                               const RowKeyRanges & ranges) const
+{
+    BlockInputStreams streams;
+    streams.reserve(ranges.size());
+    for (const auto & range : ranges)
+    {
+        RowKeyRanges data_ranges{range};
+        // The column caches of a stable snapshot are not thread safe, each stream reads from its own clone.
+        BlockInputStreamPtr data_stream = getPlacedStream(dm_context,
+                                                          *read_info.read_columns,
+                                                          data_ranges,
+                                                          EMPTY_RS_OPERATOR,
+                                                          segment_snap->stable->clone(),
+                                                          read_info.getDeltaReader(),
+                                                          read_info.index_begin,
+                                                          read_info.index_end,
+                                                          dm_context.stable_pack_rows);
+        data_stream = std::make_shared<DMRowKeyFilterBlockInputStream<true>>(data_stream, data_ranges, 0);
+        data_stream = std::make_shared<PKSquashingBlockInputStream<false>>(data_stream, EXTRA_HANDLE_COLUMN_ID, is_common_handle);
+        data_stream = std::make_shared<DMVersionFilterBlockInputStream<DM_VERSION_FILTER_MODE_COMPACT>>(
+            data_stream,
+            *read_info.read_columns,
+            dm_context.min_version,
+            is_common_handle);
+        streams.push_back(data_stream);
+    }
+    return streams;
+}
+
 /// We call getInputStreamModeFast when we read in fast mode.
 /// In this case, we will read all the data in delta and stable, and then merge them without sorting.
 /// Besides, we will do del_mark != 0 filtering to drop the deleted rows.
@@ -1031,7 +1317,9 @@ SegmentPtr Segment::mergeDelta(DMContext & dm_context, const ColumnDefinesPtr &
 StableValueSpacePtr Segment::prepareMergeDelta(DMContext & dm_context,
                                                const ColumnDefinesPtr & schema_snap,
                                                const SegmentSnapshotPtr & segment_snap,
-                                               WriteBatches & wbs) const
+                                               WriteBatches & wbs,
+                                               bool allow_incremental,
+                                               std::optional<StorageTier> target_tier) const
 {
     LOG_DEBUG(log,
               "MergeDelta - Begin prepare, delta_column_files={} delta_rows={} delta_bytes={}",
@@ -1041,6 +1329,29 @@ StableValueSpacePtr Segment::prepareMergeDelta(DMContext & dm_context,
 
     EventRecorder recorder(ProfileEvents::DMDeltaMerge, ProfileEvents::DMDeltaMergeNS);
 
+    // Migrating to another tier rewrites all DTFiles.
+    const auto tier = target_tier.value_or(getTierOfDMFiles(dm_context, segment_snap->stable->getDMFiles()));
+    if (allow_incremental && !target_tier && dm_context.enable_incremental_merge_delta)
+    {
+        if (auto new_stable = prepareMergeDeltaIncremental(dm_context, schema_snap, segment_snap, tier, wbs); new_stable)
+        {
+            LOG_DEBUG(log, "MergeDelta - Finish prepare incrementally, segment={}", info());
+            return new_stable;
+        }
+    }
+
+    if (auto ranges = splitRangeForConcurrentRewrite(dm_context, segment_snap, rowkey_range); ranges.size() > 1)
+    {
+        auto read_info = getReadInfo(dm_context, *schema_snap, segment_snap, {rowkey_range});
+        auto data_streams = getInputStreamsForConcurrentRewrite(dm_context, segment_snap, read_info, ranges);
+        if (auto dtfiles = writeIntoNewDMFilesConcurrently(dm_context, schema_snap, data_streams, tier, wbs, log); dtfiles)
+        {
+            auto new_stable = createNewStable(dm_context, schema_snap, *dtfiles, segment_snap->stable->getId(), tier, wbs);
+            LOG_DEBUG(log, "MergeDelta - Finish prepare concurrently, ranges={} segment={}", ranges.size(), info());
+            return new_stable;
+        }
+    }
+
     auto data_stream = getInputStreamForDataExport(
         dm_context,
         *schema_snap,
@@ -1049,13 +1360,166 @@ StableValueSpacePtr Segment::prepareMergeDelta(DMContext & dm_context,
         dm_context.stable_pack_rows,
         /*reorginize_block*/ true);
 
-    auto new_stable = createNewStable(dm_context, schema_snap, data_stream, segment_snap->stable->getId(), wbs);
+    auto new_stable = createNewStable(dm_context, schema_snap, data_stream, segment_snap->stable->getId(), tier, wbs);
 
-    LOG_DEBUG(log, "MergeDelta - Finish prepare, segment={}", info());
+    LOG_DEBUG(log, "MergeDelta - Finish prepare, tier={} segment={}", magic_enum::enum_name(tier), info());
 
     return new_stable;
 }
 
+StableValueSpacePtr Segment::prepareMergeDeltaIncremental(DMContext & dm_context,
+                                                          const ColumnDefinesPtr & schema_snap,
+                                                          const SegmentSnapshotPtr & segment_snap,
+                                                          StorageTier tier,
+                                                          WriteBatches & wbs) const
+{
+    // The reused DTFiles are referenced by new page ids in the local data store. It is not supported
+    // by the remote data store yet.
+    if (dm_context.db_context.getSharedContextDisagg()->remote_data_store)
+        return {};
+
+    const auto & dtfiles = segment_snap->stable->getDMFiles();
+    if (dtfiles.empty())
+        return {};
+
+    // Each DTFile covers the rowkey range [first rowkey of this file, first rowkey of the next file). It requires
+    // all rows of the DTFiles are inside the segment range (i.e. no out-of-range rows produced by logical split),
+    // and the rowkeys of adjacent DTFiles are not overlapped.
+    std::vector<RowKeyValue> file_first_keys;
+    std::vector<size_t> file_row_offsets;
+    file_first_keys.reserve(dtfiles.size());
+    file_row_offsets.reserve(dtfiles.size() + 1);
+    size_t total_rows = 0;
+    RowKeyValue prev_last_key;
+    for (size_t i = 0; i < dtfiles.size(); ++i)
+    {
+        const auto & dtfile = dtfiles[i];
+        if (dtfile->getPacks() == 0 || dtfile->getRows() == 0)
+            return {};
+        auto pack_filter = DMFilePackFilter::loadFrom(
+            dtfile,
+            dm_context.db_context.getGlobalContext().getMinMaxIndexCache(),
+            /*set_cache_if_miss*/ true,
+            {rowkey_range},
+            EMPTY_RS_OPERATOR,
+            {},
+            dm_context.db_context.getFileProvider(),
+            dm_context.getReadLimiter(),
+            dm_context.scan_context,
+            dm_context.tracing_id);
+        for (auto res : pack_filter.getHandleRes())
+        {
+            if (res != RSResult::All)
+                return {};
+        }
+        auto first_key = pack_filter.getRowKeyMinMax(0, is_common_handle).first;
+        if (i > 0 && compare(prev_last_key.toRowKeyValueRef(), first_key.toRowKeyValueRef()) >= 0)
+            return {};
+        prev_last_key = pack_filter.getRowKeyMinMax(dtfile->getPacks() - 1, is_common_handle).second;
+
+        file_first_keys.push_back(std::move(first_key));
+        file_row_offsets.push_back(total_rows);
+        total_rows += dtfile->getRows();
+    }
+    file_row_offsets.push_back(total_rows);
+
+    // Find the DTFiles affected by the delta from the delta index. The sid of an entry is the row offset
+    // in the stable. An insert is placed before the stable row `sid`, it belongs to the DTFile containing
+    // the stable row `sid - 1`. A delete removes the stable rows [sid, sid + count).
+    auto read_info = getReadInfo(dm_context, *schema_snap, segment_snap, {rowkey_range});
+    auto file_of_row = [&](size_t sid) {
+        auto it = std::upper_bound(file_row_offsets.begin(), file_row_offsets.end(), sid);
+        return std::min(static_cast<size_t>(std::distance(file_row_offsets.begin(), it)) - 1, dtfiles.size() - 1);
+    };
+    std::vector<bool> affected(dtfiles.size(), false);
+    for (auto it = read_info.index_begin; it != read_info.index_end; ++it)
+    {
+        if (it.isInsert())
+        {
+            affected[file_of_row(it.getSid() == 0 ? 0 : it.getSid() - 1)] = true;
+        }
+        else
+        {
+            for (auto i = file_of_row(it.getSid()); i <= file_of_row(it.getSid() + it.getCount() - 1); ++i)
+                affected[i] = true;
+        }
+    }
+
+    size_t affected_rows = 0;
+    for (size_t i = 0; i < dtfiles.size(); ++i)
+        affected_rows += affected[i] ? dtfiles[i]->getRows() : 0;
+    // Rewriting the whole stable is not much more expensive, and it gets rid of the fragmentation.
+    if (affected_rows * 2 > total_rows)
+        return {};
+    // Estimate the number of DTFiles after rewriting. Rewrite the whole stable to bound the fragmentation
+    // if there would be too many DTFiles.
+    size_t limit_rows = std::max<size_t>(dm_context.stable_file_limit_rows, 1);
+    size_t estimated_files = dtfiles.size() + (segment_snap->delta->getRows() + limit_rows - 1) / limit_rows;
+    if (estimated_files > dm_context.stable_max_files)
+        return {};
+
+    auto & storage_pool = dm_context.storage_pool;
+    auto delegate = dm_context.path_pool->getStableDiskDelegator();
+    DMFiles new_dtfiles;
+    size_t rewritten_files = 0;
+    size_t reused_files = 0;
+    for (size_t begin = 0; begin < dtfiles.size();)
+    {
+        if (!affected[begin])
+        {
+            // Reference the unaffected DTFile. The old page id is removed in `applyMergeDelta`.
+            const auto & dtfile = dtfiles[begin];
+            auto new_page_id = storage_pool->newDataPageIdForDTFile(delegate, __PRETTY_FUNCTION__);
+            wbs.data.putRefPage(new_page_id, dtfile->pageId());
+            new_dtfiles.push_back(DMFile::restore(
+                dm_context.db_context.getFileProvider(),
+                dtfile->fileId(),
+                /* page_id= */ new_page_id,
+                dtfile->parentPath(),
+                DMFile::ReadMetaMode::all()));
+            ++reused_files;
+            ++begin;
+            continue;
+        }
+
+        // Rewrite the continuous affected DTFiles [begin, end) together.
+        size_t end = begin + 1;
+        while (end < dtfiles.size() && affected[end])
+            ++end;
+        RowKeyRange rewrite_range(
+            begin == 0 ? rowkey_range.start : file_first_keys[begin],
+            end == dtfiles.size() ? rowkey_range.end : file_first_keys[end],
+            is_common_handle,
+            rowkey_column_size);
+        auto data_stream = getInputStreamForDataExport(
+            dm_context,
+            *schema_snap,
+            segment_snap,
+            rewrite_range,
+            dm_context.stable_pack_rows,
+            /*reorginize_block*/ true);
+        // No DTFile is returned if all rows in the range are deleted.
+        auto rewritten = writeIntoNewDMFiles(dm_context, schema_snap, data_stream, tier, wbs, /*keep_empty_file*/ false);
+        new_dtfiles.insert(new_dtfiles.end(), rewritten.begin(), rewritten.end());
+        rewritten_files += end - begin;
+        begin = end;
+    }
+
+    auto new_stable = std::make_shared<StableValueSpace>(segment_snap->stable->getId());
+    new_stable->setFiles(new_dtfiles, RowKeyRange::newAll(is_common_handle, rowkey_column_size));
+    new_stable->saveMeta(wbs.meta);
+
+    LOG_DEBUG(
+        log,
+        "MergeDelta - Incremental merge delta, rewritten_files={} reused_files={} new_files={} affected_rows={} total_rows={}",
+        rewritten_files,
+        reused_files,
+        new_dtfiles.size(),
+        affected_rows,
+        total_rows);
+    return new_stable;
+}
+
 SegmentPtr Segment::applyMergeDelta(const Segment::Lock & lock, //
                                     DMContext & context,
                                     const SegmentSnapshotPtr & segment_snap,
@@ -1090,6 +1554,7 @@ SegmentPtr Segment::applyMergeDelta(const Segment::Lock & lock, //
 
     // avoid recheck whether to do DeltaMerge using the same gc_safe_point
     new_me->setLastCheckGCSafePoint(context.min_version);
+    new_me->read_heat = read_heat;
 
     // Store new meta data
     new_me->serialize(wbs.meta);
@@ -1146,6 +1611,7 @@ SegmentPtr Segment::replaceData(const Segment::Lock & lock, //
         next_segment_id,
         new_delta,
         new_stable);
+    new_me->read_heat = read_heat;
     new_me->serialize(wbs.meta);
 
     delta->recordRemoveColumnFilesPages(wbs);
@@ -1234,6 +1700,7 @@ SegmentPtr Segment::dangerouslyReplaceDataFromCheckpoint(const Segment::Lock &,
         next_segment_id,
         new_delta,
         new_stable);
+    new_me->read_heat = read_heat;
     new_me->serialize(wbs.meta);
 
     delta->recordRemoveColumnFilesPages(wbs);
@@ -1658,7 +2125,35 @@ std::optional<Segment::SplitInfo> Segment::prepareSplitPhysical( //
 
     StableValueSpacePtr my_new_stable;
     StableValueSpacePtr other_stable;
+    const auto tier = getTierOfDMFiles(dm_context, segment_snap->stable->getDMFiles());
 
+    if (isConcurrentRewriteEnabled(dm_context))
+    {
+        // Rewrite the two new stables, and the key ranges of each of them, concurrently.
+        auto my_ranges = splitRangeForConcurrentRewrite(dm_context, segment_snap, my_range);
+        auto other_ranges = splitRangeForConcurrentRewrite(dm_context, segment_snap, other_range);
+        RowKeyRanges ranges = my_ranges;
+        ranges.insert(ranges.end(), other_ranges.begin(), other_ranges.end());
+
+        auto data_streams = getInputStreamsForConcurrentRewrite(dm_context, segment_snap, read_info, ranges);
+        if (auto dtfiles = writeIntoNewDMFilesConcurrently(dm_context, schema_snap, data_streams, tier, wbs, log); dtfiles)
+        {
+            std::vector<DMFiles> my_dtfiles(dtfiles->begin(), dtfiles->begin() + my_ranges.size());
+            std::vector<DMFiles> other_dtfiles(dtfiles->begin() + my_ranges.size(), dtfiles->end());
+
+            my_new_stable = createNewStable(dm_context, schema_snap, my_dtfiles, segment_snap->stable->getId(), tier, wbs);
+            other_stable = createNewStable(dm_context, schema_snap, other_dtfiles, dm_context.storage_pool->newMetaPageId(), tier, wbs);
+
+            LOG_DEBUG(
+                log,
+                "Split - SplitPhysical - Finish prepare my_new_stable and other_stable concurrently, my_ranges={} other_ranges={}",
+                my_ranges.size(),
+                other_ranges.size());
+        }
+    }
+
+    // Fall back to the sequential rewrite if the concurrent rewrite is not enabled or can not be scheduled.
+    if (!my_new_stable)
     {
         auto my_delta_reader = read_info.getDeltaReader(schema_snap);
 
@@ -1682,12 +2177,10 @@ std::optional<Segment::SplitInfo> Segment::prepareSplitPhysical( //
             dm_context.min_version,
             is_common_handle);
         auto my_stable_id = segment_snap->stable->getId();
-        my_new_stable = createNewStable(dm_context, schema_snap, my_data, my_stable_id, wbs);
-    }
+        my_new_stable = createNewStable(dm_context, schema_snap, my_data, my_stable_id, tier, wbs);
 
-    LOG_DEBUG(log, "Split - SplitPhysical - Finish prepare my_new_stable");
+        LOG_DEBUG(log, "Split - SplitPhysical - Finish prepare my_new_stable");
 
-    {
         // Write new segment's data
         auto other_delta_reader = read_info.getDeltaReader(schema_snap);
 
@@ -1711,10 +2204,10 @@ std::optional<Segment::SplitInfo> Segment::prepareSplitPhysical( //
             dm_context.min_version,
             is_common_handle);
         auto other_stable_id = dm_context.storage_pool->newMetaPageId();
-        other_stable = createNewStable(dm_context, schema_snap, other_data, other_stable_id, wbs);
-    }
+        other_stable = createNewStable(dm_context, schema_snap, other_data, other_stable_id, tier, wbs);
 
-    LOG_DEBUG(log, "Split - SplitPhysical - Finish prepare other_stable");
+        LOG_DEBUG(log, "Split - SplitPhysical - Finish prepare other_stable");
+    }
 
     // Remove old stable's files.
     for (const auto & file : stable->getDMFiles())
@@ -1787,6 +2280,13 @@ SegmentPair Segment::applySplit( //
         other_delta,
         split_info.other_stable);
 
+    // Both new segments are as hot as this one, and the scanned rows are split by the rows of the new segments.
+    auto my_rows = new_me->getEstimatedRows();
+    auto other_rows = other->getEstimatedRows();
+    auto my_ratio = my_rows + other_rows == 0 ? 0.5 : static_cast<Float64>(my_rows) / (my_rows + other_rows);
+    new_me->read_heat = read_heat->inherit(my_ratio);
+    other->read_heat = read_heat->inherit(1.0 - my_ratio);
+
     new_me->delta->saveMeta(wbs);
     new_me->stable->saveMeta(wbs.meta);
     new_me->serialize(wbs.meta);
@@ -1906,8 +2406,14 @@ StableValueSpacePtr Segment::prepareMerge(DMContext & dm_context, //
         dm_context.min_version,
         dm_context.is_common_handle);
 
+    DMFiles dtfiles_to_merge;
+    for (const auto & segment_snap : ordered_snapshots)
+    {
+        const auto & dtfiles = segment_snap->stable->getDMFiles();
+        dtfiles_to_merge.insert(dtfiles_to_merge.end(), dtfiles.begin(), dtfiles.end());
+    }
     auto merged_stable_id = ordered_segments[0]->stable->getId();
-    auto merged_stable = createNewStable(dm_context, schema_snap, merged_stream, merged_stable_id, wbs);
+    auto merged_stable = createNewStable(dm_context, schema_snap, merged_stream, merged_stable_id, getTierOfDMFiles(dm_context, dtfiles_to_merge), wbs);
 
     LOG_DEBUG(log, "Merge - Finish prepare, segments_to_merge={}", info(ordered_segments));
 
@@ -1961,6 +2467,9 @@ SegmentPtr Segment::applyMerge(const std::vector<Segment::Lock> & locks, //
         last_seg->next_segment_id,
         merged_delta,
         merged_stable);
+    merged->read_heat = first_seg->read_heat->inherit(1.0);
+    for (size_t i = 1; i < ordered_segments.size(); i++)
+        merged->read_heat->merge(*ordered_segments[i]->read_heat);
 
     // Store new meta data
     merged->delta->saveMeta(wbs);
@@ -2255,42 +2764,62 @@ std::pair<DeltaIndexPtr, bool> Segment::ensurePlace(const DMContext & dm_context
     auto items = delta_reader->getPlaceItems(my_placed_rows, my_placed_deletes, delta_snap->getRows(), delta_snap->getDeletes());
 
     bool fully_indexed = true;
+    // The consecutive blocks are sorted and placed together, so that the stable is only merged once for them.
+    Blocks batch;
+    size_t batch_offset = 0;
+    size_t batch_rows = 0;
+    auto place_batch = [&]() {
+        if (batch.empty())
+            return;
+        auto block = batch.size() == 1 ? std::move(batch[0]) : vstackBlocks(std::move(batch));
+        batch.clear();
+
+        if (skippable_place)
+            fully_indexed &= placeUpsert<true>(
+                dm_context,
+                stable_snap,
+                delta_reader,
+                batch_offset,
+                std::move(block),
+                *my_delta_tree,
+                relevant_range,
+                relevant_place);
+        else
+            fully_indexed &= placeUpsert<false>(
+                dm_context,
+                stable_snap,
+                delta_reader,
+                batch_offset,
+                std::move(block),
+                *my_delta_tree,
+                relevant_range,
+                relevant_place);
+
+        my_placed_rows += batch_rows;
+        batch_rows = 0;
+    };
+
     for (auto & v : items)
     {
         if (v.isBlock())
         {
             auto block = v.getBlock();
             auto offset = v.getBlockOffset();
-            auto rows = block.rows();
 
-            if (unlikely(my_placed_rows != offset))
+            if (unlikely(my_placed_rows + batch_rows != offset))
                 throw Exception("Place block offset not match", ErrorCodes::LOGICAL_ERROR);
 
-            if (skippable_place)
-                fully_indexed &= placeUpsert<true>(
-                    dm_context,
-                    stable_snap,
-                    delta_reader,
-                    offset,
-                    std::move(block),
-                    *my_delta_tree,
-                    relevant_range,
-                    relevant_place);
-            else
-                fully_indexed &= placeUpsert<false>(
-                    dm_context,
-                    stable_snap,
-                    delta_reader,
-                    offset,
-                    std::move(block),
-                    *my_delta_tree,
-                    relevant_range,
-                    relevant_place);
-
-            my_placed_rows += rows;
+            if (batch.empty())
+                batch_offset = offset;
+            batch_rows += block.rows();
+            batch.push_back(std::move(block));
+            if (batch_rows >= dm_context.place_batch_rows)
+                place_batch();
         }
         else
         {
+            place_batch();
+
             if (skippable_place)
                 fully_indexed &= placeDelete<true>(
                     dm_context,
@@ -2313,6 +2842,7 @@ std::pair<DeltaIndexPtr, bool> Segment::ensurePlace(const DMContext & dm_context
             ++my_placed_deletes;
         }
     }
+    place_batch();
 
     if (unlikely(my_placed_rows != delta_snap->getRows() || my_placed_deletes != delta_snap->getDeletes()))
     {
@@ -2337,6 +2867,57 @@ std::pair<DeltaIndexPtr, bool> Segment::ensurePlace(const DMContext & dm_context
     return {my_delta_index, fully_indexed};
 }
 
+namespace
+{
+// Return the begin positions of the runs of a block sorted by rowkey. Two adjacent runs are separated
+// by at least one stable pack, so that the packs between them can be skipped when placing the runs one by one.
+std::vector<size_t> splitPlaceRuns(const DMContext & dm_context,
+                                   const StableSnapshotPtr & stable_snap,
+                                   const RowKeyRange & segment_range,
+                                   const Block & block,
+                                   bool is_common_handle)
+{
+    std::vector<size_t> run_begins{0};
+    const auto rows = block.rows();
+    if (rows <= 1)
+        return run_begins;
+
+    // The min and max rowkey of the stable packs, in the order of rowkey.
+    std::vector<std::pair<RowKeyValue, RowKeyValue>> packs;
+    for (const auto & dmfile : stable_snap->getDMFiles())
+    {
+        auto pack_filter = DMFilePackFilter::loadFrom(
+            dmfile,
+            dm_context.db_context.getGlobalContext().getMinMaxIndexCache(),
+            /*set_cache_if_miss*/ true,
+            {segment_range},
+            EMPTY_RS_OPERATOR,
+            {},
+            dm_context.db_context.getFileProvider(),
+            dm_context.getReadLimiter(),
+            dm_context.scan_context,
+            dm_context.tracing_id);
+        for (size_t pack_id = 0; pack_id < dmfile->getPacks(); ++pack_id)
+            packs.push_back(pack_filter.getRowKeyMinMax(pack_id, is_common_handle));
+    }
+
+    RowKeyColumnContainer rowkeys(block.getByPosition(0).column, is_common_handle);
+    size_t pack_index = 0;
+    for (size_t i = 1; i < rows; ++i)
+    {
+        auto prev = rowkeys.getRowKeyValue(i - 1);
+        while (pack_index < packs.size() && !(prev < packs[pack_index].first.toRowKeyValueRef()))
+            ++pack_index;
+        if (pack_index == packs.size())
+            break;
+        // The pack is strictly between the two rows.
+        if (packs[pack_index].second.toRowKeyValueRef() < rowkeys.getRowKeyValue(i))
+            run_begins.push_back(i);
+    }
+    return run_begins;
+}
+} // namespace
+
 template <bool skippable_place>
 bool Segment::placeUpsert(const DMContext & dm_context,
                           const StableSnapshotPtr & stable_snap,
@@ -2353,45 +2934,68 @@ bool Segment::placeUpsert(const DMContext & dm_context,
 
     const auto & handle = getExtraHandleColumnDefine(is_common_handle);
     bool do_sort = sortBlockByPk(handle, block, perm);
-    RowKeyValueRef first_rowkey = RowKeyColumnContainer(block.getByPosition(0).column, is_common_handle).getRowKeyValue(0);
-    RowKeyValueRef range_start = relevant_range.getStart();
 
-    auto place_handle_range = skippable_place ? RowKeyRange::startFrom(max(first_rowkey, range_start), is_common_handle, rowkey_column_size)
-                                              : RowKeyRange::newAll(is_common_handle, rowkey_column_size);
+    auto place_run = [&](const Block & run_block, size_t run_offset, const IColumn::Permutation & run_perm) {
+        RowKeyValueRef first_rowkey = RowKeyColumnContainer(run_block.getByPosition(0).column, is_common_handle).getRowKeyValue(0);
+        RowKeyValueRef range_start = relevant_range.getStart();
 
-    auto compacted_index = update_delta_tree.getCompactedEntries();
+        auto place_handle_range = skippable_place ? RowKeyRange::startFrom(max(first_rowkey, range_start), is_common_handle, rowkey_column_size)
+                                                  : RowKeyRange::newAll(is_common_handle, rowkey_column_size);
 
-    auto merged_stream = getPlacedStream<skippable_place>( //
-        dm_context,
-        {handle, getVersionColumnDefine()},
-        {place_handle_range},
-        EMPTY_RS_OPERATOR,
-        stable_snap,
-        delta_reader,
-        compacted_index->begin(),
-        compacted_index->end(),
-        dm_context.stable_pack_rows);
-
-    if (do_sort)
-        return DM::placeInsert<true>(
-            merged_stream,
-            block,
-            relevant_range,
-            relevant_place,
-            update_delta_tree,
-            delta_value_space_offset,
-            perm,
-            getPkSort(handle));
-    else
-        return DM::placeInsert<false>(
-            merged_stream,
-            block,
-            relevant_range,
-            relevant_place,
-            update_delta_tree,
-            delta_value_space_offset,
-            perm,
-            getPkSort(handle));
+        auto compacted_index = update_delta_tree.getCompactedEntries();
+
+        auto merged_stream = getPlacedStream<skippable_place>( //
+            dm_context,
+            {handle, getVersionColumnDefine()},
+            {place_handle_range},
+            EMPTY_RS_OPERATOR,
+            stable_snap,
+            delta_reader,
+            compacted_index->begin(),
+            compacted_index->end(),
+            dm_context.stable_pack_rows);
+
+        if (do_sort)
+            return DM::placeInsert<true>(
+                merged_stream,
+                run_block,
+                relevant_range,
+                relevant_place,
+                update_delta_tree,
+                delta_value_space_offset,
+                run_perm,
+                getPkSort(handle));
+        else
+            return DM::placeInsert<false>(
+                merged_stream,
+                run_block,
+                relevant_range,
+                relevant_place,
+                update_delta_tree,
+                run_offset,
+                run_perm,
+                getPkSort(handle));
+    };
+
+    // Only skippable place can skip the stable packs before a run.
+    auto run_begins = skippable_place ? splitPlaceRuns(dm_context, stable_snap, rowkey_range, block, is_common_handle) : std::vector<size_t>{0};
+    if (run_begins.size() == 1)
+        return place_run(block, delta_value_space_offset, perm);
+
+    bool fully_indexed = true;
+    for (size_t i = 0; i < run_begins.size(); ++i)
+    {
+        auto begin = run_begins[i];
+        auto end = i + 1 < run_begins.size() ? run_begins[i + 1] : block.rows();
+        Block run_block = block.cloneEmpty();
+        for (size_t col = 0; col < block.columns(); ++col)
+            run_block.getByPosition(col).column = block.getByPosition(col).column->cut(begin, end - begin);
+        IColumn::Permutation run_perm;
+        if (do_sort)
+            run_perm.assign(perm.begin() + begin, perm.begin() + end);
+        fully_indexed &= place_run(run_block, delta_value_space_offset + begin, run_perm);
+    }
+    return fully_indexed;
 }
 
 template <bool skippable_place>
@@ -2671,7 +3275,8 @@ BitmapFilterPtr Segment::buildBitmapFilterStableOnly(const DMContext & dm_contex
         read_columns,
         max_version,
         is_common_handle,
-        dm_context.tracing_id);
+        dm_context.tracing_id,
+        dm_context.scan_context);
     bitmap_filter->set(stream);
     LOG_DEBUG(log, "buildBitmapFilterStableOnly total_rows={}, cost={}ms", segment_snap->stable->getDMFilesRows(), sw.elapsedMilliseconds());
     return bitmap_filter;
@@ -2718,6 +3323,140 @@ BlockInputStreamPtr Segment::getBitmapFilterInputStream(BitmapFilterPtr && bitma
         dm_context.tracing_id);
 }
 
+namespace
+{
+// Return the min and max values of the pack as a column of `[min, max]` in the type of `cd`,
+// or nullptr if they are unknown.
+ColumnPtr getPackMinMax(const DMFilePtr & dmfile, const MinMaxIndexPtr & minmax_index, size_t pack_id, const ColumnDefine & cd)
+{
+    if (!minmax_index)
+        return nullptr;
+    auto minmax = minmax_index->getMinMax(pack_id);
+    if (!minmax)
+        return nullptr;
+    const auto & file_type = dmfile->getColumnStat(cd.id).type;
+    // The pack has no value, all rows are null.
+    if (minmax->first.isNull() && !file_type->isNullable())
+        return nullptr;
+    auto column = file_type->createColumn();
+    column->insert(minmax->first);
+    column->insert(minmax->second);
+    return convertColumnByColumnDefineIfNeed(file_type, std::move(column), cd);
+}
+} // namespace
+
+BlockInputStreamPtr Segment::getPackStatsInputStream(BitmapFilterPtr && bitmap_filter,
+                                                     const SegmentSnapshotPtr & segment_snap,
+                                                     const DMContext & dm_context,
+                                                     const ColumnDefines & columns_to_read,
+                                                     const RowKeyRanges & read_ranges,
+                                                     const RSOperatorPtr & filter,
+                                                     UInt64 max_version,
+                                                     size_t expected_block_size)
+{
+    const auto & dmfiles = segment_snap->stable->getDMFiles();
+    std::vector<PackStatsBlockInputStream::PackStats> stats_packs;
+    // The packs that are not fully visible or have no statistics still need to be read.
+    std::vector<IdSetPtr> read_packs;
+    read_packs.reserve(dmfiles.size());
+    size_t stats_rows = 0;
+    UInt32 offset = 0;
+    for (const auto & dmfile : dmfiles)
+    {
+        DMFilePackFilter pack_filter = DMFilePackFilter::loadFrom(
+            dmfile,
+            dm_context.db_context.getMinMaxIndexCache(),
+            /*set_cache_if_miss*/ true,
+            read_ranges,
+            filter,
+            /*read_pack*/ {},
+            dm_context.db_context.getFileProvider(),
+            dm_context.db_context.getReadLimiter(),
+            dm_context.scan_context,
+            dm_context.tracing_id);
+        const auto & use_packs = pack_filter.getUsePacksConst();
+        const auto & pack_stats = dmfile->getPackStats();
+
+        std::vector<MinMaxIndexPtr> minmax_indexes;
+        minmax_indexes.reserve(columns_to_read.size());
+        for (const auto & cd : columns_to_read)
+            minmax_indexes.push_back(dmfile->isColumnExist(cd.id) ? pack_filter.getMinMaxIndex(cd.id) : nullptr);
+
+        auto read_packs_set = std::make_shared<IdSet>();
+        for (size_t pack_id = 0; pack_id < pack_stats.size(); offset += pack_stats[pack_id].rows, ++pack_id)
+        {
+            const auto rows = pack_stats[pack_id].rows;
+            if (!use_packs[pack_id])
+                continue;
+            if (rows == 0 || !bitmap_filter->isAllMatch(offset, rows))
+            {
+                read_packs_set->insert(pack_id);
+                continue;
+            }
+
+            Columns minmaxes;
+            minmaxes.reserve(columns_to_read.size());
+            for (size_t i = 0; i < columns_to_read.size(); ++i)
+            {
+                auto minmax = getPackMinMax(dmfile, minmax_indexes[i], pack_id, columns_to_read[i]);
+                if (!minmax)
+                    break;
+                minmaxes.push_back(std::move(minmax));
+            }
+            if (minmaxes.size() != columns_to_read.size())
+            {
+                read_packs_set->insert(pack_id);
+                continue;
+            }
+            stats_packs.push_back({rows, std::move(minmaxes)});
+            stats_rows += rows;
+        }
+        read_packs.push_back(read_packs_set);
+    }
+
+    LOG_DEBUG(log, "getPackStatsInputStream stats_packs={} stats_rows={} stable_rows={}", stats_packs.size(), stats_rows, segment_snap->stable->getDMFilesRows());
+
+    // set `is_fast_scan` to true to try to enable clean read
+    auto enable_handle_clean_read = !hasColumn(columns_to_read, EXTRA_HANDLE_COLUMN_ID);
+    constexpr auto is_fast_scan = true;
+    auto enable_del_clean_read = !hasColumn(columns_to_read, TAG_COLUMN_ID);
+
+    SkippableBlockInputStreamPtr stable_stream = segment_snap->stable->getInputStream(
+        dm_context,
+        columns_to_read,
+        read_ranges,
+        filter,
+        max_version,
+        expected_block_size,
+        enable_handle_clean_read,
+        is_fast_scan,
+        enable_del_clean_read,
+        read_packs);
+
+    auto columns_to_read_ptr = std::make_shared<ColumnDefines>(columns_to_read);
+    SkippableBlockInputStreamPtr delta_stream = std::make_shared<DeltaValueInputStream>(
+        dm_context,
+        segment_snap->delta,
+        columns_to_read_ptr,
+        this->rowkey_range);
+
+    BlockInputStreamPtr stream = std::make_shared<BitmapFilterBlockInputStream>(
+        columns_to_read,
+        stable_stream,
+        delta_stream,
+        segment_snap->stable->getDMFilesRows(),
+        bitmap_filter,
+        dm_context.tracing_id);
+    if (stats_packs.empty())
+        return stream;
+
+    BlockInputStreams streams{
+        std::make_shared<PackStatsBlockInputStream>(columns_to_read, std::move(stats_packs), dm_context.tracing_id),
+        stream,
+    };
+    return std::make_shared<ConcatBlockInputStream>(streams, dm_context.tracing_id);
+}
+
 BlockInputStreamPtr Segment::getLateMaterializationStream(BitmapFilterPtr && bitmap_filter,
                                                           const DMContext & dm_context,
                                                           const ColumnDefines & columns_to_read,
@@ -2767,7 +3506,14 @@ BlockInputStreamPtr Segment::getLateMaterializationStream(BitmapFilterPtr && bit
     }
 
     // construct filter stream
-    filter_column_stream = std::make_shared<FilterBlockInputStream>(filter_column_stream, filter->before_where, filter->filter_column_name, dm_context.tracing_id);
+    if (!filter->predicates.empty())
+    {
+        filter_column_stream = std::make_shared<AdaptiveFilterBlockInputStream>(filter_column_stream, filter->predicates, dm_context.scan_context, dm_context.tracing_id);
+    }
+    else
+    {
+        filter_column_stream = std::make_shared<FilterBlockInputStream>(filter_column_stream, filter->before_where, filter->filter_column_name, dm_context.tracing_id);
+    }
     filter_column_stream->setExtraInfo("push down filter");
     if (filter_columns.size() == columns_to_read.size())
     {
@@ -2860,6 +3606,19 @@ BlockInputStreamPtr Segment::getBitmapFilterInputStream(const DMContext & dm_con
             expected_block_size);
     }
 
+    if (filter && filter->aggregation_from_pack_stats)
+    {
+        return getPackStatsInputStream(
+            std::move(bitmap_filter),
+            segment_snap,
+            dm_context,
+            columns_to_read,
+            real_ranges,
+            filter->rs_operator,
+            max_version,
+            expected_block_size);
+    }
+
     return getBitmapFilterInputStream(
         std::move(bitmap_filter),
         segment_snap,
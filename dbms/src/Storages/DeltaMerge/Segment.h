@@ -24,10 +24,12 @@
 #include <Storages/DeltaMerge/DeltaTree.h>
 #include <Storages/DeltaMerge/Range.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
+#include <Storages/DeltaMerge/SegmentReadHeat.h>
 #include <Storages/DeltaMerge/SegmentReadTaskPool.h>
 #include <Storages/DeltaMerge/SkippableBlockInputStream.h>
 #include <Storages/DeltaMerge/StableValueSpace.h>
 #include <Storages/Page/PageDefinesBase.h>
+#include <Storages/PathPool_fwd.h>
 #include <Storages/Transaction/CheckpointInfo.h>
 
 namespace DB::DM
@@ -373,11 +375,19 @@ public:
      */
     [[nodiscard]] SegmentPtr mergeDelta(DMContext & dm_context, const ColumnDefinesPtr & schema_snap) const;
 
+    /**
+     * Write the delta and stable into a new stable.
+     * When `allow_incremental` is true and `dm_context.enable_incremental_merge_delta` is enabled,
+     * only the DTFiles of the stable affected by the delta are rewritten, see `prepareMergeDeltaIncremental`.
+     * The new stable is written to `target_tier` if specified, otherwise to the tier of the current stable.
+     */
     StableValueSpacePtr prepareMergeDelta(
         DMContext & dm_context,
         const ColumnDefinesPtr & schema_snap,
         const SegmentSnapshotPtr & segment_snap,
-        WriteBatches & wbs) const;
+        WriteBatches & wbs,
+        bool allow_incremental = true,
+        std::optional<StorageTier> target_tier = std::nullopt) const;
 
     /**
      * Should be protected behind the Segment update lock.
@@ -566,6 +576,13 @@ public:
 
     void setLastCheckGCSafePoint(DB::Timestamp gc_safe_point) { last_check_gc_safe_point.store(gc_safe_point, std::memory_order_relaxed); }
 
+    /// The read heat is kept after merge delta and inherited by the new segments after split and merge.
+    const SegmentReadHeatPtr & getReadHeat() const { return read_heat; }
+
+    /// The storage tier of the stable. It is not persisted in the segment meta, but derived from the paths of the
+    /// DTFiles of the stable.
+    StorageTier getStableTier(const DMContext & dm_context) const;
+
 #ifndef DBMS_PUBLIC_GTEST
 private:
 #else
@@ -597,6 +614,31 @@ public:
         UInt64 max_version = std::numeric_limits<UInt64>::max(),
         bool need_row_id = false);
 
+    /// Rewrite the DTFiles of the stable that are affected by the delta, and reference the other DTFiles.
+    /// Returns nullptr when it is not applicable or the whole stable is worth rewriting.
+    StableValueSpacePtr prepareMergeDeltaIncremental(
+        DMContext & dm_context,
+        const ColumnDefinesPtr & schema_snap,
+        const SegmentSnapshotPtr & segment_snap,
+        StorageTier tier,
+        WriteBatches & wbs) const;
+
+    /// Divide `range` into continuous key ranges at the boundaries of the stable packs, so that each of them contains
+    /// about the same number of stable rows and they can be rewritten concurrently.
+    /// Returns `{range}` if the range is too small to be divided or concurrent rewriting is disabled.
+    RowKeyRanges splitRangeForConcurrentRewrite(
+        const DMContext & dm_context,
+        const SegmentSnapshotPtr & segment_snap,
+        const RowKeyRange & range) const;
+
+    /// Create a stream to export the data of each range in `ranges`. The streams do not share the column caches and the
+    /// delta readers, so that they can be read concurrently.
+    BlockInputStreams getInputStreamsForConcurrentRewrite(
+        const DMContext & dm_context,
+        const SegmentSnapshotPtr & segment_snap,
+        const ReadInfo & read_info,
+        const RowKeyRanges & ranges) const;
+
     /// Make sure that all delta packs have been placed.
     /// Note that the index returned could be partial index, and cannot be updated to shared index.
     /// Returns <placed index, this index is fully indexed or not>
@@ -667,6 +709,16 @@ public:
                                                    const PushDownFilterPtr & filter,
                                                    UInt64 max_version,
                                                    size_t expected_block_size);
+    // Like `getBitmapFilterInputStream`, but the stable packs whose rows are all visible are generated
+    // from their statistics instead of reading. See `PushDownFilter::aggregation_from_pack_stats`.
+    BlockInputStreamPtr getPackStatsInputStream(BitmapFilterPtr && bitmap_filter,
+                                                const SegmentSnapshotPtr & segment_snap,
+                                                const DMContext & dm_context,
+                                                const ColumnDefines & columns_to_read,
+                                                const RowKeyRanges & read_ranges,
+                                                const RSOperatorPtr & filter,
+                                                UInt64 max_version,
+                                                size_t expected_block_size);
 
     BlockInputStreamPtr getLateMaterializationStream(BitmapFilterPtr && bitmap_filter,
                                                      const DMContext & dm_context,
@@ -690,6 +742,8 @@ private:
 
     std::atomic<DB::Timestamp> last_check_gc_safe_point = 0;
 
+    SegmentReadHeatPtr read_heat = std::make_shared<SegmentReadHeat>();
+
     const DeltaValueSpacePtr delta;
     const StableValueSpacePtr stable;
 
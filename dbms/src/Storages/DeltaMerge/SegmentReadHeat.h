@@ -0,0 +1,120 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <common/types.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace DB::DM
+{
+class SegmentReadHeat;
+using SegmentReadHeatPtr = std::shared_ptr<SegmentReadHeat>;
+
+/// SegmentReadHeat records how frequently a segment is read, which is used by the split and merge policies.
+/// The number of reads and scanned rows decay exponentially with a time constant of one minute, so that the
+/// decayed values approximate the reads and the scanned rows per minute.
+/// It is shared by the segment objects of the same key range, e.g. the segments before and after merging delta.
+class SegmentReadHeat
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Segments read less than this number of times per minute are considered cold.
+    static constexpr Float64 COLD_READS_PER_MINUTE = 1.0;
+
+    struct Heat
+    {
+        Float64 reads_per_minute = 0;
+        Float64 rows_per_minute = 0;
+    };
+
+    explicit SegmentReadHeat(Clock::time_point now = Clock::now())
+        : last_update(now)
+    {}
+
+    void recordRead(size_t scanned_rows, Clock::time_point now = Clock::now())
+    {
+        std::lock_guard lock(mutex);
+        decay(now);
+        heat.reads_per_minute += 1;
+        heat.rows_per_minute += scanned_rows;
+    }
+
+    Heat get(Clock::time_point now = Clock::now())
+    {
+        std::lock_guard lock(mutex);
+        decay(now);
+        return heat;
+    }
+
+    /// Returns true at most once every `interval`, to avoid trying to split a hot segment over and over again
+    /// when its split point can not be found.
+    bool tryMarkSplit(Clock::duration interval, Clock::time_point now = Clock::now())
+    {
+        std::lock_guard lock(mutex);
+        if (last_try_split.has_value() && now - *last_try_split < interval)
+            return false;
+        last_try_split = now;
+        return true;
+    }
+
+    /// Create the heat of a new segment that takes `ratio` of the data of this segment, e.g. after split.
+    /// The reads are not divided, because most reads of this segment cover both of the new segments, e.g.
+    /// the full table scans. The scanned rows are divided by `ratio`.
+    SegmentReadHeatPtr inherit(Float64 ratio, Clock::time_point now = Clock::now())
+    {
+        auto res = std::make_shared<SegmentReadHeat>(now);
+        std::lock_guard lock(mutex);
+        decay(now);
+        res->heat.reads_per_minute = heat.reads_per_minute;
+        res->heat.rows_per_minute = heat.rows_per_minute * ratio;
+        return res;
+    }
+
+    /// Add the heat of a segment merged into this one. Same as `inherit`, the reads covering both segments
+    /// are not counted twice, so the larger reads is taken. The scanned rows are summed up.
+    void merge(SegmentReadHeat & other, Clock::time_point now = Clock::now())
+    {
+        auto other_heat = other.get(now);
+        std::lock_guard lock(mutex);
+        decay(now);
+        heat.reads_per_minute = std::max(heat.reads_per_minute, other_heat.reads_per_minute);
+        heat.rows_per_minute += other_heat.rows_per_minute;
+    }
+
+private:
+    void decay(Clock::time_point now)
+    {
+        if (now <= last_update)
+            return;
+        auto factor = std::exp(-std::chrono::duration<Float64>(now - last_update).count() / 60.0);
+        heat.reads_per_minute *= factor;
+        heat.rows_per_minute *= factor;
+        last_update = now;
+    }
+
+    std::mutex mutex;
+    Heat heat;
+    Clock::time_point last_update;
+    std::optional<Clock::time_point> last_try_split;
+};
+
+} // namespace DB::DM
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include <Common/CurrentMetrics.h>
+#include <Common/Stopwatch.h>
 #include <Interpreters/Context.h>
+#include <Storages/DeltaMerge/BackgroundTaskScheduler.h>
 #include <Storages/DeltaMerge/Segment.h>
 #include <Storages/DeltaMerge/SegmentReadTaskPool.h>
 
@@ -256,7 +258,10 @@ bool SegmentReadTaskPool::readOneBlock(BlockInputStreamPtr & stream, const Segme
 
 void SegmentReadTaskPool::popBlock(Block & block)
 {
+    Stopwatch watch;
     q.pop(block);
+    // The time waiting for the storage layer is used to throttle the background tasks.
+    BackgroundTaskScheduler::instance().recordForegroundReadLatency(watch.elapsedSeconds());
     blk_stat.pop(block);
     global_blk_stat.pop(block);
     if (exceptionHappened())
@@ -0,0 +1,170 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Storages/DeltaMerge/BackgroundTaskScheduler.h>
+#include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+namespace DB::DM::tests
+{
+using namespace std::chrono_literals;
+using Priority = BackgroundTaskScheduler::Priority;
+using Decision = BackgroundTaskScheduler::Decision;
+using TaskDesc = BackgroundTaskScheduler::TaskDesc;
+
+TEST(BackgroundTaskSchedulerTest, DeferLowPriorityByUrgentTasks)
+{
+    BackgroundTaskScheduler scheduler;
+    const BackgroundTaskScheduler::Limits limits;
+
+    scheduler.addPendingTask(Priority::Normal);
+    ASSERT_EQ(0, scheduler.pendingUrgentTasks());
+    scheduler.addPendingTask(Priority::WriteStallRelief);
+    ASSERT_EQ(1, scheduler.pendingUrgentTasks());
+
+    ASSERT_EQ(Decision::DeferByUrgentTasks, scheduler.tryStartTask(TaskDesc{Priority::Low, false, false, ""}, limits, {}));
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(TaskDesc{Priority::Normal, false, false, ""}, limits, {}));
+    // Tasks exceeding the deadline are not deferred.
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(TaskDesc{Priority::Low, false, true, ""}, limits, {}));
+
+    scheduler.removePendingTask(Priority::WriteStallRelief);
+    ASSERT_EQ(0, scheduler.pendingUrgentTasks());
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(TaskDesc{Priority::Low, false, false, ""}, limits, {}));
+}
+
+TEST(BackgroundTaskSchedulerTest, DiskBudget)
+{
+    BackgroundTaskScheduler scheduler;
+    const BackgroundTaskScheduler::Limits limits{/*max_heavy_tasks_per_disk*/ 2, /*throttle_read_latency_ms*/ 0};
+
+    const TaskDesc task_a{Priority::Normal, true, false, "/disk_a"};
+    const TaskDesc task_b{Priority::Normal, true, false, "/disk_b"};
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(task_a, limits, {}));
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(task_a, limits, {}));
+    ASSERT_EQ(Decision::DeferByDiskBudget, scheduler.tryStartTask(task_a, limits, {}));
+    // Other disks and light tasks are not affected.
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(task_b, limits, {}));
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(TaskDesc{Priority::Normal, false, false, "/disk_a"}, limits, {}));
+    // Tasks relieving write stalls are not limited, but take the slots.
+    const TaskDesc urgent_a{Priority::WriteStallRelief, true, false, "/disk_a"};
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(urgent_a, limits, {}));
+    ASSERT_EQ(3, scheduler.runningHeavyTasks("/disk_a"));
+    ASSERT_EQ(1, scheduler.runningHeavyTasks("/disk_b"));
+
+    scheduler.finishTask(urgent_a);
+    scheduler.finishTask(task_a);
+    ASSERT_EQ(1, scheduler.runningHeavyTasks("/disk_a"));
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(task_a, limits, {}));
+
+    scheduler.finishTask(task_a);
+    scheduler.finishTask(task_a);
+    scheduler.finishTask(task_b);
+    ASSERT_EQ(0, scheduler.runningHeavyTasks("/disk_a"));
+    ASSERT_EQ(0, scheduler.runningHeavyTasks("/disk_b"));
+}
+
+TEST(BackgroundTaskSchedulerTest, ThrottleByForegroundLatency)
+{
+    BackgroundTaskScheduler scheduler;
+    const BackgroundTaskScheduler::Limits limits{/*max_heavy_tasks_per_disk*/ 0, /*throttle_read_latency_ms*/ 100};
+    auto now = BackgroundTaskScheduler::Clock::now();
+
+    const TaskDesc normal{Priority::Normal, true, false, ""};
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(normal, limits, {}, now));
+    scheduler.finishTask(normal);
+
+    for (size_t i = 0; i < 10; ++i)
+        scheduler.recordForegroundReadLatency(0.5, now);
+    ASSERT_DOUBLE_EQ(0.5, scheduler.getForegroundReadLatency(now));
+    ASSERT_EQ(Decision::DeferByForegroundLatency, scheduler.tryStartTask(normal, limits, {}, now));
+    ASSERT_EQ(Decision::DeferByForegroundLatency, scheduler.tryStartTask(TaskDesc{Priority::Low, false, false, ""}, limits, {}, now));
+    // Not throttled when disabled, relieving write stalls or exceeding the deadline.
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(normal, BackgroundTaskScheduler::Limits{}, {}, now));
+    scheduler.finishTask(normal);
+    const TaskDesc urgent{Priority::WriteStallRelief, true, false, ""};
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(urgent, limits, {}, now));
+    scheduler.finishTask(urgent);
+    const TaskDesc delayed{Priority::Normal, true, true, ""};
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(delayed, limits, {}, now));
+    scheduler.finishTask(delayed);
+
+    // Fast reads bring the latency down.
+    for (size_t i = 0; i < 1000; ++i)
+        scheduler.recordForegroundReadLatency(0.001, now + 1s);
+    ASSERT_LT(scheduler.getForegroundReadLatency(now + 1s), 0.1);
+    ASSERT_EQ(Decision::Run, scheduler.tryStartTask(normal, limits, {}, now + 1s));
+    scheduler.finishTask(normal);
+
+    // Without foreground reads, the latency decays to zero and the tasks are not throttled any more.
+    BackgroundTaskScheduler idle_scheduler;
+    for (size_t i = 0; i < 10; ++i)
+        idle_scheduler.recordForegroundReadLatency(0.5, now);
+    ASSERT_EQ(Decision::DeferByForegroundLatency, idle_scheduler.tryStartTask(normal, limits, {}, now));
+    ASSERT_DOUBLE_EQ(0, idle_scheduler.getForegroundReadLatency(now + 1min));
+    ASSERT_EQ(Decision::Run, idle_scheduler.tryStartTask(normal, limits, {}, now + 1min));
+    idle_scheduler.finishTask(normal);
+}
+
+TEST(BackgroundTaskSchedulerTest, MigrationBytes)
+{
+    BackgroundTaskScheduler scheduler;
+    auto now = BackgroundTaskScheduler::Clock::now();
+
+    // Unlimited.
+    ASSERT_TRUE(scheduler.tryAcquireMigrationBytes(1000, 0, now));
+
+    // The budget holds one second of the rate at first. A migration can take more than the budget left.
+    ASSERT_TRUE(scheduler.tryAcquireMigrationBytes(60, 100, now));
+    ASSERT_TRUE(scheduler.tryAcquireMigrationBytes(240, 100, now));
+    // The debt of 200 bytes is paid off after 2 seconds.
+    ASSERT_FALSE(scheduler.tryAcquireMigrationBytes(10, 100, now));
+    ASSERT_FALSE(scheduler.tryAcquireMigrationBytes(10, 100, now + 1s));
+    ASSERT_FALSE(scheduler.tryAcquireMigrationBytes(10, 100, now + 2s));
+    ASSERT_TRUE(scheduler.tryAcquireMigrationBytes(10, 100, now + 2500ms));
+
+    // The budget is capped to one second of the rate after a long idle time.
+    ASSERT_TRUE(scheduler.tryAcquireMigrationBytes(200, 100, now + 1h));
+    ASSERT_FALSE(scheduler.tryAcquireMigrationBytes(10, 100, now + 1h));
+}
+
+TEST(BackgroundTaskSchedulerTest, TaskOrder)
+{
+    using BackgroundTask = DeltaMergeStore::BackgroundTask;
+    auto now = BackgroundTaskScheduler::Clock::now();
+    auto make_task = [&](DeltaMergeStore::TaskType type, Priority priority, BackgroundTaskScheduler::Clock::duration deadline) {
+        BackgroundTask task{type, nullptr, nullptr};
+        task.priority = priority;
+        task.deadline = now + deadline;
+        return task;
+    };
+
+    std::priority_queue<BackgroundTask, std::vector<BackgroundTask>, DeltaMergeStore::BackgroundTaskOrder> tasks;
+    tasks.push(make_task(DeltaMergeStore::TaskType::Compact, Priority::Low, 1s));
+    tasks.push(make_task(DeltaMergeStore::TaskType::Flush, Priority::Normal, 10s));
+    tasks.push(make_task(DeltaMergeStore::TaskType::PlaceIndex, Priority::Normal, 5s));
+    tasks.push(make_task(DeltaMergeStore::TaskType::Flush, Priority::WriteStallRelief, 60s));
+
+    std::vector<DeltaMergeStore::TaskType> order;
+    for (; !tasks.empty(); tasks.pop())
+        order.push_back(tasks.top().type);
+    std::vector<DeltaMergeStore::TaskType> expected{
+        DeltaMergeStore::TaskType::Flush,
+        DeltaMergeStore::TaskType::PlaceIndex,
+        DeltaMergeStore::TaskType::Flush,
+        DeltaMergeStore::TaskType::Compact,
+    };
+    ASSERT_EQ(expected, order);
+}
+
+} // namespace DB::DM::tests
@@ -0,0 +1,87 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Storages/DeltaMerge/File/ColumnCompression.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <random>
+
+namespace DB::DM::tests
+{
+TEST(ColumnCompressionTest, ParseRules)
+{
+    ASSERT_EQ(nullptr, ColumnCompressionRules::parse("", 45));
+    ASSERT_EQ(nullptr, ColumnCompressionRules::parse("46.*=zstd", 45));
+    // Invalid rules are ignored.
+    ASSERT_EQ(nullptr, ColumnCompressionRules::parse("45.a=gzip,45.b,45=lz4,x.c=lz4,45.d=zstd:x,45.e=auto:1", 45));
+
+    auto rules = ColumnCompressionRules::parse(" 45.comment=zstd:9 , 46.*=none, 45.name=lz4hc, 45.*=auto, *.*=lz4", 45);
+    ASSERT_NE(nullptr, rules);
+
+    auto comment = rules->match("comment");
+    ASSERT_TRUE(comment.has_value());
+    ASSERT_FALSE(comment->is_auto);
+    ASSERT_EQ(CompressionMethod::ZSTD, comment->settings.method);
+    ASSERT_EQ(9, comment->settings.level);
+
+    auto name = rules->match("name");
+    ASSERT_TRUE(name.has_value());
+    ASSERT_EQ(CompressionMethod::LZ4HC, name->settings.method);
+    ASSERT_EQ(CompressionSettings::getDefaultLevel(CompressionMethod::LZ4HC), name->settings.level);
+
+    auto other = rules->match("other");
+    ASSERT_TRUE(other.has_value());
+    ASSERT_TRUE(other->is_auto);
+
+    rules = ColumnCompressionRules::parse("45.comment=zstd", 45);
+    ASSERT_FALSE(rules->match("other").has_value());
+}
+
+TEST(ColumnCompressionTest, ChooseByTrial)
+{
+    // Repeated data is compressed well by all methods, and LZ4 decompresses fastest.
+    String repeated;
+    for (size_t i = 0; i < 8192; ++i)
+        repeated += std::to_string(i % 16);
+    ASSERT_EQ(CompressionMethod::LZ4, chooseCompressionByTrial(repeated).method);
+
+    // Random bytes can not be compressed.
+    std::mt19937_64 rng(42);
+    String random(65536, '\0');
+    for (auto & c : random)
+        c = static_cast<char>(rng());
+    ASSERT_EQ(CompressionMethod::NONE, chooseCompressionByTrial(random).method);
+
+    // Text drawn from a small vocabulary in random order has many long matches, which are found by LZ4HC.
+    static const std::vector<String> words{"tiflash", "delta", "merge", "stable", "segment", "pack", "column", "compression"};
+    String text;
+    while (text.size() < 65536)
+    {
+        text += words[rng() % words.size()];
+        text += ' ';
+    }
+    ASSERT_EQ(CompressionMethod::LZ4HC, chooseCompressionByTrial(text).method);
+
+    // Random letters from a small alphabet have few matches, and are compressed much better by the entropy coding of ZSTD.
+    String letters(65536, '\0');
+    for (auto & c : letters)
+        c = "ACGT"[rng() % 4];
+    auto letters_compression = chooseCompressionByTrial(letters);
+    ASSERT_EQ(CompressionMethod::ZSTD, letters_compression.method);
+    ASSERT_EQ(1, letters_compression.level);
+
+    ASSERT_EQ(CompressionMethod::LZ4, chooseCompressionByTrial("").method);
+}
+
+} // namespace DB::DM::tests
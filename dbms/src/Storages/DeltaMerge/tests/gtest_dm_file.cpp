@@ -241,6 +241,44 @@ try
 }
 CATCH
 
+TEST_P(DMFileTest, ColumnCompression)
+try
+{
+    auto cols = DMTestEnv::getDefaultColumns(DMTestEnv::PkType::HiddenTiDBRowID, /*add_nullable*/ true);
+    const size_t num_rows_write = 128;
+
+    // Other tables are not affected, and the first matching rule is used.
+    db_context->getSettingsRef().dt_column_compression = fmt::format("1.*=none, 100.{}=zstd:3, *.*=auto", DMTestEnv::pk_name);
+    {
+        Block block1 = DMTestEnv::prepareSimpleWriteBlockWithNullable(0, num_rows_write / 2);
+        Block block2 = DMTestEnv::prepareSimpleWriteBlockWithNullable(num_rows_write / 2, num_rows_write);
+        auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols, /*physical_table_id*/ 100);
+        stream->writePrefix();
+        stream->write(block1, DMFileBlockOutputStream::BlockProperty{0, 0, 0, 0});
+        stream->write(block2, DMFileBlockOutputStream::BlockProperty{0, 0, 0, 0});
+        stream->writeSuffix();
+    }
+    db_context->getSettingsRef().dt_column_compression = "";
+
+    // Compressed blocks are self describing, so the file can be read with any compression, also after restored.
+    for (size_t i = 0; i < 2; ++i)
+    {
+        DMFileBlockInputStreamBuilder builder(dbContext());
+        auto stream = builder
+                          .setColumnCache(column_cache)
+                          .build(dm_file, *cols, RowKeyRanges{RowKeyRange::newAll(false, 1)}, std::make_shared<ScanContext>());
+        ASSERT_INPUTSTREAM_COLS_UR(
+            stream,
+            Strings({DMTestEnv::pk_name}),
+            createColumns({
+                createColumn<Int64>(createNumbers<Int64>(0, num_rows_write)),
+            }));
+
+        dm_file = restoreDMFile();
+    }
+}
+CATCH
+
 // test seek
 TEST_P(DMFileTest, Seek)
 try
@@ -14,6 +14,7 @@
 
 #include <Common/Logger.h>
 #include <Core/BlockGen.h>
+#include <DataStreams/TopNThreshold.h>
 #include <DataTypes/DataTypeEnum.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/convertFieldToType.h>
@@ -1425,6 +1426,32 @@ try
 }
 CATCH
 
+TEST_F(DMMinMaxIndexTest, TopN)
+try
+{
+    const auto * case_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    auto desc = std::make_shared<TopNThreshold>(DEFAULT_COL_ID, true);
+    // No threshold is published yet.
+    ASSERT_EQ(true, checkMatch(case_name, *context, "Int64", "1", createTopN(attr("Int64"), desc)));
+    desc->update(Field(static_cast<Int64>(100)));
+    ASSERT_EQ(true, checkMatch(case_name, *context, "Int64", "100", createTopN(attr("Int64"), desc)));
+    ASSERT_EQ(false, checkMatch(case_name, *context, "Int64", "99", createTopN(attr("Int64"), desc)));
+    // A looser threshold is ignored.
+    desc->update(Field(static_cast<Int64>(50)));
+    ASSERT_EQ(false, checkMatch(case_name, *context, "Int64", "99", createTopN(attr("Int64"), desc)));
+    // NULL is ordered last by DESC.
+    ASSERT_EQ(false, checkMatch(case_name, *context, "Nullable(Int64)", "\\N", createTopN(attr("Nullable(Int64)"), desc)));
+
+    auto asc = std::make_shared<TopNThreshold>(DEFAULT_COL_ID, false);
+    asc->update(Field(static_cast<Int64>(100)));
+    ASSERT_EQ(true, checkMatch(case_name, *context, "Int64", "100", createTopN(attr("Int64"), asc)));
+    ASSERT_EQ(false, checkMatch(case_name, *context, "Int64", "101", createTopN(attr("Int64"), asc)));
+    // NULL is ordered first by ASC.
+    ASSERT_EQ(true, checkMatch(case_name, *context, "Nullable(Int64)", "\\N", createTopN(attr("Nullable(Int64)"), asc)));
+    ASSERT_EQ(false, checkMatch(case_name, *context, "Nullable(Int64)", "101", createTopN(attr("Nullable(Int64)"), asc)));
+}
+CATCH
+
 TEST_F(DMMinMaxIndexTest, Enum8ValueCompare)
 try
 {
@@ -41,6 +41,11 @@ namespace tests
 void SimplePKTestBasic::reload()
 {
     TiFlashStorageTestBasic::SetUp();
+    if (!cold_data_paths.empty())
+    {
+        auto paths = DB::tests::TiFlashTestEnv::getPathPool({getTemporaryPath()});
+        db_context->setPathPool(paths.first, paths.second, Strings{}, db_context->getPathCapacity(), db_context->getFileProvider(), cold_data_paths);
+    }
 
     version = 0;
 
@@ -120,6 +120,8 @@ protected:
 protected:
     // Below are options
     bool is_common_handle = false;
+    // The stable of the store could be placed on these paths of the cold tier.
+    Strings cold_data_paths;
 };
 } // namespace tests
 } // namespace DM
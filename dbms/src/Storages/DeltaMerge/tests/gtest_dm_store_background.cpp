@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #include <Common/FailPoint.h>
+#include <Common/StringUtils/StringUtils.h>
 #include <Common/SyncPoint/SyncPoint.h>
 #include <Interpreters/Context.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/GCOptions.h>
 #include <Storages/DeltaMerge/tests/gtest_dm_simple_pk_test_basic.h>
@@ -141,6 +144,90 @@ try
 CATCH
 
 
+TEST_F(DeltaMergeStoreGCMergeTest, MergeSmallHotSegments)
+try
+{
+    fill(-1000, 1000);
+    flush();
+    mergeDelta();
+
+    ensureSegmentBreakpoints({0, 50, 100, 150, 200});
+
+    // Make the segment [0, 50) hot.
+    db_context->getGlobalContext().getSettingsRef().dt_segment_hot_read_per_minute = 3;
+    for (size_t i = 0; i < 5; ++i)
+        ASSERT_EQ(50, getRowsN(0, 50));
+
+    // Small hot segments are merged up to the normal segment limit.
+    db_context->getGlobalContext().getSettingsRef().dt_segment_limit_rows = 105;
+    auto gc_n = store->onSyncGc(1, gc_options);
+    ASSERT_EQ(std::vector<Int64>({0, 100, 150, 200}), getSegmentBreakpoints());
+    ASSERT_EQ(gc_n, 1);
+
+    // The merged segment is as hot as the hot one.
+    ASSERT_GE(getSegmentAt(0)->getReadHeat()->get().reads_per_minute, 3);
+
+    // Both of the split segments are as hot as the merged one.
+    ensureSegmentBreakpoints({0, 50, 100, 150, 200});
+    ASSERT_GE(getSegmentAt(0)->getReadHeat()->get().reads_per_minute, 3);
+    ASSERT_GE(getSegmentAt(50)->getReadHeat()->get().reads_per_minute, 3);
+
+    ASSERT_EQ(200, getRowsN(0, 200));
+    ASSERT_EQ(2000, getRowsN());
+}
+CATCH
+
+
+TEST_F(DeltaMergeStoreGCMergeTest, NotMergeHotSegmentsIntoLarger)
+try
+{
+    fill(-1000, 1000);
+    flush();
+    mergeDelta();
+
+    ensureSegmentBreakpoints({0, 50, 100});
+
+    // Make the segment [50, 100) hot.
+    db_context->getGlobalContext().getSettingsRef().dt_segment_hot_read_per_minute = 3;
+    for (size_t i = 0; i < 5; ++i)
+        ASSERT_EQ(50, getRowsN(50, 100));
+
+    // The cold segment [0, 50) could be merged until 55 * 2 rows, but the limit falls back to 55 rows
+    // once the hot segment [50, 100) is involved, so no merge will happen.
+    db_context->getGlobalContext().getSettingsRef().dt_segment_limit_rows = 55;
+    db_context->getGlobalContext().getSettingsRef().dt_segment_cold_merge_ratio = 2.0;
+    auto gc_n = store->onSyncGc(1, gc_options);
+    ASSERT_EQ(std::vector<Int64>({0, 50, 100}), getSegmentBreakpoints());
+    ASSERT_EQ(gc_n, 0);
+
+    ASSERT_EQ(100, getRowsN(0, 100));
+    ASSERT_EQ(2000, getRowsN());
+}
+CATCH
+
+
+TEST_F(DeltaMergeStoreGCMergeTest, MergeColdSegmentsIntoLarger)
+try
+{
+    fill(-1000, 1000);
+    flush();
+    mergeDelta();
+
+    ensureSegmentBreakpoints({0, 50, 100, 150, 200});
+
+    // The segments are never read, they can be merged until 55 * 2 rows.
+    db_context->getGlobalContext().getSettingsRef().dt_segment_limit_rows = 55;
+    db_context->getGlobalContext().getSettingsRef().dt_segment_cold_merge_ratio = 2.0;
+    auto gc_n = store->onSyncGc(1, gc_options);
+    ASSERT_EQ(std::vector<Int64>({0, 100, 150, 200}), getSegmentBreakpoints());
+    ASSERT_EQ(gc_n, 1);
+
+    ASSERT_EQ(200, getRowsN(0, 200));
+    ASSERT_EQ(2000, getRowsN());
+}
+CATCH
+
+
 class DeltaMergeStoreGCMergeDeltaTest : public DeltaMergeStoreGCTest
 {
 public:
@@ -403,6 +490,112 @@ try
 CATCH
 
 
+class DeltaMergeStoreGCMigrateTierTest : public DeltaMergeStoreGCTest
+{
+public:
+    void SetUp() override
+    {
+        gc_options = GCOptions::newNoneForTest();
+        gc_options.do_migrate_tier = true;
+        cold_data_paths = {Poco::Path(getTemporaryPath() + "/cold").absolute().toString()};
+        DeltaMergeStoreGCTest::SetUp();
+
+        auto & settings = db_context->getGlobalContext().getSettingsRef();
+        settings.dt_tier_cold_after_days = 1;
+        settings.dt_tier_migration_max_bytes_per_sec = 0;
+    }
+
+protected:
+    // Pretend that the stable of the segment has not been rewritten for `days` days.
+    static void setStableModifiedDaysAgo(const SegmentPtr & segment, UInt64 days)
+    {
+        const auto modified = Poco::Timestamp() - static_cast<Poco::Timestamp::TimeDiff>(days) * 24 * 3600 * Poco::Timestamp::resolution();
+        for (const auto & dtfile : segment->getStable()->getDMFiles())
+            Poco::File(dtfile->path()).setLastModified(modified);
+    }
+
+    StorageTier getStableTierAt(Int64 key) const
+    {
+        auto segment = getSegmentAt(key);
+        auto tier = segment->getStableTier(*dm_context);
+        // The DTFiles are placed under the paths of the tier.
+        for (const auto & dtfile : segment->getStable()->getDMFiles())
+            RUNTIME_CHECK(startsWith(dtfile->parentPath(), cold_data_paths[0]) == (tier == StorageTier::Cold), dtfile->path());
+        return tier;
+    }
+
+protected:
+    GCOptions gc_options{};
+};
+
+TEST_F(DeltaMergeStoreGCMigrateTierTest, MergeDeltaToTargetTier)
+try
+{
+    fill(0, 100);
+    flush();
+    ASSERT_EQ(StorageTier::Hot, getStableTierAt(0));
+
+    auto segment = store->segmentMergeDelta(*dm_context, getSegmentAt(0), DeltaMergeStore::MergeDeltaReason::Manual, nullptr, StorageTier::Cold);
+    ASSERT_NE(segment, nullptr);
+    ASSERT_EQ(0, segment->getDelta()->getRows());
+    ASSERT_EQ(StorageTier::Cold, getStableTierAt(0));
+
+    // Merge delta without the target tier keeps the stable on the current tier.
+    fill(50, 150);
+    mergeDelta();
+    ASSERT_EQ(StorageTier::Cold, getStableTierAt(0));
+
+    segment = store->segmentMergeDelta(*dm_context, getSegmentAt(0), DeltaMergeStore::MergeDeltaReason::Manual, nullptr, StorageTier::Hot);
+    ASSERT_NE(segment, nullptr);
+    ASSERT_EQ(StorageTier::Hot, getStableTierAt(0));
+
+    ASSERT_EQ(150, getRowsN());
+}
+CATCH
+
+TEST_F(DeltaMergeStoreGCMigrateTierTest, MigrateColdSegmentAndBack)
+try
+{
+    ensureSegmentBreakpoints({100});
+    fill(0, 200);
+    mergeDelta();
+    ASSERT_EQ(StorageTier::Hot, getStableTierAt(0));
+    ASSERT_EQ(StorageTier::Hot, getStableTierAt(100));
+
+    // The stables are just written, so they are not moved.
+    auto gc_n = store->onSyncGc(100, gc_options);
+    ASSERT_EQ(0, gc_n);
+    ASSERT_EQ(StorageTier::Hot, getStableTierAt(0));
+    ASSERT_EQ(StorageTier::Hot, getStableTierAt(100));
+
+    // Only the segment with an empty delta is moved to the cold tier.
+    setStableModifiedDaysAgo(getSegmentAt(0), 2);
+    setStableModifiedDaysAgo(getSegmentAt(100), 2);
+    fill(150, 160);
+    flush();
+    gc_n = store->onSyncGc(100, gc_options);
+    ASSERT_EQ(1, gc_n);
+    ASSERT_EQ(StorageTier::Cold, getStableTierAt(0));
+    ASSERT_EQ(StorageTier::Hot, getStableTierAt(100));
+
+    // The segment on the cold tier is not moved back until it becomes hot.
+    db_context->getGlobalContext().getSettingsRef().dt_tier_promote_read_per_minute = 3;
+    gc_n = store->onSyncGc(100, gc_options);
+    ASSERT_EQ(0, gc_n);
+    ASSERT_EQ(StorageTier::Cold, getStableTierAt(0));
+
+    for (size_t i = 0; i < 5; ++i)
+        ASSERT_EQ(100, getRowsN(0, 100));
+    gc_n = store->onSyncGc(100, gc_options);
+    ASSERT_EQ(1, gc_n);
+    ASSERT_EQ(StorageTier::Hot, getStableTierAt(0));
+    ASSERT_EQ(StorageTier::Hot, getStableTierAt(100));
+
+    ASSERT_EQ(200, getRowsN());
+}
+CATCH
+
+
 // This test enables GC merge and GC merge delta.
 TEST_F(DeltaMergeStoreGCTest, RandomShuffleLogicalSplitAndDeleteRange)
 try
@@ -1268,6 +1268,180 @@ try
 CATCH
 
 
+class SegmentIncrementalMergeDeltaTest : public SegmentTestBasic
+{
+public:
+    void SetUp() override
+    {
+        TiFlashStorageTestBasic::SetUp();
+        reloadWithOptions({.db_settings = {
+                               .dt_segment_stable_pack_rows = 100,
+                               .dt_enable_incremental_merge_delta = true,
+                               .dt_segment_stable_file_limit_rows = 100,
+                           }});
+    }
+
+    std::vector<UInt64> getStableFileIds(PageIdU64 segment_id)
+    {
+        std::vector<UInt64> ids;
+        for (const auto & dtfile : segments[segment_id]->getStable()->getDMFiles())
+            ids.push_back(dtfile->fileId());
+        return ids;
+    }
+};
+
+TEST_F(SegmentIncrementalMergeDeltaTest, RewriteAffectedFiles)
+try
+{
+    writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 1000, /* at */ 0);
+    mergeSegmentDelta(DELTA_MERGE_FIRST_SEGMENT_ID);
+    // The stable is split into DTFiles of 100 rows.
+    auto old_ids = getStableFileIds(DELTA_MERGE_FIRST_SEGMENT_ID);
+    ASSERT_EQ(10, old_ids.size());
+
+    // Update rows in [500, 510), only the 6th DTFile is rewritten.
+    writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 10, /* at */ 500);
+    mergeSegmentDelta(DELTA_MERGE_FIRST_SEGMENT_ID);
+    ASSERT_EQ(1000, getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID));
+    ASSERT_EQ(1010, getSegmentRowNumWithoutMVCC(DELTA_MERGE_FIRST_SEGMENT_ID));
+    auto new_ids = getStableFileIds(DELTA_MERGE_FIRST_SEGMENT_ID);
+    for (size_t i = 0; i < old_ids.size(); ++i)
+        ASSERT_EQ(i != 5, std::find(new_ids.begin(), new_ids.end(), old_ids[i]) != new_ids.end()) << i;
+
+    // Delete rows in [200, 300), the 3rd DTFile is removed.
+    writeSegmentWithDeleteRange(DELTA_MERGE_FIRST_SEGMENT_ID, 200, 300);
+    mergeSegmentDelta(DELTA_MERGE_FIRST_SEGMENT_ID);
+    ASSERT_EQ(900, getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID));
+    new_ids = getStableFileIds(DELTA_MERGE_FIRST_SEGMENT_ID);
+    ASSERT_EQ(new_ids.end(), std::find(new_ids.begin(), new_ids.end(), old_ids[2]));
+    ASSERT_NE(new_ids.end(), std::find(new_ids.begin(), new_ids.end(), old_ids[3]));
+
+    // Insert rows after the last row, only the last DTFile is rewritten.
+    writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 10, /* at */ 1000);
+    mergeSegmentDelta(DELTA_MERGE_FIRST_SEGMENT_ID);
+    ASSERT_EQ(910, getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID));
+    new_ids = getStableFileIds(DELTA_MERGE_FIRST_SEGMENT_ID);
+    ASSERT_EQ(new_ids.end(), std::find(new_ids.begin(), new_ids.end(), old_ids[9]));
+    ASSERT_NE(new_ids.end(), std::find(new_ids.begin(), new_ids.end(), old_ids[8]));
+
+    // Split and merge with multiple DTFiles in the stable.
+    auto new_seg_id = splitSegmentAt(DELTA_MERGE_FIRST_SEGMENT_ID, 650, Segment::SplitMode::Physical);
+    ASSERT_TRUE(new_seg_id.has_value());
+    ASSERT_EQ(550, getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID));
+    mergeSegment({DELTA_MERGE_FIRST_SEGMENT_ID, *new_seg_id});
+    ASSERT_EQ(910, getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID));
+}
+CATCH
+
+TEST_F(SegmentIncrementalMergeDeltaTest, RewriteWholeStable)
+try
+{
+    writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 1000, /* at */ 0);
+    mergeSegmentDelta(DELTA_MERGE_FIRST_SEGMENT_ID);
+    auto old_ids = getStableFileIds(DELTA_MERGE_FIRST_SEGMENT_ID);
+    ASSERT_EQ(10, old_ids.size());
+
+    // More than half of the rows are affected, the whole stable is rewritten.
+    writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 600, /* at */ 0);
+    mergeSegmentDelta(DELTA_MERGE_FIRST_SEGMENT_ID);
+    ASSERT_EQ(1000, getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID));
+    auto new_ids = getStableFileIds(DELTA_MERGE_FIRST_SEGMENT_ID);
+    for (auto id : old_ids)
+        ASSERT_EQ(new_ids.end(), std::find(new_ids.begin(), new_ids.end(), id));
+
+    // Merge delta by the gc thread always rewrites the whole stable.
+    old_ids = new_ids;
+    writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 10, /* at */ 0);
+    {
+        auto segment = segments[DELTA_MERGE_FIRST_SEGMENT_ID];
+        WriteBatches wbs(*dm_context->storage_pool, dm_context->getWriteLimiter());
+        auto segment_snap = segment->createSnapshot(*dm_context, true, CurrentMetrics::DT_SnapshotOfDeltaMerge);
+        auto new_stable = segment->prepareMergeDelta(*dm_context, tableColumns(), segment_snap, wbs, /*allow_incremental*/ false);
+        wbs.writeLogAndData();
+        new_stable->enableDMFilesGC(*dm_context);
+        auto lock = segment->mustGetUpdateLock();
+        segments[DELTA_MERGE_FIRST_SEGMENT_ID] = segment->applyMergeDelta(lock, *dm_context, segment_snap, wbs, new_stable);
+        wbs.writeAll();
+    }
+    ASSERT_EQ(1000, getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID));
+    new_ids = getStableFileIds(DELTA_MERGE_FIRST_SEGMENT_ID);
+    for (auto id : old_ids)
+        ASSERT_EQ(new_ids.end(), std::find(new_ids.begin(), new_ids.end(), id));
+}
+CATCH
+
+
+TEST_F(SegmentOperationTest, PlaceDeltaInBatches)
+try
+{
+    for (UInt64 place_batch_rows : {0, 1000})
+    {
+        reloadWithOptions({.db_settings = {
+                               .dt_segment_stable_pack_rows = 100,
+                               .dt_place_batch_rows = place_batch_rows,
+                           }});
+        writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 1000, /* at */ 0);
+        mergeSegmentDelta(DELTA_MERGE_FIRST_SEGMENT_ID);
+
+        // The blocks are separated by the persisted files, the big file and the mem table,
+        // and the rows are far from each other in the stable.
+        writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 10, /* at */ 5);
+        writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 10, /* at */ 995);
+        flushSegmentCache(DELTA_MERGE_FIRST_SEGMENT_ID);
+        ingestDTFileIntoDelta(DELTA_MERGE_FIRST_SEGMENT_ID, 10, /* at */ 500, false);
+        writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 10, /* at */ 300);
+        writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 10, /* at */ 1000);
+
+        ASSERT_EQ(1010, getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID)) << place_batch_rows;
+        ASSERT_EQ(1050, getSegmentRowNumWithoutMVCC(DELTA_MERGE_FIRST_SEGMENT_ID)) << place_batch_rows;
+        auto handle = getSegmentHandle(DELTA_MERGE_FIRST_SEGMENT_ID, {});
+        const auto * h = toColumnVectorDataPtr<Int64>(handle);
+        ASSERT_EQ(1010, h->size());
+        for (size_t i = 0; i < h->size(); ++i)
+            ASSERT_EQ(static_cast<Int64>(i), (*h)[i]) << place_batch_rows;
+    }
+}
+CATCH
+
+TEST_F(SegmentOperationTest, ConcurrentRewrite)
+try
+{
+    for (UInt64 concurrency : {1, 4})
+    {
+        reloadWithOptions({.db_settings = {
+                               .dt_segment_stable_pack_rows = 100,
+                               .dt_segment_rewrite_concurrency = concurrency,
+                               .dt_segment_rewrite_min_rows_per_task = 200,
+                           }});
+        writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 1000, /* at */ 0);
+        // There is no stable pack to divide the key range.
+        mergeSegmentDelta(DELTA_MERGE_FIRST_SEGMENT_ID);
+        ASSERT_EQ(1, segments[DELTA_MERGE_FIRST_SEGMENT_ID]->getStable()->getDMFiles().size()) << concurrency;
+
+        writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 10, /* at */ 500);
+        writeSegmentWithDeleteRange(DELTA_MERGE_FIRST_SEGMENT_ID, 200, 300);
+        writeSegment(DELTA_MERGE_FIRST_SEGMENT_ID, 10, /* at */ 1000);
+        // The stable is divided into 4 key ranges, each of them is written into a DTFile.
+        mergeSegmentDelta(DELTA_MERGE_FIRST_SEGMENT_ID);
+        ASSERT_EQ(concurrency == 1 ? 1 : 4, segments[DELTA_MERGE_FIRST_SEGMENT_ID]->getStable()->getDMFiles().size()) << concurrency;
+        ASSERT_EQ(910, getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID)) << concurrency;
+        auto handle = getSegmentHandle(DELTA_MERGE_FIRST_SEGMENT_ID, {});
+        const auto * h = toColumnVectorDataPtr<Int64>(handle);
+        ASSERT_EQ(910, h->size());
+        for (size_t i = 0; i < h->size(); ++i)
+            ASSERT_EQ(static_cast<Int64>(i < 200 ? i : i + 100), (*h)[i]) << concurrency;
+
+        auto new_seg_id = splitSegmentAt(DELTA_MERGE_FIRST_SEGMENT_ID, 650, Segment::SplitMode::Physical);
+        ASSERT_TRUE(new_seg_id.has_value());
+        ASSERT_EQ(550, getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID)) << concurrency;
+        ASSERT_EQ(360, getSegmentRowNum(*new_seg_id)) << concurrency;
+        mergeSegment({DELTA_MERGE_FIRST_SEGMENT_ID, *new_seg_id});
+        ASSERT_EQ(910, getSegmentRowNum(DELTA_MERGE_FIRST_SEGMENT_ID)) << concurrency;
+    }
+}
+CATCH
+
+
 } // namespace tests
 } // namespace DM
 } // namespace DB
@@ -506,4 +506,50 @@ try
 }
 CATCH
 
+TEST_F(SegmentBitmapFilterTest, AggregationFromPackStats)
+try
+{
+    writeSegment("d_mem:[0, 50000)");
+    mergeSegmentDelta(SEG_ID, true);
+    // The packs contain [10000, 10100) and [49900, 50000) are not fully visible.
+    writeSegment("d_mem:[10000, 10100)|d_dr:[49900, 50000)");
+    auto [seg, snap] = getSegmentForRead(SEG_ID);
+    ASSERT_EQ(seg->getStable()->getRows(), 50000);
+
+    auto filter = std::make_shared<PushDownFilter>(EMPTY_RS_OPERATOR);
+    filter->aggregation_from_pack_stats = true;
+    ColumnDefines columns_to_read{getExtraHandleColumnDefine(false)};
+    auto stream = seg->getInputStream(
+        ReadMode::Bitmap,
+        *dm_context,
+        columns_to_read,
+        snap,
+        {seg->getRowKeyRange()},
+        filter,
+        std::numeric_limits<UInt64>::max(),
+        DEFAULT_BLOCK_SIZE);
+    // Some packs are generated from the pack statistics.
+    ASSERT_EQ(stream->getName(), "Concat");
+
+    size_t rows = 0;
+    Int64 min = std::numeric_limits<Int64>::max();
+    Int64 max = std::numeric_limits<Int64>::min();
+    stream->readPrefix();
+    while (auto block = stream->read())
+    {
+        const auto * handles = toColumnVectorDataPtr<Int64>(block.getByName(EXTRA_HANDLE_COLUMN_NAME).column);
+        rows += handles->size();
+        for (auto h : *handles)
+        {
+            min = std::min(min, h);
+            max = std::max(max, h);
+        }
+    }
+    stream->readSuffix();
+    ASSERT_EQ(rows, 49900);
+    ASSERT_EQ(min, 0);
+    ASSERT_EQ(max, 49899);
+}
+CATCH
+
 } // namespace DB::DM::tests
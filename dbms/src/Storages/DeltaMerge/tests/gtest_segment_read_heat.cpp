@@ -0,0 +1,87 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <Storages/DeltaMerge/SegmentReadHeat.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+namespace DB::DM::tests
+{
+using namespace std::chrono_literals;
+
+TEST(SegmentReadHeatTest, Decay)
+{
+    auto now = SegmentReadHeat::Clock::now();
+    SegmentReadHeat heat(now);
+    for (size_t i = 0; i < 10; ++i)
+        heat.recordRead(100, now);
+
+    auto h = heat.get(now);
+    ASSERT_DOUBLE_EQ(10, h.reads_per_minute);
+    ASSERT_DOUBLE_EQ(1000, h.rows_per_minute);
+
+    // Decay by e after one minute.
+    h = heat.get(now + 60s);
+    ASSERT_NEAR(10 / M_E, h.reads_per_minute, 1e-6);
+    ASSERT_NEAR(1000 / M_E, h.rows_per_minute, 1e-6);
+
+    // A steady rate of one read per second converges to 60 reads per minute.
+    auto t = now + 60s;
+    for (size_t i = 0; i < 3600; ++i)
+    {
+        t += 1s;
+        heat.recordRead(1, t);
+    }
+    ASSERT_NEAR(60, heat.get(t).reads_per_minute, 1);
+
+    // Becomes cold after a long time without any read.
+    ASSERT_LT(heat.get(t + 10min).reads_per_minute, SegmentReadHeat::COLD_READS_PER_MINUTE);
+}
+
+TEST(SegmentReadHeatTest, InheritAndMerge)
+{
+    auto now = SegmentReadHeat::Clock::now();
+    SegmentReadHeat heat(now);
+    for (size_t i = 0; i < 10; ++i)
+        heat.recordRead(100, now);
+
+    // Both new segments are as hot as the split one, the scanned rows are divided.
+    auto left = heat.inherit(0.3, now);
+    auto right = heat.inherit(0.7, now);
+    ASSERT_DOUBLE_EQ(10, left->get(now).reads_per_minute);
+    ASSERT_DOUBLE_EQ(10, right->get(now).reads_per_minute);
+    ASSERT_DOUBLE_EQ(300, left->get(now).rows_per_minute);
+    ASSERT_DOUBLE_EQ(700, right->get(now).rows_per_minute);
+
+    // Merging them back gets the same heat.
+    left->merge(*right, now);
+    ASSERT_DOUBLE_EQ(10, left->get(now).reads_per_minute);
+    ASSERT_DOUBLE_EQ(1000, left->get(now).rows_per_minute);
+
+    // The reads of the segments covering only one of them are not summed up.
+    right->recordRead(100, now);
+    left->merge(*right, now);
+    ASSERT_DOUBLE_EQ(11, left->get(now).reads_per_minute);
+    ASSERT_DOUBLE_EQ(1800, left->get(now).rows_per_minute);
+}
+
+TEST(SegmentReadHeatTest, TryMarkSplit)
+{
+    auto now = SegmentReadHeat::Clock::now();
+    SegmentReadHeat heat(now);
+    ASSERT_TRUE(heat.tryMarkSplit(1min, now));
+    ASSERT_FALSE(heat.tryMarkSplit(1min, now + 30s));
+    ASSERT_TRUE(heat.tryMarkSplit(1min, now + 61s));
+    ASSERT_FALSE(heat.tryMarkSplit(1min, now + 62s));
+}
+
+} // namespace DB::DM::tests
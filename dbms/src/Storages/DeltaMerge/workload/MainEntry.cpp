@@ -357,6 +357,20 @@ void dailyRandomTest(WorkloadOptions & opts, ContextPtr context)
     }
 }
 
+// Compare placing the delta blocks one by one with placing them in batches.
+// The delta index is rebuilt by the reads after the delta is flushed, so the read speed is affected.
+void placeBenchmark(WorkloadOptions & opts, ContextPtr context)
+{
+    outputResultHeader();
+    std::vector<UInt64> place_batch_rows{0, context->getSettingsRef().dt_place_batch_rows};
+    for (size_t i = 0; i < place_batch_rows.size(); i++)
+    {
+        context->setSetting("dt_place_batch_rows", Field(place_batch_rows[i]));
+        opts.table_id = i;
+        opts.table_name = fmt::format("place_batch_rows_{}", place_batch_rows[i]);
+        ::run(opts, context);
+    }
+}
 
 std::mutex mtx_remote_fnames;
 std::vector<std::pair<String, UInt64>> remote_fnames;
@@ -640,6 +654,10 @@ int DTWorkload::mainEntry(int argc, char ** argv)
     {
         dailyRandomTest(opts, context);
     }
+    else if (opts.testing_type == "place_bench")
+    {
+        placeBenchmark(opts, context);
+    }
     else
     {
         if (opts.random_kill <= 0)
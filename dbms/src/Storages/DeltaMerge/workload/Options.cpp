@@ -86,7 +86,7 @@ std::pair<bool, std::string> WorkloadOptions::parseOptions(int argc, char * argv
         ("read_thread_count", value<uint64_t>()->default_value(1), "") //
         ("read_stream_count", value<uint64_t>()->default_value(4), "") //
         //
-        ("testing_type", value<std::string>()->default_value(""), "daily_perf/daily_random/s3_bench") //
+        ("testing_type", value<std::string>()->default_value(""), "daily_perf/daily_random/s3_bench/place_bench") //
         //
         ("log_write_request", value<bool>()->default_value(false), "") //
         //
@@ -1853,16 +1853,23 @@ bool PageDirectory<Trait>::tryDumpSnapshot(const ReadLimiterPtr & read_limiter,
     auto edit_from_disk = collapsed_dir->dumpSnapshotToEdit();
     files_snap.num_records = edit_from_disk.size();
     files_snap.read_elapsed_ms = watch.elapsedMilliseconds();
-    if constexpr (std::is_same_v<Trait, u128::PageDirectoryTrait>)
-    {
-        bool done_any_io = wal->saveSnapshot(std::move(files_snap), Trait::Serializer::serializeTo(edit_from_disk), write_limiter);
-        return done_any_io;
-    }
-    else if constexpr (std::is_same_v<Trait, universal::PageDirectoryTrait>)
+
+    // Split the snapshot into multiple log records, they are applied in the same order when restoring.
+    // An empty snapshot is still saved as one empty log record.
+    std::vector<String> serialized_snap;
+    const auto & records = edit_from_disk.getRecords();
+    for (size_t begin = 0; begin < records.size() || begin == 0; begin += MAX_RECORDS_PER_SNAPSHOT_LOG_RECORD)
     {
-        bool done_any_io = wal->saveSnapshot(std::move(files_snap), Trait::Serializer::serializeInCompressedFormTo(edit_from_disk), write_limiter);
-        return done_any_io;
+        const size_t end = std::min(records.size(), begin + MAX_RECORDS_PER_SNAPSHOT_LOG_RECORD);
+        PageEntriesEdit edit(end - begin);
+        for (size_t i = begin; i < end; ++i)
+            edit.appendRecord(records[i]);
+        if constexpr (std::is_same_v<Trait, u128::PageDirectoryTrait>)
+            serialized_snap.emplace_back(Trait::Serializer::serializeTo(edit));
+        else if constexpr (std::is_same_v<Trait, universal::PageDirectoryTrait>)
+            serialized_snap.emplace_back(Trait::Serializer::serializeInCompressedFormTo(edit));
     }
+    return wal->saveSnapshot(std::move(files_snap), std::move(serialized_snap), write_limiter);
 }
 
 template <typename Trait>
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/Stopwatch.h>
 #include <Storages/Page/V3/PageDefines.h>
 #include <Storages/Page/V3/PageDirectory.h>
 #include <Storages/Page/V3/PageDirectoryFactory.h>
@@ -37,6 +38,7 @@ typename PageDirectoryFactory<Trait>::PageDirectoryPtr
 PageDirectoryFactory<Trait>::create(const String & storage_name, FileProviderPtr & file_provider, PSDiskDelegatorPtr & delegator, const WALConfig & config)
 {
     auto [wal, reader] = WALStore::create(storage_name, file_provider, delegator, config);
+    restore_threads = config.restore_threads;
     return createFromReader(storage_name, reader, std::move(wal));
 }
 
@@ -44,8 +46,12 @@ template <typename Trait>
 typename PageDirectoryFactory<Trait>::PageDirectoryPtr
 PageDirectoryFactory<Trait>::createFromReader(const String & storage_name, WALStoreReaderPtr reader, WALStorePtr wal)
 {
+    Stopwatch watch;
     PageDirectoryPtr dir = std::make_unique<typename Trait::PageDirectory>(storage_name, std::move(wal));
-    loadFromDisk(dir, std::move(reader));
+    if (restore_threads > 1)
+        loadFromDiskParallel(dir, std::move(reader));
+    else
+        loadFromDisk(dir, std::move(reader));
 
     // Reset the `sequence` to the maximum of persisted.
     dir->sequence = max_applied_ver.sequence;
@@ -54,7 +60,13 @@ PageDirectoryFactory<Trait>::createFromReader(const String & storage_name, WALSt
     // try to run GC again on some entries that are already marked as invalid in BlobStore.
     // It's no need to remove the expired entries in BlobStore, so skip filling removed_entries to improve performance.
     dir->gcInMemEntries({.need_removed_entries = false});
-    LOG_INFO(DB::Logger::get(storage_name), "PageDirectory restored [max_page_id={}] [max_applied_ver={}]", dir->getMaxIdAfterRestart(), dir->sequence);
+    LOG_INFO(
+        DB::Logger::get(storage_name),
+        "PageDirectory restored [max_page_id={}] [max_applied_ver={}] [restore_threads={}] [elapsed_ms={}]",
+        dir->getMaxIdAfterRestart(),
+        dir->sequence,
+        restore_threads,
+        watch.elapsedMilliseconds());
 
     if (blob_stats)
     {
@@ -148,7 +160,7 @@ void PageDirectoryFactory<Trait>::loadEdit(const PageDirectoryPtr & dir, const P
 }
 
 template <typename Trait>
-void PageDirectoryFactory<Trait>::applyRecord(
+typename PageDirectoryFactory<Trait>::MVCCMapType::iterator PageDirectoryFactory<Trait>::createVersionListIfNotExist(
     const PageDirectoryPtr & dir,
     const typename PageEntriesEdit::EditRecord & r)
 {
@@ -180,7 +192,64 @@ void PageDirectoryFactory<Trait>::applyRecord(
     {
         dir->max_page_id = std::max(dir->max_page_id, Trait::PageIdTrait::getU64ID(r.page_id));
     }
+    return iter;
+}
+
+template <typename Trait>
+bool PageDirectoryFactory<Trait>::isPageLocalRecord(const typename PageEntriesEdit::EditRecord & r)
+{
+    // The other types of records may change the version lists of other pages (REF, UPSERT,
+    // UPDATE_DATA_FROM_REMOTE) or the external ids shared by the directory (VAR_EXTERNAL, PUT_EXTERNAL).
+    switch (r.type)
+    {
+    case EditRecordType::PUT:
+    case EditRecordType::DEL:
+    case EditRecordType::VAR_DELETE:
+    case EditRecordType::VAR_ENTRY:
+    case EditRecordType::VAR_REF:
+        return true;
+    default:
+        return false;
+    }
+}
+
+template <typename Trait>
+void PageDirectoryFactory<Trait>::applyPageLocalRecord(
+    const VersionedPageEntriesPtr & version_list,
+    const typename PageEntriesEdit::EditRecord & r)
+{
+    try
+    {
+        switch (r.type)
+        {
+        case EditRecordType::PUT:
+            version_list->createNewEntry(r.version, r.entry);
+            break;
+        case EditRecordType::DEL:
+        case EditRecordType::VAR_DELETE:
+            version_list->createDelete(r.version);
+            break;
+        case EditRecordType::VAR_ENTRY:
+        case EditRecordType::VAR_REF:
+            version_list->fromRestored(r);
+            break;
+        default:
+            RUNTIME_CHECK_MSG(false, "Unexpected page local record");
+        }
+    }
+    catch (DB::Exception & e)
+    {
+        e.addMessage(fmt::format(" [type={}] [page_id={}] [ver={}]", magic_enum::enum_name(r.type), r.page_id, r.version));
+        throw e;
+    }
+}
 
+template <typename Trait>
+void PageDirectoryFactory<Trait>::applyRecord(
+    const PageDirectoryPtr & dir,
+    const typename PageEntriesEdit::EditRecord & r)
+{
+    auto iter = createVersionListIfNotExist(dir, r);
     const auto & version_list = iter->second;
     const auto & restored_version = r.version;
     try
@@ -310,6 +379,110 @@ void PageDirectoryFactory<Trait>::loadFromDisk(const PageDirectoryPtr & dir, WAL
     }
 }
 
+template <typename Trait>
+void PageDirectoryFactory<Trait>::loadFromDiskParallel(const PageDirectoryPtr & dir, WALStoreReaderPtr && reader)
+{
+    // Read the records in batches. The records of a batch are deserialized concurrently, then applied in order.
+    static constexpr size_t max_batch_bytes = 64 * MB;
+    ThreadPool thread_pool(restore_threads, restore_threads, restore_threads * 2);
+    std::vector<String> batch;
+    size_t batch_bytes = 0;
+    auto load_batch = [&]() {
+        if (batch.empty())
+            return;
+        std::vector<PageEntriesEdit> edits(batch.size());
+        {
+            // Each task deserializes a continuous range of the records. The data file ids are only
+            // deduplicated inside a task.
+            const size_t num_tasks = std::min(restore_threads, batch.size());
+            auto wait_group = thread_pool.waitGroup();
+            for (size_t task_id = 0; task_id < num_tasks; ++task_id)
+            {
+                wait_group->schedule([&, task_id]() {
+                    DataFileIdSet data_file_ids;
+                    for (size_t i = batch.size() * task_id / num_tasks; i < batch.size() * (task_id + 1) / num_tasks; ++i)
+                    {
+                        if constexpr (std::is_same_v<Trait, u128::FactoryTrait>)
+                            edits[i] = Trait::Serializer::deserializeFrom(batch[i], nullptr);
+                        else
+                            edits[i] = Trait::Serializer::deserializeFrom(batch[i], &data_file_ids);
+                    }
+                });
+            }
+            wait_group->wait();
+        }
+        loadEditsParallel(dir, edits, thread_pool);
+        batch.clear();
+        batch_bytes = 0;
+    };
+
+    while (reader->remained())
+    {
+        auto record = reader->next();
+        if (!record)
+        {
+            reader->throwIfError();
+            break;
+        }
+        batch_bytes += record->size();
+        batch.emplace_back(std::move(*record));
+        if (batch_bytes >= max_batch_bytes)
+            load_batch();
+    }
+    load_batch();
+}
+
+template <typename Trait>
+void PageDirectoryFactory<Trait>::loadEditsParallel(const PageDirectoryPtr & dir, const std::vector<PageEntriesEdit> & edits, ThreadPool & thread_pool)
+{
+    // The page local records are partitioned by page id, so the records of the same page are applied in order
+    // by the same task. The other records are applied in the current thread after all the records before them.
+    std::vector<std::vector<std::pair<VersionedPageEntriesPtr, const typename PageEntriesEdit::EditRecord *>>> partitions(restore_threads);
+    bool has_pending = false;
+    auto apply_partitions = [&]() {
+        if (!has_pending)
+            return;
+        auto wait_group = thread_pool.waitGroup();
+        for (auto & partition : partitions)
+        {
+            if (partition.empty())
+                continue;
+            wait_group->schedule([&partition]() {
+                for (const auto & [version_list, record] : partition)
+                    applyPageLocalRecord(version_list, *record);
+            });
+        }
+        wait_group->wait();
+        for (auto & partition : partitions)
+            partition.clear();
+        has_pending = false;
+    };
+
+    for (const auto & edit : edits)
+    {
+        for (const auto & r : edit.getRecords())
+        {
+            if (max_applied_ver < r.version)
+                max_applied_ver = r.version;
+            if (dump_entries)
+                LOG_INFO(Logger::get(), "{}", r);
+
+            if (isPageLocalRecord(r))
+            {
+                auto iter = createVersionListIfNotExist(dir, r);
+                partitions[Trait::PageIdTrait::getU64ID(r.page_id) % restore_threads].emplace_back(iter->second, &r);
+                has_pending = true;
+            }
+            else
+            {
+                apply_partitions();
+                applyRecord(dir, r);
+            }
+        }
+    }
+    apply_partitions();
+}
+
 template class PageDirectoryFactory<u128::FactoryTrait>;
 template class PageDirectoryFactory<universal::FactoryTrait>;
 } // namespace PS::V3
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Common/UniThreadPool.h>
 #include <Storages/Page/V3/Blob/BlobStat.h>
 #include <Storages/Page/V3/BlobStore.h>
 #include <Storages/Page/V3/PageDefines.h>
@@ -21,6 +22,8 @@
 #include <Storages/Page/V3/PageEntriesEdit.h>
 #include <Storages/Page/V3/WALStore.h>
 
+#include <vector>
+
 namespace DB
 {
 class PSDiskDelegator;
@@ -51,6 +54,14 @@ public:
         return *this;
     }
 
+    // The number of threads to deserialize and apply the WAL records when restoring,
+    // 0 or 1 means restoring in the current thread only.
+    PageDirectoryFactory<Trait> & setRestoreThreads(size_t restore_threads_)
+    {
+        restore_threads = restore_threads_;
+        return *this;
+    }
+
     PageDirectoryPtr create(const String & storage_name, FileProviderPtr & file_provider, PSDiskDelegatorPtr & delegator, const WALConfig & config);
 
     PageDirectoryPtr createFromReader(const String & storage_name, WALStoreReaderPtr reader, WALStorePtr wal);
@@ -66,13 +77,29 @@ public:
     }
 
 private:
+    using MVCCMapType = typename Trait::PageDirectory::MVCCMapType;
+    using VersionedPageEntriesPtr = typename Trait::PageDirectory::VersionedPageEntriesPtr;
+
     void loadFromDisk(const PageDirectoryPtr & dir, WALStoreReaderPtr && reader);
+    void loadFromDiskParallel(const PageDirectoryPtr & dir, WALStoreReaderPtr && reader);
     void loadEdit(const PageDirectoryPtr & dir, const PageEntriesEdit & edit);
+    void loadEditsParallel(const PageDirectoryPtr & dir, const std::vector<PageEntriesEdit> & edits, ThreadPool & thread_pool);
     static void applyRecord(
         const PageDirectoryPtr & dir,
         const typename PageEntriesEdit::EditRecord & r);
 
+    // Whether the record only changes the versions of its own page, so the records of different pages
+    // can be applied concurrently.
+    static bool isPageLocalRecord(const typename PageEntriesEdit::EditRecord & r);
+    static typename MVCCMapType::iterator createVersionListIfNotExist(
+        const PageDirectoryPtr & dir,
+        const typename PageEntriesEdit::EditRecord & r);
+    static void applyPageLocalRecord(
+        const VersionedPageEntriesPtr & version_list,
+        const typename PageEntriesEdit::EditRecord & r);
+
     BlobStats * blob_stats = nullptr;
+    size_t restore_threads = 1;
 
     // For debug tool
     template <typename T>
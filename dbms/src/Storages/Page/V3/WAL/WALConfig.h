@@ -26,6 +26,7 @@ struct WALConfig
 {
     SettingUInt64 roll_size = PAGE_META_ROLL_SIZE;
     SettingUInt64 max_persisted_log_files = MAX_PERSISTED_LOG_FILES;
+    SettingUInt64 restore_threads = WAL_RESTORE_THREADS;
 
 private:
     SettingUInt64 wal_recover_mode = 0;
@@ -53,6 +54,7 @@ public:
 
         wal_config.roll_size = config.wal_roll_size;
         wal_config.max_persisted_log_files = config.wal_max_persisted_log_files;
+        wal_config.restore_threads = config.wal_restore_threads;
 
         return wal_config;
     }
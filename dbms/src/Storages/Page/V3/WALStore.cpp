@@ -207,7 +207,7 @@ WALStore::FilesSnapshot WALStore::tryGetFilesSnapshot(size_t max_persisted_log_f
 // log files.
 bool WALStore::saveSnapshot(
     FilesSnapshot && files_snap,
-    String && serialized_snap,
+    std::vector<String> && serialized_snap,
     const WriteLimiterPtr & write_limiter)
 {
     if (files_snap.persisted_log_files.empty())
@@ -220,10 +220,13 @@ bool WALStore::saveSnapshot(
     // Create a temporary file for saving directory snapshot
     auto [compact_log, log_filename] = createLogWriter({log_num, 1}, /*manual_flush*/ true);
 
-    // TODO: split the snap into multiple records in LogFile so that the memory
-    //       consumption could be more smooth.
-    ReadBufferFromString payload(serialized_snap);
-    compact_log->addRecord(payload, serialized_snap.size(), write_limiter, /*background*/ true);
+    size_t serialized_snap_size = 0;
+    for (const auto & record : serialized_snap)
+    {
+        ReadBufferFromString payload(record);
+        compact_log->addRecord(payload, record.size(), write_limiter, /*background*/ true);
+        serialized_snap_size += record.size();
+    }
     compact_log->flush(write_limiter, /*background*/ true);
     compact_log.reset(); // close fd explicitly before renaming file.
 
@@ -257,11 +260,12 @@ bool WALStore::saveSnapshot(
                 fb.append(arg.filename(arg.stage));
             },
             ", ");
-        fmt_buf.fmtAppend("] [read_cost={}] [num_records={}] [file={}] [size={}].",
+        fmt_buf.fmtAppend("] [read_cost={}] [num_records={}] [num_log_records={}] [file={}] [size={}].",
                           files_snap.read_elapsed_ms,
                           files_snap.num_records,
+                          serialized_snap.size(),
                           normal_fullname,
-                          serialized_snap.size());
+                          serialized_snap_size);
         return fmt_buf.toString();
     };
     LOG_INFO(logger, get_logging_str());
@@ -26,6 +26,7 @@
 #include <common/types.h>
 
 #include <memory>
+#include <vector>
 
 namespace DB
 {
@@ -94,9 +95,12 @@ public:
 
     FilesSnapshot tryGetFilesSnapshot(size_t max_persisted_log_files, bool force);
 
+    // Save the snapshot of the directory, each element of `serialized_snap` is written as a record in the
+    // log file, so that the memory consumption could be more smooth and the records can be deserialized
+    // concurrently when restoring.
     bool saveSnapshot(
         FilesSnapshot && files_snap,
-        String && serialized_snap,
+        std::vector<String> && serialized_snap,
         const WriteLimiterPtr & write_limiter = nullptr);
 
     const String & name() { return storage_name; }
@@ -25,6 +25,7 @@
 #include <Storages/Page/V3/PageDirectoryFactory.h>
 #include <Storages/Page/V3/PageEntriesEdit.h>
 #include <Storages/Page/V3/PageEntry.h>
+#include <Storages/Page/V3/WAL/WALReader.h>
 #include <Storages/Page/V3/WAL/serialize.h>
 #include <Storages/Page/V3/WALStore.h>
 #include <Storages/Page/V3/tests/entries_helper.h>
@@ -1001,6 +1002,96 @@ try
 }
 CATCH
 
+class PageDirectoryRestoreTest : public PageDirectoryTest
+{
+protected:
+    // Put the pages in [begin, end), then ref, delete or update some of them.
+    void applyEdits(PageIdU64 begin, PageIdU64 end, PageIdU64 ref_id_offset)
+    {
+        for (PageIdU64 page_id = begin; page_id < end; page_id += 10)
+        {
+            PageEntriesEdit edit;
+            for (PageIdU64 i = page_id; i < std::min(page_id + 10, end); ++i)
+            {
+                PageEntryV3 entry{.file_id = 1, .size = i, .padded_size = 0, .tag = 0, .offset = i * 0x100, .checksum = 0x4567};
+                if (i % 13 == 0)
+                    edit.putExternal(buildV3Id(TEST_NAMESPACE_ID, i));
+                else
+                    edit.put(buildV3Id(TEST_NAMESPACE_ID, i), entry);
+            }
+            dir->apply(std::move(edit));
+        }
+        for (PageIdU64 page_id = begin; page_id < end; page_id += 10)
+        {
+            PageEntriesEdit edit;
+            for (PageIdU64 i = page_id; i < std::min(page_id + 10, end); ++i)
+            {
+                if (i % 3 == 0)
+                    edit.ref(buildV3Id(TEST_NAMESPACE_ID, ref_id_offset + i), buildV3Id(TEST_NAMESPACE_ID, i));
+                if (i % 7 == 0)
+                    edit.del(buildV3Id(TEST_NAMESPACE_ID, i));
+                else if (i % 5 == 0 && i % 13 != 0)
+                    edit.put(buildV3Id(TEST_NAMESPACE_ID, i), PageEntryV3{.file_id = 2, .size = i, .padded_size = 0, .tag = 0, .offset = i, .checksum = 0x4567});
+            }
+            dir->apply(std::move(edit));
+        }
+    }
+
+    // Restore the directory sequentially and in parallel, and check that they get the same pages in [0, max_id).
+    void checkRestoreInParallel(PageIdU64 max_id)
+    {
+        dir.reset();
+
+        auto restore = [](size_t restore_threads) {
+            auto provider = DB::tests::TiFlashTestEnv::getDefaultFileProvider();
+            PSDiskDelegatorPtr delegator = std::make_shared<DB::tests::MockDiskDelegatorSingle>(getTemporaryPath());
+            WALConfig config;
+            config.restore_threads = restore_threads;
+            PageDirectoryFactory<u128::FactoryTrait> factory;
+            return factory.create("PageDirectoryTest", provider, delegator, config);
+        };
+        auto expected_dir = restore(1);
+        auto expected_snap = expected_dir->createSnapshot();
+        dir = restore(4);
+        auto snap = dir->createSnapshot();
+
+        ASSERT_EQ(dir->getMaxIdAfterRestart(), expected_dir->getMaxIdAfterRestart());
+        ASSERT_EQ(dir->numPages(), expected_dir->numPages());
+        for (PageIdU64 i = 0; i < max_id; ++i)
+        {
+            auto page_id = buildV3Id(TEST_NAMESPACE_ID, i);
+            EXPECT_SAME_ENTRY(expected_dir->getByIDOrNull(page_id, expected_snap).second, dir->getByIDOrNull(page_id, snap).second);
+        }
+        EXPECT_EQ(dir->getAliveExternalIds(TEST_NAMESPACE_ID), expected_dir->getAliveExternalIds(TEST_NAMESPACE_ID));
+    }
+};
+
+TEST_F(PageDirectoryRestoreTest, RestoreInParallel)
+try
+{
+    constexpr PageIdU64 num_pages = 1000;
+    applyEdits(0, num_pages, num_pages);
+    checkRestoreInParallel(num_pages * 2);
+}
+CATCH
+
+TEST_F(PageDirectoryRestoreTest, RestoreInParallelAfterDumpSnapshot)
+try
+{
+    // More records than MAX_RECORDS_PER_SNAPSHOT_LOG_RECORD, so that the compacted snapshot is split into multiple log records.
+    constexpr PageIdU64 num_pages = MAX_RECORDS_PER_SNAPSHOT_LOG_RECORD * 3 / 2;
+    applyEdits(0, num_pages, num_pages * 2);
+    ASSERT_TRUE(dir->tryDumpSnapshot(nullptr, nullptr, /*force*/ true));
+
+    const auto log_files = WALStoreReader::listAllFiles(std::make_shared<DB::tests::MockDiskDelegatorSingle>(getTemporaryPath()), log);
+    ASSERT_TRUE(std::any_of(log_files.begin(), log_files.end(), [](const LogFilename & f) { return f.level_num > 0; }));
+
+    // Some edits are applied after the snapshot, restoring should apply them on the snapshot.
+    applyEdits(num_pages - 100, num_pages + 100, num_pages * 2);
+    checkRestoreInParallel(num_pages * 3);
+}
+CATCH
+
 class PageDirectoryGCTest : public PageDirectoryTest
 {
 };
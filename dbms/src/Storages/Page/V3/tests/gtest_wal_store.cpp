@@ -818,7 +818,7 @@ try
     }
     std::tie(wal, reader) = WALStore::create(getCurrentTestName(), enc_provider, delegator, config);
     file_snap.num_records = snap_edit.size();
-    bool done = wal->saveSnapshot(std::move(file_snap), u128::Serializer::serializeTo(snap_edit));
+    bool done = wal->saveSnapshot(std::move(file_snap), {u128::Serializer::serializeTo(snap_edit)});
     ASSERT_TRUE(done);
     wal.reset();
     reader.reset();
@@ -900,7 +900,7 @@ TEST_P(WALStoreTest, GetFileSnapshot)
         // empty
         PageEntriesEdit snap_edit;
         files.num_records = snap_edit.size();
-        bool done = wal->saveSnapshot(std::move(files), u128::Serializer::serializeTo(snap_edit));
+        bool done = wal->saveSnapshot(std::move(files), {u128::Serializer::serializeTo(snap_edit)});
         ASSERT_TRUE(done);
         ASSERT_EQ(getNumLogFiles(), 1);
     }
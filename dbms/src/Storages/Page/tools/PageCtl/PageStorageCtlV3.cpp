@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/Stopwatch.h>
 #include <Encryption/MockKeyManager.h>
 #include <Interpreters/Context.h>
 #include <Poco/ConsoleChannel.h>
@@ -52,6 +53,7 @@ struct ControlOptions
     UInt64 namespace_id = DB::TEST_NAMESPACE_ID;
     StorageType storage_type = StorageType::Unknown; // only useful for universal page storage
     UInt32 keyspace_id = NullspaceID; // only useful for universal page storage
+    UInt64 restore_threads = DB::WAL_RESTORE_THREADS;
     bool enable_fo_check = true;
     bool is_imitative = true;
     String config_file_path;
@@ -86,6 +88,7 @@ ControlOptions ControlOptions::parse(int argc, char ** argv)
         ("namespace_id,N", value<UInt64>()->default_value(DB::TEST_NAMESPACE_ID), "When used `page_id`/`blob_id` to query results. You can specify a namespace id.") //
         ("page_id", value<UInt64>()->default_value(UINT64_MAX), "Query a single Page id, and print its version chain.") //
         ("blob_id,B", value<UInt32>()->default_value(UINT32_MAX), "Query a single Blob id, and print its data distribution.") //
+        ("restore_threads", value<UInt64>()->default_value(DB::WAL_RESTORE_THREADS), "The number of threads to restore the PageDirectory from WAL.") //
         ("imitative,I", value<bool>()->default_value(true), "Use imitative context instead. (encryption is not supported in this mode so that no need to set config_file_path)") //
         ("config_file_path", value<std::string>(), "Path to TiFlash config (tiflash.toml).");
 
@@ -119,6 +122,7 @@ ControlOptions ControlOptions::parse(int argc, char ** argv)
     auto storage_type_int = options["storage_type"].as<int>();
     opt.keyspace_id = options["keyspace_id"].as<UInt32>();
     opt.namespace_id = options["namespace_id"].as<UInt64>();
+    opt.restore_threads = options["restore_threads"].as<UInt64>();
     opt.is_imitative = options["imitative"].as<bool>();
     if (opt.is_imitative && options.count("config_file_path") != 0)
     {
@@ -250,12 +254,15 @@ private:
 
         constexpr static std::string_view NAME = "PageStorageControlV3";
         PageStorageConfig config;
+        config.wal_restore_threads = options.restore_threads;
         if (options.mode == ControlOptions::DisplayType::DISPLAY_WAL_ENTRIES)
         {
             // Only restore the PageDirectory
             typename Trait::PageDirectoryFactory factory;
             factory.dump_entries = true;
+            Stopwatch watch;
             factory.create(String(NAME), provider, delegator, WALConfig::from(config));
+            std::cout << fmt::format("Restored PageDirectory in {}ms", watch.elapsedMilliseconds()) << std::endl;
             return 0;
         }
 
@@ -299,7 +306,9 @@ private:
         if constexpr (std::is_same_v<Trait, u128::PageStorageControlV3Trait>)
         {
             PageStorageImpl ps(String(NAME), delegator, config, provider);
+            Stopwatch watch;
             ps.restore();
+            std::cout << fmt::format("Restored PageStorage in {}ms", watch.elapsedMilliseconds()) << std::endl;
             auto & mvcc_table_directory = ps.page_directory->mvcc_table_directory;
             auto & blobstore = ps.blob_store;
             display(mvcc_table_directory, blobstore, options);
@@ -307,7 +316,9 @@ private:
         else if constexpr (std::is_same_v<Trait, universal::PageStorageControlV3Trait>)
         {
             auto ps = UniversalPageStorage::create(String(NAME), delegator, config, provider);
+            Stopwatch watch;
             ps->restore();
+            std::cout << fmt::format("Restored PageStorage in {}ms", watch.elapsedMilliseconds()) << std::endl;
             auto & mvcc_table_directory = ps->page_directory->mvcc_table_directory;
             auto & blobstore = ps->blob_store;
             display(mvcc_table_directory, *blobstore, options);
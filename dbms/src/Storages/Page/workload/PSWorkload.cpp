@@ -129,7 +129,9 @@ void StressWorkload::initPageStorage(DB::PageStorageConfig & config, String path
                                         options.running_ps_version));
     }
 
+    Stopwatch restore_watch;
     ps->restore();
+    LOG_INFO(StressEnv::logger, "Restore PageStorage in {}ms.", restore_watch.elapsedMilliseconds());
 
     {
         size_t num_of_pages = 0;
@@ -30,6 +30,8 @@
 #include <common/logger_useful.h>
 #include <fmt/core.h>
 
+#include <algorithm>
+#include <magic_enum.hpp>
 #include <mutex>
 #include <random>
 #include <set>
@@ -69,9 +71,11 @@ PathPool::PathPool(
     const Strings & latest_data_paths_,
     const Strings & kvstore_paths_, //
     PathCapacityMetricsPtr global_capacity_,
-    FileProviderPtr file_provider_)
+    FileProviderPtr file_provider_,
+    const Strings & cold_data_paths_)
     : main_data_paths(main_data_paths_)
     , latest_data_paths(latest_data_paths_)
+    , cold_data_paths(cold_data_paths_)
     , kvstore_paths(kvstore_paths_)
     , global_capacity(global_capacity_)
     , file_provider(file_provider_)
@@ -97,7 +101,7 @@ PathPool::PathPool(
 
 StoragePathPool PathPool::withTable(const String & database_, const String & table_, bool path_need_database_name_) const
 {
-    return StoragePathPool(main_data_paths, latest_data_paths, database_, table_, path_need_database_name_, global_capacity, file_provider);
+    return StoragePathPool(main_data_paths, latest_data_paths, cold_data_paths, database_, table_, path_need_database_name_, global_capacity, file_provider);
 }
 
 Strings PathPool::listPaths() const
@@ -107,6 +111,8 @@ Strings PathPool::listPaths() const
         path_set.insert(getNormalizedPath(p + "/data"));
     for (const auto & p : latest_data_paths)
         path_set.insert(getNormalizedPath(p + "/data"));
+    for (const auto & p : cold_data_paths)
+        path_set.insert(getNormalizedPath(p + "/data"));
     Strings paths;
     for (const auto & p : path_set)
         paths.emplace_back(p);
@@ -140,6 +146,7 @@ PSDiskDelegatorPtr PathPool::getPSDiskDelegatorFixedDirectory(const String & dir
 StoragePathPool::StoragePathPool( //
     const Strings & main_data_paths,
     const Strings & latest_data_paths, //
+    const Strings & cold_data_paths,
     String database_,
     String table_,
     bool path_need_database_name_, //
@@ -160,6 +167,15 @@ StoragePathPool::StoragePathPool( //
     {
         MainPathInfo info;
         info.path = getStorePath(p + "/data", database, table);
+        info.root = getNormalizedPath(p);
+        main_path_infos.emplace_back(info);
+    }
+    for (const auto & p : cold_data_paths)
+    {
+        MainPathInfo info;
+        info.path = getStorePath(p + "/data", database, table);
+        info.root = getNormalizedPath(p);
+        info.tier = StorageTier::Cold;
         main_path_infos.emplace_back(info);
     }
     for (const auto & p : latest_data_paths)
@@ -422,19 +438,33 @@ Strings StableDiskDelegator::listPaths() const
     return paths;
 }
 
-String StableDiskDelegator::choosePath() const
+String StableDiskDelegator::choosePath(StorageTier tier) const
 {
-    std::function<String(const StoragePathPool::MainPathInfos & paths, size_t idx)> path_generator
-        = [](const StoragePathPool::MainPathInfos & paths, size_t idx) -> String {
-        return fmt::format("{}/{}", paths[idx].path, StoragePathPool::STABLE_FOLDER_NAME);
+    using MainPathInfoPtr = const StoragePathPool::MainPathInfo *;
+    std::vector<MainPathInfoPtr> candidates;
+    for (const auto & info : pool.main_path_infos)
+    {
+        if (info.tier == tier)
+            candidates.push_back(&info);
+    }
+    RUNTIME_CHECK_MSG(!candidates.empty(), "No path for DTFile, tier={}", magic_enum::enum_name(tier));
+
+    std::function<String(const std::vector<MainPathInfoPtr> & paths, size_t idx)> path_generator
+        = [](const std::vector<MainPathInfoPtr> & paths, size_t idx) -> String {
+        return fmt::format("{}/{}", paths[idx]->path, StoragePathPool::STABLE_FOLDER_NAME);
     };
 
-    std::function<String(const StoragePathPool::MainPathInfo & info)> path_getter = [](const StoragePathPool::MainPathInfo & info) -> String {
-        return info.path;
+    std::function<String(const MainPathInfoPtr & info)> path_getter = [](const MainPathInfoPtr & info) -> String {
+        return info->path;
     };
 
-    const String log_msg = fmt::format("[type=stable] [database={}] [table={}]", pool.database, pool.table);
-    return genericChoosePath(pool.main_path_infos, pool.global_capacity, path_generator, path_getter, pool.log, log_msg);
+    const String log_msg = fmt::format("[type=stable] [tier={}] [database={}] [table={}]", magic_enum::enum_name(tier), pool.database, pool.table);
+    return genericChoosePath(candidates, pool.global_capacity, path_generator, path_getter, pool.log, log_msg);
+}
+
+bool StableDiskDelegator::hasPaths(StorageTier tier) const
+{
+    return std::any_of(pool.main_path_infos.begin(), pool.main_path_infos.end(), [tier](const auto & info) { return info.tier == tier; });
 }
 
 String StableDiskDelegator::getDTFilePath(UInt64 file_id, bool throw_on_not_exist) const
@@ -448,6 +478,24 @@ String StableDiskDelegator::getDTFilePath(UInt64 file_id, bool throw_on_not_exis
     return "";
 }
 
+std::optional<StorageTier> StableDiskDelegator::getDTFileTier(UInt64 file_id) const
+{
+    std::lock_guard lock{pool.mutex};
+    auto iter = pool.dt_file_path_map.find(file_id);
+    if (iter == pool.dt_file_path_map.end())
+        return std::nullopt;
+    return pool.main_path_infos[iter->second].tier;
+}
+
+String StableDiskDelegator::getDTFileStorageRoot(UInt64 file_id) const
+{
+    std::lock_guard lock{pool.mutex};
+    auto iter = pool.dt_file_path_map.find(file_id);
+    if (iter == pool.dt_file_path_map.end())
+        return "";
+    return pool.main_path_infos[iter->second].root;
+}
+
 void StableDiskDelegator::addDTFile(UInt64 file_id, size_t file_size, std::string_view path)
 {
     path.remove_suffix(1 + strlen(StoragePathPool::STABLE_FOLDER_NAME)); // remove '/stable' added in listPathsForStable/getDTFilePath
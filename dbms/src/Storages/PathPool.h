@@ -23,6 +23,7 @@
 #include <Storages/Transaction/Types.h>
 
 #include <mutex>
+#include <optional>
 #include <unordered_map>
 
 namespace DB
@@ -46,7 +47,8 @@ public:
         const Strings & latest_data_paths,
         const Strings & kvstore_paths,
         PathCapacityMetricsPtr global_capacity_,
-        FileProviderPtr file_provider_);
+        FileProviderPtr file_provider_,
+        const Strings & cold_data_paths = {});
 
     // Constructor to create PathPool for one Storage
     StoragePathPool withTable(const String & database_, const String & table_, bool path_need_database_name_) const;
@@ -126,6 +128,7 @@ public:
 private:
     Strings main_data_paths;
     Strings latest_data_paths;
+    Strings cold_data_paths;
     Strings kvstore_paths;
     Strings global_page_paths;
 
@@ -145,12 +148,22 @@ public:
 
     Strings listPaths() const;
 
-    String choosePath() const;
+    // Choose a path of `tier` for a new DTFile.
+    String choosePath(StorageTier tier = StorageTier::Hot) const;
+
+    bool hasPaths(StorageTier tier) const;
 
     // Get the path of the DTFile with file_id.
     // If throw_on_not_exist is false, return empty string when the path is not exists.
     String getDTFilePath(UInt64 file_id, bool throw_on_not_exist = true) const;
 
+    // Returns std::nullopt if the DTFile is not found, e.g. the DTFile is on the remote store.
+    std::optional<StorageTier> getDTFileTier(UInt64 file_id) const;
+
+    // Get the root data path of the DTFile with file_id, which is shared by all tables stored on it.
+    // Returns an empty string if the DTFile is not found, e.g. the DTFile is on the remote store.
+    String getDTFileStorageRoot(UInt64 file_id) const;
+
     void addDTFile(UInt64 file_id, size_t file_size, std::string_view path);
 
     // Update the file size of the DTFile with file_id.
@@ -435,6 +448,7 @@ public:
 
     StoragePathPool(const Strings & main_data_paths,
                     const Strings & latest_data_paths,
+                    const Strings & cold_data_paths,
                     String database_,
                     String table_,
                     bool path_need_database_name_,
@@ -442,7 +456,8 @@ public:
                     FileProviderPtr file_provider_);
 
     // Generate a lightweight delegator for managing stable data, such as choosing path for DTFile or getting DTFile path by ID and so on.
-    // Those paths are generated from `main_path_infos` and `STABLE_FOLDER_NAME`
+    // Those paths are generated from `main_path_infos` and `STABLE_FOLDER_NAME`. `main_path_infos` contains both of the
+    // main data paths and the cold data paths.
     StableDiskDelegator getStableDiskDelegator() { return StableDiskDelegator(*this); }
 
     // Generate a delegator for managing the paths of `StoragePool`.
@@ -485,6 +500,9 @@ private:
     struct MainPathInfo
     {
         String path;
+        // The root data path in the config that `path` is generated from.
+        String root;
+        StorageTier tier = StorageTier::Hot;
         // DMFileID -> file size
         std::unordered_map<UInt64, size_t> file_size_map;
     };
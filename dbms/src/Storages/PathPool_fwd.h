@@ -37,4 +37,14 @@ class StableDiskDelegator;
 class PSDiskDelegator;
 using PSDiskDelegatorPtr = std::shared_ptr<PSDiskDelegator>;
 
+/// The class of the disks that the stable DTFiles are stored on.
+enum class StorageTier : UInt8
+{
+    /// The main data paths ("storage.main.dir").
+    Hot = 0,
+    /// The cold data paths ("storage.cold.dir"), usually on larger and slower disks.
+    /// Only the stable DTFiles of the segments that are rarely accessed are moved here.
+    Cold = 1,
+};
+
 } // namespace DB
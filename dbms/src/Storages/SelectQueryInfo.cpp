@@ -31,6 +31,8 @@ SelectQueryInfo::SelectQueryInfo(const SelectQueryInfo & rhs)
     , req_id(rhs.req_id)
     , keep_order(rhs.keep_order)
     , is_fast_scan(rhs.is_fast_scan)
+    , aggregation_from_pack_stats(rhs.aggregation_from_pack_stats)
+    , topn_threshold(rhs.topn_threshold)
 {}
 
 SelectQueryInfo::SelectQueryInfo(SelectQueryInfo && rhs) noexcept
@@ -41,6 +43,8 @@ SelectQueryInfo::SelectQueryInfo(SelectQueryInfo && rhs) noexcept
     , req_id(std::move(rhs.req_id))
     , keep_order(rhs.keep_order)
     , is_fast_scan(rhs.is_fast_scan)
+    , aggregation_from_pack_stats(rhs.aggregation_from_pack_stats)
+    , topn_threshold(std::move(rhs.topn_threshold))
 {}
 
 } // namespace DB
@@ -33,6 +33,9 @@ using PreparedSets = std::unordered_map<IAST *, SetPtr>;
 struct MvccQueryInfo;
 struct DAGQueryInfo;
 
+class TopNThreshold;
+using TopNThresholdPtr = std::shared_ptr<TopNThreshold>;
+
 
 /** Query along with some additional data,
   *  that can be used during query processing
@@ -53,6 +56,11 @@ struct SelectQueryInfo
     std::string req_id;
     bool keep_order = true;
     bool is_fast_scan = false;
+    /// The upper aggregation only needs the number of rows and the min/max values of the columns,
+    /// so the storage can answer the fully visible packs from the pack statistics.
+    bool aggregation_from_pack_stats = false;
+    /// The threshold of the TopN on the table scan, which is used to skip the packs that can not be in the result.
+    TopNThresholdPtr topn_threshold;
 
     SelectQueryInfo();
     ~SelectQueryInfo();
@@ -22,6 +22,7 @@
 #include <Core/Defines.h>
 #include <DataStreams/IBlockOutputStream.h>
 #include <DataStreams/OneBlockInputStream.h>
+#include <DataStreams/TopNThreshold.h>
 #include <DataTypes/isSupportedDataTypeCast.h>
 #include <Databases/IDatabase.h>
 #include <Debug/MockTiDB.h>
@@ -728,7 +729,15 @@ DM::RSOperatorPtr StorageDeltaMerge::buildRSOperator(const SelectQueryInfo & que
                 // Maybe throw an exception? Or check if `type` is nullptr before creating filter?
                 return Attr{.col_name = "", .col_id = column_id, .type = DataTypePtr{}};
             };
+            DM::RSOperatorPtr topn_operator = DM::EMPTY_RS_OPERATOR;
+            if (query_info.topn_threshold)
+            {
+                if (auto attr = create_attr_by_column_id(query_info.topn_threshold->getColumnID()); attr.type != nullptr)
+                    topn_operator = DM::createTopN(attr, query_info.topn_threshold);
+            }
             rs_operator = FilterParser::parseDAGQuery(*query_info.dag_query, columns_to_read, std::move(create_attr_by_column_id), log);
+            if (topn_operator != DM::EMPTY_RS_OPERATOR)
+                rs_operator = rs_operator != DM::EMPTY_RS_OPERATOR ? DM::createAnd({rs_operator, topn_operator}) : topn_operator;
         }
         if (likely(rs_operator != DM::EMPTY_RS_OPERATOR))
             LOG_DEBUG(tracing_logger, "Rough set filter: {}", rs_operator->toDebugString());
@@ -820,7 +829,22 @@ DM::PushDownFilterPtr StorageDeltaMerge::buildPushDownFilter(const RSOperatorPtr
         auto [before_where, filter_column_name, _] = ::DB::buildPushDownFilter(pushed_down_filters, *analyzer);
         LOG_DEBUG(tracing_logger, "Push down filter: {}", before_where->dumpActions());
 
-        return std::make_shared<PushDownFilter>(rs_operator, before_where, filter_columns, filter_column_name, extra_cast);
+        // build filter expression actions of each condition, so that they can be evaluated one by one
+        // in the order of their observed selectivity and cost.
+        PushDownPredicates predicates;
+        if (pushed_down_filters.size() > 1 && context.getSettingsRef().dt_enable_adaptive_filter_order)
+        {
+            predicates.reserve(pushed_down_filters.size());
+            for (const auto & expr : pushed_down_filters)
+            {
+                google::protobuf::RepeatedPtrField<tipb::Expr> condition;
+                *condition.Add() = expr;
+                auto predicate = ::DB::buildPushDownFilter(condition, *analyzer);
+                predicates.push_back(PushDownPredicate{std::get<0>(predicate), std::get<1>(predicate)});
+            }
+        }
+
+        return std::make_shared<PushDownFilter>(rs_operator, before_where, filter_columns, filter_column_name, extra_cast, std::move(predicates));
     }
     LOG_DEBUG(tracing_logger, "Push down filter is empty");
     return std::make_shared<PushDownFilter>(rs_operator);
@@ -837,7 +861,9 @@ DM::PushDownFilterPtr StorageDeltaMerge::parsePushDownFilter(const SelectQueryIn
     // build push down filter
     const auto & pushed_down_filters = query_info.dag_query != nullptr ? query_info.dag_query->pushed_down_filters : google::protobuf::RepeatedPtrField<tipb::Expr>{};
     const auto & columns_to_read_info = query_info.dag_query != nullptr ? query_info.dag_query->source_columns : ColumnInfos{};
-    return buildPushDownFilter(rs_operator, columns_to_read_info, pushed_down_filters, columns_to_read, context, tracing_logger);
+    auto filter = buildPushDownFilter(rs_operator, columns_to_read_info, pushed_down_filters, columns_to_read, context, tracing_logger);
+    filter->aggregation_from_pack_stats = query_info.aggregation_from_pack_stats && pushed_down_filters.empty();
+    return filter;
 }
 
 BlockInputStreams StorageDeltaMerge::read(
@@ -16,6 +16,7 @@
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/InterpreterUtils.h>
 #include <Flash/Coprocessor/RequestUtils.h>
+#include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
 #include <Interpreters/Context.h>
 #include <Storages/S3/S3Common.h>
 #include <Storages/StorageDisaggregated.h>
@@ -300,4 +301,14 @@ void StorageDisaggregated::filterConditions(NamesAndTypes && source_columns, DAG
         pipeline.transform([&profile_streams](auto & stream) { profile_streams.push_back(stream); });
     }
 }
+
+void StorageDisaggregated::filterConditions(PipelineExecutorStatus & exec_status, PipelineExecGroupBuilder & group_builder)
+{
+    assert(analyzer);
+    if (filter_conditions.hasValue())
+    {
+        // No need to cast, because already done by tiflash_storage node.
+        ::DB::executePushedDownFilter(exec_status, group_builder, /*remote_read_sources_start_index=*/group_builder.group.size(), filter_conditions, *analyzer, log);
+    }
+}
 } // namespace DB
@@ -20,6 +20,7 @@
 #include <Flash/Coprocessor/RemoteRequest.h>
 #include <Flash/Mpp/MPPTaskId.h>
 #include <Interpreters/Context_fwd.h>
+#include <Operators/Operator.h>
 #include <Storages/DeltaMerge/Remote/RNRemoteReadTask_fwd.h>
 #include <Storages/IStorage.h>
 
@@ -34,6 +35,8 @@ namespace DB
 {
 class DAGContext;
 class ExchangeReceiver;
+class PipelineExecutorStatus;
+struct PipelineExecGroupBuilder;
 namespace DM
 {
 struct ColumnDefine;
@@ -75,6 +78,15 @@ public:
         size_t max_block_size,
         unsigned num_streams) override;
 
+    // Only support reading from the remote storage (e.g. S3) for now.
+    SourceOps readSourceOps(
+        PipelineExecutorStatus & exec_status,
+        const Context & context,
+        unsigned num_streams);
+
+    // Append the pushed down filter after the source ops built by `readSourceOps`.
+    void filterConditions(PipelineExecutorStatus & exec_status, PipelineExecGroupBuilder & group_builder);
+
     RequestAndRegionIDs buildDispatchMPPTaskRequest(const pingcap::coprocessor::BatchCopTask & batch_cop_task);
 
     // To help find exec summary of ExchangeSender in tiflash_storage and merge it into TableScan's exec summary.
@@ -88,6 +100,7 @@ private:
         const Context & db_context,
         const SelectQueryInfo & query_info,
         unsigned num_streams);
+    DM::RNRemoteReadTaskPtr buildDisaggTasksWithBackoff(const Context & db_context);
     DM::RNRemoteReadTaskPtr buildDisaggTasks(
         const Context & db_context,
         const DM::ScanContextPtr & scan_context,
@@ -111,6 +124,18 @@ private:
         const SelectQueryInfo & query_info,
         size_t num_streams,
         DAGPipeline & pipeline);
+    void buildRemoteSegmentSourceOps(
+        PipelineExecutorStatus & exec_status,
+        const Context & db_context,
+        const DM::RNRemoteReadTaskPtr & remote_read_tasks,
+        size_t num_streams,
+        SourceOps & source_ops);
+    // The components shared by all the readers of the remote segments.
+    struct RemoteSegmentReadContext;
+    RemoteSegmentReadContext buildRemoteSegmentReadContext(
+        const Context & db_context,
+        const DM::RNRemoteReadTaskPtr & remote_read_tasks,
+        size_t num_streams);
 
 private:
     using RemoteTableRange = std::pair<Int64, pingcap::coprocessor::KeyRanges>;
@@ -33,6 +33,7 @@
 #include <Flash/Disaggregated/RNPageReceiver.h>
 #include <Flash/Disaggregated/RNPageReceiverContext.h>
 #include <Interpreters/Context.h>
+#include <Operators/RNRemoteSegmentSourceOp.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/Filter/PushDownFilter.h>
@@ -42,6 +43,7 @@
 #include <Storages/DeltaMerge/Remote/Proto/remote.pb.h>
 #include <Storages/DeltaMerge/Remote/RNRemoteReadTask.h>
 #include <Storages/DeltaMerge/Remote/RNRemoteSegmentThreadInputStream.h>
+#include <Storages/S3/S3Common.h>
 #include <Storages/SelectQueryInfo.h>
 #include <Storages/StorageDeltaMerge.h>
 #include <Storages/StorageDisaggregated.h>
@@ -95,14 +97,40 @@ BlockInputStreams StorageDisaggregated::readFromWriteNode(
     const Context & db_context,
     const SelectQueryInfo & query_info,
     unsigned num_streams)
+{
+    auto remote_read_tasks = buildDisaggTasksWithBackoff(db_context);
+
+    // Build InputStream according to the remote segment read tasks
+    DAGPipeline pipeline;
+    buildRemoteSegmentInputStreams(db_context, remote_read_tasks, query_info, num_streams, pipeline);
+    NamesAndTypes source_columns = genNamesAndTypesForExchangeReceiver(table_scan);
+    filterConditions(std::move(source_columns), pipeline);
+    return pipeline.streams;
+}
+
+SourceOps StorageDisaggregated::readSourceOps(
+    PipelineExecutorStatus & exec_status,
+    const Context & db_context,
+    unsigned num_streams)
+{
+    RUNTIME_CHECK_MSG(S3::ClientFactory::instance().isEnabled(), "Pipeline model only supports reading from the remote storage on the disaggregated compute node");
+
+    auto remote_read_tasks = buildDisaggTasksWithBackoff(db_context);
+
+    // Build SourceOps according to the remote segment read tasks
+    SourceOps source_ops;
+    buildRemoteSegmentSourceOps(exec_status, db_context, remote_read_tasks, num_streams, source_ops);
+    analyzer = std::make_unique<DAGExpressionAnalyzer>(genNamesAndTypesForExchangeReceiver(table_scan), context);
+    return source_ops;
+}
+
+DM::RNRemoteReadTaskPtr StorageDisaggregated::buildDisaggTasksWithBackoff(const Context & db_context)
 {
     using namespace pingcap;
 
     auto scan_context = std::make_shared<DM::ScanContext>();
     context.getDAGContext()->scan_context_map[table_scan.getTableScanExecutorID()] = scan_context;
 
-    DM::RNRemoteReadTaskPtr remote_read_tasks;
-
     double total_backoff_seconds = 0.0;
     SCOPE_EXIT({
         GET_METRIC(tiflash_disaggregated_breakdown_duration_seconds, type_total_establish_backoff).Observe(total_backoff_seconds);
@@ -122,12 +150,10 @@ BlockInputStreams StorageDisaggregated::readFromWriteNode(
             RUNTIME_CHECK(!batch_cop_tasks.empty());
 
             // Fetch the remote segment read tasks from write nodes
-            remote_read_tasks = buildDisaggTasks(
+            return buildDisaggTasks(
                 db_context,
                 scan_context,
                 batch_cop_tasks);
-
-            break;
         }
         catch (DB::Exception & e)
         {
@@ -143,16 +169,8 @@ BlockInputStreams StorageDisaggregated::readFromWriteNode(
             bo.backoff(pingcap::kv::boRegionMiss, pingcap::Exception(e.message(), e.code()));
         }
     }
-
-    // Build InputStream according to the remote segment read tasks
-    DAGPipeline pipeline;
-    buildRemoteSegmentInputStreams(db_context, remote_read_tasks, query_info, num_streams, pipeline);
-    NamesAndTypes source_columns = genNamesAndTypesForExchangeReceiver(table_scan);
-    filterConditions(std::move(source_columns), pipeline);
-    return pipeline.streams;
 }
 
-
 DM::RNRemoteReadTaskPtr StorageDisaggregated::buildDisaggTasks(
     const Context & db_context,
     const DM::ScanContextPtr & scan_context,
@@ -451,17 +469,20 @@ DM::RSOperatorPtr StorageDisaggregated::buildRSOperator(
     return rs_operator;
 }
 
-void StorageDisaggregated::buildRemoteSegmentInputStreams(
+struct StorageDisaggregated::RemoteSegmentReadContext
+{
+    RNPagePreparerPtr page_preparer;
+    DM::ColumnDefinesPtr column_defines;
+    size_t extra_table_id_index;
+    DM::PushDownFilterPtr push_down_filter;
+    DM::ReadMode read_mode;
+};
+
+StorageDisaggregated::RemoteSegmentReadContext StorageDisaggregated::buildRemoteSegmentReadContext(
     const Context & db_context,
     const DM::RNRemoteReadTaskPtr & remote_read_tasks,
-    const SelectQueryInfo &,
-    size_t num_streams,
-    DAGPipeline & pipeline)
+    size_t num_streams)
 {
-    auto io_concurrency = static_cast<size_t>(static_cast<double>(num_streams) * db_context.getSettingsRef().disagg_read_concurrency_scale);
-    LOG_DEBUG(log, "Build disagg streams with {} segment tasks, num_streams={} io_concurrency={}", remote_read_tasks->numSegments(), num_streams, io_concurrency);
-    // TODO: We can reduce max io_concurrency to numSegments.
-
     const auto & executor_id = table_scan.getTableScanExecutorID();
     // Build a RNPageReceiver to fetch the pages from all write nodes
     auto * kv_cluster = db_context.getTMTContext().getKVCluster();
@@ -475,7 +496,6 @@ void StorageDisaggregated::buildRemoteSegmentInputStreams(
 
     bool do_prepare = false;
 
-    // Build the input streams to read blocks from remote segments
     auto [column_defines, extra_table_id_index] = genColumnDefinesForDisaggregatedRead(table_scan);
     auto page_preparer = std::make_shared<RNPagePreparer>(
         remote_read_tasks,
@@ -486,10 +506,6 @@ void StorageDisaggregated::buildRemoteSegmentInputStreams(
         executor_id,
         do_prepare);
 
-    const UInt64 read_tso = sender_target_mpp_task_id.query_id.start_ts;
-    constexpr std::string_view extra_info = "disaggregated compute node remote segment reader";
-    pipeline.streams.reserve(num_streams);
-
     auto rs_operator = buildRSOperator(db_context, column_defines);
     auto push_down_filter = StorageDeltaMerge::buildPushDownFilter(
         rs_operator,
@@ -499,6 +515,32 @@ void StorageDisaggregated::buildRemoteSegmentInputStreams(
         db_context,
         log);
     auto read_mode = DM::DeltaMergeStore::getReadMode(db_context, table_scan.isFastScan(), table_scan.keepOrder(), push_down_filter);
+    return RemoteSegmentReadContext{
+        .page_preparer = std::move(page_preparer),
+        .column_defines = std::move(column_defines),
+        .extra_table_id_index = extra_table_id_index,
+        .push_down_filter = std::move(push_down_filter),
+        .read_mode = read_mode,
+    };
+}
+
+void StorageDisaggregated::buildRemoteSegmentInputStreams(
+    const Context & db_context,
+    const DM::RNRemoteReadTaskPtr & remote_read_tasks,
+    const SelectQueryInfo &,
+    size_t num_streams,
+    DAGPipeline & pipeline)
+{
+    auto io_concurrency = static_cast<size_t>(static_cast<double>(num_streams) * db_context.getSettingsRef().disagg_read_concurrency_scale);
+    LOG_DEBUG(log, "Build disagg streams with {} segment tasks, num_streams={} io_concurrency={}", remote_read_tasks->numSegments(), num_streams, io_concurrency);
+    // TODO: We can reduce max io_concurrency to numSegments.
+
+    // Build the input streams to read blocks from remote segments
+    auto read_ctx = buildRemoteSegmentReadContext(db_context, remote_read_tasks, num_streams);
+
+    const UInt64 read_tso = sender_target_mpp_task_id.query_id.start_ts;
+    constexpr std::string_view extra_info = "disaggregated compute node remote segment reader";
+    pipeline.streams.reserve(num_streams);
 
     auto sub_streams_size = io_concurrency / num_streams;
     for (size_t stream_idx = 0; stream_idx < num_streams; ++stream_idx)
@@ -509,21 +551,22 @@ void StorageDisaggregated::buildRemoteSegmentInputStreams(
         auto sub_streams = DM::RNRemoteSegmentThreadInputStream::buildInputStreams(
             db_context,
             remote_read_tasks,
-            page_preparer,
-            column_defines,
+            read_ctx.page_preparer,
+            read_ctx.column_defines,
             read_tso,
             sub_streams_size,
-            extra_table_id_index,
-            push_down_filter,
+            read_ctx.extra_table_id_index,
+            read_ctx.push_down_filter,
             extra_info,
             /*tracing_id*/ log->identifier(),
-            read_mode);
+            read_ctx.read_mode);
         RUNTIME_CHECK(!sub_streams.empty(), sub_streams.size(), sub_streams_size);
 
         auto union_stream = std::make_shared<UnionBlockInputStream<>>(sub_streams, BlockInputStreams{}, sub_streams_size, /*req_id=*/"");
         pipeline.streams.emplace_back(std::move(union_stream));
     }
 
+    const auto & executor_id = table_scan.getTableScanExecutorID();
     auto * dag_context = db_context.getDAGContext();
     auto & table_scan_io_input_streams = dag_context->getInBoundIOInputStreamsMap()[executor_id];
     auto & profile_streams = dag_context->getProfileStreamsMap()[executor_id];
@@ -533,4 +576,37 @@ void StorageDisaggregated::buildRemoteSegmentInputStreams(
     });
 }
 
+void StorageDisaggregated::buildRemoteSegmentSourceOps(
+    PipelineExecutorStatus & exec_status,
+    const Context & db_context,
+    const DM::RNRemoteReadTaskPtr & remote_read_tasks,
+    size_t num_streams,
+    SourceOps & source_ops)
+{
+    // Different from the input streams, there is no need to scale up the concurrency for IO.
+    // Waiting for the pages is done by the WaitReactor and reading is done by the IO thread pool,
+    // so the source ops never block the threads of the TaskScheduler.
+    LOG_DEBUG(log, "Build disagg source ops with {} segment tasks, num_streams={}", remote_read_tasks->numSegments(), num_streams);
+
+    auto read_ctx = buildRemoteSegmentReadContext(db_context, remote_read_tasks, num_streams);
+
+    const UInt64 read_tso = sender_target_mpp_task_id.query_id.start_ts;
+    source_ops.reserve(num_streams);
+    for (size_t i = 0; i < num_streams; ++i)
+    {
+        source_ops.emplace_back(std::make_unique<RNRemoteSegmentSourceOp>(
+            exec_status,
+            db_context,
+            remote_read_tasks,
+            read_ctx.page_preparer,
+            *read_ctx.column_defines,
+            read_ctx.push_down_filter,
+            read_tso,
+            DEFAULT_BLOCK_SIZE,
+            read_ctx.read_mode,
+            read_ctx.extra_table_id_index,
+            log->identifier()));
+    }
+}
+
 } // namespace DB
@@ -68,6 +68,9 @@ StorageSystemDTSegments::StorageSystemDTSegments(const std::string & name_)
         {"stable_dmfiles_size", std::make_shared<DataTypeUInt64>()},
         {"stable_dmfiles_size_on_disk", std::make_shared<DataTypeUInt64>()},
         {"stable_dmfiles_packs", std::make_shared<DataTypeUInt64>()},
+
+        {"read_per_minute", std::make_shared<DataTypeFloat64>()},
+        {"read_rows_per_minute", std::make_shared<DataTypeFloat64>()},
     }));
 }
 
@@ -150,6 +153,9 @@ BlockInputStreams StorageSystemDTSegments::read(const Names & column_names,
                 res_columns[j++]->insert(stat.stable_dmfiles_size);
                 res_columns[j++]->insert(stat.stable_dmfiles_size_on_disk);
                 res_columns[j++]->insert(stat.stable_dmfiles_packs);
+
+                res_columns[j++]->insert(stat.read_per_minute);
+                res_columns[j++]->insert(stat.read_rows_per_minute);
             }
         }
     }
@@ -16,6 +16,7 @@
 #include <Common/Stopwatch.h>
 #include <Common/TiFlashMetrics.h>
 #include <Common/setThreadName.h>
+#include <Flash/Coprocessor/CopResponseCache.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/SharedContexts/Disagg.h>
 #include <Storages/StorageDeltaMerge.h>
@@ -317,6 +318,8 @@ void KVStore::handleDestroy(UInt64 region_id, TMTContext & tmt, const KVStoreTas
     LOG_INFO(log, "Handle destroy {}", region->toString());
     region->setPendingRemove();
     removeRegion(region_id, /* remove_data */ true, tmt.getRegionTable(), task_lock, region_manager.genRegionTaskLock(region_id));
+    if (auto cop_response_cache = tmt.getContext().getCopResponseCache(); cop_response_cache)
+        cop_response_cache->invalidateRegion(region_id);
 }
 
 void KVStore::setRegionCompactLogConfig(UInt64 sec, UInt64 rows, UInt64 bytes)
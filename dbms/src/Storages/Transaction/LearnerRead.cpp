@@ -440,6 +440,38 @@ LearnerReadSnapshot doLearnerRead(
     return regions_snapshot;
 }
 
+std::unordered_map<RegionID, UInt64> batchGetReadIndex(const std::vector<RegionID> & region_ids, UInt64 read_tso, TMTContext & tmt)
+{
+    std::unordered_map<RegionID, UInt64> read_indexes;
+    KVStorePtr & kvstore = tmt.getKVStore();
+    // If using `std::numeric_limits<uint64_t>::max()`, set `start-ts` 0 to get the latest index, see `doLearnerRead`.
+    const auto read_index_tso = read_tso == std::numeric_limits<uint64_t>::max() ? 0 : read_tso;
+    std::vector<kvrpcpb::ReadIndexRequest> batch_read_index_req;
+    for (const auto region_id : region_ids)
+    {
+        auto region = kvstore->getRegion(region_id);
+        if (region == nullptr)
+            continue;
+        if (read_tso != std::numeric_limits<uint64_t>::max() && read_index_tso <= tmt.getRegionTable().getSelfSafeTS(region_id))
+            read_indexes.emplace(region_id, 0);
+        else
+            batch_read_index_req.emplace_back(GenRegionReadIndexReq(*region, read_index_tso));
+    }
+    // Only in mock test, `proxy_helper` will be `nullptr`, there is no leader to get the read index from.
+    if (batch_read_index_req.empty() || !kvstore->getProxyHelper() || !tmt.checkRunning())
+        return read_indexes;
+
+    GET_METRIC(tiflash_raft_read_index_count).Increment(batch_read_index_req.size());
+    kvstore->addReadIndexEvent(1);
+    SCOPE_EXIT({ kvstore->addReadIndexEvent(-1); });
+    for (auto && [resp, region_id] : kvstore->batchReadIndex(batch_read_index_req, tmt.batchReadIndexTimeout()))
+    {
+        if (!resp.has_region_error() && !resp.has_locked() && resp.read_index() != 0)
+            read_indexes.emplace(region_id, resp.read_index());
+    }
+    return read_indexes;
+}
+
 /// Ensure regions' info after read.
 void validateQueryInfo(
     const MvccQueryInfo & mvcc_query_info,
@@ -46,6 +46,11 @@ doLearnerRead(
     Context & context,
     const LoggerPtr & log);
 
+// Get the read index of `read_tso` from the leaders of the regions in batch, which is the first step of learner read.
+// The regions that can be read stale by their safe ts are mapped to 0 because they need not wait for any index.
+// The regions that meet any error or lock are not in the result, they should be handled by the normal learner read.
+std::unordered_map<RegionID, UInt64> batchGetReadIndex(const std::vector<RegionID> & region_ids, UInt64 read_tso, TMTContext & tmt);
+
 // After getting stream from storage, we must make sure regions' version haven't changed after learner read.
 // If some regions' version changed, this function will throw `RegionException`.
 void validateQueryInfo(
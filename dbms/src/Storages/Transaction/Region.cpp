@@ -15,6 +15,8 @@
 #include <Common/ProfileEvents.h>
 #include <Common/Stopwatch.h>
 #include <Common/TiFlashMetrics.h>
+#include <Flash/Coprocessor/CopResponseCache.h>
+#include <Interpreters/Context.h>
 #include <Storages/Transaction/KVStore.h>
 #include <Storages/Transaction/ProxyFFI.h>
 #include <Storages/Transaction/Region.h>
@@ -726,6 +728,10 @@ EngineStoreApplyRes Region::handleWriteRaftCmd(const WriteCmdsView & cmds, UInt6
 
     meta.notifyAll();
 
+    // The cop responses computed on the data before this index can not be served any more.
+    if (auto cop_response_cache = context.getCopResponseCache(); cop_response_cache)
+        cop_response_cache->invalidateRegion(id());
+
     return EngineStoreApplyRes::None;
 }
 
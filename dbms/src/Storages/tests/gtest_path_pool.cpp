@@ -198,6 +198,89 @@ try
 }
 CATCH
 
+TEST_F(PathPoolTest, ColdPaths)
+try
+{
+    Strings paths = getMultiTestPaths();
+    Strings main_paths(paths.begin(), paths.begin() + 2);
+    Strings cold_paths(paths.begin() + 2, paths.end());
+    auto ctx = TiFlashTestEnv::getContext();
+
+    PathPool pool(main_paths, main_paths, Strings{}, ctx->getPathCapacity(), ctx->getFileProvider(), cold_paths);
+    auto spool = pool.withTable("test", "t", false);
+    auto delegate = spool.getStableDiskDelegator();
+    ASSERT_TRUE(delegate.hasPaths(StorageTier::Hot));
+    ASSERT_TRUE(delegate.hasPaths(StorageTier::Cold));
+
+    // The DTFiles on the cold paths are listed, so that they can be found when restoring.
+    auto res = delegate.listPaths();
+    ASSERT_EQ(res.size(), paths.size());
+    auto is_path_of = [](const Strings & root_paths, const String & path) {
+        return std::any_of(root_paths.begin(), root_paths.end(), [&](const String & root) {
+            return path == root + DIR_PREFIX_OF_TABLE + StoragePathPool::STABLE_FOLDER_NAME;
+        });
+    };
+
+    for (size_t i = 0; i < TEST_NUMBER_FOR_CHOOSE; ++i)
+    {
+        const auto tier = i % 2 == 0 ? StorageTier::Hot : StorageTier::Cold;
+        auto chosen = delegate.choosePath(tier);
+        ASSERT_TRUE(is_path_of(tier == StorageTier::Hot ? main_paths : cold_paths, chosen)) << chosen;
+        delegate.addDTFile(i, 200, chosen);
+        ASSERT_EQ(delegate.getDTFilePath(i), chosen);
+        ASSERT_EQ(delegate.getDTFileTier(i), tier);
+    }
+    ASSERT_FALSE(delegate.getDTFileTier(TEST_NUMBER_FOR_CHOOSE).has_value());
+
+    for (size_t i = 0; i < TEST_NUMBER_FOR_CHOOSE; ++i)
+        delegate.removeDTFile(i);
+
+    // No cold paths are configured.
+    PathPool main_only_pool(main_paths, main_paths, Strings{}, ctx->getPathCapacity(), ctx->getFileProvider());
+    auto main_only_spool = main_only_pool.withTable("test", "t", false);
+    auto main_only_delegate = main_only_spool.getStableDiskDelegator();
+    ASSERT_TRUE(main_only_delegate.hasPaths(StorageTier::Hot));
+    ASSERT_FALSE(main_only_delegate.hasPaths(StorageTier::Cold));
+    ASSERT_THROW(main_only_delegate.choosePath(StorageTier::Cold), DB::Exception);
+}
+CATCH
+
+TEST_F(PathPoolTest, StorageRoot)
+try
+{
+    Strings paths = getMultiTestPaths();
+    auto ctx = TiFlashTestEnv::getContext();
+
+    PathPool pool(paths, paths, Strings{}, ctx->getPathCapacity(), ctx->getFileProvider());
+    auto spool_1 = pool.withTable("test", "t_1", false);
+    auto spool_2 = pool.withTable("test", "t_2", false);
+    auto delegate_1 = spool_1.getStableDiskDelegator();
+    auto delegate_2 = spool_2.getStableDiskDelegator();
+    for (size_t i = 0; i < TEST_NUMBER_FOR_CHOOSE; ++i)
+    {
+        auto chosen_1 = delegate_1.choosePath();
+        auto chosen_2 = delegate_2.choosePath();
+        delegate_1.addDTFile(i, 200, chosen_1);
+        delegate_2.addDTFile(i, 200, chosen_2);
+
+        // The root is the configured path, which is shared by the DTFiles of all tables on it.
+        const auto root_1 = delegate_1.getDTFileStorageRoot(i);
+        const auto root_2 = delegate_2.getDTFileStorageRoot(i);
+        ASSERT_EQ(chosen_1, fmt::format("{}/data/t_1/{}", root_1, StoragePathPool::STABLE_FOLDER_NAME));
+        ASSERT_EQ(chosen_2, fmt::format("{}/data/t_2/{}", root_2, StoragePathPool::STABLE_FOLDER_NAME));
+        ASSERT_NE(std::find(paths.begin(), paths.end(), root_1), paths.end()) << root_1;
+        ASSERT_NE(std::find(paths.begin(), paths.end(), root_2), paths.end()) << root_2;
+    }
+    ASSERT_EQ(delegate_1.getDTFileStorageRoot(TEST_NUMBER_FOR_CHOOSE), "");
+
+    for (size_t i = 0; i < TEST_NUMBER_FOR_CHOOSE; ++i)
+    {
+        delegate_1.removeDTFile(i);
+        delegate_2.removeDTFile(i);
+    }
+}
+CATCH
+
 TEST_F(PathPoolTest, UnalignPaths)
 try
 {
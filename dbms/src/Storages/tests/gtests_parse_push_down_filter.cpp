@@ -14,10 +14,12 @@
 
 #include <Columns/ColumnsCommon.h>
 #include <Common/typeid_cast.h>
+#include <DataStreams/BlocksListBlockInputStream.h>
 #include <Debug/dbgQueryCompiler.h>
 #include <Flash/Coprocessor/DAGQueryInfo.h>
 #include <Flash/Coprocessor/DAGQuerySource.h>
 #include <Interpreters/Context.h>
+#include <Storages/DeltaMerge/AdaptiveFilterBlockInputStream.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <Storages/DeltaMerge/Filter/PushDownFilter.h>
 #include <Storages/DeltaMerge/FilterParser/FilterParser.h>
@@ -761,4 +763,80 @@ try
 }
 CATCH
 
+TEST_F(ParsePushDownFilterTest, AdaptivePredicateOrder)
+try
+{
+    const String table_info_json = R"json({
+    "cols":[
+        {"comment":"","default":null,"default_bit":null,"id":2,"name":{"L":"col_2","O":"col_2"},"offset":-1,"origin_default":null,"state":0,"type":{"Charset":null,"Collate":null,"Decimal":0,"Elems":null,"Flag":4097,"Flen":0,"Tp":8}},
+        {"comment":"","default":null,"default_bit":null,"id":3,"name":{"L":"col_3","O":"col_3"},"offset":-1,"origin_default":null,"state":0,"type":{"Charset":null,"Collate":null,"Decimal":0,"Elems":null,"Flag":4097,"Flen":0,"Tp":8}}
+    ],
+    "pk_is_handle":false,"index_info":[],"is_common_handle":false,
+    "name":{"L":"t_111","O":"t_111"},"partition":null,
+    "comment":"Mocked.","id":30,"schema_version":-1,"state":0,"tiflash_replica":{"Count":0},"update_timestamp":1636471547239654
+})json";
+
+    // `col_2 > 0` passes all the rows, while `col_3 = 666` passes 10% of the rows.
+    auto filter = generatePushDownFilter(table_info_json, "select * from default.t_111 where col_2 > 0 and col_3 = 666", default_timezone_info);
+    ASSERT_EQ(filter->predicates.size(), 2);
+
+    constexpr size_t block_rows = 100;
+    constexpr size_t num_blocks = DM::AdaptiveFilterBlockInputStream::REORDER_INTERVAL_BLOCKS * 2;
+    auto make_input = [&]() {
+        BlocksList blocks;
+        for (size_t i = 0; i < num_blocks; ++i)
+        {
+            std::vector<Int64> col_2(block_rows), col_3(block_rows);
+            for (size_t j = 0; j < block_rows; ++j)
+            {
+                col_2[j] = i * block_rows + j + 1;
+                col_3[j] = j % 10 == 0 ? 666 : j;
+            }
+            blocks.push_back(Block{toVec<Int64>("col_2", col_2), toVec<Int64>("col_3", col_3)});
+        }
+        return std::make_shared<BlocksListBlockInputStream>(std::move(blocks));
+    };
+
+    auto scan_context = std::make_shared<DM::ScanContext>();
+    {
+        DM::AdaptiveFilterBlockInputStream stream(make_input(), filter->predicates, scan_context, "");
+        ASSERT_EQ(stream.getOrder(), std::vector<size_t>({0, 1}));
+        size_t passed_rows = 0;
+        stream.readPrefix();
+        while (Block block = stream.read())
+        {
+            for (const auto & value : typeid_cast<const ColumnInt64 &>(*block.getByName("col_3").column).getData())
+                ASSERT_EQ(value, 666);
+            passed_rows += block.rows();
+        }
+        stream.readSuffix();
+        ASSERT_EQ(passed_rows, num_blocks * block_rows / 10);
+        // The selective predicate is moved to the front.
+        ASSERT_EQ(stream.getOrder(), std::vector<size_t>({1, 0}));
+        ASSERT_GE(scan_context->total_pushdown_predicate_reorder_times.load(), 1);
+    }
+
+    auto stats = scan_context->getPushDownPredicateStats();
+    ASSERT_EQ(stats.size(), 2);
+    ASSERT_EQ(stats[1].input_rows, num_blocks * block_rows);
+    ASSERT_EQ(stats[1].passed_rows, num_blocks * block_rows / 10);
+    // Only the rows passed `col_3 = 666` are evaluated by `col_2 > 0` after reordering.
+    ASSERT_LT(stats[0].input_rows, num_blocks * block_rows);
+    ASSERT_EQ(stats[0].input_rows, stats[0].passed_rows);
+
+    {
+        // A new stream starts with the order learned by the previous one, and returns the filter without filtering the block.
+        DM::AdaptiveFilterBlockInputStream stream(make_input(), filter->predicates, scan_context, "");
+        ASSERT_EQ(stream.getOrder(), std::vector<size_t>({1, 0}));
+        stream.readPrefix();
+        FilterPtr res_filter = nullptr;
+        Block block = stream.read(res_filter, true);
+        ASSERT_EQ(block.rows(), block_rows);
+        ASSERT_NE(res_filter, nullptr);
+        ASSERT_EQ(countBytesInFilter(*res_filter), block_rows / 10);
+        stream.readSuffix();
+    }
+}
+CATCH
+
 } // namespace DB::tests